@@ -0,0 +1,16 @@
+#include <stdio.h>
+
+#include <System/Memory.h>
+
+#define BENCHMARK_RUNNER
+#include <Misc/Benchmark.h>
+
+int main(void)
+{
+    MemoryTracker memoryTracker;
+
+    RunAllBenchmarks();
+
+    MemoryDumpAllocs();
+    return 0;
+}
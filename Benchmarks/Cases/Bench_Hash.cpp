@@ -0,0 +1,112 @@
+#include <Misc/Benchmark.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <System/Core.h>
+#include <System/Memory.h>
+
+constexpr I32 HASH_BUFFER_SIZE = 1024 * 1024 + 64;
+
+struct HashBenchmark
+{
+    U8*         Buffer;
+    I32         Length;
+    I32         Count;      // Hashes per run, walking the buffer so keys differ
+};
+
+// The baseline is visible to the compiler, its result must be used to be computed
+static volatile U64 gHashBenchmarkSink;
+
+// Previous CalcHash64 (Murmur, byte loads), kept as the baseline
+static U64 MurmurHash64(const void* buffer, I32 length, U64 seed)
+{
+    constexpr U64 mul = 0xc6a4a7935bd1e995ULL;
+    constexpr U64 rot = 47;
+
+    const U8* target = (U8*)buffer;
+    const U32 l = (U32)length;
+    const U32 n = (l >> 3) << 3;
+
+    U64 h = seed ^ (l | mul);
+    for (U32 i = 0; i < n; i += 8)
+    {
+        U64 k = 0;
+        for (U32 j = 0; j < 8; j++)
+        {
+            k |= (U64)target[i + j] << (j * 8);
+        }
+
+        k *= mul;
+        k ^= (k >> rot);
+        k *= mul;
+
+        h ^= k;
+        h *= mul;
+    }
+
+    for (U32 i = n; i < l; i++)
+    {
+        h ^= (U64)target[i] << ((i - n) * 8);
+    }
+
+    h *= mul;
+    h ^= (h >> rot);
+    h *= mul;
+    h ^= (h >> rot);
+
+    return h;
+}
+
+static void CalcHash64Keys(void* data)
+{
+    HashBenchmark* benchmark = (HashBenchmark*)data;
+
+    U64 sum = 0;
+    for (I32 i = 0; i < benchmark->Count; i++)
+    {
+        sum += CalcHash64(benchmark->Buffer + (i & 63), benchmark->Length);
+    }
+    gHashBenchmarkSink = sum;
+}
+
+static void MurmurHash64Keys(void* data)
+{
+    HashBenchmark* benchmark = (HashBenchmark*)data;
+
+    U64 sum = 0;
+    for (I32 i = 0; i < benchmark->Count; i++)
+    {
+        sum += MurmurHash64(benchmark->Buffer + (i & 63), benchmark->Length, 0);
+    }
+    gHashBenchmarkSink = sum;
+}
+
+DEFINE_BENCHMARK("Hash")
+{
+    HashBenchmark benchmark;
+    benchmark.Buffer = (U8*)MemoryAlloc(HASH_BUFFER_SIZE);
+    for (I32 i = 0; i < HASH_BUFFER_SIZE; i++)
+    {
+        benchmark.Buffer[i] = (U8)(i * 131 + (i >> 8));
+    }
+
+    const I32 lengths[] = { 4, 8, 16, 32, 64, 128, 256, 1024, 4 * 1024, 64 * 1024, 1024 * 1024 };
+    for (I32 length : lengths)
+    {
+        benchmark.Length = length;
+        benchmark.Count = length <= 4096 ? 1024 : 1;
+
+        char name[64];
+        snprintf(name, sizeof(name), "CalcHash64 %d bytes", length);
+        const double seconds = MeasureBenchmark(name, benchmark.Count, CalcHash64Keys, &benchmark);
+
+        snprintf(name, sizeof(name), "Murmur (previous CalcHash64) %d bytes", length);
+        const double baselineSeconds = MeasureBenchmark(name, benchmark.Count, MurmurHash64Keys, &benchmark);
+
+        printf("    %-48s %10.3f GB/s (previous %.3f GB/s)\n", "",
+            (double)length * benchmark.Count / seconds / 1e9, (double)length * benchmark.Count / baselineSeconds / 1e9);
+    }
+
+    MemoryFree(benchmark.Buffer);
+}
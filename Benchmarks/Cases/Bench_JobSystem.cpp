@@ -0,0 +1,61 @@
+#include <Misc/Benchmark.h>
+
+#include <atomic>
+#include <stdio.h>
+
+#include <Concurrency/JobSystem.h>
+
+constexpr I32 JOBS_PER_RUN = 4096;
+
+struct JobSystemBenchmark
+{
+    std::atomic<I32>    Counter;
+    Job                 Jobs[JOBS_PER_RUN];
+};
+
+static void CountJob(void* data)
+{
+    ((std::atomic<I32>*)data)->fetch_add(1, std::memory_order_relaxed);
+}
+
+static void StartJobOneByOne(void* data)
+{
+    JobSystemBenchmark* benchmark = (JobSystemBenchmark*)data;
+    for (I32 i = 0; i < JOBS_PER_RUN; i++)
+    {
+        StartJob(benchmark->Jobs[i]);
+    }
+    WaitForJobs();
+}
+
+static void StartJobsBatched(void* data)
+{
+    JobSystemBenchmark* benchmark = (JobSystemBenchmark*)data;
+    StartJobs(benchmark->Jobs, JOBS_PER_RUN);
+    WaitForJobs();
+}
+
+DEFINE_BENCHMARK("JobSystem submission")
+{
+    static JobSystemBenchmark benchmark;
+    for (I32 i = 0; i < JOBS_PER_RUN; i++)
+    {
+        benchmark.Jobs[i] = Job{ &benchmark.Counter, CountJob, "CountJob" };
+    }
+
+    // Threads count include the main thread
+    const I32 threadCounts[] = { 1, 4, 16, 64 };
+    for (I32 threadCount : threadCounts)
+    {
+        InitJobSystem(threadCount - 1);
+
+        char name[64];
+        snprintf(name, sizeof(name), "StartJob x%d, %d threads", JOBS_PER_RUN, threadCount);
+        MeasureBenchmark(name, JOBS_PER_RUN, StartJobOneByOne, &benchmark);
+
+        snprintf(name, sizeof(name), "StartJobs x%d, %d threads", JOBS_PER_RUN, threadCount);
+        MeasureBenchmark(name, JOBS_PER_RUN, StartJobsBatched, &benchmark);
+
+        ShutdownJobSystem();
+    }
+}
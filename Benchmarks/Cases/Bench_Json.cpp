@@ -0,0 +1,363 @@
+#include <Misc/Benchmark.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+#include <Text/Json.h>
+#include <System/Memory.h>
+#include <Container/Array.h>
+#include <Concurrency/JobSystem.h>
+
+// The corpus is generated in memory so the benchmark does not depend on asset files,
+// each document mimic a kind of asset we load: sprite atlases, tile maps and localized texts.
+constexpr I32 JSON_CORPUS_SIZE = 8 * 1024 * 1024;
+
+struct JsonCorpus
+{
+    const char* Name;
+    char*       Buffer;
+    I32         Length;
+
+    char*       Scratch;    // Mutable copy for in situ parsing
+};
+
+static void CorpusAppend(JsonCorpus* corpus, const char* format, ...)
+{
+    va_list varg;
+    va_start(varg, format);
+    corpus->Length += vsnprintf(corpus->Buffer + corpus->Length, JSON_CORPUS_SIZE + 4096 - corpus->Length, format, varg);
+    va_end(varg);
+}
+
+static JsonCorpus MakeAtlasCorpus(void)
+{
+    JsonCorpus corpus = { "atlas", (char*)MemoryAlloc(JSON_CORPUS_SIZE + 4096), 0, nullptr };
+
+    CorpusAppend(&corpus, "{\n  \"frames\": {\n");
+    for (I32 i = 0; corpus.Length < JSON_CORPUS_SIZE; i++)
+    {
+        CorpusAppend(&corpus,
+            "%s    \"character/run_%05d.png\": {\n"
+            "      \"frame\": { \"x\": %d, \"y\": %d, \"w\": %d, \"h\": %d },\n"
+            "      \"rotated\": %s,\n"
+            "      \"trimmed\": true,\n"
+            "      \"spriteSourceSize\": { \"x\": %d, \"y\": %d, \"w\": 64, \"h\": 64 },\n"
+            "      \"pivot\": { \"x\": 0.5, \"y\": %.3f }\n"
+            "    }",
+            i > 0 ? ",\n" : "", i, (i * 67) % 4096, (i * 131) % 4096, 32 + i % 32, 48 + i % 16,
+            i % 7 == 0 ? "true" : "false", i % 5, i % 3, 0.25 + (i % 10) * 0.05);
+    }
+    CorpusAppend(&corpus, "\n  },\n  \"meta\": { \"image\": \"character.png\", \"format\": \"RGBA8888\", \"scale\": 1 }\n}\n");
+
+    return corpus;
+}
+
+static JsonCorpus MakeTileMapCorpus(void)
+{
+    JsonCorpus corpus = { "tilemap", (char*)MemoryAlloc(JSON_CORPUS_SIZE + 4096), 0, nullptr };
+
+    CorpusAppend(&corpus, "{\"width\":256,\"height\":256,\"tilewidth\":16,\"tileheight\":16,\"layers\":[");
+    for (I32 layer = 0; corpus.Length < JSON_CORPUS_SIZE; layer++)
+    {
+        CorpusAppend(&corpus, "%s{\"name\":\"layer%d\",\"opacity\":1,\"visible\":true,\"data\":[", layer > 0 ? "," : "", layer);
+        for (I32 i = 0; i < 256 * 256 && corpus.Length < JSON_CORPUS_SIZE; i++)
+        {
+            CorpusAppend(&corpus, i > 0 ? ",%d" : "%d", (i * 2654435761u >> 20) % 512);
+        }
+        CorpusAppend(&corpus, "]}");
+    }
+    CorpusAppend(&corpus, "]}");
+
+    return corpus;
+}
+
+static JsonCorpus MakeTextsCorpus(void)
+{
+    JsonCorpus corpus = { "texts", (char*)MemoryAlloc(JSON_CORPUS_SIZE + 4096), 0, nullptr };
+
+    CorpusAppend(&corpus, "[\n");
+    for (I32 i = 0; corpus.Length < JSON_CORPUS_SIZE; i++)
+    {
+        CorpusAppend(&corpus,
+            "%s\t{ \"id\": \"dialogue.chapter%d.line%d\", \"speaker\": \"npc_%d\", "
+            "\"text\": \"The old lighthouse keeper said \\\"nobody has climbed those stairs since the storm\\\", "
+            "then he turned back to the sea and waited.\\nPress \\\\A\\\\ to continue.\", \"duration\": %d.%d }",
+            i > 0 ? ",\n" : "", i / 100, i % 100, i % 17, 2 + i % 5, i % 10);
+    }
+    CorpusAppend(&corpus, "\n]\n");
+
+    return corpus;
+}
+
+// Exported mesh and animation, almost only numbers: positions, normals, uvs, indices and rotation keys
+static JsonCorpus MakeMeshCorpus(void)
+{
+    JsonCorpus corpus = { "mesh", (char*)MemoryAlloc(JSON_CORPUS_SIZE + 4096), 0, nullptr };
+
+    CorpusAppend(&corpus, "{\"name\":\"character\",\"vertices\":[");
+    for (I32 i = 0; corpus.Length < JSON_CORPUS_SIZE / 8 * 5; i++)
+    {
+        const float t = i * 0.0137f;
+        CorpusAppend(&corpus, "%s%.6f,%.6f,%.6f,%.7f,%.7f,%.7f,%.5f,%.5f",
+            i > 0 ? "," : "", sinf(t) * 1.75f, t * 0.01f - 0.9f, cosf(t * 0.7f) * 0.35f,
+            sinf(t * 3.0f), cosf(t * 3.0f), 0.0001234f * (i % 97), (i % 512) / 511.0f, (i % 384) / 383.0f);
+    }
+
+    CorpusAppend(&corpus, "],\"indices\":[");
+    for (I32 i = 0; corpus.Length < JSON_CORPUS_SIZE / 8 * 6; i++)
+    {
+        CorpusAppend(&corpus, i > 0 ? ",%d" : "%d", (i * 7) % 65536);
+    }
+
+    CorpusAppend(&corpus, "],\"animation\":[");
+    for (I32 i = 0; corpus.Length < JSON_CORPUS_SIZE; i++)
+    {
+        const float t = i * 0.0333333f;
+        CorpusAppend(&corpus, "%s{\"time\":%.7g,\"rotation\":[%.9g,%.9g,%.9g,%.9g],\"scale\":%.3e}",
+            i > 0 ? "," : "", t, sinf(t) * 0.5f, cosf(t) * 0.5f, -0.5f, 0.5f, 1.0f + 1e-4f * (i % 10));
+    }
+    CorpusAppend(&corpus, "]}");
+
+    return corpus;
+}
+
+static void ParseJsonCorpus(void* data)
+{
+    JsonCorpus* corpus = (JsonCorpus*)data;
+
+    Json* json = ParseJson(corpus->Buffer, corpus->Length);
+    DoNotOptimize(json);
+    FreeJson(json);
+}
+
+// The copy is part of the measure: loaders parse in situ the buffer they just read
+static void ParseJsonInSituCorpus(void* data)
+{
+    JsonCorpus* corpus = (JsonCorpus*)data;
+    memcpy(corpus->Scratch, corpus->Buffer, corpus->Length);
+
+    Json* json = ParseJsonInSitu(corpus->Scratch, corpus->Length);
+    DoNotOptimize(json);
+    FreeJson(json);
+}
+
+// Stream the corpus to the reader in file sized reads, as FileRead would
+struct JsonCorpusStream
+{
+    const JsonCorpus*   Corpus;
+    I32                 Cursor;
+};
+
+static int ReadJsonCorpus(void* userData, void* buffer, int length)
+{
+    JsonCorpusStream* stream = (JsonCorpusStream*)userData;
+
+    const I32 remain = stream->Corpus->Length - stream->Cursor;
+    const I32 count = remain < length ? remain : length;
+
+    memcpy(buffer, stream->Corpus->Buffer + stream->Cursor, count);
+    stream->Cursor += count;
+    return count;
+}
+
+static void ReadJsonCorpusTokens(void* data)
+{
+    JsonCorpusStream stream = { (JsonCorpus*)data, 0 };
+    JsonReader* reader = MakeJsonReader(ReadJsonCorpus, &stream);
+
+    I32 tokens = 0;
+    JsonToken token;
+    while ((token = JsonReaderNext(reader)) != JsonToken::End && token != JsonToken::Error)
+    {
+        tokens++;
+    }
+
+    DoNotOptimize(tokens);
+    FreeJsonReader(reader);
+}
+
+// Serialize a parsed corpus back to compact text
+struct JsonWriteCorpus
+{
+    Json*   Document;
+    I32     Indent;
+};
+
+static void WriteJsonCorpus(void* data)
+{
+    JsonWriteCorpus* corpus = (JsonWriteCorpus*)data;
+
+    JsonWriter* writer = MakeJsonWriter(corpus->Indent);
+    JsonWrite(writer, *corpus->Document);
+    DoNotOptimize(writer->Buffer);
+    FreeJsonWriter(writer);
+}
+
+DEFINE_BENCHMARK("Json parsing")
+{
+    JsonCorpus corpora[] = {
+        MakeAtlasCorpus(),
+        MakeTileMapCorpus(),
+        MakeTextsCorpus(),
+        MakeMeshCorpus(),
+    };
+
+    for (JsonCorpus& corpus : corpora)
+    {
+        Json* json = ParseJson(corpus.Buffer, corpus.Length);
+        DebugAssert(json != nullptr, "Json corpus '%s' is not well-formed", corpus.Name);
+        FreeJson(json);
+
+        char name[64];
+        snprintf(name, sizeof(name), "ParseJson %s (%.1f MB), per byte", corpus.Name, corpus.Length / (1024.0 * 1024.0));
+
+        double seconds = MeasureBenchmark(name, corpus.Length, ParseJsonCorpus, &corpus);
+        printf("    %-48s %10.3f GB/s\n", "", corpus.Length / seconds / 1e9);
+
+        corpus.Scratch = (char*)MemoryAlloc(corpus.Length);
+
+        snprintf(name, sizeof(name), "ParseJsonInSitu %s (%.1f MB), per byte", corpus.Name, corpus.Length / (1024.0 * 1024.0));
+        seconds = MeasureBenchmark(name, corpus.Length, ParseJsonInSituCorpus, &corpus);
+        printf("    %-48s %10.3f GB/s\n", "", corpus.Length / seconds / 1e9);
+
+        MemoryFree(corpus.Scratch);
+
+        snprintf(name, sizeof(name), "JsonReaderNext %s (%.1f MB), per byte", corpus.Name, corpus.Length / (1024.0 * 1024.0));
+        seconds = MeasureBenchmark(name, corpus.Length, ReadJsonCorpusTokens, &corpus);
+        printf("    %-48s %10.3f GB/s\n", "", corpus.Length / seconds / 1e9);
+
+        // Throughput of the writer is measured on the compact and pretty text it produce
+        JsonWriteCorpus writeCorpus = { ParseJson(corpus.Buffer, corpus.Length), 0 };
+        for (writeCorpus.Indent = 0; writeCorpus.Indent <= 2; writeCorpus.Indent += 2)
+        {
+            JsonWriter* writer = MakeJsonWriter(writeCorpus.Indent);
+            JsonWrite(writer, *writeCorpus.Document);
+            const I32 length = writer->Length;
+            FreeJsonWriter(writer);
+
+            snprintf(name, sizeof(name), "JsonWrite %s %s (%.1f MB), per byte", corpus.Name, writeCorpus.Indent ? "pretty" : "compact", length / (1024.0 * 1024.0));
+            seconds = MeasureBenchmark(name, length, WriteJsonCorpus, &writeCorpus);
+            printf("    %-48s %10.3f GB/s\n", "", length / seconds / 1e9);
+        }
+        FreeJson(writeCorpus.Document);
+        MemoryFree(corpus.Buffer);
+    }
+}
+
+// Look up atlas frames by name: the binary document is used in place, without parsing
+struct JsonLookupCorpus
+{
+    Json        Frames;
+    JsonBinary  BinaryFrames;
+    I32         Count;
+    I32         Cursor;
+};
+
+static void FindJsonFrame(void* data)
+{
+    JsonLookupCorpus* corpus = (JsonLookupCorpus*)data;
+
+    char name[64];
+    snprintf(name, sizeof(name), "character/run_%05d.png", corpus->Cursor++ % corpus->Count);
+    DoNotOptimize(JsonFind(corpus->Frames, name));
+}
+
+static void FindJsonBinaryFrame(void* data)
+{
+    JsonLookupCorpus* corpus = (JsonLookupCorpus*)data;
+
+    char name[64];
+    snprintf(name, sizeof(name), "character/run_%05d.png", corpus->Cursor++ % corpus->Count);
+    DoNotOptimize(JsonFind(corpus->BinaryFrames, name));
+}
+
+DEFINE_BENCHMARK("Json binary")
+{
+    JsonCorpus corpus = MakeAtlasCorpus();
+    Json* json = ParseJson(corpus.Buffer, corpus.Length);
+
+    Buffer binary = ConvertJsonToBinary(*json);
+    printf("    %-48s %10.1f MB text, %.1f MB binary\n", "", corpus.Length / (1024.0 * 1024.0), binary.Size / (1024.0 * 1024.0));
+
+    JsonBinary root = OpenJsonBinary(binary.Data, binary.Size);
+
+    JsonLookupCorpus lookup = { JsonFind(*json, "frames"), JsonFind(root, "frames"), 0, 0 };
+    lookup.Count = lookup.Frames.Object.Count;
+
+    MeasureBenchmark("JsonFind frame (hash table)", 1, FindJsonFrame, &lookup);
+    MeasureBenchmark("JsonFind frame (binary, sorted hashs)", 1, FindJsonBinaryFrame, &lookup);
+
+    MemoryFree(binary.Data);
+    FreeJson(json);
+    MemoryFree(corpus.Buffer);
+}
+
+// Pull one field of every record of the texts corpus
+struct JsonFieldCorpus
+{
+    Json*           Document;
+    Array<Json>     Values;
+};
+
+static void FindJsonFields(void* data)
+{
+    JsonFieldCorpus* corpus = (JsonFieldCorpus*)data;
+
+    ArrayClear(&corpus->Values);
+    for (int i = 0, n = corpus->Document->Array.Count; i < n; i++)
+    {
+        ArrayPush(&corpus->Values, JsonFind(corpus->Document->Array.Items[i], "speaker"));
+    }
+    DoNotOptimize(corpus->Values.Items);
+}
+
+static void QueryJsonFields(void* data)
+{
+    JsonFieldCorpus* corpus = (JsonFieldCorpus*)data;
+
+    constexpr JsonPath speakers = ConstJsonPath("/*/speaker");
+
+    ArrayClear(&corpus->Values);
+    JsonQueryAll(*corpus->Document, speakers, &corpus->Values);
+    DoNotOptimize(corpus->Values.Items);
+}
+
+DEFINE_BENCHMARK("Json path")
+{
+    JsonCorpus corpus = MakeTextsCorpus();
+
+    JsonFieldCorpus fields = { ParseJson(corpus.Buffer, corpus.Length), {} };
+    const int records = fields.Document->Array.Count;
+
+    MeasureBenchmark("JsonFind(record, \"speaker\"), per record", records, FindJsonFields, &fields);
+    MeasureBenchmark("JsonQueryAll(\"/*/speaker\"), per record", records, QueryJsonFields, &fields);
+
+    FreeArray(&fields.Values);
+    FreeJson(fields.Document);
+    MemoryFree(corpus.Buffer);
+}
+
+// Texts corpus is one large top-level array, it is split across the workers
+DEFINE_BENCHMARK("Json parallel parsing")
+{
+    JsonCorpus corpus = MakeTextsCorpus();
+
+    // Threads count include the main thread
+    const I32 threadCounts[] = { 1, 2, 4, 8 };
+    for (I32 threadCount : threadCounts)
+    {
+        InitJobSystem(threadCount - 1);
+
+        char name[64];
+        snprintf(name, sizeof(name), "ParseJson texts, %d threads, per byte", threadCount);
+
+        const double seconds = MeasureBenchmark(name, corpus.Length, ParseJsonCorpus, &corpus);
+        printf("    %-48s %10.3f GB/s\n", "", corpus.Length / seconds / 1e9);
+
+        ShutdownJobSystem();
+    }
+
+    MemoryFree(corpus.Buffer);
+}
@@ -0,0 +1,97 @@
+#include <Misc/Benchmark.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Text/Json.h>
+#include <Text/Lexer.h>
+#include <System/Memory.h>
+
+// Scripted assets: state machines with their editor metadata, then code
+constexpr I32 LEXER_SOURCE_SIZE = 16 * 1024 * 1024;
+
+struct LexerBenchmark
+{
+    char*       Source;
+    I32         Length;
+};
+
+static volatile I32 gLexerBenchmarkSink;
+
+static void LexAll(void* data)
+{
+    LexerBenchmark* benchmark = (LexerBenchmark*)data;
+
+    I32 count = 0;
+    Lexer lexer = MakeLexer(StringView(benchmark->Source, benchmark->Length));
+    for (LexerToken token; LexerNext(&lexer, &token);)
+    {
+        count++;
+    }
+    gLexerBenchmarkSink = count;
+}
+
+static void IndexMetadata(void* data)
+{
+    LexerBenchmark* benchmark = (LexerBenchmark*)data;
+
+    I32 count = 0;
+    Lexer lexer = MakeLexer(StringView(benchmark->Source, benchmark->Length));
+    for (LexerToken token; LexerNextMetadata(&lexer, &token);)
+    {
+        Json* json = ParseJson(benchmark->Source + token.Start, token.Length);
+        count += json != nullptr;
+        FreeJson(json);
+    }
+    gLexerBenchmarkSink = count;
+}
+
+DEFINE_BENCHMARK("Lexer")
+{
+    LexerBenchmark benchmark;
+    benchmark.Source = (char*)MemoryAlloc(LEXER_SOURCE_SIZE + 4096);
+    benchmark.Length = 0;
+
+    for (I32 i = 0; benchmark.Length < LEXER_SOURCE_SIZE; i++)
+    {
+        benchmark.Length += snprintf(benchmark.Source + benchmark.Length, 4096,
+            "// THIS METADATA ARE GENERATE BY EDITOR, PLEASE DO NOT REMOVE ITS\n"
+            "/*\n"
+            "{\n"
+            "    \"name\": \"enemy %d\",\n"
+            "    \"states\": [ \"idle\", \"move\", \"jump\", \"attack\" ],\n"
+            "    \"entry\": \"idle\",\n"
+            "    \"handlers\": { \"idle\": \"Enemy%d_IdleState\", \"move\": \"Enemy%d_MoveState\" }\n"
+            "}\n"
+            "*/\n"
+            "// END OF METADATA\n"
+            "\n"
+            "#include \"Enemy.h\"\n"
+            "\n"
+            "static void Enemy%d_IdleState(Enemy* enemy, float deltaTime)\n"
+            "{\n"
+            "    /* Wait for the player to come close */\n"
+            "    if (Vector2Distance(enemy->position, gPlayer.position) < 4.5f * enemy->range)\n"
+            "    {\n"
+            "        enemy->state = \"move\";\n"
+            "        enemy->timer += deltaTime * 0x10;\n"
+            "    }\n"
+            "}\n"
+            "\n"
+            "static void Enemy%d_MoveState(Enemy* enemy, float deltaTime)\n"
+            "{\n"
+            "    const Vector2 direction = Vector2Normalize(gPlayer.position - enemy->position);\n"
+            "    enemy->position += direction * (enemy->speed * deltaTime); // Straight to the player\n"
+            "}\n"
+            "\n",
+            i, i, i, i, i);
+    }
+
+    const double lexSeconds = MeasureBenchmark("LexerNext (16 MB of scripts)", 1, LexAll, &benchmark);
+    printf("    %-48s %10.3f MB/s\n", "", benchmark.Length / lexSeconds / 1e6);
+
+    const double indexSeconds = MeasureBenchmark("LexerNextMetadata + ParseJson (16 MB of scripts)", 1, IndexMetadata, &benchmark);
+    printf("    %-48s %10.3f MB/s (%d metadata blocks)\n", "", benchmark.Length / indexSeconds / 1e6, (I32)gLexerBenchmarkSink);
+
+    MemoryFree(benchmark.Source);
+}
@@ -0,0 +1,67 @@
+#include <Misc/Benchmark.h>
+
+#include <stdio.h>
+
+#include <System/Memory.h>
+#include <System/FileSystem.h>
+
+// Asset paths as found by GetFullPath: search path, then the path given to the loader
+constexpr I32 PATH_KEY_BENCHMARK_PATHS = 64 * 1024;
+
+struct PathKeyBenchmark
+{
+    char        (*Paths)[128];
+    I32*        Lengths;
+    I64         Bytes;
+};
+
+static volatile U64 gPathKeyBenchmarkSink;
+
+static void HashRawPaths(void* data)
+{
+    PathKeyBenchmark* benchmark = (PathKeyBenchmark*)data;
+
+    U64 hash = 0;
+    for (I32 i = 0; i < PATH_KEY_BENCHMARK_PATHS; i++)
+    {
+        hash ^= CalcHash64(benchmark->Paths[i], benchmark->Lengths[i]);
+    }
+    gPathKeyBenchmarkSink = hash;
+}
+
+static void HashPathKeys(void* data)
+{
+    PathKeyBenchmark* benchmark = (PathKeyBenchmark*)data;
+
+    U64 hash = 0;
+    for (I32 i = 0; i < PATH_KEY_BENCHMARK_PATHS; i++)
+    {
+        hash ^= MakePathKey(StringView(benchmark->Paths[i], benchmark->Lengths[i])).Hash;
+    }
+    gPathKeyBenchmarkSink = hash;
+}
+
+DEFINE_BENCHMARK("PathKey")
+{
+    PathKeyBenchmark benchmark;
+    benchmark.Paths = (char(*)[128])MemoryAlloc(PATH_KEY_BENCHMARK_PATHS * 128);
+    benchmark.Lengths = (I32*)MemoryAlloc(PATH_KEY_BENCHMARK_PATHS * sizeof(I32));
+    benchmark.Bytes = 0;
+
+    const char* searchPaths[] = { "../Games/Spaneon/Assets", "Assets", ".\\Assets\\", "C:/Projects/Yolo/Games/Spaneon/Assets" };
+    const char* directories[] = { "Art", "Audios", "Fonts", "Art/Sprites/../Effects", "Levels/World 1" };
+    for (I32 i = 0; i < PATH_KEY_BENCHMARK_PATHS; i++)
+    {
+        benchmark.Lengths[i] = snprintf(benchmark.Paths[i], 128, "%s/%s/Asset_%d.png", searchPaths[i % 4], directories[i % 5], i);
+        benchmark.Bytes += benchmark.Lengths[i];
+    }
+
+    const double rawSeconds = MeasureBenchmark("CalcHash64 of the full path (64K paths)", PATH_KEY_BENCHMARK_PATHS, HashRawPaths, &benchmark);
+    printf("    %-48s %10.3f GB/s\n", "", benchmark.Bytes / rawSeconds / 1e9);
+
+    const double keySeconds = MeasureBenchmark("MakePathKey (64K paths)", PATH_KEY_BENCHMARK_PATHS, HashPathKeys, &benchmark);
+    printf("    %-48s %10.3f GB/s\n", "", benchmark.Bytes / keySeconds / 1e9);
+
+    MemoryFree(benchmark.Lengths);
+    MemoryFree(benchmark.Paths);
+}
@@ -0,0 +1,114 @@
+#include <Misc/Benchmark.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Container/HashTable.h>
+#include <Container/PerfectHashTable.h>
+
+constexpr const char* PERFECT_HASH_BENCHMARK_KEYWORDS[] = {
+    "auto", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum",
+    "extern", "float", "for", "goto", "if", "inline", "int", "long", "register", "restrict", "return",
+    "short", "signed", "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void",
+    "volatile", "while",
+};
+constexpr I32 PERFECT_HASH_BENCHMARK_KEYWORD_COUNT = (I32)(sizeof(PERFECT_HASH_BENCHMARK_KEYWORDS) / sizeof(PERFECT_HASH_BENCHMARK_KEYWORDS[0]));
+constexpr auto PERFECT_HASH_BENCHMARK_TABLE = MakePerfectHashTable(PERFECT_HASH_BENCHMARK_KEYWORDS);
+
+// Identifiers of a source file: half keywords, half names
+constexpr I32 PERFECT_HASH_BENCHMARK_WORDS = 1024 * 1024;
+
+struct PerfectHashBenchmark
+{
+    char            (*Words)[16];
+    I32*            Lengths;
+    HashTable<I32>  Table;
+};
+
+static volatile I32 gPerfectHashBenchmarkSink;
+
+static void FindLinear(void* data)
+{
+    PerfectHashBenchmark* benchmark = (PerfectHashBenchmark*)data;
+
+    I32 found = 0;
+    for (I32 i = 0; i < PERFECT_HASH_BENCHMARK_WORDS; i++)
+    {
+        for (I32 j = 0; j < PERFECT_HASH_BENCHMARK_KEYWORD_COUNT; j++)
+        {
+            const char* keyword = PERFECT_HASH_BENCHMARK_KEYWORDS[j];
+            if (strlen(keyword) == (size_t)benchmark->Lengths[i] && memcmp(keyword, benchmark->Words[i], benchmark->Lengths[i]) == 0)
+            {
+                found++;
+                break;
+            }
+        }
+    }
+    gPerfectHashBenchmarkSink = found;
+}
+
+static void FindHashTable(void* data)
+{
+    PerfectHashBenchmark* benchmark = (PerfectHashBenchmark*)data;
+
+    I32 found = 0;
+    for (I32 i = 0; i < PERFECT_HASH_BENCHMARK_WORDS; i++)
+    {
+        I32 index;
+        if (HashTableTryGetValue(benchmark->Table, CalcHash64(benchmark->Words[i], benchmark->Lengths[i]), &index))
+        {
+            found += memcmp(PERFECT_HASH_BENCHMARK_KEYWORDS[index], benchmark->Words[i], benchmark->Lengths[i]) == 0;
+        }
+    }
+    gPerfectHashBenchmarkSink = found;
+}
+
+static void FindPerfectHash(void* data)
+{
+    PerfectHashBenchmark* benchmark = (PerfectHashBenchmark*)data;
+
+    I32 found = 0;
+    for (I32 i = 0; i < PERFECT_HASH_BENCHMARK_WORDS; i++)
+    {
+        found += PerfectHashFind(PERFECT_HASH_BENCHMARK_TABLE, StringView(benchmark->Words[i], benchmark->Lengths[i])) >= 0;
+    }
+    gPerfectHashBenchmarkSink = found;
+}
+
+DEFINE_BENCHMARK("PerfectHashTable")
+{
+    PerfectHashBenchmark benchmark;
+    benchmark.Words = (char(*)[16])MemoryAlloc(PERFECT_HASH_BENCHMARK_WORDS * 16);
+    benchmark.Lengths = (I32*)MemoryAlloc(PERFECT_HASH_BENCHMARK_WORDS * sizeof(I32));
+
+    U32 random = 0x12345678;
+    for (I32 i = 0; i < PERFECT_HASH_BENCHMARK_WORDS; i++)
+    {
+        random = random * 1664525 + 1013904223;
+        if (random & (1 << 20))
+        {
+            const char* keyword = PERFECT_HASH_BENCHMARK_KEYWORDS[(random >> 24) % PERFECT_HASH_BENCHMARK_KEYWORD_COUNT];
+            benchmark.Lengths[i] = (I32)strlen(keyword);
+            memcpy(benchmark.Words[i], keyword, benchmark.Lengths[i] + 1);
+        }
+        else
+        {
+            benchmark.Lengths[i] = snprintf(benchmark.Words[i], 16, "name%u", (random >> 22) % 1000);
+        }
+    }
+
+    benchmark.Table = MakeHashTable<I32>(PERFECT_HASH_BENCHMARK_KEYWORD_COUNT);
+    for (I32 i = 0; i < PERFECT_HASH_BENCHMARK_KEYWORD_COUNT; i++)
+    {
+        const char* keyword = PERFECT_HASH_BENCHMARK_KEYWORDS[i];
+        HashTableSetValue(&benchmark.Table, CalcHash64(keyword, (I32)strlen(keyword)), i);
+    }
+
+    MeasureBenchmark("Keywords linear search (1M words)", PERFECT_HASH_BENCHMARK_WORDS, FindLinear, &benchmark);
+    MeasureBenchmark("Keywords HashTable (1M words)", PERFECT_HASH_BENCHMARK_WORDS, FindHashTable, &benchmark);
+    MeasureBenchmark("Keywords PerfectHashFind (1M words)", PERFECT_HASH_BENCHMARK_WORDS, FindPerfectHash, &benchmark);
+
+    FreeHashTable(&benchmark.Table);
+    MemoryFree(benchmark.Lengths);
+    MemoryFree(benchmark.Words);
+}
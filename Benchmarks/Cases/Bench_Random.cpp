@@ -0,0 +1,58 @@
+#include <Misc/Benchmark.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <System/Memory.h>
+#include <System/Random.h>
+
+// Particles of an explosion burst: speed, angle and color of each
+constexpr I32 RANDOM_FLOAT_COUNT = 1024 * 1024;
+
+struct RandomBenchmark
+{
+    float*      Floats;
+    Random      State;
+};
+
+static volatile float gRandomBenchmarkSink;
+
+static void FillRand(void* data)
+{
+    RandomBenchmark* benchmark = (RandomBenchmark*)data;
+    for (I32 i = 0; i < RANDOM_FLOAT_COUNT; i++)
+    {
+        benchmark->Floats[i] = rand() % 101 / 100.0f;
+    }
+    gRandomBenchmarkSink = benchmark->Floats[RANDOM_FLOAT_COUNT - 1];
+}
+
+static void FillNextF32(void* data)
+{
+    RandomBenchmark* benchmark = (RandomBenchmark*)data;
+    for (I32 i = 0; i < RANDOM_FLOAT_COUNT; i++)
+    {
+        benchmark->Floats[i] = RandomNextF32(&benchmark->State);
+    }
+    gRandomBenchmarkSink = benchmark->Floats[RANDOM_FLOAT_COUNT - 1];
+}
+
+static void FillBulk(void* data)
+{
+    RandomBenchmark* benchmark = (RandomBenchmark*)data;
+    RandomFillF32(&benchmark->State, benchmark->Floats, RANDOM_FLOAT_COUNT);
+    gRandomBenchmarkSink = benchmark->Floats[RANDOM_FLOAT_COUNT - 1];
+}
+
+DEFINE_BENCHMARK("Random")
+{
+    RandomBenchmark benchmark;
+    benchmark.Floats = (float*)MemoryAlloc(RANDOM_FLOAT_COUNT * sizeof(float));
+    benchmark.State = MakeRandom(1);
+
+    MeasureBenchmark("rand() % 101 / 100.0f (1M floats)", RANDOM_FLOAT_COUNT, FillRand, &benchmark);
+    MeasureBenchmark("RandomNextF32 (1M floats)", RANDOM_FLOAT_COUNT, FillNextF32, &benchmark);
+    MeasureBenchmark("RandomFillF32 (1M floats)", RANDOM_FLOAT_COUNT, FillBulk, &benchmark);
+
+    MemoryFree(benchmark.Floats);
+}
@@ -0,0 +1,302 @@
+#include <Misc/Benchmark.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Text/String.h>
+#include <System/Memory.h>
+
+// Identifiers as found in scenes and assets: short, sharing long prefixes
+constexpr I32 STRING_IDENTIFIER_COUNT = 1024;
+
+// Text as found in localization files, the searched words only appear at the very end or not at all
+constexpr I32 STRING_TEXT_SIZE = 4 * 1024 * 1024;
+
+struct StringIdentifiers
+{
+    char        Buffer[STRING_IDENTIFIER_COUNT][32];
+    I32         Lengths[STRING_IDENTIFIER_COUNT];
+};
+
+static StringIdentifiers* MakeStringIdentifiers(void)
+{
+    static const char* prefixes[] = { "player_", "enemy_spawn_", "ui_button_", "sfx_footstep_" };
+
+    StringIdentifiers* identifiers = (StringIdentifiers*)MemoryAlloc(sizeof(StringIdentifiers));
+    for (I32 i = 0; i < STRING_IDENTIFIER_COUNT; i++)
+    {
+        identifiers->Lengths[i] = snprintf(identifiers->Buffer[i], sizeof(identifiers->Buffer[i]), "%s%05d", prefixes[i % 4], i * 7919 % 100000);
+    }
+
+    return identifiers;
+}
+
+static void EqualsIdentifiers(void* data)
+{
+    StringIdentifiers* identifiers = (StringIdentifiers*)data;
+
+    I32 count = 0;
+    for (I32 i = 0; i < STRING_IDENTIFIER_COUNT; i++)
+    {
+        // Same prefix and same length: only the last digits differ
+        const I32 j = (i + 4) % STRING_IDENTIFIER_COUNT;
+        count += StringEquals(StringView(identifiers->Buffer[i], identifiers->Lengths[i]), StringView(identifiers->Buffer[j], identifiers->Lengths[j]));
+    }
+    DoNotOptimize(count);
+}
+
+static void CompareIdentifiers(void* data)
+{
+    StringIdentifiers* identifiers = (StringIdentifiers*)data;
+
+    I32 sum = 0;
+    for (I32 i = 0; i < STRING_IDENTIFIER_COUNT; i++)
+    {
+        const I32 j = (i + 4) % STRING_IDENTIFIER_COUNT;
+        sum += StringCompare(StringView(identifiers->Buffer[i], identifiers->Lengths[i]), StringView(identifiers->Buffer[j], identifiers->Lengths[j])) < 0;
+    }
+    DoNotOptimize(sum);
+}
+
+static void FindInIdentifiers(void* data)
+{
+    StringIdentifiers* identifiers = (StringIdentifiers*)data;
+
+    I32 sum = 0;
+    for (I32 i = 0; i < STRING_IDENTIFIER_COUNT; i++)
+    {
+        sum += StringLastIndexOf(StringView(identifiers->Buffer[i], identifiers->Lengths[i]), '_');
+        sum += StringIndexOf(StringView(identifiers->Buffer[i], identifiers->Lengths[i]), "spawn");
+    }
+    DoNotOptimize(sum);
+}
+
+static void InternIdentifiers(void* data)
+{
+    StringIdentifiers* identifiers = (StringIdentifiers*)data;
+
+    I32 sum = 0;
+    for (I32 i = 0; i < STRING_IDENTIFIER_COUNT; i++)
+    {
+        sum += InternString(StringView(identifiers->Buffer[i], identifiers->Lengths[i])).Length;
+    }
+    DoNotOptimize(sum);
+}
+
+static void MakeSymbolIdentifiers(void* data)
+{
+    StringIdentifiers* identifiers = (StringIdentifiers*)data;
+
+    U64 sum = 0;
+    for (I32 i = 0; i < STRING_IDENTIFIER_COUNT; i++)
+    {
+        sum += MakeSymbol(StringView(identifiers->Buffer[i], identifiers->Lengths[i])).Hash;
+    }
+    DoNotOptimize(sum);
+}
+
+static void EqualsInternedIdentifiers(void* data)
+{
+    String* interned = (String*)data;
+
+    I32 count = 0;
+    for (I32 i = 0; i < STRING_IDENTIFIER_COUNT; i++)
+    {
+        const I32 j = (i + 4) % STRING_IDENTIFIER_COUNT;
+        count += interned[i].Buffer == interned[j].Buffer;
+    }
+    DoNotOptimize(count);
+}
+
+struct StringText
+{
+    char*       Buffer;
+    I32         Length;
+};
+
+static StringText MakeStringText(void)
+{
+    static const char sentence[] = "The old lighthouse keeper said nobody has climbed those stairs since the storm. ";
+
+    StringText text = { (char*)MemoryAlloc(STRING_TEXT_SIZE + 1), 0 };
+    while (text.Length + (I32)sizeof(sentence) < STRING_TEXT_SIZE)
+    {
+        memcpy(text.Buffer + text.Length, sentence, sizeof(sentence) - 1);
+        text.Length += sizeof(sentence) - 1;
+    }
+
+    const char ending[] = "Quietly, the keeper smiled.";
+    memcpy(text.Buffer + text.Length, ending, sizeof(ending));
+    text.Length += sizeof(ending) - 1;
+
+    return text;
+}
+
+static void IndexOfCharText(void* data)
+{
+    StringText* text = (StringText*)data;
+    DoNotOptimize(StringIndexOf(StringView(text->Buffer, text->Length), 'Q'));
+}
+
+// The C library functions are known to the compiler, their result must be used to be computed
+static const void* volatile gStringBenchmarkSink;
+
+static void MemchrText(void* data)
+{
+    StringText* text = (StringText*)data;
+    gStringBenchmarkSink = memchr(text->Buffer, 'Q', text->Length);
+}
+
+static void LastIndexOfCharText(void* data)
+{
+    StringText* text = (StringText*)data;
+    DoNotOptimize(StringLastIndexOf(StringView(text->Buffer, text->Length), '#'));
+}
+
+static void IndexOfText(void* data)
+{
+    StringText* text = (StringText*)data;
+    DoNotOptimize(StringIndexOf(StringView(text->Buffer, text->Length), "keeper smiled"));
+}
+
+static void StrstrText(void* data)
+{
+    StringText* text = (StringText*)data;
+    gStringBenchmarkSink = strstr(text->Buffer, "keeper smiled");
+}
+
+static void LastIndexOfText(void* data)
+{
+    StringText* text = (StringText*)data;
+    DoNotOptimize(StringLastIndexOf(StringView(text->Buffer, text->Length), "keeper frowned"));
+}
+
+static void EqualsText(void* data)
+{
+    StringText* text = (StringText*)data;
+
+    // Two halves of the text: equal until the ending
+    const I32 half = text->Length / 2;
+    DoNotOptimize(StringEquals(StringView(text->Buffer, half), StringView(text->Buffer + half - half % 80, half)));
+}
+
+DEFINE_BENCHMARK("String identifiers")
+{
+    StringIdentifiers* identifiers = MakeStringIdentifiers();
+
+    MeasureBenchmark("StringEquals identifiers", STRING_IDENTIFIER_COUNT, EqualsIdentifiers, identifiers);
+    MeasureBenchmark("StringCompare identifiers", STRING_IDENTIFIER_COUNT, CompareIdentifiers, identifiers);
+    MeasureBenchmark("StringLastIndexOf char + StringIndexOf identifiers", STRING_IDENTIFIER_COUNT, FindInIdentifiers, identifiers);
+
+    // Once interned, lookups only hash and compare with the stored entry
+    String* interned = (String*)MemoryAlloc(STRING_IDENTIFIER_COUNT * sizeof(String));
+    for (I32 i = 0; i < STRING_IDENTIFIER_COUNT; i++)
+    {
+        interned[i] = InternString(StringView(identifiers->Buffer[i], identifiers->Lengths[i]));
+    }
+
+    MeasureBenchmark("InternString identifiers (already interned)", STRING_IDENTIFIER_COUNT, InternIdentifiers, identifiers);
+    MeasureBenchmark("MakeSymbol identifiers", STRING_IDENTIFIER_COUNT, MakeSymbolIdentifiers, identifiers);
+    MeasureBenchmark("Interned identifiers pointer equality", STRING_IDENTIFIER_COUNT, EqualsInternedIdentifiers, interned);
+
+    MemoryFree(interned);
+    MemoryFree(identifiers);
+}
+
+DEFINE_BENCHMARK("String text")
+{
+    StringText text = MakeStringText();
+
+    const struct
+    {
+        const char* Name;
+        void        (*Func)(void* data);
+    } cases[] = {
+        { "StringIndexOf char (4 MB), per byte",         IndexOfCharText },
+        { "memchr (4 MB), per byte",                     MemchrText },
+        { "StringLastIndexOf char (4 MB), per byte",     LastIndexOfCharText },
+        { "StringIndexOf substring (4 MB), per byte",    IndexOfText },
+        { "strstr (4 MB), per byte",                     StrstrText },
+        { "StringLastIndexOf substring (4 MB), per byte", LastIndexOfText },
+        { "StringEquals (2 MB), per byte",               EqualsText },
+    };
+
+    for (const auto& benchmark : cases)
+    {
+        const double seconds = MeasureBenchmark(benchmark.Name, text.Length, benchmark.Func, &text);
+        printf("    %-48s %10.3f GB/s\n", "", text.Length / seconds / 1e9);
+    }
+
+    MemoryFree(text.Buffer);
+}
+
+// Overlay lines as drawn every frame: a few numbers between labels
+constexpr I32 STRING_OVERLAY_LINES = 1024;
+
+static void FormatOverlayPrintf(void* data)
+{
+    (void)data;
+
+    I32 length = 0;
+    for (I32 i = 0; i < STRING_OVERLAY_LINES; i++)
+    {
+        char buffer[128];
+        String text = StringFormat(buffer, sizeof(buffer), "FPS: %.2f frame %d entities %d", 60.0 - i * 0.013, i, i * 37);
+        length += text.Length;
+    }
+    DoNotOptimize(length);
+}
+
+static void FormatOverlayBuilder(void* data)
+{
+    (void)data;
+
+    I32 length = 0;
+    for (I32 i = 0; i < STRING_OVERLAY_LINES; i++)
+    {
+        StringBuilder builder = {};
+        StringBuilderAppend(&builder, "FPS: ");
+        StringBuilderAppendFixed(&builder, 60.0 - i * 0.013, 2);
+        StringBuilderAppend(&builder, " frame ");
+        StringBuilderAppendInteger(&builder, i);
+        StringBuilderAppend(&builder, " entities ");
+        StringBuilderAppendInteger(&builder, i * 37);
+        length += StringBuilderToString(&builder).Length;
+        FreeStringBuilder(&builder);
+    }
+    DoNotOptimize(length);
+}
+
+static void FormatDoublesPrintf(void* data)
+{
+    (void)data;
+
+    I32 length = 0;
+    for (I32 i = 0; i < STRING_OVERLAY_LINES; i++)
+    {
+        char buffer[32];
+        length += snprintf(buffer, sizeof(buffer), "%.17g", i * 1.0137);
+    }
+    DoNotOptimize(length);
+}
+
+static void FormatDoublesBuilder(void* data)
+{
+    (void)data;
+
+    I32 length = 0;
+    for (I32 i = 0; i < STRING_OVERLAY_LINES; i++)
+    {
+        char buffer[FORMAT_NUMBER_SIZE];
+        length += FormatDouble(buffer, i * 1.0137);
+    }
+    DoNotOptimize(length);
+}
+
+DEFINE_BENCHMARK("String builder")
+{
+    MeasureBenchmark("StringFormat overlay line", STRING_OVERLAY_LINES, FormatOverlayPrintf, nullptr);
+    MeasureBenchmark("StringBuilder overlay line", STRING_OVERLAY_LINES, FormatOverlayBuilder, nullptr);
+    MeasureBenchmark("snprintf %.17g double", STRING_OVERLAY_LINES, FormatDoublesPrintf, nullptr);
+    MeasureBenchmark("FormatDouble (shortest round-trip)", STRING_OVERLAY_LINES, FormatDoublesBuilder, nullptr);
+}
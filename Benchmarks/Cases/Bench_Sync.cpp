@@ -0,0 +1,141 @@
+#include <Misc/Benchmark.h>
+
+#include <stdio.h>
+#include <mutex>
+#include <thread>
+
+#include <Concurrency/Sync.h>
+
+#if defined(_WIN32)
+#   define WIN32_LEAN_AND_MEAN
+#   include <Windows.h>
+#else
+#   include <pthread.h>
+#endif
+
+constexpr I32 SYNC_OPS_PER_RUN = 1 << 16;
+
+struct SyncBenchmark
+{
+    I32     ThreadCount;
+    void    (*Acquire)(void* lock);
+    void    (*Release)(void* lock);
+    void*   Lock;
+
+    alignas(CACHE_LINE_SIZE) U64 Counter;
+};
+
+static void SyncBenchmarkThread(SyncBenchmark* benchmark)
+{
+    I32 iterations = SYNC_OPS_PER_RUN / benchmark->ThreadCount;
+    for (I32 i = 0; i < iterations; i++)
+    {
+        benchmark->Acquire(benchmark->Lock);
+        benchmark->Counter++;
+        benchmark->Release(benchmark->Lock);
+    }
+}
+
+static void RunSyncBenchmark(void* data)
+{
+    SyncBenchmark* benchmark = (SyncBenchmark*)data;
+
+    // Uncontended run on the calling thread, no thread creation cost
+    if (benchmark->ThreadCount == 1)
+    {
+        SyncBenchmarkThread(benchmark);
+        return;
+    }
+
+    std::thread threads[32];
+    for (I32 i = 0; i < benchmark->ThreadCount; i++)
+    {
+        threads[i] = std::thread(SyncBenchmarkThread, benchmark);
+    }
+
+    for (I32 i = 0; i < benchmark->ThreadCount; i++)
+    {
+        threads[i].join();
+    }
+}
+
+static void MeasureLock(const char* lockName, void* lock, void (*acquire)(void*), void (*release)(void*))
+{
+    const I32 threadCounts[] = { 1, 2, 8, 32 };
+    for (I32 threadCount : threadCounts)
+    {
+        static SyncBenchmark benchmark;
+        benchmark.ThreadCount = threadCount;
+        benchmark.Acquire = acquire;
+        benchmark.Release = release;
+        benchmark.Lock = lock;
+        benchmark.Counter = 0;
+
+        char name[64];
+        snprintf(name, sizeof(name), "%s, %d threads", lockName, threadCount);
+        MeasureBenchmark(name, SYNC_OPS_PER_RUN, RunSyncBenchmark, &benchmark);
+    }
+}
+
+DEFINE_BENCHMARK("Sync lock contention")
+{
+    static SpinLock spinLock;
+    MeasureLock("SpinLock", &spinLock,
+        [](void* lock) { SpinLockAcquire((SpinLock*)lock); },
+        [](void* lock) { SpinLockRelease((SpinLock*)lock); });
+
+    static TicketLock ticketLock;
+    MeasureLock("TicketLock", &ticketLock,
+        [](void* lock) { TicketLockAcquire((TicketLock*)lock); },
+        [](void* lock) { TicketLockRelease((TicketLock*)lock); });
+
+    static Mutex mutex;
+    MeasureLock("Mutex", &mutex,
+        [](void* lock) { MutexLock((Mutex*)lock); },
+        [](void* lock) { MutexUnlock((Mutex*)lock); });
+
+    static RWLock rwLock;
+    MeasureLock("RWLock (write)", &rwLock,
+        [](void* lock) { RWLockWriteLock((RWLock*)lock); },
+        [](void* lock) { RWLockWriteUnlock((RWLock*)lock); });
+
+    MeasureLock("RWLock (read)", &rwLock,
+        [](void* lock) { RWLockReadLock((RWLock*)lock); },
+        [](void* lock) { RWLockReadUnlock((RWLock*)lock); });
+
+    static std::mutex stdMutex;
+    MeasureLock("std::mutex", &stdMutex,
+        [](void* lock) { ((std::mutex*)lock)->lock(); },
+        [](void* lock) { ((std::mutex*)lock)->unlock(); });
+
+#if defined(_WIN32)
+    static SRWLOCK srwLock = SRWLOCK_INIT;
+    MeasureLock("SRWLOCK (exclusive)", &srwLock,
+        [](void* lock) { AcquireSRWLockExclusive((SRWLOCK*)lock); },
+        [](void* lock) { ReleaseSRWLockExclusive((SRWLOCK*)lock); });
+
+    static CRITICAL_SECTION criticalSection;
+    InitializeCriticalSection(&criticalSection);
+    MeasureLock("CRITICAL_SECTION", &criticalSection,
+        [](void* lock) { EnterCriticalSection((CRITICAL_SECTION*)lock); },
+        [](void* lock) { LeaveCriticalSection((CRITICAL_SECTION*)lock); });
+    DeleteCriticalSection(&criticalSection);
+#else
+    static pthread_mutex_t pthreadMutex = PTHREAD_MUTEX_INITIALIZER;
+    MeasureLock("pthread_mutex_t", &pthreadMutex,
+        [](void* lock) { pthread_mutex_lock((pthread_mutex_t*)lock); },
+        [](void* lock) { pthread_mutex_unlock((pthread_mutex_t*)lock); });
+
+    static pthread_spinlock_t pthreadSpinLock;
+    pthread_spin_init(&pthreadSpinLock, PTHREAD_PROCESS_PRIVATE);
+    MeasureLock("pthread_spinlock_t", (void*)&pthreadSpinLock,
+        [](void* lock) { pthread_spin_lock((pthread_spinlock_t*)lock); },
+        [](void* lock) { pthread_spin_unlock((pthread_spinlock_t*)lock); });
+    pthread_spin_destroy(&pthreadSpinLock);
+
+    static pthread_rwlock_t pthreadRWLock = PTHREAD_RWLOCK_INITIALIZER;
+    MeasureLock("pthread_rwlock_t (write)", &pthreadRWLock,
+        [](void* lock) { pthread_rwlock_wrlock((pthread_rwlock_t*)lock); },
+        [](void* lock) { pthread_rwlock_unlock((pthread_rwlock_t*)lock); });
+#endif
+}
@@ -0,0 +1,98 @@
+#include <Misc/Benchmark.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Text/TextBuffer.h>
+#include <System/Memory.h>
+
+// A log as opened in the tools: 8 MB, lines of ~70 chars
+constexpr I32 TEXT_BUFFER_LOG_SIZE  = 8 * 1024 * 1024;
+constexpr I32 TEXT_BUFFER_EDITS     = 1024;
+
+struct TextBufferBenchmark
+{
+    char*       Log;
+    I32         LogLength;
+
+    TextBuffer  Buffer;
+
+    char*       Flat;           // Baseline: one contiguous buffer edited with memmove
+    I32         FlatLength;
+
+    U32         Random;
+};
+
+static I32 NextEditPosition(TextBufferBenchmark* benchmark, I32 length)
+{
+    benchmark->Random = benchmark->Random * 1664525U + 1013904223U;
+    return (I32)(benchmark->Random % (U32)(length + 1));
+}
+
+// Type a char then delete it, at random positions: the size does not change between runs
+static void EditTextBuffer(void* data)
+{
+    TextBufferBenchmark* benchmark = (TextBufferBenchmark*)data;
+    for (I32 i = 0; i < TEXT_BUFFER_EDITS; i++)
+    {
+        const I32 position = NextEditPosition(benchmark, TextBufferLength(&benchmark->Buffer));
+        TextBufferInsert(&benchmark->Buffer, position, StringView("x", 1));
+        TextBufferDelete(&benchmark->Buffer, position, 1);
+    }
+}
+
+static void EditFlat(void* data)
+{
+    TextBufferBenchmark* benchmark = (TextBufferBenchmark*)data;
+    for (I32 i = 0; i < TEXT_BUFFER_EDITS; i++)
+    {
+        const I32 position = NextEditPosition(benchmark, benchmark->FlatLength);
+        char* p = benchmark->Flat + position;
+
+        memmove(p + 1, p, benchmark->FlatLength - position);
+        *p = 'x';
+        memmove(p, p + 1, benchmark->FlatLength - position);
+    }
+}
+
+static void LineLookups(void* data)
+{
+    TextBufferBenchmark* benchmark = (TextBufferBenchmark*)data;
+    const I32 lineCount = TextBufferLineCount(&benchmark->Buffer);
+
+    I32 sum = 0;
+    for (I32 i = 0; i < TEXT_BUFFER_EDITS; i++)
+    {
+        const I32 line = NextEditPosition(benchmark, lineCount - 1);
+        sum += TextBufferLineStart(&benchmark->Buffer, line);
+        sum += TextBufferLineOf(&benchmark->Buffer, sum & 0xffff);
+    }
+    DoNotOptimize(sum);
+}
+
+DEFINE_BENCHMARK("TextBuffer")
+{
+    TextBufferBenchmark benchmark = {};
+    benchmark.Log = (char*)MemoryAlloc(TEXT_BUFFER_LOG_SIZE + 128);
+    while (benchmark.LogLength < TEXT_BUFFER_LOG_SIZE)
+    {
+        benchmark.LogLength += snprintf(benchmark.Log + benchmark.LogLength, 128,
+            "[%08d] Loaded asset 'Textures/Tile_%05d.png' in %d.%03d ms\n", benchmark.LogLength, benchmark.LogLength % 99991, benchmark.LogLength % 7, benchmark.LogLength % 1000);
+    }
+
+    benchmark.Buffer = MakeTextBuffer(StringView(benchmark.Log, benchmark.LogLength));
+
+    benchmark.Flat = (char*)MemoryAlloc(benchmark.LogLength + 1);
+    memcpy(benchmark.Flat, benchmark.Log, benchmark.LogLength);
+    benchmark.FlatLength = benchmark.LogLength;
+
+    // Edits accumulate pieces over the runs, the tree keeps them O(log n) deep
+    MeasureBenchmark("TextBuffer insert + delete char (8 MB log)", TEXT_BUFFER_EDITS * 2, EditTextBuffer, &benchmark);
+    MeasureBenchmark("memmove insert + delete char (8 MB log)", TEXT_BUFFER_EDITS * 2, EditFlat, &benchmark);
+    MeasureBenchmark("TextBuffer line start + line of position", TEXT_BUFFER_EDITS * 2, LineLookups, &benchmark);
+    printf("    %-48s %10d pieces\n", "", benchmark.Buffer.Pieces.Count);
+
+    FreeTextBuffer(&benchmark.Buffer);
+    MemoryFree(benchmark.Flat);
+    MemoryFree(benchmark.Log);
+}
@@ -0,0 +1,113 @@
+#include <Misc/Benchmark.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Text/Utf8.h>
+#include <System/Memory.h>
+
+constexpr I32 UTF8_TEXT_SIZE = 4 * 1024 * 1024;
+
+struct Utf8Benchmark
+{
+    char*       Text;
+    I32         Length;
+
+    U32*        Codepoints;
+    U16*        Wide;
+};
+
+static volatile I32 gUtf8BenchmarkSink;
+
+static void ValidateText(void* data)
+{
+    Utf8Benchmark* benchmark = (Utf8Benchmark*)data;
+    gUtf8BenchmarkSink = Utf8IsValid(StringView(benchmark->Text, benchmark->Length));
+}
+
+// Baseline: check the text one sequence at a time
+static void DecodeValidateText(void* data)
+{
+    Utf8Benchmark* benchmark = (Utf8Benchmark*)data;
+
+    I32 invalid = 0;
+    for (I32 i = 0, sequenceLength = 0; i < benchmark->Length; i += sequenceLength)
+    {
+        invalid += Utf8Decode(benchmark->Text + i, benchmark->Length - i, &sequenceLength) == UTF8_REPLACEMENT_CHAR;
+    }
+    gUtf8BenchmarkSink = invalid;
+}
+
+static void CountCodepoints(void* data)
+{
+    Utf8Benchmark* benchmark = (Utf8Benchmark*)data;
+    gUtf8BenchmarkSink = Utf8Length(StringView(benchmark->Text, benchmark->Length));
+}
+
+static void DecodeCodepoints(void* data)
+{
+    Utf8Benchmark* benchmark = (Utf8Benchmark*)data;
+    gUtf8BenchmarkSink = Utf8ToCodepoints(StringView(benchmark->Text, benchmark->Length), benchmark->Codepoints, benchmark->Length);
+}
+
+static void ConvertUtf16(void* data)
+{
+    Utf8Benchmark* benchmark = (Utf8Benchmark*)data;
+    gUtf8BenchmarkSink = Utf8ToUtf16(StringView(benchmark->Text, benchmark->Length), benchmark->Wide, benchmark->Length);
+}
+
+// Fill the text with the pieces, picked at random
+static void MakeUtf8Text(Utf8Benchmark* benchmark, const char* const* pieces, I32 pieceCount)
+{
+    U32 random = 12345;
+    benchmark->Length = 0;
+    while (benchmark->Length < UTF8_TEXT_SIZE - 64)
+    {
+        random = random * 1664525U + 1013904223U;
+        const char* piece = pieces[(random >> 16) % (U32)pieceCount];
+        const I32 length = (I32)strlen(piece);
+        memcpy(benchmark->Text + benchmark->Length, piece, length);
+        benchmark->Length += length;
+    }
+}
+
+static void MeasureUtf8Text(Utf8Benchmark* benchmark, const char* textName)
+{
+    struct { const char* Name; void (*Func)(void*); } cases[] = {
+        { "Utf8IsValid", ValidateText },
+        { "Utf8Decode loop (baseline)", DecodeValidateText },
+        { "Utf8Length", CountCodepoints },
+        { "Utf8ToCodepoints", DecodeCodepoints },
+        { "Utf8ToUtf16", ConvertUtf16 },
+    };
+
+    for (const auto& c : cases)
+    {
+        char name[64];
+        snprintf(name, sizeof(name), "%s (%s)", c.Name, textName);
+        const double seconds = MeasureBenchmark(name, 1, c.Func, benchmark);
+        printf("    %-48s %10.3f GB/s\n", "", benchmark->Length / seconds / 1e9);
+    }
+}
+
+DEFINE_BENCHMARK("UTF-8")
+{
+    Utf8Benchmark benchmark;
+    benchmark.Text = (char*)MemoryAlloc(UTF8_TEXT_SIZE);
+    benchmark.Codepoints = (U32*)MemoryAlloc(sizeof(U32) * UTF8_TEXT_SIZE);
+    benchmark.Wide = (U16*)MemoryAlloc(sizeof(U16) * UTF8_TEXT_SIZE);
+
+    // Scripts and data files are mostly ASCII
+    const char* ascii[] = { "\"name\": ", "\"Textures/Tile.png\", ", "{ \"frame\": 12 }\n", "    ", "return value;\n" };
+    MakeUtf8Text(&benchmark, ascii, 5);
+    MeasureUtf8Text(&benchmark, "ASCII");
+
+    // Localized strings tables: accented latin, cyrillic, CJK, emoji
+    const char* mixed[] = { "caf\xC3\xA9 ", "\xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 ", "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E", "\xF0\x9F\x98\x80", "Start Game\n" };
+    MakeUtf8Text(&benchmark, mixed, 5);
+    MeasureUtf8Text(&benchmark, "mixed");
+
+    MemoryFree(benchmark.Wide);
+    MemoryFree(benchmark.Codepoints);
+    MemoryFree(benchmark.Text);
+}
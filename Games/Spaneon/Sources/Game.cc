@@ -12,7 +12,7 @@ namespace Game
         FileOps::AddSearchPath("../Games/Spaneon/Assets");
 #endif
 
-        world = WorldOps::New();
+        world = WorldOps::New(RandomNextU64());
     }
 
     void Quit(void)
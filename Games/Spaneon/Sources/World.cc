@@ -129,9 +129,10 @@ namespace EntityOps
 
 namespace WorldOps
 {
-    World New(void)
+    World New(U64 seed)
     {
         World world = {};
+        world.random                = MakeRandom(seed);
 
         world.player.active         = true;
         world.player.color          = Vector4{ 1.0f, 1.0f, 1.0f, 1.0f };
@@ -209,7 +210,7 @@ namespace WorldOps
 
     void FireBullets(World* world, Vector2 aim_dir)
     {
-        float angle = atan2f(aim_dir.y, aim_dir.x) + (rand() % 101) / 100.0f * (PI * 0.025f);
+        float angle = atan2f(aim_dir.y, aim_dir.x) + RandomNextF32(&world->random) * (PI * 0.025f);
         float offset = PI * 0.1f;
 
         aim_dir = Vector2{ cosf(angle), sinf(angle) };
@@ -229,17 +230,17 @@ namespace WorldOps
         }
     }
 
-    Vector2 GetSpawnPosition(World world)
+    Vector2 GetSpawnPosition(World* world)
     {
         const float min_distance_sqr = (WindowHeight() * 0.3f) * (WindowHeight() * 0.3f);
 
         Vector2 pos;
         do
         {
-            float x = (2.0f * (rand() % 101) / 100.0f - 1.0f) * 0.8f * WindowWidth();
-            float y = (2.0f * (rand() % 101) / 100.0f - 1.0f) * 0.8f * WindowHeight();
+            float x = RandomRangeF32(&world->random, -1.0f, 1.0f) * 0.8f * WindowWidth();
+            float y = RandomRangeF32(&world->random, -1.0f, 1.0f) * 0.8f * WindowHeight();
             pos = Vector2{ x, y };
-        } while (distsqr(pos, world.player.position) < min_distance_sqr);
+        } while (distsqr(pos, world->player.position) < min_distance_sqr);
 
         return pos;
     }
@@ -248,7 +249,7 @@ namespace WorldOps
     {
         //GameAudio::PlaySpawn();
 
-        Vector2 pos = GetSpawnPosition(*world);
+        Vector2 pos = GetSpawnPosition(world);
         Vector2 vel = normalize(world->player.position - pos);
 
         Texture texture = TextureOps::Load("Art/Seeker.png");
@@ -283,7 +284,7 @@ namespace WorldOps
     {
         //GameAudio::PlaySpawn();
 
-        Vector2 pos = GetSpawnPosition(*world);
+        Vector2 pos = GetSpawnPosition(world);
         Vector2 vel = normalize(world->player.position - pos);
 
         Texture texture = TextureOps::Load("Art/Wanderer.png");
@@ -318,7 +319,7 @@ namespace WorldOps
     {
         //GameAudio::PlaySpawn();
 
-        Vector2 pos = GetSpawnPosition(*world);
+        Vector2 pos = GetSpawnPosition(world);
         Vector2 vel = Vector2{ 0.0f, 0.0f };
 
         Texture texture = TextureOps::Load("Art/Black Hole.png");
@@ -361,8 +362,8 @@ namespace WorldOps
 
             for (int i = 0; i < PARTICLE_COUNT; i++)
             {
-                float speed = 640.0f * (0.2f + (rand() % 101 / 100.0f) * 0.8f);
-                float angle = rand() % 101 / 100.0f * 2 * PI;
+                float speed = 640.0f * (0.2f + RandomNextF32(&world->random) * 0.8f);
+                float angle = RandomNextF32(&world->random) * 2 * PI;
                 Vector2  vel   = Vector2{ cosf(angle) * speed, sinf(angle) * speed };
                 Vector4  color = Vector4{ 0.6f, 1.0f, 1.0f, 1.0f };
 
@@ -380,17 +381,17 @@ namespace WorldOps
 
         Texture texture = TextureOps::Load("Art/Laser.png");
 
-        float hue1 = rand() % 101 / 100.0f * 6.0f;
-        float hue2 = fmodf(hue1 + (rand() % 101 / 100.0f * 2.0f), 6.0f);
+        float hue1 = RandomNextF32(&world->random) * 6.0f;
+        float hue2 = fmodf(hue1 + (RandomNextF32(&world->random) * 2.0f), 6.0f);
         Vector4  color1 = Color::HSV(hue1, 0.5f, 1);
         Vector4  color2 = Color::HSV(hue2, 0.5f, 1);
 
         for (int i = 0; i < 120; i++)
         {
-            float speed = 640.0f * (0.2f + (rand() % 101 / 100.0f) * 0.8f);
-            float angle = rand() % 101 / 100.0f * 2 * PI;
+            float speed = 640.0f * (0.2f + RandomNextF32(&world->random) * 0.8f);
+            float angle = RandomNextF32(&world->random) * 2 * PI;
             Vector2  vel   = Vector2{ cosf(angle) * speed, sinf(angle) * speed };
-            Vector4  color = color1 + (color2 - color1) * ((rand() % 101) / 100.0f);
+            Vector4  color = color1 + (color2 - color1) * RandomNextF32(&world->random);
 
             //ParticleSystem::SpawnParticle(texture, world->seekers.elements[index].position, color, 1.0f, Vector2{ 1.0f, 1.0f }, 0.0f, vel);
         }
@@ -405,17 +406,17 @@ namespace WorldOps
 
         Texture texture = TextureOps::Load("Art/Laser.png");
 
-        float hue1 = rand() % 101 / 100.0f * 6.0f;
-        float hue2 = fmodf(hue1 + (rand() % 101 / 100.0f * 2.0f), 6.0f);
+        float hue1 = RandomNextF32(&world->random) * 6.0f;
+        float hue2 = fmodf(hue1 + (RandomNextF32(&world->random) * 2.0f), 6.0f);
         Vector4  color1 = Color::HSV(hue1, 0.5f, 1);
         Vector4  color2 = Color::HSV(hue2, 0.5f, 1);
 
         for (int i = 0; i < 120; i++)
         {
-            float speed = 640.0f * (0.2f + (rand() % 101 / 100.0f) * 0.8f);
-            float angle = rand() % 101 / 100.0f * 2 * PI;
+            float speed = 640.0f * (0.2f + RandomNextF32(&world->random) * 0.8f);
+            float angle = RandomNextF32(&world->random) * 2 * PI;
             Vector2  vel   = Vector2{ cosf(angle) * speed, sinf(angle) * speed };
-            Vector4  color = color1 + (color2 - color1) * ((rand() % 101) / 100.0f);
+            Vector4  color = color1 + (color2 - color1) * RandomNextF32(&world->random);
 
             //ParticleSystem::SpawnParticle(texture, world->seekers.elements[index].position, color, 1.0f, Vector2{ 1.0f, 1.0f }, 0.0f, vel);
         }
@@ -430,17 +431,17 @@ namespace WorldOps
 
         Texture texture = TextureOps::Load("Art/Laser.png");
 
-        float hue1 = rand() % 101 / 100.0f * 6.0f;
-        float hue2 = fmodf(hue1 + (rand() % 101 / 100.0f * 2.0f), 6.0f);
+        float hue1 = RandomNextF32(&world->random) * 6.0f;
+        float hue2 = fmodf(hue1 + (RandomNextF32(&world->random) * 2.0f), 6.0f);
         Vector4  color1 = Color::HSV(hue1, 0.5f, 1);
         Vector4  color2 = Color::HSV(hue2, 0.5f, 1);
 
         for (int i = 0; i < 120; i++)
         {
-            float speed = 640.0f * (0.2f + (rand() % 101 / 100.0f) * 0.8f);
-            float angle = rand() % 101 / 100.0f * 2 * PI;
+            float speed = 640.0f * (0.2f + RandomNextF32(&world->random) * 0.8f);
+            float angle = RandomNextF32(&world->random) * 2 * PI;
             Vector2  vel   = Vector2{ cosf(angle) * speed, sinf(angle) * speed };
-            Vector4  color = color1 + (color2 - color1) * ((rand() % 101) / 100.0f);
+            Vector4  color = color1 + (color2 - color1) * RandomNextF32(&world->random);
 
             //ParticleSystem::SpawnParticle(texture, world->seekers.elements[index].position, color, 1.0f, Vector2{ 1.0f, 1.0f }, 0.0f, vel);
         }
@@ -462,18 +463,18 @@ namespace WorldOps
         world->gameOverTimer = 3.0f;
         Texture texture = TextureOps::Load("Art/Laser.png");
 
-        float hue1      = rand() % 101 / 100.0f * 6.0f;
-        float hue2      = fmodf(hue1 + (rand() % 101 / 100.0f * 2.0f), 6.0f);
+        float hue1      = RandomNextF32(&world->random) * 6.0f;
+        float hue2      = fmodf(hue1 + (RandomNextF32(&world->random) * 2.0f), 6.0f);
         Vector4  color1    = Color::HSV(hue1, 0.5f, 1);
         Vector4  color2    = Color::HSV(hue2, 0.5f, 1);
 
         for (int i = 0; i < 1200; i++)
         {
-            float speed = 10.0f * maxf((float)WindowWidth(), (float)WindowHeight()) * (0.6f + (rand() % 101 / 100.0f) * 0.4f);
-            float angle = rand() % 101 / 100.0f * 2 * PI;
+            float speed = 10.0f * maxf((float)WindowWidth(), (float)WindowHeight()) * (0.6f + RandomNextF32(&world->random) * 0.4f);
+            float angle = RandomNextF32(&world->random) * 2 * PI;
             Vector2  vel   = Vector2{cosf(angle) * speed, sinf(angle) * speed };
 
-            Vector4 color  = color1 + (color2 - color1) * ((rand() % 101) / 100.0f);
+            Vector4 color  = color1 + (color2 - color1) * RandomNextF32(&world->random);
             //ParticleSystem::SpawnParticle(texture, player.position, color, gameOverTimer, float2(1.0f), 0.0f, vel);
         }
 
@@ -598,12 +599,12 @@ namespace WorldOps
                     float direction = atan2f(s->velocity.y, s->velocity.x);
                     for (int j = 0; j < INTERPOLATIONS; j++)
                     {
-                        direction += (0.12f * (rand() % 101 / 100.0f) - 0.06f) * PI;
+                        direction += (0.12f * RandomNextF32(&world->random) - 0.06f) * PI;
 
                         if (s->position.x < -WindowWidth() || s->position.x > WindowWidth()
                             || s->position.y < -WindowHeight() || s->position.y > WindowHeight())
                         {
-                            direction = atan2f(-s->position.y, -s->position.x) + (1.0f * (rand() % 101 / 100.0f) - 0.5f) * PI;
+                            direction = atan2f(-s->position.y, -s->position.x) + (1.0f * RandomNextF32(&world->random) - 0.5f) * PI;
                         }
 
                         s->rotation = direction;
@@ -705,12 +706,12 @@ namespace WorldOps
 
                 if (GetTotalFrames() % 3 == 0)
                 {
-                    float speed = 16.0f * s->radius * (0.8f + (rand() % 101 / 100.0f) * 0.2f);
-                    float angle = rand() % 101 / 100.0f * GetTotalTime();
+                    float speed = 16.0f * s->radius * (0.8f + RandomNextF32(&world->random) * 0.2f);
+                    float angle = RandomNextF32(&world->random) * GetTotalTime();
                     Vector2  vel   = Vector2{ cosf(angle) * speed, sinf(angle) * speed };
-                    Vector2  pos   = s->position + 0.4f * Vector2{vel.y, -vel.x } + (4.0f + rand() % 101 / 100.0f * 4.0f);
+                    Vector2  pos   = s->position + 0.4f * Vector2{vel.y, -vel.x } + (4.0f + RandomNextF32(&world->random) * 4.0f);
 
-                    Vector4  color = color1 + (color2 - color1) * ((rand() % 101) / 100.0f);
+                    Vector4  color = color1 + (color2 - color1) * RandomNextF32(&world->random);
                     //ParticleSystem::SpawnParticle(glow_tex, pos, color, 4.0f, float2(0.3f, 0.2f), 0.0f, vel);
                     //ParticleSystem::SpawnParticle(line_tex, pos, color, 4.0f, float2(1.0f, 1.0f), 0.0f, vel);
                 }
@@ -719,18 +720,18 @@ namespace WorldOps
                 {
                     Texture texture = TextureOps::Load("Art/Laser.png");
 
-                    float hue1 = rand() % 101 / 100.0f * 6.0f;
-                    float hue2 = fmodf(hue1 + (rand() % 101 / 100.0f * 2.0f), 6.0f);
+                    float hue1 = RandomNextF32(&world->random) * 6.0f;
+                    float hue2 = fmodf(hue1 + (RandomNextF32(&world->random) * 2.0f), 6.0f);
                     Vector4  color1 = Color::HSV(hue1, 0.5f, 1);
                     Vector4  color2 = Color::HSV(hue2, 0.5f, 1);
 
                     for (int i = 0; i < 120.0f; i++)
                     {
                         float speed = 180.0f;
-                        float angle = rand() % 101 / 100.0f * 2 * PI;
+                        float angle = RandomNextF32(&world->random) * 2 * PI;
                         Vector2  vel   = Vector2{ cosf(angle) * speed, sinf(angle) * speed };
                         Vector2  pos   = s->position + vel;
-                        Vector4  color = color1 + (color2 - color1) * ((rand() % 101) / 100.0f);
+                        Vector4  color = color1 + (color2 - color1) * RandomNextF32(&world->random);
                         //ParticleSystem::SpawnParticle(texture, pos, color, 2.0f, float2(1.0f), 0.0f, float2(0.0f));
                     }
                 }
@@ -813,9 +814,9 @@ namespace WorldOps
         {
             world->spawnTimer -= world->spawnInterval;
 
-            if (rand() % 101 < world->seekerSpawnRate) SpawnSeeker(world);
-            if (rand() % 101 < world->wandererSpawnRate) SpawnWanderer(world);
-            if (rand() % 101 < world->blackHoleSpawnRate) SpawnBlackhole(world);
+            if (RandomRangeI32(&world->random, 0, 101) < world->seekerSpawnRate) SpawnSeeker(world);
+            if (RandomRangeI32(&world->random, 0, 101) < world->wandererSpawnRate) SpawnWanderer(world);
+            if (RandomRangeI32(&world->random, 0, 101) < world->blackHoleSpawnRate) SpawnBlackhole(world);
         }
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Yolo/Types.h>
+#include <System/Random.h>
 
 struct Entity
 {
@@ -46,11 +47,13 @@ struct World
 
     bool            lock;
     float           gameOverTimer;
+
+    Random          random;         // Spawns and particles, seeded by New so a replay only needs the seed
 };
 
 namespace WorldOps
 {
-    World   New(void);
+    World   New(U64 seed);
     void    Free(World* world);
 
     void    Update(World* world, float horizontalInput, float verticalInput, Vector2 aimDir, bool fire, float deltaTime);
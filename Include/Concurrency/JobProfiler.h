@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <System/Core.h>
+
+// ----------------------------------------
+// Build switch
+// ----------------------------------------
+
+/// JOB_PROFILER
+/// Enabled by default in debug builds.
+/// Define JOB_PROFILER=0 (or 1) in your build to override,
+/// when compiled out the profiler cost nothing to the job system.
+#ifndef JOB_PROFILER
+#   ifndef NDEBUG
+#       define JOB_PROFILER 1
+#   else
+#       define JOB_PROFILER 0
+#   endif
+#endif
+
+#if JOB_PROFILER && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   else
+#       include <x86intrin.h>
+#   endif
+#   define JOB_PROFILER_RDTSC 1
+#else
+#   define JOB_PROFILER_RDTSC 0
+#endif
+
+// ----------------------------------------
+// Types
+// ----------------------------------------
+
+constexpr I32 JOB_PROFILER_MAX_WORKERS      = 64;
+constexpr I32 JOB_PROFILER_EVENTS_CAPACITY  = 1024; // Per worker, must be power of two
+
+/// JobProfileEvent
+/// One executed job, timestamps are in profiler ticks
+struct JobProfileEvent
+{
+    const char* Name;
+    U64         Start;
+    U64         End;
+    I32         Worker;
+};
+
+// ----------------------------------------
+// Main functions
+// ----------------------------------------
+
+#if JOB_PROFILER
+void        JobProfilerEnable(bool enable);
+bool        JobProfilerIsEnabled(void);
+
+void        JobProfilerClear(void);
+void        JobProfilerRecord(I32 worker, const char* name, U64 start, U64 end);
+
+// Copy the latest events of all workers, return the number of events copied
+I32         JobProfilerCollect(JobProfileEvent* events, I32 maxEvents);
+double      JobProfilerTicksToMicroseconds(U64 ticks);
+
+// Write all recorded events as Chrome tracing JSON (chrome://tracing, ui.perfetto.dev)
+bool        JobProfilerExport(StringView path);
+
+extern std::atomic<bool> JobProfilerEnabled;
+
+#if !JOB_PROFILER_RDTSC
+U64         JobProfilerTimestampFallback(void);
+#endif
+
+inline U64 JobProfilerTimestamp(void)
+{
+#if JOB_PROFILER_RDTSC
+    return (U64)__rdtsc();
+#else
+    return JobProfilerTimestampFallback();
+#endif
+}
+
+// Return 0 when the profiler is disabled, so JobProfilerEnd can skip recording
+inline U64 JobProfilerBegin(void)
+{
+    return JobProfilerEnabled.load(std::memory_order_relaxed) ? JobProfilerTimestamp() : 0;
+}
+
+inline void JobProfilerEnd(I32 worker, const char* name, U64 start)
+{
+    if (start != 0)
+    {
+        JobProfilerRecord(worker, name, start, JobProfilerTimestamp());
+    }
+}
+#else
+inline void JobProfilerEnable(bool enable) {}
+inline bool JobProfilerIsEnabled(void) { return false; }
+
+inline void JobProfilerClear(void) {}
+inline void JobProfilerRecord(I32 worker, const char* name, U64 start, U64 end) {}
+
+inline I32  JobProfilerCollect(JobProfileEvent* events, I32 maxEvents) { return 0; }
+inline double JobProfilerTicksToMicroseconds(U64 ticks) { return 0.0; }
+
+inline bool JobProfilerExport(StringView path) { return false; }
+
+inline U64  JobProfilerTimestamp(void) { return 0; }
+inline U64  JobProfilerBegin(void) { return 0; }
+inline void JobProfilerEnd(I32 worker, const char* name, U64 start) {}
+#endif
+
+// --------------------------------------
+// Report jobs
+// --------------------------------------
+
+enum ImGuiDumpJobsFlags
+{
+    ImGuiDumpJobsFlags_None,
+    ImGuiDumpJobsFlags_OpenWindow = 1 << 0,
+};
+
+namespace ImGui
+{
+    // Open an debug window to view per-worker job timelines
+    void DumpJobTimeline(ImGuiDumpJobsFlags flags);
+}
@@ -1,8 +1,70 @@
 #pragma once
 
+#include <atomic>
 #include <System/Core.h>
 
-void StartJob(Job job);
-void StartJob(void* data, void (*execute)(void* data));
+// ----------------------------------------
+// Types
+// ----------------------------------------
 
+constexpr I32 JOB_SYSTEM_MAX_WORKERS    = 63; // Plus the main thread
+constexpr I32 JOB_QUEUE_CAPACITY        = 4096; // Per queue, when full the job run on the calling thread
+
+/// JobPriority
+/// Each priority has its own queue. Workers prefer High over Normal over Background,
+/// a lower priority that was passed over too many times is picked next (starvation protection).
+/// Background jobs never occupy all workers: one worker is always kept for frame-critical work.
+enum struct JobPriority
+{
+    High,       // Latency-critical: audio mixing, input
+    Normal,     // Frame work
+    Background, // Streaming, loading, long running tasks
+
+    Count,
+};
+
+// ----------------------------------------
+// Main functions
+// ----------------------------------------
+
+// Start worker threads, workerCount < 0 mean use all hardware threads except the main thread.
+// Without workers (never initialized or workerCount == 0) jobs run on the thread calling UpdateJobs.
+bool InitJobSystem(I32 workerCount = -1);
+
+// Run all remaining jobs then stop worker threads
+void ShutdownJobSystem(void);
+
+I32  GetJobWorkerCount(void);
+
+// Index of the worker running the calling thread, the main thread is 0
+I32  GetJobWorkerIndex(void);
+
+void StartJob(Job job, JobPriority priority = JobPriority::Normal);
+void StartJob(void* data, void (*execute)(void* data), const char* name = nullptr, JobPriority priority = JobPriority::Normal);
+
+// Publish a whole batch at once into the injection queue, workers grab sub-ranges of it.
+// Jobs are not copied: the array must stay alive until the jobs are done (see WaitForJobs).
+void StartJobs(const Job* jobs, I32 count);
+
+// Run pending jobs on the calling thread.
+// With workers the calling thread only help with High and Normal jobs.
 void UpdateJobs(void);
+
+// Help running jobs until all started jobs (of any priority) are done
+void WaitForJobs(void);
+
+// Help running frame jobs until counter reach zero, jobs decrement the counter themselves.
+// Unlike WaitForJobs, this never wait for unrelated background jobs.
+void WaitForJobs(const std::atomic<I32>* counter);
+
+// ----------------------------------------
+// Main thread jobs
+// ----------------------------------------
+
+// Queue a job that must run on the main thread (graphics, window events), safe to call from any thread
+void StartMainThreadJob(Job job);
+void StartMainThreadJob(void* data, void (*execute)(void* data), const char* name = nullptr);
+
+// Run main thread jobs until timeBudget (in seconds) is spent, at least one pending job is run.
+// Called by UpdateWindow each frame. Return the number of jobs executed.
+I32  UpdateMainThreadJobs(float timeBudget);
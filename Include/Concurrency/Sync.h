@@ -0,0 +1,189 @@
+#pragma once
+
+#include <atomic>
+#include <System/Core.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   else
+#       include <immintrin.h>
+#   endif
+#endif
+
+// ----------------------------------------
+// Types
+// ----------------------------------------
+
+constexpr I32 CACHE_LINE_SIZE = 64;
+
+/// SpinLock
+/// Test-and-test-and-set lock with exponential backoff.
+/// Only for very short critical sections, never sleep in the kernel.
+struct alignas(CACHE_LINE_SIZE) SpinLock
+{
+    std::atomic<U32>    Locked;
+};
+
+/// TicketLock
+/// FIFO spin lock, waiters are served in arrival order (fair under contention).
+struct alignas(CACHE_LINE_SIZE) TicketLock
+{
+    std::atomic<U32>    Next;
+    std::atomic<U32>    Serving;
+};
+
+/// Mutex
+/// Adaptive lock: spin for a while, then sleep on a futex (WaitOnAddress on Windows).
+/// State: 0 unlocked, 1 locked, 2 locked with sleeping waiters.
+struct alignas(CACHE_LINE_SIZE) Mutex
+{
+    std::atomic<U32>    State;
+};
+
+/// RWLock
+/// Many readers or one writer, writers are preferred so they are not starved by readers.
+struct alignas(CACHE_LINE_SIZE) RWLock
+{
+    std::atomic<U32>    State;          // Reader count, or RWLOCK_WRITER
+    std::atomic<U32>    WaitingWriters;
+    std::atomic<U32>    Generation;     // Bumped on every release, sleepers wait on it
+    std::atomic<U32>    Sleepers;       // Threads sleeping on Generation
+};
+
+constexpr U32 RWLOCK_WRITER = 0xFFFFFFFFu;
+
+/// Event
+/// One-shot event: once signaled every waiter (current and future) is released, until reset.
+struct alignas(CACHE_LINE_SIZE) Event
+{
+    std::atomic<U32>    Signaled;
+};
+
+/// Semaphore
+/// Counting semaphore, signal only enter the kernel when there are sleeping waiters.
+struct alignas(CACHE_LINE_SIZE) Semaphore
+{
+    std::atomic<U32>    Count;
+    std::atomic<U32>    Waiters;
+};
+
+// All primitives start unlocked (or unsignaled) when zero-initialized:
+// static storage, or `Mutex mutex = {};`
+
+// ----------------------------------------
+// Thread helpers
+// ----------------------------------------
+
+// Hint the cpu we are in a spin-wait loop
+inline void CpuPause(void)
+{
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+void        ThreadYield(void);
+
+// Block while *address == expected (may return spuriously)
+void        FutexWait(std::atomic<U32>* address, U32 expected);
+void        FutexWakeOne(std::atomic<U32>* address);
+void        FutexWakeAll(std::atomic<U32>* address);
+
+// ----------------------------------------
+// SpinLock
+// ----------------------------------------
+
+inline bool SpinLockTryAcquire(SpinLock* lock)
+{
+    return lock->Locked.load(std::memory_order_relaxed) == 0
+        && lock->Locked.exchange(1, std::memory_order_acquire) == 0;
+}
+
+void        SpinLockAcquireSlow(SpinLock* lock);
+
+inline void SpinLockAcquire(SpinLock* lock)
+{
+    if (lock->Locked.exchange(1, std::memory_order_acquire) != 0)
+    {
+        SpinLockAcquireSlow(lock);
+    }
+}
+
+inline void SpinLockRelease(SpinLock* lock)
+{
+    lock->Locked.store(0, std::memory_order_release);
+}
+
+// ----------------------------------------
+// TicketLock
+// ----------------------------------------
+
+void        TicketLockAcquire(TicketLock* lock);
+bool        TicketLockTryAcquire(TicketLock* lock);
+
+inline void TicketLockRelease(TicketLock* lock)
+{
+    lock->Serving.store(lock->Serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+// ----------------------------------------
+// Mutex
+// ----------------------------------------
+
+inline bool MutexTryLock(Mutex* mutex)
+{
+    U32 expected = 0;
+    return mutex->State.compare_exchange_strong(expected, 1, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+void        MutexLockSlow(Mutex* mutex);
+
+inline void MutexLock(Mutex* mutex)
+{
+    if (!MutexTryLock(mutex))
+    {
+        MutexLockSlow(mutex);
+    }
+}
+
+inline void MutexUnlock(Mutex* mutex)
+{
+    if (mutex->State.exchange(0, std::memory_order_release) == 2)
+    {
+        FutexWakeOne(&mutex->State);
+    }
+}
+
+// ----------------------------------------
+// RWLock
+// ----------------------------------------
+
+void        RWLockReadLock(RWLock* lock);
+void        RWLockReadUnlock(RWLock* lock);
+
+void        RWLockWriteLock(RWLock* lock);
+void        RWLockWriteUnlock(RWLock* lock);
+
+// ----------------------------------------
+// Event
+// ----------------------------------------
+
+void        EventSignal(Event* event);
+void        EventWait(Event* event);
+void        EventReset(Event* event);
+
+inline bool EventIsSignaled(const Event* event)
+{
+    return event->Signaled.load(std::memory_order_acquire) != 0;
+}
+
+// ----------------------------------------
+// Semaphore
+// ----------------------------------------
+
+void        SemaphoreSignal(Semaphore* semaphore, U32 count = 1);
+void        SemaphoreWait(Semaphore* semaphore);
+bool        SemaphoreTryWait(Semaphore* semaphore);
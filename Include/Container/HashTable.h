@@ -49,6 +49,9 @@ inline I32 HashTableIndexOf(HashTable<T> hashTable, U64 key, I32* outHashIndex =
 {
     if (!hashTable.Hashs || !hashTable.Count)
     {
+        // Buckets may already exist (cleared or pre-allocated table), new entries still need a valid slot
+        if (outHashIndex) *outHashIndex = hashTable.HashCount > 0 ? (I32)(key % (U64)hashTable.HashCount) : 0;
+        if (outPrevIndex) *outPrevIndex = -1;
         return -1;
     }
 
@@ -131,6 +134,62 @@ inline bool HashTable_TryRefValue(const HashTable<T>& hashTable, U64 key, T** ou
     }
 }
 
+// Make sure the hash table can hold capacity entries without growing
+template <typename T>
+inline bool HashTableEnsure(HashTable<T>* hashTable, I32 capacity)
+{
+    assert(hashTable);
+
+    if (capacity <= hashTable->Capacity)
+    {
+        return true;
+    }
+
+    // Even capacity keep Keys and Values aligned after the I32 Nexts
+    const I32 oldCapacity = hashTable->Capacity;
+    const I32 newCapacity = (capacity + 1) & ~1;
+
+    const I32 oldBufferSize = oldCapacity * (sizeof(I32) + sizeof(U64) + sizeof(T));
+    const I32 newBufferSize = newCapacity * (sizeof(I32) + sizeof(U64) + sizeof(T));
+
+    U8* oldBuffer = (U8*)hashTable->Nexts;
+    U8* newBuffer = (U8*)MemoryAlloc(newBufferSize);
+
+    if (oldCapacity > 0 && oldBuffer != nullptr)
+    {
+        // Copy old hashTable->Nexts memory
+        MemoryCopy(
+            newBuffer,
+            oldBuffer,
+            oldCapacity * sizeof(I32)
+        );
+
+        // Copy old hashTable->Keys memory
+        MemoryCopy(
+            newBuffer + newCapacity * sizeof(I32),
+            oldBuffer + oldCapacity * sizeof(I32),
+            oldCapacity * sizeof(U64)
+        );
+
+        // Copy old hashTable->Values memory
+        MemoryCopy(
+            newBuffer + newCapacity * (sizeof(I32) + sizeof(U64)),
+            oldBuffer + oldCapacity * (sizeof(I32) + sizeof(U64)),
+            oldCapacity * sizeof(T)
+        );
+    }
+
+    // Release old buffer
+    MemoryFree(oldBuffer);
+
+    hashTable->Nexts    = (I32*) newBuffer;
+    hashTable->Keys     = (U64*)(newBuffer + newCapacity *  sizeof(I32));
+    hashTable->Values   = (T*)  (newBuffer + newCapacity * (sizeof(I32) + sizeof(U64)));
+    hashTable->Capacity = newCapacity;
+
+    return newBuffer != nullptr;
+}
+
 // Get value entry, if not exists create new. 
 // Return true if success, false otherwise.
 template <typename T>
@@ -160,46 +219,7 @@ inline I32 HashTableGetValueOrNewSlot(HashTable<T>* hashTable, U64 key, T** outV
 
         if (hashTable->Count + 1 > hashTable->Capacity)
         {
-            const I32 oldCapacity = hashTable->Capacity;
-            const I32 newCapacity = oldCapacity > 0 ? oldCapacity * 2 : 32;
-
-            const I32 oldBufferSize = oldCapacity * (sizeof(I32) + sizeof(U64) + sizeof(T));
-            const I32 newBufferSize = newCapacity * (sizeof(I32) + sizeof(U64) + sizeof(T));
-            
-            U8* oldBuffer = (U8*)hashTable->Nexts;
-            U8* newBuffer = (U8*)MemoryAlloc(newBufferSize);
-
-            if (oldCapacity > 0 && oldBuffer != nullptr)
-            {
-                // Copy old hashTable->Nexts memory
-                MemoryCopy(
-                    newBuffer,
-                    oldBuffer,
-                    oldCapacity * sizeof(I32)
-                );
-
-                // Copy old hashTable->Keys memory
-                MemoryCopy(
-                    newBuffer + newCapacity * sizeof(I32),
-                    oldBuffer + oldCapacity * sizeof(I32),
-                    oldCapacity * sizeof(U64)
-                );
-            
-                // Copy old hashTable->Values memory
-                MemoryCopy(
-                    newBuffer + newCapacity * (sizeof(I32) + sizeof(U64)),
-                    oldBuffer + oldCapacity * (sizeof(I32) + sizeof(U64)),
-                    oldCapacity * sizeof(T)
-                );
-            }
-            
-            // Release old buffer
-            MemoryFree(oldBuffer);
-
-            hashTable->Nexts    = (I32*) newBuffer;
-            hashTable->Keys     = (U64*)(newBuffer + newCapacity *  sizeof(I32));
-            hashTable->Values   = (T*)  (newBuffer + newCapacity * (sizeof(I32) + sizeof(U64)));
-            hashTable->Capacity = newCapacity;
+            HashTableEnsure(hashTable, hashTable->Capacity > 0 ? hashTable->Capacity * 2 : 32);
         }
         
         // Append the value to the tail of the array
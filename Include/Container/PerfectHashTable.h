@@ -0,0 +1,216 @@
+#pragma once
+
+#include <string.h>
+#include <System/Core.h>
+
+constexpr I32 PerfectHashNextPowerOfTwo(I32 value)
+{
+    I32 result = 1;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+// Tries per bucket before giving up, tables have twice more slots than keys so a few are enough
+constexpr U32 PERFECT_HASH_MAX_DISPLACEMENT = 1 << 16;
+
+/// PerfectHashEntry
+/// Slot of a perfect hash table, Length is -1 for empty slots
+struct PerfectHashEntry
+{
+    const char* Key;
+    I32         Length;
+    I32         Index;      // Index of the key in the list the table was built from
+};
+
+/// PerfectHashTable
+/// Collision-free lookup table of a fixed list of strings, built at compile time (CHD: hash, bucket, displace).
+///     Keys are spread in buckets by their hash, then each bucket, largest first, searches the displacement
+///     which puts all its keys in free slots. A lookup is one hash, one displacement read and one compare, no probing.
+/// Note:
+///     The keys are not copied, they must be string literals (or outlive the table).
+///     Valid is false when two keys are equal, check it with static_assert.
+/// Usage:
+///     constexpr const char* EXTENSIONS[] = { "png", "wav", "json", "ttf" };
+///     constexpr auto EXTENSION_TABLE = MakePerfectHashTable(EXTENSIONS);
+///     static_assert(EXTENSION_TABLE.Valid, "Duplicated extensions");
+///
+///     switch (PerfectHashFind(EXTENSION_TABLE, extension))
+///     {
+///     case ConstPerfectHashFind(EXTENSION_TABLE, "png"): ...
+///     case -1: /* Not in the list */ ...
+///     }
+template <I32 COUNT>
+struct PerfectHashTable
+{
+    static constexpr I32 SLOT_COUNT     = PerfectHashNextPowerOfTwo(COUNT) * 2;
+    static constexpr I32 BUCKET_COUNT   = PerfectHashNextPowerOfTwo(COUNT) / 2 > 0 ? PerfectHashNextPowerOfTwo(COUNT) / 2 : 1;
+
+    PerfectHashEntry    Entries[SLOT_COUNT];
+    U32                 Displacements[BUCKET_COUNT];
+    bool                Valid;
+
+    constexpr PerfectHashTable()
+        : Entries()
+        , Displacements()
+        , Valid(false)
+    {
+    }
+};
+
+// -----------------------------------
+// Hashing
+// -----------------------------------
+
+// Buckets use the high half of the key hash, slots the whole hash mixed with the displacement of the bucket
+constexpr U32 PerfectHashBucket(U64 hash, I32 bucketCount)
+{
+    return (U32)(hash >> 32) & (U32)(bucketCount - 1);
+}
+
+constexpr U32 PerfectHashSlot(U64 hash, U32 displacement, I32 slotCount)
+{
+    U64 x = hash + (displacement + 1ULL) * HASH_KEY_STEP;
+    x ^= x >> 31;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 32;
+    return (U32)x & (U32)(slotCount - 1);
+}
+
+constexpr I32 PerfectHashStringLength(const char* string)
+{
+    I32 length = 0;
+    while (string[length])
+    {
+        length++;
+    }
+    return length;
+}
+
+// -----------------------------------
+// Main functions
+// -----------------------------------
+
+template <I32 COUNT>
+constexpr PerfectHashTable<COUNT> MakePerfectHashTable(const char* const (&keys)[COUNT])
+{
+    using Table = PerfectHashTable<COUNT>;
+
+    Table table;
+    for (I32 i = 0; i < Table::SLOT_COUNT; i++)
+    {
+        table.Entries[i] = { nullptr, -1, -1 };
+    }
+
+    U64 hashes[COUNT] = {};
+    U32 buckets[COUNT] = {};
+    I32 bucketSizes[Table::BUCKET_COUNT] = {};
+    I32 maxBucketSize = 0;
+    for (I32 i = 0; i < COUNT; i++)
+    {
+        hashes[i] = ConstHash64(StringView(keys[i], PerfectHashStringLength(keys[i])));
+        buckets[i] = PerfectHashBucket(hashes[i], Table::BUCKET_COUNT);
+
+        const I32 size = ++bucketSizes[buckets[i]];
+        maxBucketSize = size > maxBucketSize ? size : maxBucketSize;
+    }
+
+    // Largest buckets first, they are the hardest to place
+    for (I32 size = maxBucketSize; size > 0; size--)
+    {
+        for (I32 bucket = 0; bucket < Table::BUCKET_COUNT; bucket++)
+        {
+            if (bucketSizes[bucket] != size)
+            {
+                continue;
+            }
+
+            bool placed = false;
+            for (U32 displacement = 0; displacement < PERFECT_HASH_MAX_DISPLACEMENT && !placed; displacement++)
+            {
+                U32 slots[COUNT] = {};
+                I32 slotCount = 0;
+                bool free = true;
+                for (I32 i = 0; i < COUNT && free; i++)
+                {
+                    if (buckets[i] != (U32)bucket)
+                    {
+                        continue;
+                    }
+
+                    const U32 slot = PerfectHashSlot(hashes[i], displacement, Table::SLOT_COUNT);
+                    free = table.Entries[slot].Length < 0;
+                    for (I32 j = 0; j < slotCount && free; j++)
+                    {
+                        free = slots[j] != slot;
+                    }
+
+                    slots[slotCount++] = slot;
+                }
+
+                if (!free)
+                {
+                    continue;
+                }
+
+                for (I32 i = 0, j = 0; i < COUNT; i++)
+                {
+                    if (buckets[i] == (U32)bucket)
+                    {
+                        table.Entries[slots[j++]] = { keys[i], PerfectHashStringLength(keys[i]), i };
+                    }
+                }
+
+                table.Displacements[bucket] = displacement;
+                placed = true;
+            }
+
+            // Equal keys have the same slots whatever the displacement
+            if (!placed)
+            {
+                return table;
+            }
+        }
+    }
+
+    table.Valid = true;
+    return table;
+}
+
+// Index of the key in the list the table was built from, -1 when the key is not in it
+template <I32 COUNT>
+inline I32 PerfectHashFind(const PerfectHashTable<COUNT>& table, StringView key)
+{
+    using Table = PerfectHashTable<COUNT>;
+
+    const U64 hash = CalcHash64(key.Buffer, key.Length);
+    const PerfectHashEntry& entry = table.Entries[PerfectHashSlot(hash, table.Displacements[PerfectHashBucket(hash, Table::BUCKET_COUNT)], Table::SLOT_COUNT)];
+    return entry.Length == key.Length && memcmp(entry.Key, key.Buffer, key.Length) == 0 ? entry.Index : -1;
+}
+
+// Compile-time twin of PerfectHashFind, for case labels and static_assert
+// Takes the literal itself: a StringView made from a literal sets a 1-bit signed field, which is not a constant expression on every compiler
+template <I32 COUNT, I32 LENGTH>
+constexpr I32 ConstPerfectHashFind(const PerfectHashTable<COUNT>& table, const char (&key)[LENGTH])
+{
+    using Table = PerfectHashTable<COUNT>;
+
+    const U64 hash = ConstHash64(StringView(key, LENGTH - 1));
+    const PerfectHashEntry& entry = table.Entries[PerfectHashSlot(hash, table.Displacements[PerfectHashBucket(hash, Table::BUCKET_COUNT)], Table::SLOT_COUNT)];
+    if (entry.Length != LENGTH - 1)
+    {
+        return -1;
+    }
+
+    for (I32 i = 0; i < LENGTH - 1; i++)
+    {
+        if (entry.Key[i] != key[i])
+        {
+            return -1;
+        }
+    }
+
+    return entry.Index;
+}
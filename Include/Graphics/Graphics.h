@@ -218,6 +218,12 @@ namespace Graphics
     bool    IsWireframe(void);
     void    SetWireframe(bool enable);
 
+    // Opt-in pipelined frame loop: textures drawn this frame are recorded into a snapshot
+    // and converted to vertices on job workers (see InitJobSystem) while the next frame is simulated.
+    // EndDrawing present the previous snapshot, so sprites are shown one frame later.
+    bool    IsFramePipelining(void);
+    void    SetFramePipelining(bool enable);
+
     Matrix4 GetProjection(void);
     void    SetProjection(Matrix4 projection);
 
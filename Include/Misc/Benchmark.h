@@ -0,0 +1,108 @@
+#ifndef __BENCHMARK__
+#define __BENCHMARK__
+
+struct Benchmark
+{
+    using           BenchmarkFunc = void(*)();
+
+    const char*     Name;
+    BenchmarkFunc   Func;
+    Benchmark*      Next;
+
+                    Benchmark(const char* name, const BenchmarkFunc func);
+};
+
+#ifndef _CONCAT
+#define _CONCAT(a, b)       _CONCAT_IMPL(a, b)
+#define _CONCAT_IMPL(a, b)  a ## b
+#endif
+
+#ifndef _SYMBOL
+#define _SYMBOL(name)       _CONCAT(name, __LINE__)
+#endif
+
+#define DEFINE_BENCHMARK(name)                                              \
+    static void _SYMBOL(BenchmarkFunc)();                                   \
+    static const Benchmark _SYMBOL(BENCHMARK)(name, _SYMBOL(BenchmarkFunc)); \
+    static void _SYMBOL(BenchmarkFunc)()
+
+// Run func(data) repeatedly for at least BENCHMARK_MIN_SECONDS and print the average time.
+// opsPerRun is the number of operations done by one call, used to report time per operation.
+// Return the average seconds per run.
+double MeasureBenchmark(const char* name, int opsPerRun, void (*func)(void* data), void* data);
+
+// Prevent the compiler from optimizing away a computed value
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+    const volatile char* volatile sink = (const volatile char*)&value;
+    (void)sink;
+}
+
+#endif
+
+#ifdef BENCHMARK_RUNNER
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+#include <System/Core.h>
+#include <System/Memory.h>
+
+#ifndef BENCHMARK_MIN_SECONDS
+#define BENCHMARK_MIN_SECONDS 0.25
+#endif
+
+static Benchmark*   gBenchmarks         = nullptr;
+static int          gBenchmarksCount    = 0;
+
+Benchmark::Benchmark(const char* name, const BenchmarkFunc func)
+    : Name(name)
+    , Func(func)
+    , Next(gBenchmarks)
+{
+    DebugAssert(name != nullptr && strlen(name), "Benchmark should have an name");
+    DebugAssert(func != nullptr, "Benchmark must have an executor");
+
+    gBenchmarks = this;
+    gBenchmarksCount++;
+}
+
+double MeasureBenchmark(const char* name, int opsPerRun, void (*func)(void* data), void* data)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Warm up caches, lazy initialization, worker threads
+    func(data);
+
+    int     runs    = 0;
+    double  elapsed = 0.0;
+
+    Clock::time_point start = Clock::now();
+    do
+    {
+        func(data);
+        runs++;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < BENCHMARK_MIN_SECONDS);
+
+    double secondsPerRun = elapsed / runs;
+    double nsPerOp = secondsPerRun * 1e9 / (opsPerRun > 0 ? opsPerRun : 1);
+    printf("    %-48s %10d runs %14.3f us/run %12.2f ns/op\n", name, runs, secondsPerRun * 1e6, nsPerOp);
+    return secondsPerRun;
+}
+
+static void RunAllBenchmarks()
+{
+    for (Benchmark* benchmark = gBenchmarks; benchmark != nullptr; benchmark = benchmark->Next)
+    {
+        // Benchmark should make sure there is no memory leaks in the system
+        MemoryTracker memoryTracker;
+
+        printf("%s\n", benchmark->Name);
+        benchmark->Func();
+    }
+}
+
+#endif
@@ -206,7 +206,7 @@ struct StringView
     {
     }
 
-    inline StringView(const char* buffer, const I32 length)
+    constexpr StringView(const char* buffer, const I32 length)
         : Buffer(buffer)
         , Length(length)
         , IsOwned(false)
@@ -311,8 +311,13 @@ struct Job
 {
     void* Data;
     void (*Execute)(void* data);
+
+    const char* Name; // Optional, shown in job profiler
 };
 
+// Cpu supports AVX2 and the os saves the ymm registers, checked once
+bool CpuHasAVX2(void);
+
 // ----------------------
 // IO types
 // ----------------------
@@ -419,111 +424,190 @@ inline I64 NextPOTwosI64(I64 x)
 // Main hashsing functions
 // -------------------------------------
 
+// Hash of the bytes, in little-endian order on every platform:
+//  - Up to HASH_LONG_MIN bytes: wyhash-style, two 64x64->128 multiplies on unaligned word loads
+//  - Longer inputs: xxh3-style accumulation of 64 bytes stripes in 8 lanes, SSE2/AVX2 at runtime
+// ConstHash64 is the compile-time twin of CalcHash64, both give the same value for any input.
+// The 32-bit hashes are the 64-bit hash folded.
 U32 CalcHash32(const void* buffer, I32 length, U32 seed = 0);
 U64 CalcHash64(const void* buffer, I32 length, U64 seed = 0);
 
-constexpr U32 ConstHash32(StringView string, U32 seed = 0)
+constexpr U64 HASH_SECRET[4]        = { 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL };
+
+constexpr I32 HASH_LONG_MIN         = 256;
+constexpr I32 HASH_STRIPE_SIZE      = 64;
+constexpr I32 HASH_BLOCK_STRIPES    = 16;   // Accumulators are scrambled after each block
+constexpr U64 HASH_LANE_KEYS[8]     = {
+    0x5f642f87d5e23888ULL, 0x5a4d78533d034cb5ULL, 0x8a85ffdaea35a5a6ULL, 0xad002edb4259d53aULL,
+    0x807b1f5869c624bcULL, 0x1e2ac6b725fc033eULL, 0x3071c63893f2dcbdULL, 0x82642fea4a219753ULL,
+};
+constexpr U64 HASH_KEY_STEP         = 0x9e3779b97f4a7c15ULL;    // Lane keys change every stripe, so stripes cannot be swapped
+constexpr U64 HASH_SCRAMBLE_PRIME   = 0x9e3779b1ULL;
+
+constexpr U64 ConstHashRead64(const char* p)
 {
-    // Murmur hash: multiply (mu) and rotate (r) x2
-    constexpr U32 mul = 0xcc9e2d51;
-    constexpr U32 rot = 17; // should be prime number
+    return ((U64)(U8)p[0] <<  0) | ((U64)(U8)p[1] <<  8) | ((U64)(U8)p[2] << 16) | ((U64)(U8)p[3] << 24)
+         | ((U64)(U8)p[4] << 32) | ((U64)(U8)p[5] << 40) | ((U64)(U8)p[6] << 48) | ((U64)(U8)p[7] << 56);
+}
 
-    const U32 length = string.Length;
-    const I8* target = string.Buffer;
+constexpr U64 ConstHashRead32(const char* p)
+{
+    return ((U64)(U8)p[0] << 0) | ((U64)(U8)p[1] << 8) | ((U64)(U8)p[2] << 16) | ((U64)(U8)p[3] << 24);
+}
 
-    const U32 l = length;
-    const U32 n = (l >> 3) << 3;
+// 64x64->128 multiply: a and b receive the low and high halves
+constexpr void ConstHashMum(U64& a, U64& b)
+{
+    const U64 aLow = a & 0xffffffffULL, aHigh = a >> 32;
+    const U64 bLow = b & 0xffffffffULL, bHigh = b >> 32;
 
-    U32 h = seed ^ (l | mul);
-    for (U32 i = 0; i < n; i += 4)
-    {
-        U32 b0 = target[i + 0];
-        U32 b1 = target[i + 1];
-        U32 b2 = target[i + 2];
-        U32 b3 = target[i + 3];
-#if CPU_LITTLE_ENDIAN
-        U32 k = (b3 << 24) | (b2 << 16) | (b1 << 8) | (b0 << 0);
-#else
-        U32 k = (b0 << 24) | (b1 << 16) | (b2 << 8) | (b3 << 0);
-#endif
+    const U64 lowLow = aLow * bLow;
+    const U64 lowHigh = aLow * bHigh;
+    const U64 highLow = aHigh * bLow;
+    const U64 middle = (lowLow >> 32) + (lowHigh & 0xffffffffULL) + (highLow & 0xffffffffULL);
 
-        k *= mul;
-        k ^= (k >> rot);
-        k *= mul;
+    a = (lowLow & 0xffffffffULL) | (middle << 32);
+    b = aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+}
 
-        h ^= k;
-        h *= mul;
-    }
+constexpr U64 ConstHashMix(U64 a, U64 b)
+{
+    ConstHashMum(a, b);
+    return a ^ b;
+}
 
-    switch (l & 3)
+constexpr void ConstHashStripe(U64* acc, U64* keys, const char* stripe)
+{
+    for (I32 i = 0; i < 8; i++)
     {
-    case 3: h ^= (U32)((target + n)[2]) << 16U;   /* fall through */
-    case 2: h ^= (U32)((target + n)[1]) <<  8U;   /* fall through */
-    case 1: h ^= (U32)((target + n)[0]) <<  0U;   /* fall through */
-    };
+        const U64 data = ConstHashRead64(stripe + i * 8);
+        const U64 dataKey = data ^ keys[i];
+        acc[i] += (dataKey & 0xffffffffULL) * (dataKey >> 32);
+        acc[i ^ 1] += data;
+        keys[i] += HASH_KEY_STEP;
+    }
+}
 
-    h *= mul;
-    h ^= (h >> rot);
-    h *= mul;
-    h ^= (h >> rot);
+constexpr void ConstHashScramble(U64* acc)
+{
+    for (I32 i = 0; i < 8; i++)
+    {
+        acc[i] = (acc[i] ^ (acc[i] >> 47) ^ HASH_LANE_KEYS[i]) * HASH_SCRAMBLE_PRIME;
+    }
+}
 
-    return h;
+// Initial accumulators and lane keys of long inputs
+constexpr void ConstHashInitLanes(U64* acc, U64* keys, U64 seed)
+{
+    for (I32 i = 0; i < 8; i++)
+    {
+        acc[i] = HASH_LANE_KEYS[(i + 4) & 7];
+        keys[i] = HASH_LANE_KEYS[i] + seed;
+    }
 }
 
-constexpr U64 ConstHash64(StringView string, U64 seed = 0)
+// Final hash of long inputs from the accumulators, the runtime SIMD paths end here too
+constexpr U64 ConstHashMergeLanes(const U64* acc, U32 length, U64 seed)
 {
-    // Murmur hash: multiply (mu) and rotate (r) x2
-    constexpr U64 mul = 0xc6a4a7935bd1e995ULL;
-    constexpr U64 rot = 47; // should be prime number
+    U64 h = (length * 0x9e3779b185ebca87ULL) ^ seed;
+    for (I32 i = 0; i < 4; i++)
+    {
+        h += ConstHashMix(acc[i * 2] ^ HASH_SECRET[i], acc[i * 2 + 1] ^ HASH_LANE_KEYS[i * 2]);
+    }
 
-    const U32 length = string.Length;
-    const I8* target = string.Buffer;
+    h ^= h >> 37;
+    h *= 0x165667919e3779f9ULL;
+    h ^= h >> 32;
+    return h;
+}
 
-    const U32 l = length;
-    const U32 n = (l >> 3) << 3;
+// Every full stripe but the last one, then the last 64 bytes (overlapping the previous stripe)
+constexpr U64 ConstHashLong64(const char* buffer, U32 length, U64 seed)
+{
+    U64 acc[8] = {};
+    U64 keys[8] = {};
+    ConstHashInitLanes(acc, keys, seed);
 
-    U64 h = seed ^ (l | mul);
-    for (U32 i = 0; i < n; i += 8)
+    const U32 stripes = (length - 1) / HASH_STRIPE_SIZE;
+    for (U32 i = 0; i < stripes; i++)
     {
-        U64 b0 = target[i + 0];
-        U64 b1 = target[i + 1];
-        U64 b2 = target[i + 2];
-        U64 b3 = target[i + 3];
-        U64 b4 = target[i + 4];
-        U64 b5 = target[i + 5];
-        U64 b6 = target[i + 6];
-        U64 b7 = target[i + 7];
-#if CPU_LITTLE_ENDIAN
-        U64 k = (b7 << 56) | (b6 << 48) | (b5 << 40) | (b4 << 32) | (b3 << 24) | (b2 << 16) | (b1 << 8) | (b0 << 0);
-#else
-        U64 k = (b0 << 56) | (b1 << 48) | (b2 << 40) | (b3 << 32) | (b4 << 24) | (b5 << 16) | (b6 << 8) | (b7 << 0);
-#endif
+        ConstHashStripe(acc, keys, buffer + i * HASH_STRIPE_SIZE);
+        if (i % HASH_BLOCK_STRIPES == HASH_BLOCK_STRIPES - 1)
+        {
+            ConstHashScramble(acc);
+        }
+    }
 
-        k *= mul;
-        k ^= (k >> rot);
-        k *= mul;
+    ConstHashStripe(acc, keys, buffer + length - HASH_STRIPE_SIZE);
+    return ConstHashMergeLanes(acc, length, seed);
+}
+
+constexpr U64 ConstHash64(StringView string, U64 seed = 0)
+{
+    const char* buffer = string.Buffer;
+    const U32 length = (U32)string.Length;
 
-        h ^= k;
-        h *= mul;
+    seed ^= ConstHashMix(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+    if (length > (U32)HASH_LONG_MIN)
+    {
+        return ConstHashLong64(buffer, length, seed);
     }
 
-    switch (l & 7)
+    U64 a = 0;
+    U64 b = 0;
+    if (length <= 16)
     {
-    case 7: h ^= (U64)((target + n)[6]) << 48U;   /* fall through */
-    case 6: h ^= (U64)((target + n)[5]) << 40U;   /* fall through */
-    case 5: h ^= (U64)((target + n)[4]) << 32U;   /* fall through */
-    case 4: h ^= (U64)((target + n)[3]) << 24U;   /* fall through */
-    case 3: h ^= (U64)((target + n)[2]) << 16U;   /* fall through */
-    case 2: h ^= (U64)((target + n)[1]) <<  8U;   /* fall through */
-    case 1: h ^= (U64)((target + n)[0]) <<  0U;   /* fall through */
-    };
+        if (length >= 4)
+        {
+            const U32 offset = (length >> 3) << 2;
+            a = (ConstHashRead32(buffer) << 32) | ConstHashRead32(buffer + offset);
+            b = (ConstHashRead32(buffer + length - 4) << 32) | ConstHashRead32(buffer + length - 4 - offset);
+        }
+        else if (length > 0)
+        {
+            a = ((U64)(U8)buffer[0] << 16) | ((U64)(U8)buffer[length >> 1] << 8) | (U64)(U8)buffer[length - 1];
+        }
+    }
+    else
+    {
+        const char* p = buffer;
+        U32 i = length;
+        if (i > 48)
+        {
+            U64 seed1 = seed;
+            U64 seed2 = seed;
+            do
+            {
+                seed = ConstHashMix(ConstHashRead64(p) ^ HASH_SECRET[1], ConstHashRead64(p + 8) ^ seed);
+                seed1 = ConstHashMix(ConstHashRead64(p + 16) ^ HASH_SECRET[2], ConstHashRead64(p + 24) ^ seed1);
+                seed2 = ConstHashMix(ConstHashRead64(p + 32) ^ HASH_SECRET[3], ConstHashRead64(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (i > 16)
+        {
+            seed = ConstHashMix(ConstHashRead64(p) ^ HASH_SECRET[1], ConstHashRead64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
 
-    h *= mul;
-    h ^= (h >> rot);
-    h *= mul;
-    h ^= (h >> rot);
+        a = ConstHashRead64(p + i - 16);
+        b = ConstHashRead64(p + i - 8);
+    }
 
-    return h;
+    a ^= HASH_SECRET[1];
+    b ^= seed;
+    ConstHashMum(a, b);
+    return ConstHashMix(a ^ HASH_SECRET[0] ^ length, b ^ HASH_SECRET[1]);
+}
+
+constexpr U32 ConstHash32(StringView string, U32 seed = 0)
+{
+    const U64 h = ConstHash64(string, seed);
+    return (U32)(h ^ (h >> 32));
 }
 
 inline U32 CalcHashPtr32(void* ptr, U32 seed = 0)
@@ -604,6 +688,7 @@ inline Handle MakeHandle(void* pointer)
 // Random numbers
 // ------------------------------------
 
+// Numbers of the calling thread generator, see System/Random.h
 I32 RandomNextI32(void);
 I64 RandomNextI64(void);
 U32 RandomNextU32(void);
@@ -40,3 +40,30 @@ Buffer      LoadFileData(StringView path);
 
 Buffer64    LoadFileData64(File file);
 Buffer64    LoadFileData64(StringView path);
+
+// Map the whole file read-only in memory, pages are loaded on first access
+Buffer64    MapFileData(StringView path);
+void        UnmapFileData(Buffer64 buffer);
+
+// ------------------------------
+// Paths
+// ------------------------------
+
+constexpr U32 PATH_FOLD_CASE = 1 << 0;  // Lowercase ASCII letters, Windows file names are not case-sensitive
+
+/// PathKey
+/// Hash of a normalized path, to key asset caches: the same file reached with other separators,
+/// "." and ".." segments or letter case has the same key, and is loaded once.
+struct PathKey
+{
+    U64         Hash;
+    I32         Length;     // Length of the normalized path
+};
+
+// Write the canonical form of path in output: '/' separators, no repeated or trailing separator,
+// no "." segment, ".." removes the segment before it (kept at the start of relative paths).
+// The normalized path is never longer than path, capacity must be path.Length at least, -1 is returned otherwise.
+I32         NormalizePath(StringView path, char* output, I32 capacity, U32 flags = 0);
+
+// Normalize and hash, without allocation for paths shorter than 1024 bytes
+PathKey     MakePathKey(StringView path, U32 flags = PATH_FOLD_CASE);
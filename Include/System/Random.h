@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string.h>
+#include <System/Core.h>
+
+/// Random
+/// xoshiro256** generator: 32 bytes of state, a few shifts and xors per number, passes BigCrush.
+/// Note:
+///     The same seed gives the same sequence on every platform and instruction set, replays can store the seed only.
+///     A state must not be shared by threads: use one per thread (GetThreadRandom), or split one with RandomJump.
+struct Random
+{
+    U64         State[4];
+};
+
+// -----------------------------------
+// Main functions
+// -----------------------------------
+
+// The seed is expanded with SplitMix64, any value (even 0) gives a good state
+Random      MakeRandom(U64 seed);
+
+// Advance the state by 2^128 numbers: the streams of a state and its jumped copies never overlap
+void        RandomJump(Random* random);
+
+// Generator of the calling thread, seeded from the time and the thread the first time it is used
+Random*     GetThreadRandom(void);
+
+// Fill output with floats in [0, 1), 8 per step from 4 interleaved streams (SSE2 or AVX2).
+// The streams are seeded from random, the result does not depend on the instruction set.
+void        RandomFillF32(Random* random, float* output, I32 count);
+
+// -----------------------------------
+// Numbers
+// -----------------------------------
+
+inline U64 Random_RotateLeft(U64 x, I32 k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+inline U64 RandomNextU64(Random* random)
+{
+    U64* s = random->State;
+    const U64 result = Random_RotateLeft(s[1] * 5, 7) * 9;
+    const U64 t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = Random_RotateLeft(s[3], 45);
+
+    return result;
+}
+
+inline U32 RandomNextU32(Random* random)
+{
+    return (U32)(RandomNextU64(random) >> 32);
+}
+
+// Float in [0, 1), the top 23 bits are the mantissa of a float in [1, 2)
+inline float RandomNextF32(Random* random)
+{
+    const U32 bits = (U32)(RandomNextU64(random) >> 41) | 0x3F800000U;
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result - 1.0f;
+}
+
+// Float in [min, max)
+inline float RandomRangeF32(Random* random, float min, float max)
+{
+    return min + (max - min) * RandomNextF32(random);
+}
+
+// Integer in [min, max), without the bias of modulo (multiply and keep the high half)
+inline I32 RandomRangeI32(Random* random, I32 min, I32 max)
+{
+    const U64 range = (U64)((I64)max - (I64)min);
+    return (I32)((I64)min + (I64)((RandomNextU32(random) * range) >> 32));
+}
@@ -12,6 +12,7 @@ enum struct JsonType
     Number,
     String,
     Boolean,
+    Integer,    /* Number without fraction or exponent that fit in I64, kept exact (-0 stays a Number) */
 };
 
 /// JsonError
@@ -40,6 +41,10 @@ enum struct JsonError
 ///     This data structure is used to parsing json only
 ///     Please, donot store Json data structure and its memory in your system
 ///     Use the right data structure instead.
+///     All nodes and strings of a document live in one memory block owned by the root,
+///     they are released at once by FreeJson (never free or grow them yourself).
+///     Objects keep their members in document order. Member names are interned per document,
+///     equal names share one string and can be compared by pointer.
 struct Json
 {
     JsonType    Type;
@@ -47,6 +52,7 @@ struct Json
     union
     {
         double          Number;
+        I64             Integer;
         bool            Boolean;
 
         String          String;
@@ -57,11 +63,19 @@ struct Json
     };
 };
 
+// Read the whole file and parse it in situ, the file content is released with the document
+// Large documents made of one top-level array are parsed in parallel when the job system has workers,
+// the result is the same as the single-threaded parse.
 Json*           LoadJson(const char* filePath);
 
 Json*           ParseJson(const char* content);
 Json*           ParseJson(const char* content, int contentLength);
 
+// Parse in place: escapes are decoded inside content and strings point into it (no string allocations).
+// content must be mutable and outlive the returned Json.
+Json*           ParseJsonInSitu(char* content);
+Json*           ParseJsonInSitu(char* content, int contentLength);
+
 void            FreeJson(Json* rootValue);
 
 JsonError       JsonGetError(const Json* rootValue);
@@ -70,4 +84,244 @@ const char*     JsonGetErrorString(const Json* rootValue);
 bool            JsonEquals(const Json a, const Json b);
 
 Json            JsonFind(const Json value, const char* name);
+Json            JsonFind(const Json value, Symbol name);      /* ConstSymbol("name") hash the name at compile time */
 Json            JsonFind(const Json value, U64 hash);
+
+/// JsonPath
+/// Precompiled JSON Pointer (RFC 6901), like "/levels/3/entities/*/position".
+/// Note:
+///     Keys are hashed once, when the path is made (at compile time with ConstJsonPath), queries never hash names.
+///     A numeric step is an index in arrays and a key in objects, '*' match every item or member.
+///     "~0" and "~1" escape '~' and '/' in keys. Count is -1 for a malformed or too deep path.
+constexpr int   JSON_PATH_MAX_STEPS     = 16;
+constexpr int   JSON_PATH_MAX_KEY       = 256;
+
+struct JsonPathStep
+{
+    U64         Hash;
+    I32         Index;      /* -1 when the step is not an array index */
+    bool        Wildcard;
+};
+
+struct JsonPath
+{
+    I32             Count;
+    JsonPathStep    Steps[JSON_PATH_MAX_STEPS];
+};
+
+constexpr JsonPath MakeJsonPath(const char* path, I32 length)
+{
+    JsonPath result = {};
+    if (length > 0 && path[0] != '/')
+    {
+        result.Count = -1;
+        return result;
+    }
+
+    /* The empty path is the value itself */
+    for (I32 cursor = 1; length > 0 && cursor <= length; cursor++)
+    {
+        if (result.Count == JSON_PATH_MAX_STEPS)
+        {
+            result.Count = -1;
+            return result;
+        }
+
+        char name[JSON_PATH_MAX_KEY] = {};
+        I32  nameLength = 0;
+        I64  index = 0;
+
+        for (; cursor < length && path[cursor] != '/'; cursor++)
+        {
+            char c = path[cursor];
+            if (c == '~')
+            {
+                c = cursor + 1 < length && path[cursor + 1] == '0' ? '~' : cursor + 1 < length && path[cursor + 1] == '1' ? '/' : 0;
+                cursor++;
+            }
+
+            if (c == 0 || nameLength == JSON_PATH_MAX_KEY)
+            {
+                result.Count = -1;
+                return result;
+            }
+
+            name[nameLength++] = c;
+            index = index >= 0 && c >= '0' && c <= '9' && index <= 0x7FFFFFFF ? index * 10 + (c - '0') : -1;
+        }
+
+        /* Indices have no leading zeros */
+        const bool isIndex = nameLength > 0 && index >= 0 && index <= 0x7FFFFFFF && (name[0] != '0' || nameLength == 1);
+
+        JsonPathStep& step = result.Steps[result.Count++];
+        step.Hash = ConstHash64(StringView(name, nameLength));
+        step.Index = isIndex ? (I32)index : -1;
+        step.Wildcard = nameLength == 1 && name[0] == '*';
+    }
+
+    return result;
+}
+
+template <I32 LENGTH>
+constexpr JsonPath ConstJsonPath(const char (&path)[LENGTH])
+{
+    return MakeJsonPath(path, LENGTH - 1);
+}
+
+JsonPath        MakeJsonPath(const char* path);
+
+// First value at path, or a null value
+Json            JsonQuery(const Json value, const JsonPath& path);
+
+// Append every value at path to outValues in document order, return the count appended.
+// Records of an array are expected to share their layout: each member is first looked for at the position it had in the previous record.
+int             JsonQueryAll(const Json value, const JsonPath& path, Array<Json>* outValues);
+
+// Value of a number or an integer as a double
+inline double   JsonGetNumber(const Json value)
+{
+    return value.Type == JsonType::Integer ? (double)value.Integer : value.Number;
+}
+
+// Interned name of the member at index (in document order) of a parsed object
+String          JsonGetKey(const Json object, int index);
+
+/// JsonToken
+/// Events produced by JsonReaderNext
+enum struct JsonToken
+{
+    None,
+
+    BeginObject,
+    EndObject,
+    BeginArray,
+    EndArray,
+
+    Key,
+    String,
+    Number,
+    Integer,
+    Boolean,
+    Null,
+
+    End,            /* No more documents in the input */
+    Error,          /* Sticky, see JsonReaderGetError */
+};
+
+/// JsonReader
+/// Incremental pull reader, the input is read in chunks and no tree is built.
+/// Note:
+///     Memory is bounded by the chunk size (grown only for a single token larger than a chunk), never by the document size.
+///     String holds the current key or string, it is null-terminated and only valid until the next JsonReaderNext.
+///     Documents may follow each other in the input (JSON Lines logs), End is reported after the last one.
+struct JsonReader
+{
+    JsonToken   Token;
+    int         Depth;      /* Containers opened before the current token */
+
+    union
+    {
+        double  Number;
+        I64     Integer;
+        bool    Boolean;
+        String  String;
+    };
+};
+
+constexpr int   JSON_READER_CHUNK_SIZE  = 64 * 1024;
+constexpr int   JSON_READER_MAX_DEPTH   = 1024;
+
+// Fill buffer with at most length bytes, return the bytes count, 0 at the end of the input, -1 on error
+using           JsonReadFunc = int(*)(void* userData, void* buffer, int length);
+
+JsonReader*     OpenJsonReader(const char* filePath, int chunkSize = JSON_READER_CHUNK_SIZE);
+JsonReader*     MakeJsonReader(File file, int chunkSize = JSON_READER_CHUNK_SIZE);
+JsonReader*     MakeJsonReader(JsonReadFunc read, void* userData, int chunkSize = JSON_READER_CHUNK_SIZE);
+void            FreeJsonReader(JsonReader* reader);
+
+JsonToken       JsonReaderNext(JsonReader* reader);
+
+// Skip the children of the object or array just begun, the next token is after its end
+bool            JsonReaderSkip(JsonReader* reader);
+
+JsonError       JsonReaderGetError(const JsonReader* reader);
+const char*     JsonReaderGetErrorString(const JsonReader* reader);
+
+/// JsonWriter
+/// Serialize Json text into a growable buffer, or in chunks into a file.
+/// Note:
+///     Indent is 0 for compact output, otherwise the spaces per depth of pretty output.
+///     Buffer/Length hold the text not flushed yet, the whole document when no file is given.
+///     Non-finite numbers have no JSON representation and are written as null.
+///     Invalid UTF-8 sequences in keys and strings are written as U+FFFD, the output always parses.
+///     Documents written after each other are separated by a newline (JSON Lines logs).
+struct JsonWriter
+{
+    char*       Buffer;
+    int         Length;
+};
+
+constexpr int   JSON_WRITER_CHUNK_SIZE  = 64 * 1024;
+
+JsonWriter*     MakeJsonWriter(int indent = 0);
+JsonWriter*     MakeJsonWriter(File file, int indent = 0);
+void            FreeJsonWriter(JsonWriter* writer);
+
+// Write the buffered text to the file, return false if any write failed since the writer was made
+bool            JsonWriterFlush(JsonWriter* writer);
+
+void            JsonWriteBeginObject(JsonWriter* writer);
+void            JsonWriteEndObject(JsonWriter* writer);
+void            JsonWriteBeginArray(JsonWriter* writer);
+void            JsonWriteEndArray(JsonWriter* writer);
+
+void            JsonWriteKey(JsonWriter* writer, StringView name);
+void            JsonWriteString(JsonWriter* writer, StringView value);
+void            JsonWriteNumber(JsonWriter* writer, double value);
+void            JsonWriteInteger(JsonWriter* writer, I64 value);
+void            JsonWriteBoolean(JsonWriter* writer, bool value);
+void            JsonWriteNull(JsonWriter* writer);
+
+// Write a parsed document or one of its values, return false if any write failed
+bool            JsonWrite(JsonWriter* writer, const Json value);
+
+// Write the document to a file, the counterpart of LoadJson
+bool            SaveJson(const char* filePath, const Json value, int indent = 0);
+
+/// JsonBinary
+/// A value of a binary document, read in place without parsing (memory-mapped asset databases).
+/// Note:
+///     Objects members are sorted by key hash: JsonFind is a binary search, member indices are not in document order.
+///     Strings point into the document and are null-terminated, they live as long as the document.
+///     Offsets are not validated past the header, only open documents made by ConvertJsonToBinary.
+struct JsonBinary
+{
+    const U8*   Document;   /* Start of the document, nullptr for an invalid value */
+    U64         Bits;       /* Type tag and inline value or offset */
+};
+
+// Encode a document to the binary format, the buffer is released with MemoryFree
+Buffer          ConvertJsonToBinary(const Json value);
+bool            SaveJsonBinary(const char* filePath, const Json value);
+
+// Root of a binary document in memory, invalid (Document is nullptr) if data is not a binary document
+JsonBinary      OpenJsonBinary(const void* data, I64 size);
+
+// Map a binary document file, unmapped with UnmapJsonBinary on its root
+JsonBinary      MapJsonBinary(const char* filePath);
+void            UnmapJsonBinary(JsonBinary root);
+
+JsonType        JsonBinaryGetType(const JsonBinary value);
+bool            JsonBinaryGetBoolean(const JsonBinary value);
+I64             JsonBinaryGetInteger(const JsonBinary value);
+double          JsonBinaryGetNumber(const JsonBinary value);    /* Number or integer as a double */
+String          JsonBinaryGetString(const JsonBinary value);
+
+// Items of an array or members of an object
+int             JsonBinaryGetCount(const JsonBinary value);
+JsonBinary      JsonBinaryGetItem(const JsonBinary array, int index);
+String          JsonBinaryGetKey(const JsonBinary object, int index);
+JsonBinary      JsonBinaryGetValue(const JsonBinary object, int index);
+
+JsonBinary      JsonFind(const JsonBinary object, const char* name);
+JsonBinary      JsonFind(const JsonBinary object, U64 hash);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <System/Core.h>
+
+/// LexerTokenType
+/// Kind of the tokens of C-like sources
+enum struct LexerTokenType
+{
+    Identifier,     // Keywords included, UTF-8 bytes are identifier chars
+    Number,         // Integer or floating point literal, with its suffix
+    String,         // Quotes, prefix (L, u8, R...) and escapes included
+    Char,
+    Punctuator,     // Longest match: <<=, ->, ::...
+    Preprocessor,   // Whole directive line, from '#' to the end of line, continuations included
+    Comment,        // Only reported with LEXER_KEEP_COMMENTS
+    Metadata,       // Block comment holding a JSON object, the token is the JSON text only
+    Error,          // Unterminated literal or comment, or a char starting no token. Lexing resumes after it.
+    End,
+};
+
+/// LexerToken
+/// Span of the source, tokens are never copied
+struct LexerToken
+{
+    LexerTokenType  Type;
+    I32             Start;
+    I32             Length;
+    I32             Line;       // Line of the first char, starting at 1
+};
+
+/// Lexer
+/// Tokenizer for C-like sources (C, C++, shaders, scripts), and the editor metadata embedded in them.
+/// Note:
+///     Chars are classified with a table, comments, literals and skipped code are scanned 16 bytes at a time.
+///     Metadata is a block comment which content is a JSON object, as written by the editor:
+///         /*
+///         { "name": "main player", "states": [ "idle", "move" ] }
+///         */
+///     The JSON text is parsed from the source without copy: ParseJson(lexer.Buffer + token.Start, token.Length).
+struct Lexer
+{
+    const char*     Buffer;
+    I32             Length;
+    I32             Cursor;
+    I32             Line;
+    U32             Flags;
+    bool            LineStart;  // Only spaces and comments since the last line break, '#' starts a directive
+};
+
+constexpr U32 LEXER_KEEP_COMMENTS = 1 << 0;
+
+// -----------------------------------
+// Main functions
+// -----------------------------------
+
+// The source is not copied, it must outlive the lexer and its tokens
+Lexer       MakeLexer(StringView source, U32 flags = 0);
+
+// Read the next token, return false at the end of the source (the token is End):
+//     for (LexerToken token; LexerNext(&lexer, &token);) { ... }
+bool        LexerNext(Lexer* lexer, LexerToken* outToken);
+
+// Skip to the next Metadata token, return false when there is none left.
+// Much faster than LexerNext: only comments and literals (which may contain comment markers) are looked at.
+bool        LexerNextMetadata(Lexer* lexer, LexerToken* outToken);
+
+StringView  LexerTokenText(const Lexer* lexer, const LexerToken* token);
+
+// Identifier which is a C or C++ keyword, found with a perfect hash table
+bool        LexerIsKeyword(const Lexer* lexer, const LexerToken* token);
@@ -37,6 +37,80 @@ String  SubString(StringView source, I32 start, I32 end = -1);
 String  RefString(StringView source);
 String  RefString(const char* source, I32 length, bool isOwned = false);
 
+// -----------------------------------
+// String interning
+// -----------------------------------
+
+// Store the string once in the global intern pool, thread-safe.
+// Equal strings give the same buffer (null-terminated), so interned strings can be compared by pointer.
+// Interned strings are never freed.
+String  InternString(StringView string);
+
+// Symbol of an interned name, its Name (debug builds) points to the pool.
+// Asserts when two different interned names have the same hash, so symbols can be compared by hash only.
+Symbol  InternSymbol(StringView name);
+
+// Name of an interned symbol, also available in release builds. Empty when the name was never interned.
+String  GetSymbolName(Symbol symbol);
+
+// -----------------------------------
+// Number formatting
+// -----------------------------------
+
+// Large enough for any formatted integer or double
+constexpr I32 FORMAT_NUMBER_SIZE = 32;
+
+// Write value in decimal, return the length (the buffer is not null-terminated)
+I32     FormatInteger(char* buffer, I64 value);
+I32     FormatUnsigned(char* buffer, U64 value);
+
+// Shortest decimal that parse back to the same double (Ryu), return the length (not null-terminated).
+// Fixed notation for exponents in [-5, 16], scientific otherwise; integral values keep a ".0" suffix.
+I32     FormatDouble(char* buffer, double value);
+
+// Fixed notation with decimals (0 to 9) digits after the point, as printf "%.*f" (halfway cases may round
+// differently in the last digit). Values of 2^53 and more once scaled fall back to FormatDouble.
+I32     FormatFixed(char* buffer, double value, I32 decimals);
+
+// -----------------------------------
+// String builder
+// -----------------------------------
+
+constexpr I32 STRING_BUILDER_INLINE_SIZE = 112;
+
+/// StringBuilder
+/// Append-only text that grows geometrically, short texts stay in the inline buffer (no allocation).
+/// Numbers are appended with the Format functions, without parsing a format string.
+/// A zero-initialized StringBuilder is empty and ready to use.
+/// Note:
+///     The buffer is always null-terminated. Views returned by StringBuilderToString are invalidated by
+///     the next append, copy them with SaveString to keep them.
+struct StringBuilder
+{
+    char*       Heap;       // nullptr while the text fits in Inline
+    I32         Length;
+    I32         Capacity;   // Heap capacity
+    char        Inline[STRING_BUILDER_INLINE_SIZE];
+};
+
+void    FreeStringBuilder(StringBuilder* builder);
+void    StringBuilderClear(StringBuilder* builder);
+
+// Make room for capacity chars (null terminator excluded)
+bool    StringBuilderReserve(StringBuilder* builder, I32 capacity);
+
+void    StringBuilderAppend(StringBuilder* builder, StringView text);
+void    StringBuilderAppendChar(StringBuilder* builder, char c);
+void    StringBuilderAppendInteger(StringBuilder* builder, I64 value);
+void    StringBuilderAppendUnsigned(StringBuilder* builder, U64 value);
+void    StringBuilderAppendDouble(StringBuilder* builder, double value);
+void    StringBuilderAppendFixed(StringBuilder* builder, double value, I32 decimals);
+
+// Fallback for the formats without a fast path, goes through vsnprintf
+void    StringBuilderAppendFormat(StringBuilder* builder, const char* format, ...);
+
+String  StringBuilderToString(const StringBuilder* builder);
+
 // -----------------------------------
 // Constructor functions
 // -----------------------------------
@@ -46,7 +120,7 @@ constexpr String ConstString(const char(&buffer)[LENGTH])
 {
     String result;
     result.Buffer   = buffer;
-    result.Length   = LENGTH;
+    result.Length   = LENGTH - 1;    // Without the null terminator, like StringView
     result.IsOwned  = false;
     result.IsConst  = true;
     result.Alloced  = 0;
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <System/Core.h>
+
+/// TextPiece
+/// Node of the piece tree: a span of one of the sources, and the sums of its subtree
+struct TextPiece
+{
+    I32         Left;           // Index in TextBuffer.Pieces, -1 when none
+    I32         Right;
+    U32         Priority;       // Treap priority, parents have higher ones
+
+    I32         Source;         // TEXT_SOURCE_ORIGINAL or TEXT_SOURCE_ADDED
+    I32         Start;
+    I32         Length;
+    I32         FirstBreak;     // Index of the first line break of the span in the source LineBreaks
+    I32         BreakCount;
+
+    I32         TreeLength;     // Chars and line breaks of the piece and its subtree
+    I32         TreeBreaks;
+};
+
+constexpr I32 TEXT_SOURCE_ORIGINAL  = 0;
+constexpr I32 TEXT_SOURCE_ADDED     = 1;
+
+/// TextBuffer
+/// Editable text for large documents (logs, scripts), as a piece table:
+///     The text is a sequence of pieces referencing the original content or the added chars,
+///     which are never moved nor modified. Pieces are kept in a balanced tree (treap) ordered
+///     by position, so inserting and deleting are O(log n) whatever the document size.
+///     Line breaks positions are indexed per source, line lookups are O(log n) too.
+/// Note:
+///     The text is not contiguous, read it through TextBufferIterator or TextBufferCopy.
+struct TextBuffer
+{
+    Array<TextPiece>    Pieces;
+    I32                 Root;
+    I32                 FreePiece;      // Free list of pieces, linked by Left
+
+    char*               Original;
+    I32                 OriginalLength;
+    Array<char>         Added;          // Append only
+
+    Array<I32>          LineBreaks[2];  // Positions of '\n' in each source, sorted
+
+    U32                 RandomState;
+};
+
+/// TextBufferIterator
+/// Walk a range of a text buffer chunk by chunk, each chunk being contiguous in memory.
+/// Iterators are invalidated by any change of the buffer.
+struct TextBufferIterator
+{
+    const TextBuffer*   Buffer;
+    I32                 Position;
+    I32                 End;
+};
+
+// -----------------------------------
+// Main functions
+// -----------------------------------
+
+// The initial content is copied
+TextBuffer  MakeTextBuffer(StringView content = StringView("", 0));
+void        FreeTextBuffer(TextBuffer* buffer);
+
+I32         TextBufferLength(const TextBuffer* buffer);
+
+// Position is clamped to [0, length]
+bool        TextBufferInsert(TextBuffer* buffer, I32 position, StringView text);
+void        TextBufferDelete(TextBuffer* buffer, I32 position, I32 length);
+
+char        TextBufferCharAt(const TextBuffer* buffer, I32 position);
+
+// Copy length chars from position into output (not null-terminated), return the copied count
+I32         TextBufferCopy(const TextBuffer* buffer, I32 position, I32 length, char* output);
+
+// Flatten the whole text in a new string, to save or search it
+String      TextBufferToString(const TextBuffer* buffer);
+
+// -----------------------------------
+// Lines
+// -----------------------------------
+
+// Lines are separated by '\n', a buffer always has at least one line
+I32         TextBufferLineCount(const TextBuffer* buffer);
+
+// Position of the first char of the line, the length of the buffer when line is past the last one
+I32         TextBufferLineStart(const TextBuffer* buffer, I32 line);
+
+// Position after the last char of the line, its '\n' excluded
+I32         TextBufferLineEnd(const TextBuffer* buffer, I32 line);
+
+// Line containing the char at position
+I32         TextBufferLineOf(const TextBuffer* buffer, I32 position);
+
+// -----------------------------------
+// Iteration
+// -----------------------------------
+
+// Iterate the chars in [start, end), end = -1 for the end of the buffer.
+// A line can be drawn without flattening, chunk by chunk:
+//     TextBufferIterator it = MakeTextBufferIterator(buffer, TextBufferLineStart(buffer, line), TextBufferLineEnd(buffer, line));
+//     for (String chunk; TextBufferNext(&it, &chunk);) { ImGui::TextUnformatted(chunk.Buffer, chunk.Buffer + chunk.Length); ImGui::SameLine(0, 0); }
+TextBufferIterator  MakeTextBufferIterator(const TextBuffer* buffer, I32 start = 0, I32 end = -1);
+bool                TextBufferNext(TextBufferIterator* iterator, String* outChunk);
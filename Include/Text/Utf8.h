@@ -0,0 +1,51 @@
+#pragma once
+
+#include <System/Core.h>
+
+// -----------------------------------
+// Constants
+// -----------------------------------
+
+constexpr U32 UTF8_REPLACEMENT_CHAR = 0xFFFD;   // Decoded in place of invalid sequences
+constexpr U32 UTF8_MAX_CODEPOINT    = 0x10FFFF;
+constexpr I32 UTF8_MAX_BYTES        = 4;        // Bytes of the longest encoded code point
+
+// -----------------------------------
+// Validation
+// -----------------------------------
+
+// Check that text is well-formed UTF-8: no overlong forms, no surrogates, nothing above U+10FFFF, no truncated sequence.
+// ASCII is skipped 16 or 32 bytes at a time, mixed text is checked with lookup tables, both run at memory bandwidth.
+bool        Utf8IsValid(StringView text);
+
+// Index of the first byte of the first invalid sequence, -1 when text is valid
+I32         Utf8InvalidIndex(StringView text);
+
+// Number of code points of valid text
+I32         Utf8Length(StringView text);
+
+// -----------------------------------
+// Code points
+// -----------------------------------
+
+// Decode the code point at the start of text and its encoded length.
+// Invalid sequences decode to UTF8_REPLACEMENT_CHAR and skip one byte, so decoding always progress.
+U32         Utf8Decode(const char* text, I32 length, I32* outLength);
+
+// Encode a code point in buffer (UTF8_MAX_BYTES at least), return the bytes written.
+// Surrogates and code points above U+10FFFF are encoded as UTF8_REPLACEMENT_CHAR.
+I32         Utf8Encode(U32 codepoint, char* buffer);
+
+// Decode text into code points (text.Length at most), return the count written
+I32         Utf8ToCodepoints(StringView text, U32* output, I32 capacity);
+
+// -----------------------------------
+// UTF-16
+// -----------------------------------
+
+// For Win32 wide char APIs. Output is not null-terminated, return the count of U16 written.
+// Text longer than the output is truncated at a code point boundary.
+I32         Utf8ToUtf16(StringView text, U16* output, I32 capacity);
+
+// Unpaired surrogates are converted to UTF8_REPLACEMENT_CHAR
+I32         Utf16ToUtf8(const U16* text, I32 length, char* output, I32 capacity);
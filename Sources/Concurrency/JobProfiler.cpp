@@ -0,0 +1,449 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Concurrency/JobProfiler.h>
+
+#include <System/Memory.h>
+#include <System/FileSystem.h>
+#include <Graphics/Imgui.h>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#elif defined(__unix__)
+#include <time.h>
+#endif
+
+#if JOB_PROFILER
+
+// ----------------------
+// Internal types
+// ----------------------
+
+static_assert((JOB_PROFILER_EVENTS_CAPACITY & (JOB_PROFILER_EVENTS_CAPACITY - 1)) == 0, "JOB_PROFILER_EVENTS_CAPACITY must be power of two");
+
+/// Single-producer ring: only the owner worker writes, any thread may read.
+/// When the ring is full the oldest events are overwritten.
+struct alignas(64) JobProfileRing
+{
+    std::atomic<U64>    Head;
+    U8                  Padding[64 - sizeof(std::atomic<U64>)];
+
+    JobProfileEvent     Events[JOB_PROFILER_EVENTS_CAPACITY];
+};
+
+std::atomic<bool>           JobProfilerEnabled;
+
+static JobProfileRing       Rings[JOB_PROFILER_MAX_WORKERS];
+static std::atomic<I32>     RingCount;
+
+static struct
+{
+    U64                     Ticks;
+    U64                     Nanoseconds;
+} Calibration;
+
+// ----------------------------
+// Timer helpers
+// ----------------------------
+
+static U64 MonotonicNanoseconds(void)
+{
+#if defined(_WIN32)
+    static LARGE_INTEGER frequency;
+    if (frequency.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&frequency);
+    }
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (U64)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (U64)ts.tv_sec * 1000000000ULL + (U64)ts.tv_nsec;
+#endif
+}
+
+#if !JOB_PROFILER_RDTSC
+U64 JobProfilerTimestampFallback(void)
+{
+    return MonotonicNanoseconds();
+}
+#endif
+
+// -------------------------------------
+// Main functions
+// -------------------------------------
+
+void JobProfilerEnable(bool enable)
+{
+    if (enable && Calibration.Ticks == 0)
+    {
+        Calibration.Ticks = JobProfilerTimestamp();
+        Calibration.Nanoseconds = MonotonicNanoseconds();
+    }
+
+    JobProfilerEnabled.store(enable, std::memory_order_relaxed);
+}
+
+bool JobProfilerIsEnabled(void)
+{
+    return JobProfilerEnabled.load(std::memory_order_relaxed);
+}
+
+void JobProfilerClear(void)
+{
+    for (I32 i = 0, n = RingCount.load(std::memory_order_acquire); i < n; i++)
+    {
+        Rings[i].Head.store(0, std::memory_order_release);
+    }
+}
+
+void JobProfilerRecord(I32 worker, const char* name, U64 start, U64 end)
+{
+    DebugAssert(worker >= 0 && worker < JOB_PROFILER_MAX_WORKERS, "Worker index is out of range");
+
+    I32 ringCount = RingCount.load(std::memory_order_relaxed);
+    while (worker >= ringCount && !RingCount.compare_exchange_weak(ringCount, worker + 1, std::memory_order_release))
+    {
+        // Another worker raised the count, try again with the new value
+    }
+
+    JobProfileRing* ring = &Rings[worker];
+
+    U64 head = ring->Head.load(std::memory_order_relaxed);
+    JobProfileEvent* event = &ring->Events[head & (JOB_PROFILER_EVENTS_CAPACITY - 1)];
+    event->Name = name;
+    event->Start = start;
+    event->End = end;
+    event->Worker = worker;
+
+    ring->Head.store(head + 1, std::memory_order_release);
+}
+
+// Copy the events of a worker, skip the events that were overwritten while copying
+static I32 JobProfiler_CollectWorker(I32 worker, JobProfileEvent* events)
+{
+    JobProfileRing* ring = &Rings[worker];
+
+    U64 head = ring->Head.load(std::memory_order_acquire);
+    U64 tail = head > JOB_PROFILER_EVENTS_CAPACITY ? head - JOB_PROFILER_EVENTS_CAPACITY : 0;
+    for (U64 i = tail; i < head; i++)
+    {
+        events[i - tail] = ring->Events[i & (JOB_PROFILER_EVENTS_CAPACITY - 1)];
+    }
+
+    U64 newHead = ring->Head.load(std::memory_order_acquire);
+    U64 overwritten = newHead > JOB_PROFILER_EVENTS_CAPACITY ? newHead - JOB_PROFILER_EVENTS_CAPACITY : 0;
+    if (overwritten > tail)
+    {
+        U64 skip = overwritten - tail < head - tail ? overwritten - tail : head - tail;
+        memmove(events, events + skip, (size_t)(head - tail - skip) * sizeof(JobProfileEvent));
+        tail += skip;
+    }
+
+    return (I32)(head - tail);
+}
+
+I32 JobProfilerCollect(JobProfileEvent* events, I32 maxEvents)
+{
+    JobProfileEvent workerEvents[JOB_PROFILER_EVENTS_CAPACITY];
+
+    I32 count = 0;
+    for (I32 worker = 0, n = RingCount.load(std::memory_order_acquire); worker < n; worker++)
+    {
+        I32 workerCount = JobProfiler_CollectWorker(worker, workerEvents);
+        for (I32 i = 0; i < workerCount && count < maxEvents; i++)
+        {
+            events[count++] = workerEvents[i];
+        }
+    }
+
+    return count;
+}
+
+double JobProfilerTicksToMicroseconds(U64 ticks)
+{
+#if JOB_PROFILER_RDTSC
+    U64 elapsedTicks = JobProfilerTimestamp() - Calibration.Ticks;
+    U64 elapsedNanoseconds = MonotonicNanoseconds() - Calibration.Nanoseconds;
+    if (elapsedTicks == 0 || elapsedNanoseconds == 0)
+    {
+        return 0.0;
+    }
+
+    return (double)ticks * ((double)elapsedNanoseconds / (double)elapsedTicks) * 1e-3;
+#else
+    return (double)ticks * 1e-3;
+#endif
+}
+
+// -------------------------------------
+// Export to Chrome tracing format
+// -------------------------------------
+
+struct JobTraceWriter
+{
+    File    Target;
+    I32     Length;
+    bool    Failed;
+    char    Buffer[4096];
+};
+
+static void JobTraceWriter_Flush(JobTraceWriter* writer)
+{
+    if (writer->Length > 0)
+    {
+        if (FileWrite(writer->Target, writer->Buffer, writer->Length) != writer->Length)
+        {
+            writer->Failed = true;
+        }
+        writer->Length = 0;
+    }
+}
+
+static void JobTraceWriter_Write(JobTraceWriter* writer, const char* format, ...)
+{
+    // Keep enough space for an event line
+    if (writer->Length > (I32)sizeof(writer->Buffer) - 512)
+    {
+        JobTraceWriter_Flush(writer);
+    }
+
+    ArgList argv;
+    ArgListBegin(argv, format);
+    I32 length = vsnprintf(writer->Buffer + writer->Length, sizeof(writer->Buffer) - writer->Length, format, argv);
+    ArgListEnd(argv);
+
+    if (length > 0)
+    {
+        writer->Length += length;
+    }
+}
+
+// Copy the job name into a json string, unnamed jobs are shown as "Job"
+static const char* JobTrace_EscapeName(const char* name, char* buffer, I32 bufferSize)
+{
+    if (name == nullptr)
+    {
+        return "Job";
+    }
+
+    I32 length = 0;
+    for (const char* c = name; *c != '\0' && length < bufferSize - 2; c++)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            buffer[length++] = '\\';
+        }
+        else if ((U8)*c < 0x20)
+        {
+            continue;
+        }
+        buffer[length++] = *c;
+    }
+    buffer[length] = '\0';
+    return buffer;
+}
+
+bool JobProfilerExport(StringView path)
+{
+    File file = OpenFile(path, (FileMode)(FileMode::Write | FileMode::Create | FileMode::Truncate));
+    if (!file)
+    {
+        return false;
+    }
+
+    JobTraceWriter* writer = (JobTraceWriter*)MemoryAlloc(sizeof(JobTraceWriter));
+    writer->Target = file;
+    writer->Length = 0;
+    writer->Failed = false;
+
+    JobProfileEvent events[JOB_PROFILER_EVENTS_CAPACITY];
+    I32 workerCount = RingCount.load(std::memory_order_acquire);
+
+    // Timestamps are relative to the oldest event, keep microseconds small
+    U64 baseTicks = ~0ULL;
+    for (I32 worker = 0; worker < workerCount; worker++)
+    {
+        I32 count = JobProfiler_CollectWorker(worker, events);
+        if (count > 0 && events[0].Start < baseTicks)
+        {
+            baseTicks = events[0].Start;
+        }
+    }
+
+    JobTraceWriter_Write(writer, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    bool first = true;
+    for (I32 worker = 0; worker < workerCount; worker++)
+    {
+        JobTraceWriter_Write(writer, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s %d\"}}",
+            first ? "" : ",\n", worker, worker == 0 ? "Main" : "Worker", worker);
+        first = false;
+
+        char name[256];
+        I32 count = JobProfiler_CollectWorker(worker, events);
+        for (I32 i = 0; i < count; i++)
+        {
+            JobProfileEvent event = events[i];
+            double timestamp = JobProfilerTicksToMicroseconds(event.Start - baseTicks);
+            double duration = JobProfilerTicksToMicroseconds(event.End - event.Start);
+
+            JobTraceWriter_Write(writer, ",\n{\"name\":\"%s\",\"cat\":\"job\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                JobTrace_EscapeName(event.Name, name, sizeof(name)), worker, timestamp, duration);
+        }
+    }
+
+    JobTraceWriter_Write(writer, "\n]}\n");
+    JobTraceWriter_Flush(writer);
+
+    bool succeed = !writer->Failed;
+
+    MemoryFree(writer);
+    CloseFile(file);
+    return succeed;
+}
+
+// -------------------------------------
+// ImGui timeline
+// -------------------------------------
+
+void ImGui::DumpJobTimeline(ImGuiDumpJobsFlags flags)
+{
+    static float timeRangeMs = 33.3f;
+    static bool  paused = false;
+    static JobProfileEvent events[JOB_PROFILER_EVENTS_CAPACITY];
+
+    bool render = true;
+
+    bool openWindow = (flags & ImGuiDumpJobsFlags_OpenWindow) != 0;
+    if (openWindow)
+    {
+        render = ImGui::Begin("Job Timeline");
+    }
+
+    if (render)
+    {
+        bool enabled = JobProfilerIsEnabled();
+        if (ImGui::Checkbox("Enabled", &enabled))
+        {
+            JobProfilerEnable(enabled);
+        }
+
+        ImGui::SameLine();
+        ImGui::Checkbox("Paused", &paused);
+
+        ImGui::SameLine();
+        if (ImGui::Button("Clear"))
+        {
+            JobProfilerClear();
+        }
+
+        ImGui::SameLine();
+        if (ImGui::Button("Export"))
+        {
+            JobProfilerExport("JobTrace.json");
+        }
+
+        ImGui::SliderFloat("Range (ms)", &timeRangeMs, 1.0f, 200.0f, "%.1f");
+
+        static U64 endTicks;
+        if (!paused || endTicks == 0)
+        {
+            endTicks = JobProfilerTimestamp();
+        }
+
+        const float rowHeight = 20.0f;
+        const I32 workerCount = RingCount.load(std::memory_order_acquire);
+
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImVec2 size = ImVec2(ImGui::GetContentRegionAvail().x, rowHeight * (workerCount > 0 ? workerCount : 1));
+        ImGui::Dummy(size);
+
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+        drawList->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(30, 30, 30, 255));
+
+        const float labelWidth = 72.0f;
+        const float timelineWidth = size.x - labelWidth;
+        const double rangeUs = (double)timeRangeMs * 1000.0;
+
+        for (I32 worker = 0; worker < workerCount; worker++)
+        {
+            float rowTop = origin.y + worker * rowHeight;
+
+            char label[32];
+            snprintf(label, sizeof(label), worker == 0 ? "Main" : "Worker %d", worker);
+            drawList->AddText(ImVec2(origin.x + 4.0f, rowTop + 3.0f), IM_COL32(200, 200, 200, 255), label);
+
+            I32 count = JobProfiler_CollectWorker(worker, events);
+            for (I32 i = 0; i < count; i++)
+            {
+                JobProfileEvent event = events[i];
+                if (event.End > endTicks)
+                {
+                    continue;
+                }
+
+                double startUs = rangeUs - JobProfilerTicksToMicroseconds(endTicks - event.Start);
+                double endUs = rangeUs - JobProfilerTicksToMicroseconds(endTicks - event.End);
+                if (endUs < 0.0)
+                {
+                    continue;
+                }
+
+                float x0 = origin.x + labelWidth + (float)(startUs / rangeUs) * timelineWidth;
+                float x1 = origin.x + labelWidth + (float)(endUs / rangeUs) * timelineWidth;
+                if (x0 < origin.x + labelWidth) x0 = origin.x + labelWidth;
+                if (x1 < x0 + 1.0f) x1 = x0 + 1.0f;
+
+                ImVec2 min = ImVec2(x0, rowTop + 1.0f);
+                ImVec2 max = ImVec2(x1, rowTop + rowHeight - 1.0f);
+
+                float hue = (CalcHashPtr32((void*)event.Name) & 0xff) / 255.0f;
+                float r, g, b;
+                ImGui::ColorConvertHSVtoRGB(hue, 0.6f, 0.8f, r, g, b);
+                drawList->AddRectFilled(min, max, ImGui::GetColorU32(ImVec4(r, g, b, 1.0f)));
+
+                if (ImGui::IsMouseHoveringRect(min, max))
+                {
+                    ImGui::SetTooltip("%s\nWorker: %d\nDuration: %.3fus",
+                        event.Name ? event.Name : "Job", worker, endUs - startUs);
+                }
+            }
+        }
+    }
+
+    if (openWindow)
+    {
+        ImGui::End();
+    }
+}
+
+// END OF #if JOB_PROFILER
+#else
+void ImGui::DumpJobTimeline(ImGuiDumpJobsFlags flags)
+{
+    bool render = true;
+
+    bool openWindow = (flags & ImGuiDumpJobsFlags_OpenWindow) != 0;
+    if (openWindow)
+    {
+        render = ImGui::Begin("Job Timeline");
+    }
+
+    if (render)
+    {
+        ImGui::Text("Job profiler is compiled out, build with JOB_PROFILER=1!");
+    }
+
+    if (openWindow)
+    {
+        ImGui::End();
+    }
+}
+#endif
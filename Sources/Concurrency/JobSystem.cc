@@ -1,36 +1,635 @@
-#include <Yolo/Job.h>
-#include <Yolo/Array.h>
+#include <Concurrency/Sync.h>
+#include <Concurrency/JobSystem.h>
+#include <Concurrency/JobProfiler.h>
 
-namespace JobOps
+#include <chrono>
+#include <thread>
+
+// A lower priority queue passed over this many times in a row is picked next
+constexpr I32 JOB_STARVATION_LIMIT  = 8;
+
+// Number of batches StartJobs can have in flight
+constexpr I32 JOB_BATCH_CAPACITY    = 64;
+
+/// JobQueue
+/// Fixed capacity ring, guarded by JobSystem.Lock.
+/// No allocation so jobs can be started from any thread.
+/// Count can be read without the lock as a hint.
+struct JobQueue
+{
+    I32                 Head;
+    std::atomic<I32>    Count;
+    Job                 Items[JOB_QUEUE_CAPACITY];
+};
+
+/// JobBatch
+/// One StartJobs call, workers claim sub-ranges of it.
+/// Claim hold the batch position in the high bits and the next job index in the low bits,
+/// so a worker holding a stale position can never claim jobs of the batch reusing the slot.
+struct alignas(64) JobBatch
+{
+    std::atomic<U32>        Sequence;
+    std::atomic<const Job*> Jobs;
+    std::atomic<I32>        Count;
+    std::atomic<I32>        GrainSize;
+    std::atomic<U64>        Claim;
+    std::atomic<I32>        Finished;
+};
+
+/// JobRange
+/// Jobs claimed from a batch
+struct JobRange
+{
+    JobBatch*   Batch;
+    U32         Position;
+    const Job*  Jobs;
+    I32         Count;
+    I32         BatchCount;
+};
+
+/// JobInjectionQueue
+/// Bounded lock-free MPMC queue of batches (sequence numbered slots).
+/// Publishing a batch take a single CAS on Tail, consumers only touch Head when a batch is fully claimed.
+static struct
+{
+    alignas(64) std::atomic<U32>    Head;
+    alignas(64) std::atomic<U32>    Tail;
+
+    JobBatch                        Batches[JOB_BATCH_CAPACITY];
+} JobInjection;
+
+static struct
 {
-    Array<Job> jobs;
+    Mutex                   Lock;
+    Semaphore               WorkSignal;
+    std::atomic<I32>        SleepingWorkers;
+
+    JobQueue                Queues[(I32)JobPriority::Count];
+    JobQueue                MainThreadQueue;
+
+    I32                     NormalSkips;
+    I32                     BackgroundSkips;
+    std::atomic<I32>        RunningBackground;
+
+    std::atomic<I32>        PendingJobs;
+
+    std::atomic<bool>       Quit;
+    I32                     WorkerCount;
+    std::thread             Workers[JOB_SYSTEM_MAX_WORKERS];
+} JobSystem;
 
-    void Start(Job job)
+static thread_local I32 WorkerIndex = 0;
+
+// ----------------------------------------
+// Queue functions
+// ----------------------------------------
+
+static bool JobQueuePush(JobQueue* queue, Job job)
+{
+    if (queue->Count == JOB_QUEUE_CAPACITY)
     {
-        ArrayPush(&jobs, job);
+        return false;
     }
 
-    void Start(void* data, void (*execute)(void* data))
+    queue->Items[(queue->Head + queue->Count) % JOB_QUEUE_CAPACITY] = job;
+    queue->Count++;
+    return true;
+}
+
+static Job JobQueuePop(JobQueue* queue)
+{
+    Job job = queue->Items[queue->Head];
+    queue->Head = (queue->Head + 1) % JOB_QUEUE_CAPACITY;
+    queue->Count--;
+    return job;
+}
+
+static void ExecuteJob(Job job)
+{
+    U64 start = JobProfilerBegin();
+    job.Execute(job.Data);
+    JobProfilerEnd(WorkerIndex, job.Name, start);
+}
+
+// ----------------------------------------
+// Injection queue functions
+// ----------------------------------------
+
+static void JobInjectionInit(void)
+{
+    // Function-local static initialization is thread-safe
+    static const bool initialized = []{
+        for (I32 i = 0; i < JOB_BATCH_CAPACITY; i++)
+        {
+            JobInjection.Batches[i].Sequence.store((U32)i, std::memory_order_relaxed);
+        }
+        return true;
+    }();
+    (void)initialized;
+}
+
+static bool JobInjectionPush(const Job* jobs, I32 count, I32 grainSize)
+{
+    JobBatch* batch;
+    U32 position = JobInjection.Tail.load(std::memory_order_relaxed);
+    while (true)
     {
-        Start(Job{ data, execute });
+        batch = &JobInjection.Batches[position % JOB_BATCH_CAPACITY];
+
+        U32 sequence = batch->Sequence.load(std::memory_order_acquire);
+        I32 diff = (I32)(sequence - position);
+        if (diff == 0)
+        {
+            if (JobInjection.Tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // Full, the slot is still used by a batch one lap behind
+            return false;
+        }
+        else
+        {
+            position = JobInjection.Tail.load(std::memory_order_relaxed);
+        }
     }
 
-    void UpdateJobs(void)
+    batch->Jobs.store(jobs, std::memory_order_relaxed);
+    batch->Count.store(count, std::memory_order_relaxed);
+    batch->GrainSize.store(grainSize, std::memory_order_relaxed);
+    batch->Finished.store(0, std::memory_order_relaxed);
+    batch->Claim.store((U64)position << 32, std::memory_order_relaxed);
+    batch->Sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+static bool JobInjectionHasWork(void)
+{
+    return JobInjection.Head.load(std::memory_order_acquire) != JobInjection.Tail.load(std::memory_order_acquire);
+}
+
+static bool JobInjectionClaim(JobRange* range)
+{
+    U32 position = JobInjection.Head.load(std::memory_order_acquire);
+    while (true)
     {
-        int n = jobs.Count;
-        for (int i = 0; i < n; i++)
+        JobBatch* batch = &JobInjection.Batches[position % JOB_BATCH_CAPACITY];
+
+        U32 sequence = batch->Sequence.load(std::memory_order_acquire);
+        I32 diff = (I32)(sequence - (position + 1));
+        if (diff < 0)
         {
-            Job job = jobs.Items[i];
-            job.Execute(job.Data);
+            // Empty, or the batch is not published yet
+            return false;
         }
 
-        if (n == jobs.Count)
+        if (diff == 0)
         {
-            ArrayClear(&jobs);
+            const Job*  jobs        = batch->Jobs.load(std::memory_order_relaxed);
+            I32         count       = batch->Count.load(std::memory_order_relaxed);
+            I32         grainSize   = batch->GrainSize.load(std::memory_order_relaxed);
+
+            U64 claim = batch->Claim.load(std::memory_order_relaxed);
+            while ((U32)(claim >> 32) == position && (I32)(U32)claim < count)
+            {
+                I32 start   = (I32)(U32)claim;
+                I32 end     = start + grainSize < count ? start + grainSize : count;
+                if (batch->Claim.compare_exchange_weak(claim, ((U64)position << 32) | (U32)end, std::memory_order_acq_rel))
+                {
+                    range->Batch        = batch;
+                    range->Position     = position;
+                    range->Jobs         = jobs + start;
+                    range->Count        = end - start;
+                    range->BatchCount   = count;
+                    return true;
+                }
+            }
         }
-        else
+
+        // Batch fully claimed (or already finished), move the head past it
+        if (JobInjection.Head.compare_exchange_strong(position, position + 1, std::memory_order_acq_rel))
         {
-            ArrayErase(&jobs, 0, n);
+            position = position + 1;
         }
     }
 }
+
+static void JobInjectionFinish(const JobRange* range)
+{
+    JobBatch* batch = range->Batch;
+    if (batch->Finished.fetch_add(range->Count, std::memory_order_acq_rel) + range->Count == range->BatchCount)
+    {
+        // Last range of the batch, release the slot for the next lap
+        batch->Sequence.store(range->Position + JOB_BATCH_CAPACITY, std::memory_order_release);
+    }
+}
+
+// Claim and run one range of injected jobs
+static bool RunInjectedJobs(void)
+{
+    JobRange range;
+    if (!JobInjectionClaim(&range))
+    {
+        return false;
+    }
+
+    for (I32 i = 0; i < range.Count; i++)
+    {
+        ExecuteJob(range.Jobs[i]);
+    }
+
+    JobInjectionFinish(&range);
+    JobSystem.PendingJobs.fetch_sub(range.Count, std::memory_order_acq_rel);
+    return true;
+}
+
+// High priority jobs go before injected batches
+static bool ShouldRunInjectedJobs(void)
+{
+    return JobSystem.Queues[(I32)JobPriority::High].Count.load(std::memory_order_relaxed) == 0;
+}
+
+// ----------------------------------------
+// Scheduling, must hold JobSystem.Lock
+// (HasRunnableJob can also be called without the lock as a hint)
+// ----------------------------------------
+
+// Keep one worker free of background jobs so they never delay frame-critical work
+static bool CanRunBackgroundJob(void)
+{
+    if (JobSystem.Quit || JobSystem.WorkerCount <= 1)
+    {
+        return true;
+    }
+
+    return JobSystem.RunningBackground < JobSystem.WorkerCount - 1;
+}
+
+static bool HasRunnableJob(bool allowBackground)
+{
+    return JobSystem.Queues[(I32)JobPriority::High].Count > 0
+        || JobSystem.Queues[(I32)JobPriority::Normal].Count > 0
+        || (allowBackground && JobSystem.Queues[(I32)JobPriority::Background].Count > 0 && CanRunBackgroundJob());
+}
+
+static bool PopJob(bool allowBackground, Job* outJob, JobPriority* outPriority)
+{
+    JobQueue* highQueue         = &JobSystem.Queues[(I32)JobPriority::High];
+    JobQueue* normalQueue       = &JobSystem.Queues[(I32)JobPriority::Normal];
+    JobQueue* backgroundQueue   = &JobSystem.Queues[(I32)JobPriority::Background];
+
+    bool normalReady            = normalQueue->Count > 0;
+    bool backgroundReady        = allowBackground && backgroundQueue->Count > 0 && CanRunBackgroundJob();
+
+    JobPriority priority;
+    if (backgroundReady && JobSystem.BackgroundSkips >= JOB_STARVATION_LIMIT)
+    {
+        priority = JobPriority::Background;
+    }
+    else if (normalReady && JobSystem.NormalSkips >= JOB_STARVATION_LIMIT)
+    {
+        priority = JobPriority::Normal;
+    }
+    else if (highQueue->Count > 0)
+    {
+        priority = JobPriority::High;
+    }
+    else if (normalReady)
+    {
+        priority = JobPriority::Normal;
+    }
+    else if (backgroundReady)
+    {
+        priority = JobPriority::Background;
+    }
+    else
+    {
+        return false;
+    }
+
+    JobSystem.NormalSkips       = (priority == JobPriority::Normal) ? 0 : JobSystem.NormalSkips + normalReady;
+    JobSystem.BackgroundSkips   = (priority == JobPriority::Background) ? 0 : JobSystem.BackgroundSkips + backgroundReady;
+
+    *outJob = JobQueuePop(&JobSystem.Queues[(I32)priority]);
+    *outPriority = priority;
+    return true;
+}
+
+// ----------------------------------------
+// Workers
+// ----------------------------------------
+
+// Wake sleeping workers, only enter the kernel when some are sleeping
+static void WakeWorkers(I32 count)
+{
+    // Pairs with the fence in WorkerMain: queued work must be visible before reading SleepingWorkers
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    I32 sleeping = JobSystem.SleepingWorkers.load();
+    if (sleeping > 0)
+    {
+        SemaphoreSignal(&JobSystem.WorkSignal, (U32)(count < sleeping ? count : sleeping));
+    }
+}
+
+static void WorkerMain(I32 workerIndex)
+{
+    WorkerIndex = workerIndex;
+
+    while (true)
+    {
+        if (ShouldRunInjectedJobs() && RunInjectedJobs())
+        {
+            continue;
+        }
+
+        Job job;
+        JobPriority priority;
+
+        MutexLock(&JobSystem.Lock);
+        bool popped = PopJob(true, &job, &priority);
+        if (popped && priority == JobPriority::Background)
+        {
+            JobSystem.RunningBackground++;
+        }
+        MutexUnlock(&JobSystem.Lock);
+
+        if (popped)
+        {
+            ExecuteJob(job);
+            JobSystem.PendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+
+            if (priority == JobPriority::Background)
+            {
+                // A background job may have been waiting for this slot
+                JobSystem.RunningBackground--;
+                WakeWorkers(1);
+            }
+            continue;
+        }
+
+        if (JobInjectionHasWork())
+        {
+            continue;
+        }
+
+        if (JobSystem.Quit)
+        {
+            // All queues are empty
+            break;
+        }
+
+        // Announce we are going to sleep before the last check,
+        // so a producer either see us sleeping or we see its job
+        JobSystem.SleepingWorkers.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!JobSystem.Quit && !HasRunnableJob(true) && !JobInjectionHasWork())
+        {
+            SemaphoreWait(&JobSystem.WorkSignal);
+        }
+        JobSystem.SleepingWorkers.fetch_sub(1);
+    }
+}
+
+bool InitJobSystem(I32 workerCount)
+{
+    if (JobSystem.WorkerCount > 0)
+    {
+        return false;
+    }
+
+    if (workerCount < 0)
+    {
+        workerCount = (I32)std::thread::hardware_concurrency() - 1;
+    }
+
+    if (workerCount > JOB_SYSTEM_MAX_WORKERS)
+    {
+        workerCount = JOB_SYSTEM_MAX_WORKERS;
+    }
+
+    if (workerCount > JOB_PROFILER_MAX_WORKERS - 1)
+    {
+        workerCount = JOB_PROFILER_MAX_WORKERS - 1;
+    }
+
+    JobInjectionInit();
+
+    JobSystem.Quit = false;
+    JobSystem.NormalSkips = 0;
+    JobSystem.BackgroundSkips = 0;
+    JobSystem.RunningBackground = 0;
+    JobSystem.SleepingWorkers = 0;
+    JobSystem.WorkSignal.Count = 0;
+    JobSystem.WorkerCount = workerCount;
+
+    for (I32 i = 0; i < workerCount; i++)
+    {
+        JobSystem.Workers[i] = std::thread(WorkerMain, i + 1);
+    }
+
+    return true;
+}
+
+void ShutdownJobSystem(void)
+{
+    JobSystem.Quit = true;
+    SemaphoreSignal(&JobSystem.WorkSignal, (U32)JobSystem.WorkerCount);
+
+    for (I32 i = 0; i < JobSystem.WorkerCount; i++)
+    {
+        JobSystem.Workers[i].join();
+    }
+
+    JobSystem.WorkerCount = 0;
+    JobSystem.Quit = false;
+
+    // Without workers, remaining jobs run here
+    UpdateJobs();
+    while (UpdateMainThreadJobs(0.0f) > 0)
+    {
+    }
+}
+
+I32 GetJobWorkerCount(void)
+{
+    return JobSystem.WorkerCount;
+}
+
+I32 GetJobWorkerIndex(void)
+{
+    return WorkerIndex;
+}
+
+// ----------------------------------------
+// Main functions
+// ----------------------------------------
+
+void StartJob(Job job, JobPriority priority)
+{
+    MutexLock(&JobSystem.Lock);
+    bool queued = JobQueuePush(&JobSystem.Queues[(I32)priority], job);
+    if (queued)
+    {
+        JobSystem.PendingJobs.fetch_add(1, std::memory_order_relaxed);
+    }
+    MutexUnlock(&JobSystem.Lock);
+
+    if (queued)
+    {
+        WakeWorkers(1);
+    }
+    else
+    {
+        ExecuteJob(job);
+    }
+}
+
+void StartJob(void* data, void (*execute)(void* data), const char* name, JobPriority priority)
+{
+    StartJob(Job{ data, execute, name }, priority);
+}
+
+void StartJobs(const Job* jobs, I32 count)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    JobInjectionInit();
+
+    // Around 4 ranges per thread, so faster workers can steal the rest
+    I32 grainSize = count / ((JobSystem.WorkerCount + 1) * 4);
+    grainSize = grainSize > 1 ? grainSize : 1;
+
+    JobSystem.PendingJobs.fetch_add(count, std::memory_order_relaxed);
+    while (!JobInjectionPush(jobs, count, grainSize))
+    {
+        // All batch slots are in flight, help until one is released
+        if (!RunInjectedJobs())
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    WakeWorkers(JobSystem.WorkerCount);
+}
+
+// Pop one job from the queues and run it on the calling thread
+static bool RunQueuedJob(bool allowBackground)
+{
+    Job job;
+    JobPriority priority;
+
+    MutexLock(&JobSystem.Lock);
+    bool popped = PopJob(allowBackground, &job, &priority);
+    MutexUnlock(&JobSystem.Lock);
+
+    if (!popped)
+    {
+        return false;
+    }
+
+    ExecuteJob(job);
+    JobSystem.PendingJobs.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void UpdateJobs(void)
+{
+    // Main thread only help with frame work when workers handle the background queue
+    bool allowBackground = JobSystem.WorkerCount == 0;
+
+    while ((ShouldRunInjectedJobs() && RunInjectedJobs()) || RunQueuedJob(allowBackground))
+    {
+    }
+}
+
+void WaitForJobs(void)
+{
+    while (JobSystem.PendingJobs.load(std::memory_order_acquire) > 0)
+    {
+        if (!RunInjectedJobs() && !RunQueuedJob(true))
+        {
+            // Remaining jobs are running on workers
+            std::this_thread::yield();
+        }
+    }
+}
+
+void WaitForJobs(const std::atomic<I32>* counter)
+{
+    bool allowBackground = JobSystem.WorkerCount == 0;
+    while (counter->load(std::memory_order_acquire) > 0)
+    {
+        if (!(ShouldRunInjectedJobs() && RunInjectedJobs()) && !RunQueuedJob(allowBackground))
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// ----------------------------------------
+// Main thread jobs
+// ----------------------------------------
+
+void StartMainThreadJob(Job job)
+{
+    MutexLock(&JobSystem.Lock);
+    while (!JobQueuePush(&JobSystem.MainThreadQueue, job))
+    {
+        MutexUnlock(&JobSystem.Lock);
+
+        if (WorkerIndex == 0)
+        {
+            // Queue is full and we already are on the main thread
+            ExecuteJob(job);
+            return;
+        }
+
+        // Rare, wait for the main thread to drain its queue
+        ThreadYield();
+        MutexLock(&JobSystem.Lock);
+    }
+    MutexUnlock(&JobSystem.Lock);
+}
+
+void StartMainThreadJob(void* data, void (*execute)(void* data), const char* name)
+{
+    StartMainThreadJob(Job{ data, execute, name });
+}
+
+I32 UpdateMainThreadJobs(float timeBudget)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point start = Clock::now();
+    I32 executed = 0;
+
+    while (JobSystem.MainThreadQueue.Count > 0)
+    {
+        MutexLock(&JobSystem.Lock);
+        bool popped = JobSystem.MainThreadQueue.Count > 0;
+        Job job = popped ? JobQueuePop(&JobSystem.MainThreadQueue) : Job{};
+        MutexUnlock(&JobSystem.Lock);
+
+        if (!popped)
+        {
+            break;
+        }
+
+        ExecuteJob(job);
+        executed++;
+
+        float elapsed = std::chrono::duration<float>(Clock::now() - start).count();
+        if (elapsed >= timeBudget)
+        {
+            break;
+        }
+    }
+
+    return executed;
+}
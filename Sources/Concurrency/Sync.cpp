@@ -0,0 +1,345 @@
+#include <Concurrency/Sync.h>
+
+#include <thread>
+
+#if defined(_WIN32)
+#   define WIN32_LEAN_AND_MEAN
+#   include <Windows.h>
+#   pragma comment(lib, "Synchronization.lib")
+#elif defined(__linux__)
+#   include <unistd.h>
+#   include <sys/syscall.h>
+#   include <linux/futex.h>
+#endif
+
+// Number of pause before an adaptive lock go to sleep
+constexpr I32 MUTEX_SPIN_COUNT      = 128;
+
+// Backoff double the number of pause until this limit, then yield the thread
+constexpr I32 SPIN_BACKOFF_LIMIT    = 64;
+
+// ----------------------------------------
+// Thread helpers
+// ----------------------------------------
+
+void ThreadYield(void)
+{
+    std::this_thread::yield();
+}
+
+void FutexWait(std::atomic<U32>* address, U32 expected)
+{
+#if defined(_WIN32)
+    WaitOnAddress((volatile VOID*)address, &expected, sizeof(U32), INFINITE);
+#elif defined(__linux__)
+    syscall(SYS_futex, (U32*)address, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    if (address->load(std::memory_order_relaxed) == expected)
+    {
+        ThreadYield();
+    }
+#endif
+}
+
+void FutexWakeOne(std::atomic<U32>* address)
+{
+#if defined(_WIN32)
+    WakeByAddressSingle((PVOID)address);
+#elif defined(__linux__)
+    syscall(SYS_futex, (U32*)address, FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+    (void)address;
+#endif
+}
+
+void FutexWakeAll(std::atomic<U32>* address)
+{
+#if defined(_WIN32)
+    WakeByAddressAll((PVOID)address);
+#elif defined(__linux__)
+    syscall(SYS_futex, (U32*)address, FUTEX_WAKE_PRIVATE, 0x7FFFFFFF, nullptr, nullptr, 0);
+#else
+    (void)address;
+#endif
+}
+
+static void SpinBackoff(I32* backoff)
+{
+    if (*backoff <= SPIN_BACKOFF_LIMIT)
+    {
+        for (I32 i = 0; i < *backoff; i++)
+        {
+            CpuPause();
+        }
+        *backoff *= 2;
+    }
+    else
+    {
+        // Lock holder may have been preempted, give it the cpu
+        ThreadYield();
+    }
+}
+
+// ----------------------------------------
+// SpinLock
+// ----------------------------------------
+
+void SpinLockAcquireSlow(SpinLock* lock)
+{
+    I32 backoff = 1;
+    do
+    {
+        // Spin on a plain load, so the cache line stays shared until the lock is released
+        while (lock->Locked.load(std::memory_order_relaxed) != 0)
+        {
+            SpinBackoff(&backoff);
+        }
+    } while (lock->Locked.exchange(1, std::memory_order_acquire) != 0);
+}
+
+// ----------------------------------------
+// TicketLock
+// ----------------------------------------
+
+void TicketLockAcquire(TicketLock* lock)
+{
+    U32 ticket = lock->Next.fetch_add(1, std::memory_order_relaxed);
+
+    I32 spins = 0;
+    while (true)
+    {
+        U32 serving = lock->Serving.load(std::memory_order_acquire);
+        if (serving == ticket)
+        {
+            return;
+        }
+
+        // Proportional backoff: wait longer when more threads are ahead of us,
+        // then yield in case the owner (or the next in line) was preempted
+        if (spins < MUTEX_SPIN_COUNT)
+        {
+            U32 ahead = ticket - serving;
+            for (U32 i = 0; i < ahead; i++)
+            {
+                CpuPause();
+            }
+            spins++;
+        }
+        else
+        {
+            ThreadYield();
+        }
+    }
+}
+
+bool TicketLockTryAcquire(TicketLock* lock)
+{
+    U32 serving = lock->Serving.load(std::memory_order_acquire);
+    U32 ticket = serving;
+    return lock->Next.compare_exchange_strong(ticket, serving + 1, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+// ----------------------------------------
+// Mutex
+// ----------------------------------------
+
+void MutexLockSlow(Mutex* mutex)
+{
+    for (I32 i = 0; i < MUTEX_SPIN_COUNT; i++)
+    {
+        if (mutex->State.load(std::memory_order_relaxed) == 0 && MutexTryLock(mutex))
+        {
+            return;
+        }
+
+        CpuPause();
+    }
+
+    // Mark the mutex as contended, so the owner wake us on unlock
+    U32 state = mutex->State.exchange(2, std::memory_order_acquire);
+    while (state != 0)
+    {
+        FutexWait(&mutex->State, 2);
+        state = mutex->State.exchange(2, std::memory_order_acquire);
+    }
+}
+
+// ----------------------------------------
+// RWLock
+// ----------------------------------------
+
+// Sleep until the next release, generation must be read before the state that made us wait:
+// a release in between changes it, so the wait returns at once instead of missing the wake
+static void RWLockSleep(RWLock* lock, U32 generation)
+{
+    lock->Sleepers.fetch_add(1);
+    FutexWait(&lock->Generation, generation);
+    lock->Sleepers.fetch_sub(1);
+}
+
+static void RWLockWakeSleepers(RWLock* lock)
+{
+    lock->Generation.fetch_add(1);
+    if (lock->Sleepers.load() > 0)
+    {
+        FutexWakeAll(&lock->Generation);
+    }
+}
+
+void RWLockReadLock(RWLock* lock)
+{
+    I32 spins = 0;
+    while (true)
+    {
+        U32 generation = lock->Generation.load();
+        U32 state = lock->State.load(std::memory_order_relaxed);
+        if (state != RWLOCK_WRITER && lock->WaitingWriters.load() == 0)
+        {
+            if (lock->State.compare_exchange_weak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                return;
+            }
+            continue;
+        }
+
+        if (spins < MUTEX_SPIN_COUNT)
+        {
+            CpuPause();
+            spins++;
+        }
+        else
+        {
+            RWLockSleep(lock, generation);
+        }
+    }
+}
+
+void RWLockReadUnlock(RWLock* lock)
+{
+    if (lock->State.fetch_sub(1, std::memory_order_release) == 1)
+    {
+        RWLockWakeSleepers(lock);
+    }
+}
+
+void RWLockWriteLock(RWLock* lock)
+{
+    // Stop new readers from coming in
+    lock->WaitingWriters.fetch_add(1);
+
+    I32 spins = 0;
+    while (true)
+    {
+        U32 generation = lock->Generation.load();
+        U32 state = 0;
+        if (lock->State.compare_exchange_weak(state, RWLOCK_WRITER, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            break;
+        }
+
+        if (spins < MUTEX_SPIN_COUNT)
+        {
+            CpuPause();
+            spins++;
+        }
+        else
+        {
+            RWLockSleep(lock, generation);
+        }
+    }
+
+    // Readers that saw us waiting go back to check the state
+    lock->WaitingWriters.fetch_sub(1);
+    RWLockWakeSleepers(lock);
+}
+
+void RWLockWriteUnlock(RWLock* lock)
+{
+    lock->State.store(0);
+    RWLockWakeSleepers(lock);
+}
+
+// ----------------------------------------
+// Event
+// ----------------------------------------
+
+void EventSignal(Event* event)
+{
+    event->Signaled.store(1, std::memory_order_release);
+    FutexWakeAll(&event->Signaled);
+}
+
+void EventWait(Event* event)
+{
+    for (I32 i = 0; i < MUTEX_SPIN_COUNT && !EventIsSignaled(event); i++)
+    {
+        CpuPause();
+    }
+
+    while (!EventIsSignaled(event))
+    {
+        FutexWait(&event->Signaled, 0);
+    }
+}
+
+void EventReset(Event* event)
+{
+    event->Signaled.store(0, std::memory_order_release);
+}
+
+// ----------------------------------------
+// Semaphore
+// ----------------------------------------
+
+void SemaphoreSignal(Semaphore* semaphore, U32 count)
+{
+    semaphore->Count.fetch_add(count);
+    if (semaphore->Waiters.load() > 0)
+    {
+        if (count == 1)
+        {
+            FutexWakeOne(&semaphore->Count);
+        }
+        else
+        {
+            FutexWakeAll(&semaphore->Count);
+        }
+    }
+}
+
+bool SemaphoreTryWait(Semaphore* semaphore)
+{
+    U32 count = semaphore->Count.load(std::memory_order_relaxed);
+    while (count > 0)
+    {
+        if (semaphore->Count.compare_exchange_weak(count, count - 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void SemaphoreWait(Semaphore* semaphore)
+{
+    for (I32 i = 0; i < MUTEX_SPIN_COUNT; i++)
+    {
+        if (SemaphoreTryWait(semaphore))
+        {
+            return;
+        }
+
+        CpuPause();
+    }
+
+    while (!SemaphoreTryWait(semaphore))
+    {
+        semaphore->Waiters.fetch_add(1);
+        if (semaphore->Count.load() == 0)
+        {
+            FutexWait(&semaphore->Count, 0);
+        }
+        semaphore->Waiters.fetch_sub(1);
+    }
+}
@@ -4,6 +4,7 @@
 
 #include <Math/Math.h>
 #include <Text/String.h>
+#include <Text/Utf8.h>
 #include <Container/Array.h>
 
 DrawTextBuffer DrawTextBuffer::New()
@@ -108,12 +109,13 @@ void DrawTextBuffer::AddText(DrawTextBuffer* drawTextBuffer, const char* text, F
         float advanceX = 0;
         float advanceY = 0;
 
-        for (I32 i = 0; i < length; i++)
+        // Glyphs are baked for the first code points, indexed by code point
+        for (I32 i = 0, sequenceLength = 0; i < length; i += sequenceLength)
         {
             drawTextBuffer->shouldUpdate = true;
 
-            I32 c = text[i];
-            if (c > 0 && c < font.Glyphs.Count)
+            const U32 c = Utf8Decode(text + i, length - i, &sequenceLength);
+            if (c > 0 && c < (U32)font.Glyphs.Count)
             {
                 FontGlyph glyph = font.Glyphs.Items[c];
 
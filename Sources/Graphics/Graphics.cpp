@@ -7,6 +7,7 @@
 #include "./DrawBuffer.h"
 #include "./DrawTextBuffer.h"
 #include "./DrawSpriteBuffer.h"
+#include "./RenderSnapshot.h"
 
 #include <GL/glew.h>
 #include <SDL2/SDL.h>
@@ -29,6 +30,12 @@ namespace Graphics
     static DrawTextBuffer   drawTextBuffer;
     static DrawSpriteBuffer drawSpriteBuffer;
 
+    // Pipelined frame loop: sprites of frame N+1 are recorded into one snapshot
+    // while the vertices of frame N are built on workers from the other one
+    static bool             framePipelining;
+    static I32              renderWriteIndex;
+    static RenderSnapshot   renderSnapshots[2];
+
     constexpr StringView vshaderSource =
         "#version 330 core\n"
 
@@ -155,6 +162,10 @@ namespace Graphics
         drawBuffer = DrawBufferNew();
         drawTextBuffer = DrawTextBuffer::New();
         drawSpriteBuffer = DrawSpriteBufferOps::New();
+
+        RenderSnapshotNew(&renderSnapshots[0]);
+        RenderSnapshotNew(&renderSnapshots[1]);
+        renderWriteIndex = 0;
     }
 
     void Clear(void)
@@ -240,6 +251,42 @@ namespace Graphics
         lineWidth = width;
     }
 
+    bool IsFramePipelining(void)
+    {
+        return framePipelining;
+    }
+
+    void SetFramePipelining(bool enable)
+    {
+        if (framePipelining == enable)
+        {
+            return;
+        }
+
+        // Drop in-flight frames, they were recorded for the other mode
+        for (I32 i = 0; i < 2; i++)
+        {
+            RenderSnapshotWaitBuild(&renderSnapshots[i]);
+            RenderSnapshotClear(&renderSnapshots[i]);
+        }
+
+        framePipelining = enable;
+    }
+
+    void PresentRenderSnapshot(void)
+    {
+        // Frame N: built by workers while the simulation recorded frame N+1
+        RenderSnapshot* built = &renderSnapshots[1 - renderWriteIndex];
+        RenderSnapshotWaitBuild(built);
+        DrawSpriteBufferOps::Draw(&built->Buffer, spriteShader, projection);
+
+        // Frame N+1: build it while the simulation record frame N+2
+        RenderSnapshotStartBuild(&renderSnapshots[renderWriteIndex]);
+
+        renderWriteIndex = 1 - renderWriteIndex;
+        RenderSnapshotClear(&renderSnapshots[renderWriteIndex]);
+    }
+
     Matrix4 GetProjection(void)
     {
         return projection;
@@ -260,7 +307,14 @@ bool BeginDrawing(void)
 
 void EndDrawing(void)
 {
-    DrawSpriteBufferOps::Draw(&Graphics::drawSpriteBuffer, Graphics::spriteShader, Graphics::projection);
+    if (Graphics::framePipelining)
+    {
+        Graphics::PresentRenderSnapshot();
+    }
+    else
+    {
+        DrawSpriteBufferOps::Draw(&Graphics::drawSpriteBuffer, Graphics::spriteShader, Graphics::projection);
+    }
 }
 
 void DrawArray(VertexArray vertexArray, Shader shader, I32 count, I32 offset)
@@ -336,7 +390,14 @@ void DrawTexture(Texture texture, Vector2 position, float rotation, Vector2 scal
     glBindVertexArray(0);
     glUseProgram(0);
 #endif
-    DrawSpriteBufferOps::AddTexture(&Graphics::drawSpriteBuffer, texture, position, rotation, scale, color, pivot);
+    if (Graphics::framePipelining)
+    {
+        RenderSnapshotAddTexture(&Graphics::renderSnapshots[Graphics::renderWriteIndex], texture, position, rotation, scale, color, pivot);
+    }
+    else
+    {
+        DrawSpriteBufferOps::AddTexture(&Graphics::drawSpriteBuffer, texture, position, rotation, scale, color, pivot);
+    }
 }
 
 #undef DrawText
@@ -379,8 +440,10 @@ void DrawFramerate(Font font, Vector2 position)
 {
     //DrawRectangle(DrawMode::Fill, position, Vector2{ 100.0f, 50.0f }, Vector4{ 0, 0, 0, 0.2f });
 
-    char buffer[1024];
-    float framerate = GetFramerate();
-    String text = StringFormat(buffer, sizeof(buffer), "FPS: %.2f", framerate);
-    DrawText(text, font, position);
+    // Short enough to stay in the builder inline buffer: no allocation nor format parsing every frame
+    StringBuilder builder = {};
+    StringBuilderAppend(&builder, "FPS: ");
+    StringBuilderAppendFixed(&builder, GetFramerate(), 2);
+    DrawText(StringBuilderToString(&builder), font, position);
+    FreeStringBuilder(&builder);
 }
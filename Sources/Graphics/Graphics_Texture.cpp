@@ -53,13 +53,14 @@ Texture LoadTexture(StringView path)
         return {};
     }
 
-    U64 textureHash = CalcHash64(fullPath.Buffer, fullPath.Length);
+    // Keyed by the normalized path: "Art/Player.png" and "./art\player.png" are the same texture
+    U64 textureHash = MakePathKey(fullPath).Hash;
 
-        Texture cachedTexture;
-        if (HashTableTryGetValue(LoadedTextures, textureHash, &cachedTexture))
-        {
-            return cachedTexture;
-        }
+    Texture cachedTexture;
+    if (HashTableTryGetValue(LoadedTextures, textureHash, &cachedTexture))
+    {
+        return cachedTexture;
+    }
 
     I32 width, height, channel;
     void* pixels = stbi_load(fullPath.Buffer, &width, &height, &channel, 0);
@@ -0,0 +1,166 @@
+#include "./RenderSnapshot.h"
+
+#include <Math/Math.h>
+#include <Container/Array.h>
+#include <Concurrency/JobSystem.h>
+
+void RenderSnapshotNew(RenderSnapshot* snapshot)
+{
+    assert(snapshot);
+
+    snapshot->Sprites = MakeArray<RenderSprite>();
+    snapshot->BuildJobs = MakeArray<Job>();
+    snapshot->BuildChunks = MakeArray<RenderBuildChunk>();
+    snapshot->PendingBuildJobs.store(0, std::memory_order_relaxed);
+
+    snapshot->Buffer = DrawSpriteBufferOps::New();
+}
+
+void RenderSnapshotFree(RenderSnapshot* snapshot)
+{
+    assert(snapshot);
+
+    RenderSnapshotWaitBuild(snapshot);
+
+    FreeArray(&snapshot->Sprites);
+    FreeArray(&snapshot->BuildJobs);
+    FreeArray(&snapshot->BuildChunks);
+
+    DrawSpriteBufferOps::Free(&snapshot->Buffer);
+}
+
+void RenderSnapshotClear(RenderSnapshot* snapshot)
+{
+    assert(snapshot);
+    assert(snapshot->PendingBuildJobs.load(std::memory_order_relaxed) == 0);
+
+    ArrayClear(&snapshot->Sprites);
+    DrawSpriteBufferOps::Clear(&snapshot->Buffer);
+}
+
+void RenderSnapshotAddTexture(RenderSnapshot* snapshot, Texture texture, Vector2 position, float rotation, Vector2 scale, Vector4 color, Vector2 pivot)
+{
+    assert(snapshot);
+
+    if (snapshot->Sprites.Count >= RENDER_SNAPSHOT_MAX_SPRITES)
+    {
+        DebugAssert(false, "Too many sprites in one frame, max is %d", RENDER_SNAPSHOT_MAX_SPRITES);
+        return;
+    }
+
+    RenderSprite sprite = {
+        texture.Handle,
+        Vector2{ (float)texture.Width, (float)texture.Height },
+
+        position,
+        rotation,
+        scale,
+        pivot,
+        color,
+    };
+
+    // Commands are cheap to record here, workers only write vertices and indices
+    DrawSpriteBuffer* buffer = &snapshot->Buffer;
+    if (buffer->commands.Count > 0 && buffer->commands.Items[buffer->commands.Count - 1].textureHandle == texture.Handle)
+    {
+        buffer->commands.Items[buffer->commands.Count - 1].indexCount += 6;
+    }
+    else
+    {
+        DrawSpriteBuffer::Command command = {
+            6,
+            snapshot->Sprites.Count * 6,
+            texture.Handle
+        };
+
+        ArrayPush(&buffer->commands, command);
+    }
+
+    ArrayPush(&snapshot->Sprites, sprite);
+}
+
+// ----------------------------------------
+// Build vertices on workers
+// ----------------------------------------
+
+static void RenderSnapshotBuildChunk(void* data)
+{
+    RenderBuildChunk*   chunk       = (RenderBuildChunk*)data;
+    RenderSnapshot*     snapshot    = chunk->Snapshot;
+
+    VertexColor*        vertices    = snapshot->Buffer.vertices.Items + chunk->Start * 4;
+    U16*                indices     = snapshot->Buffer.indices.Items + chunk->Start * 6;
+
+    for (I32 i = 0; i < chunk->Count; i++)
+    {
+        RenderSprite sprite = snapshot->Sprites.Items[chunk->Start + i];
+
+        Matrix4 transform = Matrix4Transform2D(sprite.Position, sprite.Rotation, sprite.Scale, sprite.Pivot * sprite.TextureSize);
+
+        float width = sprite.TextureSize.x;
+        float height = sprite.TextureSize.y;
+
+        vertices[0] = VertexColor{ mul(transform, Vector3{ 0, 0 }), Vector2{ 0.0f, 1.0f }, sprite.Color };
+        vertices[1] = VertexColor{ mul(transform, Vector3{ 0, height }), Vector2{ 0.0f, 0.0f }, sprite.Color };
+        vertices[2] = VertexColor{ mul(transform, Vector3{ width, height }), Vector2{ 1.0f, 0.0f }, sprite.Color };
+        vertices[3] = VertexColor{ mul(transform, Vector3{ width, 0 }), Vector2{ 1.0f, 1.0f }, sprite.Color };
+
+        U16 startIndex = (U16)((chunk->Start + i) * 4);
+        indices[0] = (U16)(startIndex + 0);
+        indices[1] = (U16)(startIndex + 1);
+        indices[2] = (U16)(startIndex + 2);
+        indices[3] = (U16)(startIndex + 0);
+        indices[4] = (U16)(startIndex + 2);
+        indices[5] = (U16)(startIndex + 3);
+
+        vertices += 4;
+        indices += 6;
+    }
+
+    snapshot->PendingBuildJobs.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+void RenderSnapshotStartBuild(RenderSnapshot* snapshot)
+{
+    assert(snapshot);
+
+    I32 spriteCount = snapshot->Sprites.Count;
+    I32 chunkCount = (spriteCount + RENDER_SNAPSHOT_BUILD_CHUNK - 1) / RENDER_SNAPSHOT_BUILD_CHUNK;
+    if (chunkCount == 0)
+    {
+        return;
+    }
+
+    // Allocate everything here, workers only write into the arrays
+    DrawSpriteBuffer* buffer = &snapshot->Buffer;
+    ArrayEnsure(&buffer->vertices, spriteCount * 4);
+    ArrayEnsure(&buffer->indices, spriteCount * 6);
+    buffer->vertices.Count = spriteCount * 4;
+    buffer->indices.Count = spriteCount * 6;
+    buffer->shouldUpdate = true;
+
+    ArrayEnsure(&snapshot->BuildJobs, chunkCount);
+    ArrayEnsure(&snapshot->BuildChunks, chunkCount);
+    snapshot->BuildJobs.Count = chunkCount;
+    snapshot->BuildChunks.Count = chunkCount;
+
+    for (I32 i = 0; i < chunkCount; i++)
+    {
+        I32 start = i * RENDER_SNAPSHOT_BUILD_CHUNK;
+        I32 count = spriteCount - start < RENDER_SNAPSHOT_BUILD_CHUNK ? spriteCount - start : RENDER_SNAPSHOT_BUILD_CHUNK;
+
+        RenderBuildChunk* chunk = &snapshot->BuildChunks.Items[i];
+        *chunk = RenderBuildChunk{ snapshot, start, count };
+        snapshot->BuildJobs.Items[i] = Job{ chunk, RenderSnapshotBuildChunk, "RenderSnapshotBuildChunk" };
+    }
+
+    snapshot->PendingBuildJobs.store(chunkCount, std::memory_order_release);
+    StartJobs(snapshot->BuildJobs.Items, chunkCount);
+}
+
+void RenderSnapshotWaitBuild(RenderSnapshot* snapshot)
+{
+    assert(snapshot);
+
+    WaitForJobs(&snapshot->PendingBuildJobs);
+}
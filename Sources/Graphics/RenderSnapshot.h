@@ -0,0 +1,60 @@
+#pragma once
+
+#include <atomic>
+
+#include <System/Core.h>
+#include <Graphics/Graphics.h>
+
+#include "./DrawSpriteBuffer.h"
+
+/// RenderSprite
+/// What the simulation want to draw, vertices are built later on workers
+struct RenderSprite
+{
+    Handle              TextureHandle;
+    Vector2             TextureSize;
+
+    Vector2             Position;
+    float               Rotation;
+    Vector2             Scale;
+    Vector2             Pivot;
+    Vector4             Color;
+};
+
+struct RenderSnapshot;
+
+/// RenderBuildChunk
+/// Range of sprites converted to vertices by one job
+struct RenderBuildChunk
+{
+    RenderSnapshot*     Snapshot;
+    I32                 Start;
+    I32                 Count;
+};
+
+/// RenderSnapshot
+/// One frame of render state, double-buffered by the pipelined frame loop:
+/// the simulation records frame N+1 while the vertices of frame N are built on workers.
+struct RenderSnapshot
+{
+    Array<RenderSprite>     Sprites;
+
+    Array<Job>              BuildJobs;
+    Array<RenderBuildChunk> BuildChunks;
+    std::atomic<I32>        PendingBuildJobs;
+
+    DrawSpriteBuffer        Buffer; // Built vertices, commands are recorded with the sprites
+};
+
+constexpr I32 RENDER_SNAPSHOT_MAX_SPRITES   = 65536 / 4; // U16 indices
+constexpr I32 RENDER_SNAPSHOT_BUILD_CHUNK   = 256;
+
+void RenderSnapshotNew(RenderSnapshot* snapshot);
+void RenderSnapshotFree(RenderSnapshot* snapshot);
+
+void RenderSnapshotClear(RenderSnapshot* snapshot);
+void RenderSnapshotAddTexture(RenderSnapshot* snapshot, Texture texture, Vector2 position, float rotation, Vector2 scale, Vector4 color, Vector2 pivot);
+
+// Start building the vertices on workers, must be called from the main thread
+void RenderSnapshotStartBuild(RenderSnapshot* snapshot);
+void RenderSnapshotWaitBuild(RenderSnapshot* snapshot);
@@ -2,6 +2,7 @@
 #include <System/Core.h>
 #include <System/Input.h>
 #include <Graphics/Window.h>
+#include <Concurrency/JobSystem.h>
 
 #ifdef _WIN32
 #   define VC_EXTRALEAN
@@ -65,6 +66,8 @@ static void FakeMicroSleep(U64 microseconds);
 static void UpdateTimer(void);
 static bool UpdateTimerAndSleep(void);
 
+static float GetMainThreadJobsBudget(void);
+
 // ------------------------------
 // Input internal functions
 // ------------------------------
@@ -383,6 +386,9 @@ bool UpdateWindow(void)
             break;
         }
     }
+
+    // Run jobs that need the main thread (graphics, window), within a part of the frame time
+    UpdateMainThreadJobs(GetMainThreadJobsBudget());
     
     // Start new ImGui frame
     if (!Runtime.ShouldClose)
@@ -460,6 +466,12 @@ static struct
     NtDelayExecutionFN NtDelayExecution;
 } Timer;
 
+// A quarter of the frame time limit
+float GetMainThreadJobsBudget(void)
+{
+    return (float)((double)Timer.CachedLimitTicks / (double)Timer.CachedCpuFrequency) * 0.25f;
+}
+
 void OpenTimer(int fps)
 {
     Timer.TotalFrames = 0;
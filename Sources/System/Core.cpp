@@ -1,180 +1,391 @@
-#include <time.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <System/Core.h>
 
-U32 CalcHash32(const void* buffer, I32 length, U32 seed)
-{
-    // Murmur hash: multiply (mu) and rotate (r) x2
-    constexpr U32 mul = 0xcc9e2d51;
-    constexpr U32 rot = 17; // should be prime number
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
 
-    const U8* target = (U8*)buffer;
-    const U32 l = (U32)length;
-    const U32 n = (l >> 2) << 2;
+// SSE2 is the x64 baseline, the AVX2 path is built alongside and picked at runtime
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define HASH_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define HASH_SSE2 0
+#endif
 
-    U32 h = seed ^ (l | mul);
-    for (U32 i = 0; i < n; i += 4)
-    {
-        U32 b0 = target[i + 0];
-        U32 b1 = target[i + 1];
-        U32 b2 = target[i + 2];
-        U32 b3 = target[i + 3];
-#if CPU_LITTLE_ENDIAN
-        U32 k = (b3 << 24) | (b2 << 16) | (b1 << 8) | (b0 << 0);
+#if HASH_SSE2 && (defined(_M_X64) || defined(__x86_64__))
+#   define HASH_AVX2 1
+#   include <immintrin.h>
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       define HASH_TARGET_AVX2
+#   else
+#       include <cpuid.h>
+#       define HASH_TARGET_AVX2 __attribute__((target("avx2")))
+#   endif
 #else
-        U32 k = (b0 << 24) | (b1 << 16) | (b2 << 8) | (b3 << 0);
+#   define HASH_AVX2 0
 #endif
 
-        k *= mul;
-        k ^= (k >> rot);
-        k *= mul;
+// -------------------------------------
+// System info
+// -------------------------------------
 
-        h ^= k;
-        h *= mul;
+static bool Cpu_CheckAVX2(void)
+{
+#if !HASH_AVX2
+    return false;
+#elif defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
     }
 
-    switch (l & 3)
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
     {
-    case 3: h ^= (U32)((target + n)[2]) << 16;   /* fall through */
-    case 2: h ^= (U32)((target + n)[1]) << 8;   /* fall through */
-    case 1: h ^= (U32)((target + n)[0]) << 0;   /* fall through */
-    };
+        return false;
+    }
 
-    h *= mul;
-    h ^= (h >> rot);
-    h *= mul;
-    h ^= (h >> rot);
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, nullptr) < 7)
+    {
+        return false;
+    }
 
-    return h;
+    __cpuid(1, eax, ebx, ecx, edx);
+    if ((ecx & (1u << 27)) == 0 || (ecx & (1u << 28)) == 0)
+    {
+        return false;
+    }
+
+    unsigned int xcrLow, xcrHigh;
+    __asm__("xgetbv" : "=a"(xcrLow), "=d"(xcrHigh) : "c"(0));
+    if ((xcrLow & 6) != 6)
+    {
+        return false;
+    }
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    return (ebx & (1u << 5)) != 0;
+#endif
 }
 
-U64 CalcHash64(const void* buffer, I32 length, U64 seed)
+bool CpuHasAVX2(void)
 {
-    // Murmur hash: multiply (mu) and rotate (r) x2
-    constexpr U64 mul = 0xc6a4a7935bd1e995ULL;
-    constexpr U64 rot = 47; // should be prime number
+    static const bool hasAVX2 = Cpu_CheckAVX2();
+    return hasAVX2;
+}
 
-    const U8* target = (U8*)buffer;
-    const U32 l = (U32)length;
-    const U32 n = (l >> 3) << 3;
-
-    U64 h = seed ^ (l | mul);
-    for (U32 i = 0; i < n; i += 8)
-    {
-        U64 b0 = target[i + 0];
-        U64 b1 = target[i + 1];
-        U64 b2 = target[i + 2];
-        U64 b3 = target[i + 3];
-        U64 b4 = target[i + 4];
-        U64 b5 = target[i + 5];
-        U64 b6 = target[i + 6];
-        U64 b7 = target[i + 7];
+// -------------------------------------
+// Hashing
+// -------------------------------------
+
+// Same as the constexpr helpers of Core.h, with word loads and native 128-bit multiplies
+
+static inline U64 Hash_Read64(const U8* p)
+{
+#if CPU_LITTLE_ENDIAN
+    U64 value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+#else
+    return ConstHashRead64((const char*)p);
+#endif
+}
+
+static inline U64 Hash_Read32(const U8* p)
+{
 #if CPU_LITTLE_ENDIAN
-        U64 k = (b7 << 56) | (b6 << 48) | (b5 << 40) | (b4 << 32) | (b3 << 24) | (b2 << 16) | (b1 << 8) | (b0 << 0);
+    U32 value;
+    memcpy(&value, p, sizeof(value));
+    return value;
 #else
-        U64 k = (b0 << 56) | (b1 << 48) | (b2 << 40) | (b3 << 32) | (b4 << 24) | (b5 << 16) | (b6 << 8) | (b7 << 0);
+    return ConstHashRead32((const char*)p);
 #endif
+}
 
-        k *= mul;
-        k ^= (k >> rot);
-        k *= mul;
+static inline void Hash_Mum(U64* a, U64* b)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    U64 high;
+    *a = _umul128(*a, *b, &high);
+    *b = high;
+#elif defined(__SIZEOF_INT128__)
+    const __uint128_t product = (__uint128_t)*a * *b;
+    *a = (U64)product;
+    *b = (U64)(product >> 64);
+#else
+    ConstHashMum(*a, *b);
+#endif
+}
 
-        h ^= k;
-        h *= mul;
-    }
+static inline U64 Hash_Mix(U64 a, U64 b)
+{
+    Hash_Mum(&a, &b);
+    return a ^ b;
+}
 
-    switch (l & 7)
-    {
-    case 7: h ^= (U64)((target + n)[6]) << 48;   /* fall through */
-    case 6: h ^= (U64)((target + n)[5]) << 40;   /* fall through */
-    case 5: h ^= (U64)((target + n)[4]) << 32;   /* fall through */
-    case 4: h ^= (U64)((target + n)[3]) << 24;   /* fall through */
-    case 3: h ^= (U64)((target + n)[2]) << 16;   /* fall through */
-    case 2: h ^= (U64)((target + n)[1]) <<  8;   /* fall through */
-    case 1: h ^= (U64)((target + n)[0]) <<  0;   /* fall through */
-    };
+// Seed 0 is by far the most common, skip its mixing
+constexpr U64 HASH_DEFAULT_SEED = ConstHashMix(HASH_SECRET[0], HASH_SECRET[1]);
 
-    h *= mul;
-    h ^= (h >> rot);
-    h *= mul;
-    h ^= (h >> rot);
+#if !HASH_SSE2
+static void Hash_AccumulateScalar(U64* acc, const U8* buffer, U32 length, U64 seed)
+{
+    U64 keys[8];
+    ConstHashInitLanes(acc, keys, seed);
 
-    return h;
+    const U32 stripes = (length - 1) / HASH_STRIPE_SIZE;
+    for (U32 s = 0; s <= stripes; s++)
+    {
+        const U8* stripe = s < stripes ? buffer + s * HASH_STRIPE_SIZE : buffer + length - HASH_STRIPE_SIZE;
+        for (I32 i = 0; i < 8; i++)
+        {
+            const U64 data = Hash_Read64(stripe + i * 8);
+            const U64 dataKey = data ^ keys[i];
+            acc[i] += (dataKey & 0xffffffffULL) * (dataKey >> 32);
+            acc[i ^ 1] += data;
+            keys[i] += HASH_KEY_STEP;
+        }
+
+        if (s < stripes && s % HASH_BLOCK_STRIPES == HASH_BLOCK_STRIPES - 1)
+        {
+            ConstHashScramble(acc);
+        }
+    }
 }
+#endif
 
-void DebugPrintInternal(const char* func, const char* file, int line, const char* format, ...)
+#if HASH_SSE2
+// Each register holds 2 lanes, the data is added to the neighbour lane by swapping the halves
+static void Hash_AccumulateSSE2(U64* acc, const U8* buffer, U32 length, U64 seed)
 {
-    printf("[%s:%d:%s] ", file, line, func);
+    U64 initAcc[8];
+    U64 initKeys[8];
+    ConstHashInitLanes(initAcc, initKeys, seed);
 
-    ArgList arglist;
-    ArgListBegin(arglist, format);
-    vprintf(format, arglist);
-    ArgListEnd(arglist);
+    __m128i lanes[4];
+    __m128i keys[4];
+    for (I32 i = 0; i < 4; i++)
+    {
+        lanes[i] = _mm_loadu_si128((const __m128i*)(initAcc + i * 2));
+        keys[i] = _mm_loadu_si128((const __m128i*)(initKeys + i * 2));
+    }
 
-    printf("\n");
+    const __m128i step = _mm_set_epi32((I32)(HASH_KEY_STEP >> 32), (I32)HASH_KEY_STEP, (I32)(HASH_KEY_STEP >> 32), (I32)HASH_KEY_STEP);
+    const __m128i prime = _mm_set_epi32(0, (I32)HASH_SCRAMBLE_PRIME, 0, (I32)HASH_SCRAMBLE_PRIME);
+
+    const U32 stripes = (length - 1) / HASH_STRIPE_SIZE;
+    for (U32 s = 0; s <= stripes; s++)
+    {
+        const U8* stripe = s < stripes ? buffer + s * HASH_STRIPE_SIZE : buffer + length - HASH_STRIPE_SIZE;
+        for (I32 i = 0; i < 4; i++)
+        {
+            const __m128i data = _mm_loadu_si128((const __m128i*)(stripe + i * 16));
+            const __m128i dataKey = _mm_xor_si128(data, keys[i]);
+            const __m128i product = _mm_mul_epu32(dataKey, _mm_srli_epi64(dataKey, 32));
+            lanes[i] = _mm_add_epi64(lanes[i], product);
+            lanes[i] = _mm_add_epi64(lanes[i], _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2)));
+            keys[i] = _mm_add_epi64(keys[i], step);
+        }
+
+        if (s < stripes && s % HASH_BLOCK_STRIPES == HASH_BLOCK_STRIPES - 1)
+        {
+            for (I32 i = 0; i < 4; i++)
+            {
+                __m128i value = _mm_xor_si128(lanes[i], _mm_srli_epi64(lanes[i], 47));
+                value = _mm_xor_si128(value, _mm_loadu_si128((const __m128i*)(HASH_LANE_KEYS + i * 2)));
+
+                const __m128i low = _mm_mul_epu32(value, prime);
+                const __m128i high = _mm_mul_epu32(_mm_srli_epi64(value, 32), prime);
+                lanes[i] = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+            }
+        }
+    }
+
+    for (I32 i = 0; i < 4; i++)
+    {
+        _mm_storeu_si128((__m128i*)(acc + i * 2), lanes[i]);
+    }
 }
+#endif
 
-void DebugAssertReport(const char* test, const char* func, const char* file, int line, const char* format, ...)
+#if HASH_AVX2
+HASH_TARGET_AVX2
+static void Hash_AccumulateAVX2(U64* acc, const U8* buffer, U32 length, U64 seed)
 {
-    printf("Assertion failed: %s\n", test);
-    printf("At %s:%d:%s\n\n", file, line, func);
+    U64 initAcc[8];
+    U64 initKeys[8];
+    ConstHashInitLanes(initAcc, initKeys, seed);
 
-    ArgList arglist;
-    ArgListBegin(arglist, format);
-    vprintf(format, arglist);
-    ArgListEnd(arglist);
+    __m256i lanes[2];
+    __m256i keys[2];
+    for (I32 i = 0; i < 2; i++)
+    {
+        lanes[i] = _mm256_loadu_si256((const __m256i*)(initAcc + i * 4));
+        keys[i] = _mm256_loadu_si256((const __m256i*)(initKeys + i * 4));
+    }
 
-    printf("\n");
+    const __m256i step = _mm256_set1_epi64x((long long)HASH_KEY_STEP);
+    const __m256i prime = _mm256_set1_epi64x((long long)HASH_SCRAMBLE_PRIME);
+
+    const U32 stripes = (length - 1) / HASH_STRIPE_SIZE;
+    for (U32 s = 0; s <= stripes; s++)
+    {
+        const U8* stripe = s < stripes ? buffer + s * HASH_STRIPE_SIZE : buffer + length - HASH_STRIPE_SIZE;
+        for (I32 i = 0; i < 2; i++)
+        {
+            const __m256i data = _mm256_loadu_si256((const __m256i*)(stripe + i * 32));
+            const __m256i dataKey = _mm256_xor_si256(data, keys[i]);
+            const __m256i product = _mm256_mul_epu32(dataKey, _mm256_srli_epi64(dataKey, 32));
+            lanes[i] = _mm256_add_epi64(lanes[i], product);
+            lanes[i] = _mm256_add_epi64(lanes[i], _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2)));
+            keys[i] = _mm256_add_epi64(keys[i], step);
+        }
+
+        if (s < stripes && s % HASH_BLOCK_STRIPES == HASH_BLOCK_STRIPES - 1)
+        {
+            for (I32 i = 0; i < 2; i++)
+            {
+                __m256i value = _mm256_xor_si256(lanes[i], _mm256_srli_epi64(lanes[i], 47));
+                value = _mm256_xor_si256(value, _mm256_loadu_si256((const __m256i*)(HASH_LANE_KEYS + i * 4)));
+
+                const __m256i low = _mm256_mul_epu32(value, prime);
+                const __m256i high = _mm256_mul_epu32(_mm256_srli_epi64(value, 32), prime);
+                lanes[i] = _mm256_add_epi64(low, _mm256_slli_epi64(high, 32));
+            }
+        }
+    }
+
+    for (I32 i = 0; i < 2; i++)
+    {
+        _mm256_storeu_si256((__m256i*)(acc + i * 4), lanes[i]);
+    }
+    _mm256_zeroupper();
 }
+#endif
+
+typedef void HashAccumulateFunc(U64* acc, const U8* buffer, U32 length, U64 seed);
 
-I32 RandomNextI32()
+static HashAccumulateFunc* Hash_SelectAccumulate(void)
 {
-    I32 result = (I32)time(nullptr);
+#if HASH_AVX2
+    if (CpuHasAVX2())
+    {
+        return Hash_AccumulateAVX2;
+    }
+#endif
+
+#if HASH_SSE2
+    return Hash_AccumulateSSE2;
+#else
+    return Hash_AccumulateScalar;
+#endif
+}
 
-    result ^= (result >> 13);
-    result ^= (result << 17);
-    result ^= (result >> 5);
+static U64 Hash_Long(const U8* buffer, U32 length, U64 seed)
+{
+    static HashAccumulateFunc* accumulate = Hash_SelectAccumulate();
 
-    return result;
+    U64 acc[8];
+    accumulate(acc, buffer, length, seed);
+    return ConstHashMergeLanes(acc, length, seed);
 }
 
-I64 RandomNextI64()
+U64 CalcHash64(const void* buffer, I32 length, U64 seed)
 {
-    I64 result = (I64)time(nullptr);
+    const U8* p = (const U8*)buffer;
+    const U32 l = (U32)length;
 
-    result ^= (result >> 13);
-    result ^= (result << 17);
-    result ^= (result >> 5);
-    result ^= (result >> 23);
-    result ^= (result << 37);
-    result ^= (result >> 11);
+    seed = seed ? seed ^ Hash_Mix(seed ^ HASH_SECRET[0], HASH_SECRET[1]) : HASH_DEFAULT_SEED;
+    if (l > (U32)HASH_LONG_MIN)
+    {
+        return Hash_Long(p, l, seed);
+    }
 
-    return result;
+    U64 a = 0;
+    U64 b = 0;
+    if (l <= 16)
+    {
+        if (l >= 4)
+        {
+            const U32 offset = (l >> 3) << 2;
+            a = (Hash_Read32(p) << 32) | Hash_Read32(p + offset);
+            b = (Hash_Read32(p + l - 4) << 32) | Hash_Read32(p + l - 4 - offset);
+        }
+        else if (l > 0)
+        {
+            a = ((U64)p[0] << 16) | ((U64)p[l >> 1] << 8) | (U64)p[l - 1];
+        }
+    }
+    else
+    {
+        U32 i = l;
+        if (i > 48)
+        {
+            U64 seed1 = seed;
+            U64 seed2 = seed;
+            do
+            {
+                seed = Hash_Mix(Hash_Read64(p) ^ HASH_SECRET[1], Hash_Read64(p + 8) ^ seed);
+                seed1 = Hash_Mix(Hash_Read64(p + 16) ^ HASH_SECRET[2], Hash_Read64(p + 24) ^ seed1);
+                seed2 = Hash_Mix(Hash_Read64(p + 32) ^ HASH_SECRET[3], Hash_Read64(p + 40) ^ seed2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= seed1 ^ seed2;
+        }
+
+        while (i > 16)
+        {
+            seed = Hash_Mix(Hash_Read64(p) ^ HASH_SECRET[1], Hash_Read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+
+        a = Hash_Read64(p + i - 16);
+        b = Hash_Read64(p + i - 8);
+    }
+
+    a ^= HASH_SECRET[1];
+    b ^= seed;
+    Hash_Mum(&a, &b);
+    return Hash_Mix(a ^ HASH_SECRET[0] ^ l, b ^ HASH_SECRET[1]);
 }
 
-U32 RandomNextU32()
+U32 CalcHash32(const void* buffer, I32 length, U32 seed)
 {
-    static U32 result = 0;
+    const U64 h = CalcHash64(buffer, length, seed);
+    return (U32)(h ^ (h >> 32));
+}
 
-    result += (U32)time(nullptr);
-    result ^= (result >> 13);
-    result ^= (result << 17);
-    result ^= (result >> 5);
+void DebugPrintInternal(const char* func, const char* file, int line, const char* format, ...)
+{
+    printf("[%s:%d:%s] ", file, line, func);
 
-    return result;
+    ArgList arglist;
+    ArgListBegin(arglist, format);
+    vprintf(format, arglist);
+    ArgListEnd(arglist);
+
+    printf("\n");
 }
 
-U64 RandomNextU64()
+void DebugAssertReport(const char* test, const char* func, const char* file, int line, const char* format, ...)
 {
-    U64 result = (U64)time(nullptr);
+    printf("Assertion failed: %s\n", test);
+    printf("At %s:%d:%s\n\n", file, line, func);
 
-    result ^= (result >> 13);
-    result ^= (result << 17);
-    result ^= (result >> 5);
-    result ^= (result >> 23);
-    result ^= (result << 37);
-    result ^= (result >> 11);
+    ArgList arglist;
+    ArgListBegin(arglist, format);
+    vprintf(format, arglist);
+    ArgListEnd(arglist);
 
-    return result;
+    printf("\n");
 }
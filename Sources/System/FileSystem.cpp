@@ -1,6 +1,7 @@
 #define _CRT_SECURE_NO_WARNINGS
 
 #include <System/FileSystem.h>
+#include <System/Memory.h>
 #include <Container/Array.h>
 #include <Text/String.h>
 
@@ -96,10 +97,21 @@ String GetFullPath(StringView path)
 
 File OpenFile(StringView path, FileMode mode)
 {
+    char pathBuffer[2048];
+
     String fullPath = GetFullPath(path);
     if (IsStringEmpty(fullPath))
     {
-        return 0;
+        // New files are created at the given path
+        if (!(mode & FileMode::Create) || path.Length >= (I32)sizeof(pathBuffer))
+        {
+            return 0;
+        }
+
+        // The view may not be null-terminated, CreateFileA need it to be
+        MemoryCopy(pathBuffer, path.Buffer, path.Length);
+        pathBuffer[path.Length] = '\0';
+        fullPath = RefString(pathBuffer, path.Length);
     }
 
     DWORD access = 0;
@@ -257,7 +269,7 @@ File OpenFile(StringView path, FileMode mode)
         //attributes |= FILE_FLAG_OVERLAPPED;
     }
 
-    HANDLE handle = CreateFileA(path.Buffer,
+    HANDLE handle = CreateFileA(fullPath.Buffer,
         access,
         shared,
         NULL,
@@ -371,20 +383,107 @@ I32 FileWrite(File file, const void* buffer, I32 length)
 
 Buffer LoadFileData(File file)
 {
-    return { nullptr, 0 };
+    const I32 size = GetFileSize(file);
+    if (size <= 0)
+    {
+        return { nullptr, 0 };
+    }
+
+    U8* data = (U8*)MemoryAlloc(size);
+    if (!data)
+    {
+        return { nullptr, 0 };
+    }
+
+    // ReadFile may return less than asked, read until the whole file is in memory
+    I32 readBytes = 0;
+    while (readBytes < size)
+    {
+        const I32 read = FileRead(file, data + readBytes, size - readBytes);
+        if (read <= 0)
+        {
+            break;
+        }
+
+        readBytes += read;
+    }
+
+    return { data, readBytes };
 }
 
 Buffer LoadFileData(StringView path)
 {
-    return { nullptr, 0 };
+    File file = OpenFile(path, FileMode::Read);
+    if (!file)
+    {
+        return { nullptr, 0 };
+    }
+
+    Buffer buffer = LoadFileData(file);
+    CloseFile(file);
+
+    return buffer;
 }
 
 Buffer64 LoadFileData64(File file)
 {
-    return { nullptr, 0 };
+    // Memory allocations are still limited to I32 sizes, larger files should be streamed
+    const I64 size = GetFileSize64(file);
+    if (size <= 0 || size > 0x7FFFFFFF)
+    {
+        return { nullptr, 0 };
+    }
+
+    Buffer buffer = LoadFileData(file);
+    return { buffer.Data, buffer.Size };
 }
 
 Buffer64 LoadFileData64(StringView path)
 {
-    return { nullptr, 0 };
+    File file = OpenFile(path, FileMode::Read);
+    if (!file)
+    {
+        return { nullptr, 0 };
+    }
+
+    Buffer64 buffer = LoadFileData64(file);
+    CloseFile(file);
+
+    return buffer;
+}
+
+Buffer64 MapFileData(StringView path)
+{
+    File file = OpenFile(path, FileMode::Read);
+    if (!file)
+    {
+        return { nullptr, 0 };
+    }
+
+    const I64 size = GetFileSize64(file);
+
+    // The view keep the file mapped, both handles can be closed right away
+    HANDLE mapping = size > 0 ? ::CreateFileMappingA((HANDLE)(intptr_t)file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    void*  data = mapping ? ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+    if (mapping)
+    {
+        ::CloseHandle(mapping);
+    }
+    CloseFile(file);
+
+    if (!data)
+    {
+        return { nullptr, 0 };
+    }
+
+    return { (U8*)data, size };
+}
+
+void UnmapFileData(Buffer64 buffer)
+{
+    if (buffer.Data)
+    {
+        ::UnmapViewOfFile(buffer.Data);
+    }
 }
@@ -0,0 +1,187 @@
+#include <System/Memory.h>
+#include <System/FileSystem.h>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define PATH_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define PATH_SSE2 0
+#endif
+
+constexpr I32 PATH_KEY_BUFFER_SIZE = 1024;
+
+// -----------------------------------
+// Segments
+// -----------------------------------
+
+static inline bool Path_IsSeparator(U8 c)
+{
+    return c == '/' || c == '\\';
+}
+
+#if PATH_SSE2
+static inline I32 Path_LowestBit(U32 mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (I32)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+// Copy the segment at start to output + cursor, lowercased when folding case, return its end (a separator or the end of path).
+// 16 bytes are copied at a time while output has room, the bytes past the segment are overwritten by the next one.
+static I32 Path_CopySegment(const U8* path, I32 start, I32 end, U8* output, I32 cursor, I32 capacity, bool foldCase)
+{
+    I32 i = start;
+
+#if PATH_SSE2
+    const __m128i slash = _mm_set1_epi8('/');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i upperBias = _mm_set1_epi8((char)(0x80 - 'A'));    // 'A'..'Z' become the 26 lowest signed bytes
+    const __m128i upperLimit = _mm_set1_epi8((char)(-0x80 + 26));
+    const __m128i caseBit = _mm_set1_epi8(foldCase ? 0x20 : 0);
+
+    for (; i + 16 <= end && cursor + (i - start) + 16 <= capacity; i += 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)(path + i));
+        const __m128i upper = _mm_cmplt_epi8(_mm_add_epi8(chars, upperBias), upperLimit);
+        _mm_storeu_si128((__m128i*)(output + cursor + (i - start)), _mm_add_epi8(chars, _mm_and_si128(upper, caseBit)));
+
+        const U32 separators = (U32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chars, slash), _mm_cmpeq_epi8(chars, backslash)));
+        if (separators)
+        {
+            return i + Path_LowestBit(separators);
+        }
+    }
+#endif
+
+    for (; i < end && !Path_IsSeparator(path[i]); i++)
+    {
+        const U8 c = path[i];
+        output[cursor + (i - start)] = foldCase && c >= 'A' && c <= 'Z' ? (U8)(c + 0x20) : c;
+    }
+
+    return i;
+}
+
+// Start of the last segment of output, root when it is empty
+static I32 Path_LastSegment(const U8* output, I32 root, I32 length)
+{
+    I32 i = length;
+    while (i > root && output[i - 1] != '/')
+    {
+        i--;
+    }
+    return i;
+}
+
+// -----------------------------------
+// Main functions
+// -----------------------------------
+
+I32 NormalizePath(StringView path, char* output, I32 capacity, U32 flags)
+{
+    if (capacity < path.Length)
+    {
+        return -1;
+    }
+
+    const U8* buffer = (const U8*)path.Buffer;
+    const I32 end = path.Length;
+    const bool foldCase = (flags & PATH_FOLD_CASE) != 0;
+
+    U8* result = (U8*)output;
+    I32 length = 0;
+    I32 root = 0;   // Output that ".." cannot remove: "/" of absolute paths, or a drive "c:"
+
+    I32 i = 0;
+    if (end > 0 && Path_IsSeparator(buffer[0]))
+    {
+        result[length++] = '/';
+        root = 1;
+    }
+
+    // The output never passes the input: each segment written was preceded by a separator in path
+    while (i < end)
+    {
+        while (i < end && Path_IsSeparator(buffer[i]))
+        {
+            i++;
+        }
+
+        if (i == end)
+        {
+            break;
+        }
+
+        const I32 cursor = length > (root == 1 ? 1 : 0) ? length + 1 : length;
+        const I32 segmentEnd = Path_CopySegment(buffer, i, end, result, cursor, capacity, foldCase);
+        const I32 segmentLength = segmentEnd - i;
+
+        const bool dot = segmentLength == 1 && buffer[i] == '.';
+        const bool dotDot = segmentLength == 2 && buffer[i] == '.' && buffer[i + 1] == '.';
+        i = segmentEnd;
+
+        if (dot)
+        {
+            continue;
+        }
+
+        if (dotDot)
+        {
+            const I32 last = Path_LastSegment(result, root, length);
+            const bool parent = length - last == 2 && result[last] == '.' && result[last + 1] == '.';
+            if (length > root && !parent)
+            {
+                length = last > root ? last - 1 : root;
+                continue;
+            }
+
+            // Nothing above the root of an absolute path
+            if (root > 0 && length == root)
+            {
+                continue;
+            }
+        }
+
+        if (cursor > length)
+        {
+            result[length] = '/';
+        }
+        length = cursor + segmentLength;
+
+        // A drive is the root of the paths which start with it
+        if (cursor == 0 && segmentLength == 2 && result[1] == ':')
+        {
+            root = 2;
+        }
+    }
+
+    return length;
+}
+
+PathKey MakePathKey(StringView path, U32 flags)
+{
+    char buffer[PATH_KEY_BUFFER_SIZE];
+
+    const bool large = path.Length > PATH_KEY_BUFFER_SIZE;
+    char* normalized = large ? (char*)MemoryAlloc(path.Length) : buffer;
+
+    const I32 length = NormalizePath(path, normalized, large ? path.Length : PATH_KEY_BUFFER_SIZE, flags);
+    const PathKey key = { CalcHash64(normalized, length), length };
+
+    if (large)
+    {
+        MemoryFree(normalized);
+    }
+
+    return key;
+}
@@ -0,0 +1,277 @@
+#include <time.h>
+
+#include <System/Random.h>
+
+// SSE2 is the x64 baseline, the AVX2 path is built alongside and picked at runtime
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define RANDOM_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define RANDOM_SSE2 0
+#endif
+
+#if RANDOM_SSE2 && (defined(_M_X64) || defined(__x86_64__))
+#   define RANDOM_AVX2 1
+#   include <immintrin.h>
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       define RANDOM_TARGET_AVX2
+#   else
+#       define RANDOM_TARGET_AVX2 __attribute__((target("avx2")))
+#   endif
+#else
+#   define RANDOM_AVX2 0
+#endif
+
+// Streams of RandomFillF32, each number gives 2 floats: its top 23 bits then the 23 bits below the low word
+constexpr I32 RANDOM_FILL_LANES = 4;
+constexpr I32 RANDOM_FILL_STEP  = RANDOM_FILL_LANES * 2;
+
+static thread_local Random  ThreadRandom;
+static thread_local bool    ThreadRandomSeeded = false;
+
+// -----------------------------------
+// Bulk generation
+// -----------------------------------
+
+static inline float Random_BitsToF32(U32 mantissa)
+{
+    const U32 bits = mantissa | 0x3F800000U;
+
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result - 1.0f;
+}
+
+// Reference step, the SIMD paths give the same floats
+static void Random_FillStepScalar(Random* lanes, float* output)
+{
+    for (I32 k = 0; k < RANDOM_FILL_LANES; k++)
+    {
+        const U64 x = RandomNextU64(&lanes[k]);
+        output[k * 2 + 0] = Random_BitsToF32((U32)(x >> 41));
+        output[k * 2 + 1] = Random_BitsToF32((U32)(x >> 9) & 0x7FFFFFU);
+    }
+}
+
+#if RANDOM_SSE2
+// 64-bit lanes have no multiply before AVX-512: x * 5 and x * 9 are a shift and an add
+static inline __m128i Random_NextSSE2(__m128i* s)
+{
+    const __m128i m5 = _mm_add_epi64(_mm_slli_epi64(s[1], 2), s[1]);
+    const __m128i r7 = _mm_or_si128(_mm_slli_epi64(m5, 7), _mm_srli_epi64(m5, 57));
+    const __m128i result = _mm_add_epi64(_mm_slli_epi64(r7, 3), r7);
+    const __m128i t = _mm_slli_epi64(s[1], 17);
+
+    s[2] = _mm_xor_si128(s[2], s[0]);
+    s[3] = _mm_xor_si128(s[3], s[1]);
+    s[1] = _mm_xor_si128(s[1], s[2]);
+    s[0] = _mm_xor_si128(s[0], s[3]);
+    s[2] = _mm_xor_si128(s[2], t);
+    s[3] = _mm_or_si128(_mm_slli_epi64(s[3], 45), _mm_srli_epi64(s[3], 19));
+
+    return result;
+}
+
+// Top 23 bits in the low float of each 64-bit lane, the 23 bits below the low word in the high float, as in Random_FillStepScalar
+static inline __m128 Random_ToF32SSE2(__m128i x)
+{
+    const __m128i high = _mm_srli_epi64(x, 41);
+    const __m128i low = _mm_slli_epi64(_mm_and_si128(_mm_srli_epi64(x, 9), _mm_set1_epi64x(0x7FFFFF)), 32);
+    const __m128i bits = _mm_or_si128(_mm_or_si128(high, low), _mm_set1_epi32(0x3F800000));
+    return _mm_sub_ps(_mm_castsi128_ps(bits), _mm_set1_ps(1.0f));
+}
+
+// Lanes 0-1 and 2-3 in two registers, the state is stored lane by lane in lanes
+static I32 Random_FillSSE2(Random* lanes, float* output, I32 count)
+{
+    __m128i a[4];
+    __m128i b[4];
+    for (I32 i = 0; i < 4; i++)
+    {
+        a[i] = _mm_set_epi64x((long long)lanes[1].State[i], (long long)lanes[0].State[i]);
+        b[i] = _mm_set_epi64x((long long)lanes[3].State[i], (long long)lanes[2].State[i]);
+    }
+
+    I32 i = 0;
+    for (; i + RANDOM_FILL_STEP <= count; i += RANDOM_FILL_STEP)
+    {
+        _mm_storeu_ps(output + i + 0, Random_ToF32SSE2(Random_NextSSE2(a)));
+        _mm_storeu_ps(output + i + 4, Random_ToF32SSE2(Random_NextSSE2(b)));
+    }
+
+    for (I32 j = 0; j < 4; j++)
+    {
+        alignas(16) U64 values[2];
+        _mm_store_si128((__m128i*)values, a[j]);
+        lanes[0].State[j] = values[0];
+        lanes[1].State[j] = values[1];
+
+        _mm_store_si128((__m128i*)values, b[j]);
+        lanes[2].State[j] = values[0];
+        lanes[3].State[j] = values[1];
+    }
+
+    return i;
+}
+#endif
+
+#if RANDOM_AVX2
+RANDOM_TARGET_AVX2
+static I32 Random_FillAVX2(Random* lanes, float* output, I32 count)
+{
+    __m256i s[4];
+    for (I32 i = 0; i < 4; i++)
+    {
+        s[i] = _mm256_set_epi64x((long long)lanes[3].State[i], (long long)lanes[2].State[i], (long long)lanes[1].State[i], (long long)lanes[0].State[i]);
+    }
+
+    const __m256i mantissa = _mm256_set1_epi64x(0x7FFFFF);
+    const __m256i one = _mm256_set1_epi32(0x3F800000);
+    const __m256 oneF32 = _mm256_set1_ps(1.0f);
+
+    I32 i = 0;
+    for (; i + RANDOM_FILL_STEP <= count; i += RANDOM_FILL_STEP)
+    {
+        const __m256i m5 = _mm256_add_epi64(_mm256_slli_epi64(s[1], 2), s[1]);
+        const __m256i r7 = _mm256_or_si256(_mm256_slli_epi64(m5, 7), _mm256_srli_epi64(m5, 57));
+        const __m256i x = _mm256_add_epi64(_mm256_slli_epi64(r7, 3), r7);
+        const __m256i t = _mm256_slli_epi64(s[1], 17);
+
+        s[2] = _mm256_xor_si256(s[2], s[0]);
+        s[3] = _mm256_xor_si256(s[3], s[1]);
+        s[1] = _mm256_xor_si256(s[1], s[2]);
+        s[0] = _mm256_xor_si256(s[0], s[3]);
+        s[2] = _mm256_xor_si256(s[2], t);
+        s[3] = _mm256_or_si256(_mm256_slli_epi64(s[3], 45), _mm256_srli_epi64(s[3], 19));
+
+        const __m256i high = _mm256_srli_epi64(x, 41);
+        const __m256i low = _mm256_slli_epi64(_mm256_and_si256(_mm256_srli_epi64(x, 9), mantissa), 32);
+        const __m256i bits = _mm256_or_si256(_mm256_or_si256(high, low), one);
+        _mm256_storeu_ps(output + i, _mm256_sub_ps(_mm256_castsi256_ps(bits), oneF32));
+    }
+
+    for (I32 j = 0; j < 4; j++)
+    {
+        alignas(32) U64 values[4];
+        _mm256_store_si256((__m256i*)values, s[j]);
+        for (I32 k = 0; k < RANDOM_FILL_LANES; k++)
+        {
+            lanes[k].State[j] = values[k];
+        }
+    }
+
+    return i;
+}
+#endif
+
+// -----------------------------------
+// Main functions
+// -----------------------------------
+
+Random MakeRandom(U64 seed)
+{
+    Random random;
+    for (I32 i = 0; i < 4; i++)
+    {
+        // SplitMix64
+        U64 z = (seed += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        random.State[i] = z ^ (z >> 31);
+    }
+    return random;
+}
+
+void RandomJump(Random* random)
+{
+    constexpr U64 JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+
+    U64 state[4] = {};
+    for (U64 jump : JUMP)
+    {
+        for (I32 bit = 0; bit < 64; bit++)
+        {
+            if (jump & (1ULL << bit))
+            {
+                for (I32 i = 0; i < 4; i++)
+                {
+                    state[i] ^= random->State[i];
+                }
+            }
+            RandomNextU64(random);
+        }
+    }
+
+    memcpy(random->State, state, sizeof(state));
+}
+
+Random* GetThreadRandom(void)
+{
+    if (!ThreadRandomSeeded)
+    {
+        // Threads started in the same second differ by the address of their state
+        ThreadRandom = MakeRandom((U64)time(nullptr) ^ ((U64)(UPtr)&ThreadRandom * HASH_KEY_STEP));
+        ThreadRandomSeeded = true;
+    }
+
+    return &ThreadRandom;
+}
+
+void RandomFillF32(Random* random, float* output, I32 count)
+{
+    Random lanes[RANDOM_FILL_LANES];
+    for (Random& lane : lanes)
+    {
+        lane = MakeRandom(RandomNextU64(random));
+    }
+
+    I32 i = 0;
+#if RANDOM_AVX2
+    if (CpuHasAVX2())
+    {
+        i = Random_FillAVX2(lanes, output, count);
+    }
+    else
+#endif
+    {
+#if RANDOM_SSE2
+        i = Random_FillSSE2(lanes, output, count);
+#endif
+    }
+
+    for (; i + RANDOM_FILL_STEP <= count; i += RANDOM_FILL_STEP)
+    {
+        Random_FillStepScalar(lanes, output + i);
+    }
+
+    if (i < count)
+    {
+        float step[RANDOM_FILL_STEP];
+        Random_FillStepScalar(lanes, step);
+        memcpy(output + i, step, (count - i) * sizeof(float));
+    }
+}
+
+// -----------------------------------
+// Thread generator shortcuts (Core.h)
+// -----------------------------------
+
+I32 RandomNextI32()
+{
+    return (I32)RandomNextU32(GetThreadRandom());
+}
+
+I64 RandomNextI64()
+{
+    return (I64)RandomNextU64(GetThreadRandom());
+}
+
+U32 RandomNextU32()
+{
+    return RandomNextU32(GetThreadRandom());
+}
+
+U64 RandomNextU64()
+{
+    return RandomNextU64(GetThreadRandom());
+}
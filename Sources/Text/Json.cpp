@@ -10,6 +10,9 @@
 
 #include <Text/Json.h>
 #include <Text/String.h>
+#include <Text/Utf8.h>
+
+#include "./JsonPowers.h"
 
 #include <System/Memory.h>
 #include <System/FileSystem.h>
@@ -17,20 +20,90 @@
 #include <Container/Array.h>
 #include <Container/HashTable.h>
 
+#include <Concurrency/JobSystem.h>
+
+// Parsing is done in two stages (like simdjson):
+//  1. Json_BuildIndex scan the whole document 64 bytes at a time with SIMD and
+//     record the offset of every structural character ({}[]:,), opening quote
+//     and start of scalar (number, true, false, null) into the structural index.
+//  2. Json_ParseValue walk the index and build the Json tree, it never look at
+//     whitespace and never track line/column (only computed when an error occur).
+
+#if defined(__AVX2__)
+#   define JSON_AVX2 1
+#else
+#   define JSON_AVX2 0
+#endif
+
+#if JSON_AVX2 || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define JSON_SSE2 1
+#else
+#   define JSON_SSE2 0
+#endif
+
+#if JSON_AVX2
+#   include <immintrin.h>
+#elif JSON_SSE2
+#   include <emmintrin.h>
+#endif
+
+// Carry-less multiply is its own extension: gcc and clang need -mpclmul, MSVC exposes it with /arch:AVX2 (every AVX2 cpu has it)
+#if JSON_AVX2 && (defined(_M_X64) || defined(__x86_64__)) && (defined(__PCLMUL__) || (defined(_MSC_VER) && !defined(__clang__)))
+#   define JSON_CLMUL 1
+#else
+#   define JSON_CLMUL 0
+#endif
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
 #define JSON_SUPEROF(ptr, T, member) (T*)((char*)ptr - offsetof(T, member))
 
+constexpr int JSON_ARENA_ALIGNMENT  = 8;
+constexpr int JSON_ARENA_MIN_BLOCK  = 4096;
+
+constexpr int JSON_ERROR_MESSAGE_SIZE = 1024;
+
+/// JsonArena
+/// Memory block of every node and string of a document, released at once by FreeJson.
+/// The first block is sized from the structural index, more blocks are only chained on malformed documents.
+struct alignas(JSON_ARENA_ALIGNMENT) JsonArena
+{
+    JsonArena*          Next;
+    int                 Size;
+    int                 Used;
+    /* Followed by Size bytes */
+};
+
 struct JsonState
 {
     Json                Root;
     JsonState*          Next;
 
-    int                 Line;
-    int                 Column;
-    int                 Cursor;
-    //JsonType            ParsingType;
+    int                 Cursor;         /* Byte offset of the token being parsed */
 
     int                 Length;         /* Reference only */
     const char*         Buffer;         /* Reference only */
+    bool                InSitu;         /* Buffer is mutable, strings are decoded in place and point into it */
+    char*               Content;        /* File content owned by the document (LoadJson), strings point into it */
+    I64                 StreamOffset;   /* Input bytes before Buffer when reading a stream, -1 when Buffer hold the whole document */
+
+    U32*                Index;          /* Structural index, only alive while parsing */
+    int                 IndexCount;
+    int                 IndexCursor;
+
+    int*                Counts;         /* Children count of arrays and objects in document order, only alive while parsing */
+    int                 CountsCount;
+    int                 CountsCursor;
+
+    HashTable<String>   Keys;           /* Interned member names by hash, only alive while parsing (names live in the arena) */
+    int                 KeysCount;      /* Members in the document, sizes the Keys buckets */
+
+    bool                IsChunk;        /* Items of the top-level array parsed on a job worker: Index and Counts are the root's, and
+                                           everything is allocated beforehand as the heap is not thread-safe */
+
+    JsonArena*          Arena;
 
     JsonError           ErrorCode;
     char*               ErrorMessage;
@@ -39,8 +112,6 @@ struct JsonState
 
 static void Json_SetErrorArgs(JsonState* state, JsonType type, JsonError code, const char* fmt, va_list valist)
 {
-    constexpr int ERROR_MESSAGE_SIZE = 1024;
-
     const char* type_name;
     switch (type)
     {
@@ -53,6 +124,7 @@ static void Json_SetErrorArgs(JsonState* state, JsonType type, JsonError code, c
         break;
 
     case JsonType::Number:
+    case JsonType::Integer:
         type_name = "number";
         break;
 
@@ -76,18 +148,41 @@ static void Json_SetErrorArgs(JsonState* state, JsonType type, JsonError code, c
     state->ErrorCode = code;
     if (state->ErrorMessage == nullptr)
     {
-        state->ErrorMessage = (char*)MemoryAlloc(ERROR_MESSAGE_SIZE);
+        state->ErrorMessage = (char*)MemoryAlloc(JSON_ERROR_MESSAGE_SIZE);
     }
 
     char final_format[1024];
-    char templ_format[1024] = "%s\n\tAt line %d, column %d. Parsing token: <%s>.";
+    if (state->StreamOffset >= 0)
+    {
+        /* The beginning of a stream is already discarded, only the input offset is known */
+        const long long offset = state->StreamOffset + (state->Cursor < state->Length ? state->Cursor : state->Length);
+        snprintf(final_format, sizeof(final_format), "%s\n\tAt byte %lld. Parsing token: <%s>.", fmt, offset, type_name);
+    }
+    else
+    {
+        /* Line and column are not tracked while parsing, recompute them from the error offset */
+        int line = 1;
+        int column = 1;
+        for (int i = 0, n = state->Cursor < state->Length ? state->Cursor : state->Length; i < n; i++)
+        {
+            if (state->Buffer[i] == '\n')
+            {
+                line++;
+                column = 1;
+            }
+            else
+            {
+                column++;
+            }
+        }
+
+        snprintf(final_format, sizeof(final_format), "%s\n\tAt line %d, column %d. Parsing token: <%s>.", fmt, line, column, type_name);
+    }
 
 #if defined(_MSC_VER) && _MSC_VER >= 1200
-    sprintf_s(final_format, sizeof(final_format), templ_format, fmt, state->Line, state->Column, type_name);
-    sprintf_s(state->ErrorMessage, ERROR_MESSAGE_SIZE, final_format, valist);
+    vsprintf_s(state->ErrorMessage, JSON_ERROR_MESSAGE_SIZE, final_format, valist);
 #else
-    sprintf(final_format, templ_format, fmt, state->line, state->column, type_name);
-    sprintf(state->errmsg, final_format, valist);
+    vsnprintf(state->ErrorMessage, JSON_ERROR_MESSAGE_SIZE, final_format, valist);
 #endif
 }
 
@@ -111,52 +206,36 @@ static void Json_Panic(JsonState* state, JsonType type, JsonError code, const ch
     longjmp(state->ErrorJump, (int)code);
 }
 
-static void Json_ReleaseMemory(Json* value)
-{
-    if (value)
-    {
-        int i, n;
-        switch (value->Type)
-        {
-        case JsonType::Array:
-            for (i = 0, n = value->Array.Count; i < n; i++)
-            {
-                Json_ReleaseMemory(&value->Array.Items[i]);
-            }
-            FreeArray(&value->Array);
-            break;
-
-        case JsonType::Object:
-            for (i = 0, n = value->Object.Count; i < n; i++)
-            {
-                Json_ReleaseMemory(&value->Object.Values[i]);
-            }
-            FreeHashTable(&value->Object);
-            break;
-
-        case JsonType::String:
-            FreeString(&value->String);
-            break;
-
-        default:
-            break;
-        }
-    }
-}
-
 /* @funcdef: JsonState_Make */
 static JsonState* JsonState_Make(const char* json, int jsonLength)
 {
     JsonState* state = (JsonState*)MemoryAlloc(sizeof(JsonState));
     if (state)
     {
+        state->Root = {};
         state->Next = nullptr;
 
-        state->Line = 1;
-        state->Column = 1;
         state->Cursor = 0;
         state->Buffer = json;
         state->Length = jsonLength;
+        state->InSitu = false;
+        state->Content = nullptr;
+        state->StreamOffset = -1;
+
+        state->Index = nullptr;
+        state->IndexCount = 0;
+        state->IndexCursor = 0;
+
+        state->Counts = nullptr;
+        state->CountsCount = 0;
+        state->CountsCursor = 0;
+
+        state->Keys = MakeHashTable<String>();
+        state->KeysCount = 0;
+
+        state->IsChunk = false;
+
+        state->Arena = nullptr;
 
         state->ErrorCode = JsonError::None;
         state->ErrorMessage = nullptr;
@@ -164,16 +243,40 @@ static JsonState* JsonState_Make(const char* json, int jsonLength)
     return state;
 }
 
+/* @funcdef: JsonState_FreeScratch */
+/* Release the memory only needed while parsing */
+static void JsonState_FreeScratch(JsonState* state)
+{
+    if (!state->IsChunk)
+    {
+        MemoryFree(state->Index);
+        MemoryFree(state->Counts);
+    }
+
+    state->Index = nullptr;
+    state->Counts = nullptr;
+
+    FreeHashTable(&state->Keys);
+}
+
 /* @funcdef: JsonState_Free */
 static void JsonState_Free(JsonState* state)
 {
     if (state)
     {
-        Json* root = &state->Root;
-        Json_ReleaseMemory(root);
+        /* The whole tree live in the arena, no need to walk it */
+        JsonArena* arena = state->Arena;
+        while (arena)
+        {
+            JsonArena* next = arena->Next;
+            MemoryFree(arena);
+            arena = next;
+        }
 
         JsonState* next = state->Next;
 
+        JsonState_FreeScratch(state);
+        MemoryFree(state->Content);
         MemoryFree(state->ErrorMessage);
         MemoryFree(state);
 
@@ -181,692 +284,2777 @@ static void JsonState_Free(JsonState* state)
     }
 }
 
-/* @funcdef: Json_IsEOF */
-static int Json_IsEOF(JsonState* state)
+/* @funcdef: JsonArena_Push */
+static bool JsonArena_Push(JsonState* state, int size)
 {
-    return state->Cursor >= state->Length || state->Buffer[state->Cursor] <= 0;
-}
+    JsonArena* arena = (JsonArena*)MemoryAlloc((int)sizeof(JsonArena) + size);
+    if (!arena)
+    {
+        return false;
+    }
 
-/* @funcdef: Json_PeekChar */
-static int Json_PeekChar(JsonState* state)
-{
-    return state->Buffer[state->Cursor];
+    arena->Next = state->Arena;
+    arena->Size = size;
+    arena->Used = 0;
+
+    state->Arena = arena;
+    return true;
 }
 
-/* @funcdef: Json_NextChar */
-static int Json_NextChar(JsonState* state)
+/* @funcdef: Json_Alloc */
+static void* Json_Alloc(JsonState* state, int size)
 {
-    if (Json_IsEOF(state))
-    {
-        return -1;
-    }
-    else
-    {
-        int c = state->Buffer[++state->Cursor];
+    size = (size + JSON_ARENA_ALIGNMENT - 1) & ~(JSON_ARENA_ALIGNMENT - 1);
 
-        if (c == '\n')
+    JsonArena* arena = state->Arena;
+    if (!arena || arena->Used + size > arena->Size)
+    {
+        /* Chunk arenas are sized like the document one, they are only exceeded by a broken counting pass */
+        if (state->IsChunk)
         {
-            state->Line++;
-            state->Column = 1;
+            Json_Panic(state, JsonType::Null, JsonError::InternalError, "Chunk arena overflow");
         }
-        else
+
+        if (!JsonArena_Push(state, size > JSON_ARENA_MIN_BLOCK ? size : JSON_ARENA_MIN_BLOCK))
         {
-            state->Column = state->Column + 1;
+            Json_Panic(state, JsonType::Null, JsonError::OutOfMemory, "Out of memory");
         }
 
-        return c;
+        arena = state->Arena;
     }
+
+    void* result = (U8*)(arena + 1) + arena->Used;
+    arena->Used += size;
+    return result;
 }
 
-/* @funcdef: Json_SkipSpace */
-static int Json_SkipSpace(JsonState* state)
+/* @funcdef: Json_HashCount */
+static inline int Json_HashCount(int count)
 {
-    int c = Json_PeekChar(state);
-    while (c > 0 && isspace(c))
-    {
-        c = Json_NextChar(state);
-    }
-    return c;
+    return count > 8 ? NextPOTwosI32(count) : 8;
 }
 
-/* @funcdef: Json_MatchChar */
-static int Json_MatchChar(JsonState* state, JsonType type, int c)
+/* @funcdef: Json_ArenaSizeOf */
+/* Arena bytes used by an array or an object with count children */
+static inline I64 Json_ArenaSizeOf(JsonType type, int count)
 {
-    if (Json_PeekChar(state) == c)
+    if (count == 0)
     {
-        return Json_NextChar(state);
+        return 0;
     }
-    else
+
+    if (type == JsonType::Array)
     {
-        Json_Panic(state, type, JsonError::UnmatchToken, "Expected '%c'", (char)c);
-        return -1;
+        return (I64)count * sizeof(Json);
     }
-}
 
-/* All parse functions declaration */
+    /* Hashs, then Nexts, Keys and Values in one buffer (the same layout as HashTableEnsure) followed by the key names */
+    const I64 capacity = (count + 1) & ~1;
+    return (I64)Json_HashCount(count) * sizeof(I32) + capacity * (sizeof(I32) + sizeof(U64) + sizeof(Json) + sizeof(String));
+}
 
-static void Json_ParseArray(JsonState* state, Json* outValue);
-static void Json_ParseSingle(JsonState* state, Json* outValue);
-static void Json_ParseObject(JsonState* state, Json* outValue);
-static void Json_ParseNumber(JsonState* state, Json* outValue);
-static void Json_ParseString(JsonState* state, Json* outValue);
+/* Stage 1: structural index */
 
-/* @funcdef: Json_ParseNumber */
-static void Json_ParseNumber(JsonState* state, Json* outValue)
+/* @funcdef: Json_CountTrailingZeros */
+static inline int Json_CountTrailingZeros(U64 bits)
 {
-    if (Json_SkipSpace(state) > 0)
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return (int)index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanForward(&index, (unsigned long)bits))
     {
-        int c = Json_PeekChar(state);
-        int sign = 1;
+        return (int)index;
+    }
+    _BitScanForward(&index, (unsigned long)(bits >> 32));
+    return (int)index + 32;
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
 
-        if (c == '+')
-        {
-            c = Json_NextChar(state);
-            Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "JSON does not support number start with '+'");
-        }
-        else if (c == '-')
-        {
-            sign = -1;
-            c = Json_NextChar(state);
-        }
-        else if (c == '0')
-        {
-            c = Json_NextChar(state);
-            if (!isspace(c) && !ispunct(c))
-            {
-                Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "JSON does not support number start with '0' (only standalone '0' is accepted)");
-            }
-        }
-        else if (!isdigit(c))
+/// JsonBlock
+/// Bitmasks of one 64 bytes block, bit i is set when the byte i is of the class
+struct JsonBlock
+{
+    U64                 Quote;
+    U64                 Backslash;
+    U64                 Operator;       /* { } [ ] : , */
+    U64                 Whitespace;
+};
+
+/* @funcdef: Json_ClassifyBlock */
+static inline void Json_ClassifyBlock(const char* block, JsonBlock* outBlock)
+{
+#if JSON_AVX2
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i openBrace = _mm256_set1_epi8('{');
+    const __m256i closeBrace = _mm256_set1_epi8('}');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i lowerBit = _mm256_set1_epi8(0x20);
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i carriage = _mm256_set1_epi8('\r');
+
+    U64 quoteBits = 0, backslashBits = 0, operatorBits = 0, whitespaceBits = 0;
+    for (int i = 0; i < 64; i += 32)
+    {
+        const __m256i chars = _mm256_loadu_si256((const __m256i*)(block + i));
+
+        /* '[' | 0x20 == '{' and ']' | 0x20 == '}' */
+        const __m256i lower = _mm256_or_si256(chars, lowerBit);
+        const __m256i operators = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(lower, openBrace), _mm256_cmpeq_epi8(lower, closeBrace)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chars, colon), _mm256_cmpeq_epi8(chars, comma)));
+        const __m256i whitespaces = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chars, space), _mm256_cmpeq_epi8(chars, tab)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chars, newline), _mm256_cmpeq_epi8(chars, carriage)));
+
+        quoteBits       |= (U64)(U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, quote)) << i;
+        backslashBits   |= (U64)(U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, backslash)) << i;
+        operatorBits    |= (U64)(U32)_mm256_movemask_epi8(operators) << i;
+        whitespaceBits  |= (U64)(U32)_mm256_movemask_epi8(whitespaces) << i;
+    }
+#elif JSON_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i openBrace = _mm_set1_epi8('{');
+    const __m128i closeBrace = _mm_set1_epi8('}');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i lowerBit = _mm_set1_epi8(0x20);
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i carriage = _mm_set1_epi8('\r');
+
+    U64 quoteBits = 0, backslashBits = 0, operatorBits = 0, whitespaceBits = 0;
+    for (int i = 0; i < 64; i += 16)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)(block + i));
+
+        /* '[' | 0x20 == '{' and ']' | 0x20 == '}' */
+        const __m128i lower = _mm_or_si128(chars, lowerBit);
+        const __m128i operators = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(lower, openBrace), _mm_cmpeq_epi8(lower, closeBrace)),
+            _mm_or_si128(_mm_cmpeq_epi8(chars, colon), _mm_cmpeq_epi8(chars, comma)));
+        const __m128i whitespaces = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chars, space), _mm_cmpeq_epi8(chars, tab)),
+            _mm_or_si128(_mm_cmpeq_epi8(chars, newline), _mm_cmpeq_epi8(chars, carriage)));
+
+        quoteBits       |= (U64)(U16)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, quote)) << i;
+        backslashBits   |= (U64)(U16)_mm_movemask_epi8(_mm_cmpeq_epi8(chars, backslash)) << i;
+        operatorBits    |= (U64)(U16)_mm_movemask_epi8(operators) << i;
+        whitespaceBits  |= (U64)(U16)_mm_movemask_epi8(whitespaces) << i;
+    }
+#else
+    U64 quoteBits = 0, backslashBits = 0, operatorBits = 0, whitespaceBits = 0;
+    for (int i = 0; i < 64; i++)
+    {
+        const U64 bit = 1ull << i;
+        switch (block[i])
         {
-            Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "Unexpected '%c'", c);
-        }
+        case '"':
+            quoteBits |= bit;
+            break;
 
-        int    dot = 0;
-        int    exp = 0;
-        int    expsgn = 0;
-        int    exppow = 0;
-        int    expchk = 0;
-        int    numpow = 1;
-        double number = 0;
+        case '\\':
+            backslashBits |= bit;
+            break;
 
-        while (c > 0)
-        {
-            if (c == 'e')
-            {
-                if (exp)
-                {
-                    Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "Too many 'e' are presented in a <number>");
-                }
-                else if (dot && numpow == 1)
-                {
-                    Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken,
-                        "'.' is presented in number token, but require a digit after '.' ('%c')", c);
-                }
-                else
-                {
-                    exp = 1;
-                    expchk = 0;
-                }
-            }
-            else if (c == '.')
-            {
-                if (exp)
-                {
-                    Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "Cannot has '.' after 'e' is presented in a <number>");
-                }
-                else if (dot)
-                {
-                    Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "Too many '.' are presented in a <number>");
-                }
-                else
-                {
-                    dot = 1;
-                }
-            }
-            else if (exp && (c == '-' || c == '+'))
-            {
-                if (expchk)
-                {
-                    Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "'%c' is presented after digits are presented of exponent part", c);
-                }
-                else if (expsgn)
-                {
-                    Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "Too many signed characters are presented after 'e'");
-                }
-                else
-                {
-                    expsgn = (c == '-' ? -1 : 1);
-                }
-            }
-            else if (!isdigit(c))
-            {
-                break;
-            }
-            else
-            {
-                if (exp)
-                {
-                    expchk = 1;
-                    exppow = exppow * 10 + (c - '0');
-                }
-                else
-                {
-                    if (dot)
-                    {
-                        numpow *= 10;
-                        number += (c - '0') / (double)numpow;
-                    }
-                    else
-                    {
-                        number = number * 10 + (c - '0');
-                    }
-                }
-            }
+        case '{': case '}':
+        case '[': case ']':
+        case ':': case ',':
+            operatorBits |= bit;
+            break;
 
-            c = Json_NextChar(state);
+        case ' ': case '\t':
+        case '\n': case '\r':
+            whitespaceBits |= bit;
+            break;
         }
+    }
+#endif
 
-        if (exp && !expchk)
-        {
-            Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "'e' is presented in number token, but require a digit after 'e' ('%c')", (char)c);
-        }
-        if (dot && numpow == 1)
-        {
-            Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "'.' is presented in number token, but require a digit after '.' ('%c')", (char)c);
-        }
-        else
-        {
-            Json value = { JsonType::Number };
-            value.Number = sign * number;
+    outBlock->Quote = quoteBits;
+    outBlock->Backslash = backslashBits;
+    outBlock->Operator = operatorBits;
+    outBlock->Whitespace = whitespaceBits;
+}
 
-            if (exp)
-            {
-                int i;
-                double tmp = 1;
-                for (i = 0; i < exppow; i++)
-                {
-                    tmp *= 10;
-                }
+/* @funcdef: Json_FindEscaped */
+/* Mask of characters escaped by a backslash, handle runs of backslashes across blocks */
+static inline U64 Json_FindEscaped(U64 backslash, U64* nextIsEscaped)
+{
+    if (backslash == 0)
+    {
+        U64 escaped = *nextIsEscaped;
+        *nextIsEscaped = 0;
+        return escaped;
+    }
 
-                if (expsgn < 0)
-                {
-                    value.Number /= tmp;
-                }
-                else
-                {
-                    value.Number *= tmp;
-                }
-            }
+    const U64 oddBits = 0xAAAAAAAAAAAAAAAAull;
 
-            *outValue = value;
-        }
-    }
+    /* A backslash start a sequence when it is not escaped itself, odd length sequences escape the next character */
+    const U64 potentialEscape = backslash & ~*nextIsEscaped;
+    const U64 maybeEscaped = potentialEscape << 1;
+    const U64 escapeAndTerminal = ((maybeEscaped | oddBits) - potentialEscape) ^ oddBits;
+    const U64 escaped = escapeAndTerminal ^ (backslash | *nextIsEscaped);
+    const U64 escape = escapeAndTerminal & backslash;
+
+    *nextIsEscaped = escape >> 63;
+    return escaped;
 }
 
-/* @funcdef: Json_ParseArray */
-static void Json_ParseArray(JsonState* state, Json* outValue)
+/* @funcdef: Json_PrefixXor */
+/* Bit i of the result is the xor of the bits 0..i, turn quote bits into an in-string mask */
+static inline U64 Json_PrefixXor(U64 bits)
 {
-    if (Json_SkipSpace(state) > 0)
-    {
-        Json_MatchChar(state, JsonType::Array, '[');
+#if JSON_CLMUL
+    return (U64)_mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_set_epi64x(0, (I64)bits), _mm_set1_epi8((char)0xFF), 0));
+#else
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+#endif
+}
 
-        Array<Json> values = {};
-        while (Json_SkipSpace(state) > 0 && Json_PeekChar(state) != ']')
-        {
-            if (values.Count > 0)
-            {
-                Json_MatchChar(state, JsonType::Array, ',');
-            }
+/* @funcdef: Json_BuildIndex */
+/* Write offsets of all structural characters into index (must have room for length + 1 entries), return the count */
+static int Json_BuildIndex(const char* buffer, int length, U32* index)
+{
+    U64 prevEscaped = 0;
+    U64 prevInString = 0;
+    U64 prevScalar = 0;
 
-            Json value;
-            Json_ParseSingle(state, &value);
+    int  count = 0;
+    char tail[64];
 
-            ArrayPush(&values, value);
+    for (int offset = 0; offset < length; offset += 64)
+    {
+        const char* block = buffer + offset;
+        if (length - offset < 64)
+        {
+            /* Pad the last block with whitespaces, they never produce structurals */
+            memset(tail, ' ', sizeof(tail));
+            memcpy(tail, block, length - offset);
+            block = tail;
         }
 
-        Json_SkipSpace(state);
-        Json_MatchChar(state, JsonType::Array, ']');
+        JsonBlock masks;
+        Json_ClassifyBlock(block, &masks);
+
+        const U64 escaped = Json_FindEscaped(masks.Backslash, &prevEscaped);
+        const U64 quote = masks.Quote & ~escaped;
+
+        /* The opening quote is inside the mask, the closing quote is not */
+        const U64 inString = Json_PrefixXor(quote) ^ prevInString;
+        prevInString = (U64)((I64)inString >> 63);
 
-        outValue->Type = JsonType::Array;
-        outValue->Array = values;
+        /* Scalars are everything outside strings that is neither an operator nor a whitespace */
+        const U64 scalar = ~(masks.Operator | masks.Whitespace | quote | inString);
+        const U64 scalarStart = scalar & ~((scalar << 1) | prevScalar);
+        prevScalar = scalar >> 63;
+
+        U64 structurals = (masks.Operator & ~inString) | (quote & inString) | scalarStart;
+        while (structurals)
+        {
+            index[count++] = (U32)(offset + Json_CountTrailingZeros(structurals));
+            structurals &= structurals - 1;
+        }
     }
+
+    return count;
 }
 
-/* Json_ParseSingle */
-static void Json_ParseSingle(JsonState* state, Json* outValue)
+/* @funcdef: Json_CountValues */
+/* Count the children of every array and object, and the arena size of the whole tree.
+ * Counts are exact for well-formed documents, stage 2 still check them as the document may be malformed.
+ */
+static I64 Json_CountValues(JsonState* state)
 {
-    if (Json_SkipSpace(state) > 0)
-    {
-        int c = Json_PeekChar(state);
+    Array<int> counts = {};
+    Array<int> opened = {};     /* Containers not closed yet */
 
+    /* Strings are never longer than their source, plus alignment. In situ they take no arena memory. */
+    I64 arenaSize = state->InSitu ? 0 : state->Length;
+
+    int prev = 0;
+    for (int i = 0, n = state->IndexCount; i < n; i++)
+    {
+        const int c = (U8)state->Buffer[state->Index[i]];
         switch (c)
         {
         case '[':
-            Json_ParseArray(state, outValue);
-            break;
-
         case '{':
-            Json_ParseObject(state, outValue);
-            break;
-
-        case '"':
-            Json_ParseString(state, outValue);
-            break;
-
-        case '+': case '-': case '0':
-        case '1': case '2': case '3':
-        case '4': case '5': case '6':
-        case '7': case '8': case '9':
-            Json_ParseNumber(state, outValue);
+            ArrayPush(&opened, counts.Count);
+            ArrayPush(&counts, 0);
             break;
 
-        default:
-        {
-            int length = 0;
-            while (c > 0 && isalpha(c))
+        case ',':
+            if (opened.Count > 0)
             {
-                length++;
-                c = Json_NextChar(state);
+                counts.Items[opened.Items[opened.Count - 1]]++;
             }
+            break;
 
-            const char* token = state->Buffer + state->Cursor - length;
-            if (length == 4 && strncmp(token, "true", 4) == 0)
-            {
-                outValue->Type = JsonType::Boolean;
-                outValue->Boolean = true;
-            }
-            else if (length == 4 && strncmp(token, "null", 4) == 0)
-            {
-                outValue->Type = JsonType::Null;
-            }
-            else if (length == 5 && strncmp(token, "false", 5) == 0)
-            {
-                outValue->Type = JsonType::Boolean;
-                outValue->Boolean = false;
-            }
-            else
+        case ']':
+        case '}':
+            if (opened.Count > 0)
             {
-                char tmp[256];
-                tmp[length] = 0;
-                while (length--)
-                {
-                    tmp[length] = token[length];
-                }
+                /* n commas separate n + 1 values, unless the container is empty */
+                const int container = opened.Items[--opened.Count];
+                const int count = counts.Items[container] + (prev != '[' && prev != '{');
 
-                Json_Panic(state, JsonType::Null, JsonError::UnexpectedToken, "Unexpected token '%s'", tmp);
+                counts.Items[container] = count;
+                arenaSize += Json_ArenaSizeOf(c == ']' ? JsonType::Array : JsonType::Object, count);
             }
-        } break;
-        /* END OF SWITCH STATEMENT */
+            break;
+
+        case '"':
+            arenaSize += state->InSitu ? 0 : JSON_ARENA_ALIGNMENT;
+            break;
+
+        case ':':
+            state->KeysCount++;
+            break;
         }
+
+        prev = c;
     }
-}
 
-static char* Json_ParseStringNoToken(JsonState* state, int* outLength)
-{
-    Json_MatchChar(state, JsonType::String, '"');
+    FreeArray(&opened);
 
-    int i;
-    int c0, c1;
+    state->Counts = counts.Items;
+    state->CountsCount = counts.Count;
+    state->CountsCursor = 0;
 
-    char buffer[2048];
-    int length = 0;
-    while (!Json_IsEOF(state) && (c0 = Json_PeekChar(state)) != '"')
-    {
-        if (c0 == '\\')
-        {
-            c0 = Json_NextChar(state);
-            switch (c0)
-            {
-            case 'n':
-                buffer[length++] = '\n';
-                break;
+    return arenaSize;
+}
 
-            case 't':
-                buffer[length++] = '\t';
-                break;
+/* Stage 2: build the tree from the structural index */
 
-            case 'r':
-                buffer[length++] = '\r';
-                break;
+/* @funcdef: Json_IsOperatorOrSpace */
+static inline bool Json_IsOperatorOrSpace(int c)
+{
+    switch (c)
+    {
+    case '{': case '}':
+    case '[': case ']':
+    case ':': case ',':
+    case ' ': case '\t':
+    case '\n': case '\r':
+        return true;
 
-            case 'b':
-                buffer[length++] = '\b';
-                break;
+    default:
+        return false;
+    }
+}
 
-            case '\\':
-                buffer[length++] = '\\';
-                break;
+/* @funcdef: Json_IsDigit */
+static inline bool Json_IsDigit(int c)
+{
+    return (unsigned)(c - '0') < 10u;
+}
 
-            case '"':
-                buffer[length++] = '\"';
+/* @funcdef: Json_NextToken */
+/* Move to the next structural, return its character or 0 at the end of the document */
+static inline int Json_NextToken(JsonState* state)
+{
+    if (state->IndexCursor >= state->IndexCount)
+    {
+        state->Cursor = state->Length;
+        return 0;
+    }
+
+    const int offset = (int)state->Index[state->IndexCursor++];
+    state->Cursor = offset;
+    return (U8)state->Buffer[offset];
+}
+
+/* @funcdef: Json_PeekToken */
+static inline int Json_PeekToken(JsonState* state)
+{
+    if (state->IndexCursor >= state->IndexCount)
+    {
+        return 0;
+    }
+
+    return (U8)state->Buffer[state->Index[state->IndexCursor]];
+}
+
+/* @funcdef: Json_CheckScalarEnd */
+/* Scalars must be followed by an operator, a whitespace or the end of the document */
+static inline void Json_CheckScalarEnd(JsonState* state, JsonType type, const char* end)
+{
+    if (end < state->Buffer + state->Length && !Json_IsOperatorOrSpace(*end))
+    {
+        state->Cursor = (int)(end - state->Buffer);
+        Json_Panic(state, type, JsonError::UnexpectedToken, "Unexpected '%c'", *end);
+    }
+}
+
+/* @funcdef: Json_NextCount */
+/* Children count of the next array or object, computed by Json_CountValues */
+static inline int Json_NextCount(JsonState* state, JsonType type)
+{
+    if (state->CountsCursor >= state->CountsCount)
+    {
+        Json_Panic(state, type, JsonError::Format, "JSON is not well-formed");
+    }
+
+    return state->Counts[state->CountsCursor++];
+}
+
+/* All parse functions declaration */
+
+static void Json_ParseArray(JsonState* state, Json* outValue);
+static void Json_ParseValue(JsonState* state, int c, Json* outValue);
+static void Json_ParseObject(JsonState* state, Json* outValue);
+static void Json_ParseNumber(JsonState* state, Json* outValue);
+static void Json_ParseString(JsonState* state, Json* outValue);
+
+/* Numbers */
+
+/* @funcdef: Json_CountLeadingZeros */
+static inline int Json_CountLeadingZeros(U64 bits)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanReverse64(&index, bits);
+    return 63 - (int)index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    if (_BitScanReverse(&index, (unsigned long)(bits >> 32)))
+    {
+        return 31 - (int)index;
+    }
+    _BitScanReverse(&index, (unsigned long)bits);
+    return 63 - (int)index;
+#else
+    return __builtin_clzll(bits);
+#endif
+}
+
+/* @funcdef: Json_Multiply128 */
+/* Full 64x64 bits product, return the low half */
+static inline U64 Json_Multiply128(U64 a, U64 b, U64* outHigh)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    return _umul128(a, b, outHigh);
+#elif defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = (unsigned __int128)a * b;
+    *outHigh = (U64)(product >> 64);
+    return (U64)product;
+#else
+    const U64 aLow = (U32)a, aHigh = a >> 32;
+    const U64 bLow = (U32)b, bHigh = b >> 32;
+
+    const U64 lowLow = aLow * bLow;
+    const U64 highLow = aHigh * bLow;
+    const U64 cross = (lowLow >> 32) + (U32)highLow + aLow * bHigh;
+
+    *outHigh = aHigh * bHigh + (highLow >> 32) + (cross >> 32);
+    return (cross << 32) | (U32)lowLow;
+#endif
+}
+
+/* @funcdef: Json_IsEightDigits */
+static inline bool Json_IsEightDigits(U64 chars)
+{
+    return ((chars & 0xF0F0F0F0F0F0F0F0ull) | (((chars + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull;
+}
+
+/* @funcdef: Json_ParseEightDigits */
+/* Value of 8 digits loaded little-endian in a word, with 3 multiplications instead of 8 */
+static inline U32 Json_ParseEightDigits(U64 chars)
+{
+    chars -= 0x3030303030303030ull;
+    chars = chars * 10 + (chars >> 8);
+    chars = ((chars & 0x000000FF000000FFull) * (100 + (1000000ull << 32)) + ((chars >> 16) & 0x000000FF000000FFull) * (1 + (10000ull << 32))) >> 32;
+    return (U32)chars;
+}
+
+/* @funcdef: Json_EiselLemire */
+/* Bits of the double nearest to mantissa * 10^exponent, correctly rounded (Eisel-Lemire, "Number Parsing at a Gigabyte per Second").
+ * The truncated 128-bit product with 5^exponent is always enough for a 64-bit mantissa (Mushtak & Lemire, "Fast Number Parsing Without Fallback").
+ */
+static U64 Json_EiselLemire(U64 mantissa, int exponent)
+{
+    constexpr U64 INFINITY_BITS = 0x7FF0000000000000ull;
+
+    if (mantissa == 0 || exponent < JSON_POWER_OF_FIVE_MIN)
+    {
+        return 0;
+    }
+
+    if (exponent > JSON_POWER_OF_FIVE_MAX)
+    {
+        return INFINITY_BITS;
+    }
+
+    const int leadingZeros = Json_CountLeadingZeros(mantissa);
+    mantissa <<= leadingZeros;
+
+    const U64* powerOfFive = &JsonPowersOfFive[(exponent - JSON_POWER_OF_FIVE_MIN) * 2];
+
+    U64 high;
+    U64 low = Json_Multiply128(mantissa, powerOfFive[0], &high);
+
+    /* Only 55 bits are needed, the lower half of the power matter when they are all set */
+    if ((high & 0x1FF) == 0x1FF)
+    {
+        U64 secondHigh;
+        Json_Multiply128(mantissa, powerOfFive[1], &secondHigh);
+
+        low += secondHigh;
+        high += low < secondHigh;
+    }
+
+    const int upperBit = (int)(high >> 63);
+    U64 bits = high >> (upperBit + 9);
+
+    /* floor(log2(10^exponent)) + 63, biased */
+    int power2 = (((152170 + 65536) * exponent) >> 16) + 63 + upperBit - leadingZeros + 1023;
+
+    if (power2 <= 0)
+    {
+        /* Subnormal, the exponent field is 0 unless rounding carry into the smallest normal */
+        if (-power2 + 1 >= 64)
+        {
+            return 0;
+        }
+
+        bits >>= -power2 + 1;
+        bits += bits & 1;
+        bits >>= 1;
+
+        power2 = bits < (1ull << 52) ? 0 : 1;
+        return ((U64)power2 << 52) | (bits & ((1ull << 52) - 1));
+    }
+
+    /* Exactly halfway between two doubles: round to even (only possible for small exponents) */
+    if (low <= 1 && exponent >= -4 && exponent <= 23 && (bits & 3) == 1 && (bits << (upperBit + 9)) == high)
+    {
+        bits &= ~1ull;
+    }
+
+    bits += bits & 1;
+    bits >>= 1;
+
+    if (bits >= (2ull << 52))
+    {
+        bits = 1ull << 52;
+        power2++;
+    }
+
+    if (power2 >= 0x7FF)
+    {
+        return INFINITY_BITS;
+    }
+
+    return ((U64)power2 << 52) | (bits & ~(1ull << 52));
+}
+
+/* @funcdef: Json_ParseNumber */
+static void Json_ParseNumber(JsonState* state, Json* outValue)
+{
+    /* Exact powers of ten, a double can represent them without rounding */
+    static const double powersOfTen[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+
+    const char* start = state->Buffer + state->Cursor;
+    const char* end = state->Buffer + state->Length;
+    const char* ptr = start;
+
+    bool negative = false;
+    if (*ptr == '+')
+    {
+        Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "JSON does not support number start with '+'");
+    }
+    else if (*ptr == '-')
+    {
+        negative = true;
+        ptr++;
+    }
+
+    if (ptr >= end || !Json_IsDigit(*ptr))
+    {
+        Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "Expected a digit after '-'");
+    }
+
+    if (*ptr == '0' && ptr + 1 < end && Json_IsDigit(ptr[1]))
+    {
+        Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "JSON does not support number start with '0' (only standalone '0' is accepted)");
+    }
+
+    /* Accumulate up to 19 significant digits, the mantissa is exact while not truncated */
+    U64  mantissa = 0;
+    int  digits = 0;
+    int  exponent = 0;
+    bool truncated = false;
+    bool isInteger = true;
+
+    /* The first digit is significant, unless the integer part is a standalone '0' */
+    mantissa = (U64)(*ptr++ - '0');
+    digits = mantissa != 0;
+
+    /* Then 8 digits at a time */
+    while (digits <= 11 && ptr + 8 <= end)
+    {
+        U64 chars;
+        memcpy(&chars, ptr, sizeof(chars));
+        if (!Json_IsEightDigits(chars))
+        {
+            break;
+        }
+
+        mantissa = mantissa * 100000000 + Json_ParseEightDigits(chars);
+        digits += 8;
+        ptr += 8;
+    }
+
+    for (; ptr < end && Json_IsDigit(*ptr); ptr++)
+    {
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10 + (U64)(*ptr - '0');
+            digits++;
+        }
+        else
+        {
+            exponent++;
+            truncated = true;
+        }
+    }
+
+    if (ptr < end && *ptr == '.')
+    {
+        isInteger = false;
+
+        ptr++;
+        if (ptr >= end || !Json_IsDigit(*ptr))
+        {
+            Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "'.' is presented in number token, but require a digit after '.' ('%c')", ptr < end ? *ptr : ' ');
+        }
+
+        /* Leading zeros only move the exponent */
+        if (mantissa == 0)
+        {
+            for (; ptr < end && *ptr == '0'; ptr++)
+            {
+                exponent--;
+            }
+        }
+
+        while (digits <= 11 && ptr + 8 <= end)
+        {
+            U64 chars;
+            memcpy(&chars, ptr, sizeof(chars));
+            if (!Json_IsEightDigits(chars))
+            {
+                break;
+            }
+
+            mantissa = mantissa * 100000000 + Json_ParseEightDigits(chars);
+            digits += 8;
+            exponent -= 8;
+            ptr += 8;
+        }
+
+        for (; ptr < end && Json_IsDigit(*ptr); ptr++)
+        {
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + (U64)(*ptr - '0');
+                digits += mantissa != 0;
+                exponent--;
+            }
+            else
+            {
+                truncated = true;
+            }
+        }
+    }
+
+    if (ptr < end && (*ptr == 'e' || *ptr == 'E'))
+    {
+        isInteger = false;
+
+        ptr++;
+
+        int expSign = 1;
+        if (ptr < end && (*ptr == '-' || *ptr == '+'))
+        {
+            expSign = *ptr == '-' ? -1 : 1;
+            ptr++;
+        }
+
+        if (ptr >= end || !Json_IsDigit(*ptr))
+        {
+            Json_Panic(state, JsonType::Number, JsonError::UnexpectedToken, "'e' is presented in number token, but require a digit after 'e' ('%c')", ptr < end ? *ptr : ' ');
+        }
+
+        int expValue = 0;
+        for (; ptr < end && Json_IsDigit(*ptr); ptr++)
+        {
+            if (expValue < 100000)
+            {
+                expValue = expValue * 10 + (*ptr - '0');
+            }
+        }
+
+        exponent += expSign * expValue;
+    }
+
+    Json_CheckScalarEnd(state, JsonType::Number, ptr);
+
+    /* Integers that fit are kept exact, -0 has no integer representation and stays a double */
+    if (isInteger && !truncated && mantissa <= 0x7FFFFFFFFFFFFFFFull + negative && !(negative && mantissa == 0))
+    {
+        outValue->Type = JsonType::Integer;
+        outValue->Integer = negative ? (I64)(0 - mantissa) : (I64)mantissa;
+        return;
+    }
+
+    double number;
+    if (!truncated && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22)
+    {
+        /* Both operands are exact, so the result is correctly rounded */
+        number = exponent < 0 ? (double)mantissa / powersOfTen[-exponent] : (double)mantissa * powersOfTen[exponent];
+    }
+    else
+    {
+        /* With more than 19 digits the value is between mantissa and mantissa + 1 (times 10^exponent) */
+        const U64 bits = Json_EiselLemire(mantissa, exponent);
+        if (!truncated || bits == Json_EiselLemire(mantissa + 1, exponent))
+        {
+            memcpy(&number, &bits, sizeof(number));
+        }
+        else
+        {
+            /* Rare: the dropped digits decide the rounding, strtod need a null-terminated string */
+            char  small[64];
+            const int length = (int)(ptr - start);
+            if (length >= (int)sizeof(small) && state->IsChunk)
+            {
+                /* Jobs cannot allocate, but in a chunk the top-level ']' always follow and stop strtod */
+                number = fabs(strtod(start, nullptr));
+            }
+            else
+            {
+                char* token = length < (int)sizeof(small) ? small : (char*)MemoryAlloc(length + 1);
+                memcpy(token, start, length);
+                token[length] = '\0';
+
+                number = fabs(strtod(token, nullptr));
+
+                if (token != small)
+                {
+                    MemoryFree(token);
+                }
+            }
+        }
+    }
+
+    outValue->Type = JsonType::Number;
+    outValue->Number = negative ? -number : number;
+}
+
+/* @funcdef: Json_ParseArray */
+static void Json_ParseArray(JsonState* state, Json* outValue)
+{
+    /* Items are parsed in place, the counting pass already know how many they are */
+    const int count = Json_NextCount(state, JsonType::Array);
+
+    Array<Json> values = {};
+    if (count > 0)
+    {
+        values.Items = (Json*)Json_Alloc(state, count * (int)sizeof(Json));
+        values.Capacity = count;
+    }
+
+    if (Json_PeekToken(state) == ']')
+    {
+        Json_NextToken(state);
+    }
+    else
+    {
+        for (;;)
+        {
+            if (values.Count >= count)
+            {
+                Json_Panic(state, JsonType::Array, JsonError::UnmatchToken, "Expected ']'");
+            }
+
+            Json_ParseValue(state, Json_NextToken(state), &values.Items[values.Count++]);
+
+            const int c = Json_NextToken(state);
+            if (c == ']')
+            {
                 break;
+            }
+            else if (c != ',')
+            {
+                Json_Panic(state, JsonType::Array, JsonError::UnmatchToken, "Expected ',' or ']'");
+            }
+        }
+    }
+
+    outValue->Type = JsonType::Array;
+    outValue->Array = values;
+}
+
+/* Json_ParseValue */
+static void Json_ParseValue(JsonState* state, int c, Json* outValue)
+{
+    switch (c)
+    {
+    case '[':
+        Json_ParseArray(state, outValue);
+        break;
+
+    case '{':
+        Json_ParseObject(state, outValue);
+        break;
+
+    case '"':
+        Json_ParseString(state, outValue);
+        break;
+
+    case '+': case '-': case '0':
+    case '1': case '2': case '3':
+    case '4': case '5': case '6':
+    case '7': case '8': case '9':
+        Json_ParseNumber(state, outValue);
+        break;
+
+    case ']': case '}':
+    case ':': case ',':
+        Json_Panic(state, JsonType::Null, JsonError::UnexpectedToken, "Unexpected '%c'", c);
+        break;
+
+    case 0:
+        Json_Panic(state, JsonType::Null, JsonError::UnexpectedToken, "Unexpected end of JSON");
+        break;
+
+    default:
+    {
+        const char* token = state->Buffer + state->Cursor;
+        const int   remain = state->Length - state->Cursor;
+
+        int length;
+        if (remain >= 4 && memcmp(token, "true", 4) == 0)
+        {
+            outValue->Type = JsonType::Boolean;
+            outValue->Boolean = true;
+            length = 4;
+        }
+        else if (remain >= 4 && memcmp(token, "null", 4) == 0)
+        {
+            outValue->Type = JsonType::Null;
+            length = 4;
+        }
+        else if (remain >= 5 && memcmp(token, "false", 5) == 0)
+        {
+            outValue->Type = JsonType::Boolean;
+            outValue->Boolean = false;
+            length = 5;
+        }
+        else
+        {
+            char tmp[256];
+            for (length = 0; length < remain && length < (int)sizeof(tmp) - 1 && !Json_IsOperatorOrSpace(token[length]); length++)
+            {
+                tmp[length] = token[length];
+            }
+            tmp[length] = 0;
+
+            Json_Panic(state, JsonType::Null, JsonError::UnexpectedToken, "Unexpected token '%s'", tmp);
+        }
+
+        Json_CheckScalarEnd(state, outValue->Type, token + length);
+    } break;
+    /* END OF SWITCH STATEMENT */
+    }
+}
+
+/* @funcdef: Json_SkipPlainChars */
+/* Return the first quote, backslash or control character from ptr, or end */
+static inline const char* Json_SkipPlainChars(const char* ptr, const char* end)
+{
+    /* 32 or 16 bytes at a time */
+#if JSON_AVX2
+    const __m256i quote32 = _mm256_set1_epi8('"');
+    const __m256i backslash32 = _mm256_set1_epi8('\\');
+    const __m256i control32 = _mm256_set1_epi8(0x1F);
+    const __m256i zero32 = _mm256_setzero_si256();
+    while (ptr + 32 <= end)
+    {
+        const __m256i chars = _mm256_loadu_si256((const __m256i*)ptr);
+        const U32 mask = (U32)_mm256_movemask_epi8(_mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chars, quote32), _mm256_cmpeq_epi8(chars, backslash32)),
+            _mm256_cmpeq_epi8(_mm256_subs_epu8(chars, control32), zero32)));
+        if (mask != 0)
+        {
+            ptr += Json_CountTrailingZeros(mask);
+            break;
+        }
+        ptr += 32;
+    }
+#endif
+
+#if JSON_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    const __m128i zero = _mm_setzero_si128();
+    while (ptr + 16 <= end)
+    {
+        const __m128i chars = _mm_loadu_si128((const __m128i*)ptr);
+        const int mask = _mm_movemask_epi8(_mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chars, quote), _mm_cmpeq_epi8(chars, backslash)),
+            _mm_cmpeq_epi8(_mm_subs_epu8(chars, control), zero)));
+        if (mask != 0)
+        {
+            ptr += Json_CountTrailingZeros((U64)mask);
+            break;
+        }
+        ptr += 16;
+    }
+#endif
+
+    while (ptr < end && *ptr != '"' && *ptr != '\\' && (U8)*ptr >= 0x20)
+    {
+        ptr++;
+    }
+    return ptr;
+}
+
+/* @funcdef: Json_FindStringEnd */
+/* Find the closing quote of the string content start at ptr.
+ * Return the quote, a newline character (invalid in strings) or a pointer past end when the string is not terminated.
+ */
+static const char* Json_FindStringEnd(const char* ptr, const char* end, bool* outHasEscapes)
+{
+    bool hasEscapes = false;
+    for (;;)
+    {
+        ptr = Json_SkipPlainChars(ptr, end);
+        if (ptr >= end)
+        {
+            *outHasEscapes = hasEscapes;
+            return ptr;
+        }
+
+        switch (*ptr)
+        {
+        case '"':
+        case '\r':
+        case '\n':
+            *outHasEscapes = hasEscapes;
+            return ptr;
+
+        case '\\':
+            hasEscapes = true;
+            ptr += 2;
+            break;
+
+        default:
+            ptr++;
+            break;
+        }
+    }
+}
+
+/* @funcdef: Json_ScanString */
+/* Find the closing quote of the string start at the cursor, return its offset */
+static int Json_ScanString(JsonState* state, bool* outHasEscapes)
+{
+    const char* end = state->Buffer + state->Length;
+    const char* ptr = Json_FindStringEnd(state->Buffer + state->Cursor + 1, end, outHasEscapes);
+
+    if (ptr >= end)
+    {
+        state->Cursor = state->Length;
+        Json_Panic(state, JsonType::String, JsonError::UnmatchToken, "Expected '\"'");
+    }
+
+    if (*ptr != '"')
+    {
+        state->Cursor = (int)(ptr - state->Buffer);
+        Json_Panic(state, JsonType::String, JsonError::UnexpectedToken, "Unexpected newline characters '%c'", *ptr);
+    }
+
+    return (int)(ptr - state->Buffer);
+}
+
+/* @funcdef: Json_ReadHex4 */
+/* Read the 4 hex digits after source[*i], return -1 when one is invalid (*i is moved to it) */
+static int Json_ReadHex4(const char* source, int sourceLength, int* i)
+{
+    int value = 0;
+    for (int j = 0; j < 4; j++)
+    {
+        const int c = ++*i < sourceLength ? (U8)source[*i] : 0;
+        if (!isxdigit(c))
+        {
+            return -1;
+        }
+
+        value = value * 16 + (isdigit(c) ? c - '0' : (c | 0x20) - 'a' + 10);
+    }
+
+    return value;
+}
+
+/* @funcdef: Json_UnescapeString */
+/* Decode the escape sequences of source into buffer (at least sourceLength bytes), return the decoded length.
+ * Return -1 on invalid escape sequence (the cursor is moved to it), so the caller can release buffer before panic.
+ */
+static int Json_UnescapeString(JsonState* state, const char* source, int sourceLength, char* buffer)
+{
+    int length = 0;
+    for (int i = 0; i < sourceLength; i++)
+    {
+        int c0 = (U8)source[i];
+        if (c0 != '\\')
+        {
+            buffer[length++] = (char)c0;
+            continue;
+        }
+
+        c0 = (U8)source[++i];
+        switch (c0)
+        {
+        case 'n':
+            buffer[length++] = '\n';
+            break;
+
+        case 't':
+            buffer[length++] = '\t';
+            break;
+
+        case 'r':
+            buffer[length++] = '\r';
+            break;
+
+        case 'b':
+            buffer[length++] = '\b';
+            break;
+
+        case 'f':
+            buffer[length++] = '\f';
+            break;
+
+        case '/':
+            buffer[length++] = '/';
+            break;
+
+        case '\\':
+            buffer[length++] = '\\';
+            break;
+
+        case '"':
+            buffer[length++] = '\"';
+            break;
+
+        case 'u':
+        {
+            int c1 = Json_ReadHex4(source, sourceLength, &i);
+            if (c1 < 0)
+            {
+                state->Cursor = (int)(source + i - state->Buffer);
+                return -1;
+            }
+
+            /* A high surrogate followed by a low one is a pair, \uXXXX\uXXXX take 12 bytes of source and 4 bytes of UTF-8.
+             * Unpaired surrogates cannot be encoded in UTF-8, they become U+FFFD.
+             */
+            if (c1 >= 0xD800 && c1 <= 0xDBFF && i + 2 < sourceLength && source[i + 1] == '\\' && source[i + 2] == 'u')
+            {
+                int j = i + 2;
+                const int c2 = Json_ReadHex4(source, sourceLength, &j);
+                if (c2 >= 0xDC00 && c2 <= 0xDFFF)
+                {
+                    c1 = 0x10000 + ((c1 - 0xD800) << 10) + (c2 - 0xDC00);
+                    i = j;
+                }
+            }
+
+            /* \uXXXX take 6 bytes of source and at most 3 bytes of UTF-8 */
+            length += Utf8Encode((U32)c1, buffer + length);
+        } break;
+
+        default:
+            state->Cursor = (int)(source + i - state->Buffer);
+            return -1;
+        }
+    }
+
+    return length;
+}
+
+/* @funcdef: Json_DecodeString */
+/* Decode the string scanned from start to end into the arena, or in place in situ */
+static String Json_DecodeString(JsonState* state, int start, int end, bool hasEscapes, JsonType type)
+{
+    const int sourceLength = end - start;
+
+    if (sourceLength == 0)
+    {
+        return RefString("", 0, false);
+    }
+
+    /* In situ the string is decoded in place, it never outgrow its source and the closing quote become the null terminator */
+    char* string = state->InSitu ? (char*)state->Buffer + start : (char*)Json_Alloc(state, sourceLength + 1);
+
+    int length = sourceLength;
+    if (hasEscapes)
+    {
+        length = Json_UnescapeString(state, state->Buffer + start, sourceLength, string);
+        if (length < 0)
+        {
+            Json_Panic(state, type, JsonError::UnknownToken, "Invalid escape sequence");
+        }
+    }
+    else if (!state->InSitu)
+    {
+        memcpy(string, state->Buffer + start, sourceLength);
+    }
+
+    string[length] = '\0';
+    return RefString(string, length, false);
+}
+
+/* @funcdef: Json_ParseString */
+static void Json_ParseString(JsonState* state, Json* outValue)
+{
+    bool hasEscapes;
+    const int start = state->Cursor + 1;
+    const int end = Json_ScanString(state, &hasEscapes);
+
+    outValue->Type = JsonType::String;
+    outValue->String = Json_DecodeString(state, start, end, hasEscapes, JsonType::String);
+}
+
+/* @funcdef: Json_ParseKey */
+/* Member names are interned per document: equal names share one string, which is only copied once */
+static String Json_ParseKey(JsonState* state, U64* outHash)
+{
+    bool hasEscapes;
+    const int start = state->Cursor + 1;
+    const int end = Json_ScanString(state, &hasEscapes);
+
+    if (!state->Keys.Hashs)
+    {
+        state->Keys = MakeHashTable<String>(Json_HashCount(state->KeysCount / 4));
+    }
+
+    /* Without escapes the source is the name, it is only decoded the first time it is seen */
+    String name;
+    if (hasEscapes)
+    {
+        name = Json_DecodeString(state, start, end, true, JsonType::Object);
+    }
+    else
+    {
+        name = RefString(state->Buffer + start, end - start, false);
+    }
+
+    const U64 hash = CalcHash64(name.Buffer, name.Length);
+    *outHash = hash;
+
+    String* interned;
+    if (HashTable_TryRefValue(state->Keys, hash, &interned))
+    {
+        if (interned->Length == name.Length && memcmp(interned->Buffer, name.Buffer, name.Length) == 0)
+        {
+            return *interned;
+        }
+    }
+
+    if (!hasEscapes)
+    {
+        name = Json_DecodeString(state, start, end, false, JsonType::Object);
+    }
+
+    HashTableSetValue(&state->Keys, hash, name);
+    return name;
+}
+
+/* @funcdef: Json_ParseObject */
+static void Json_ParseObject(JsonState* state, Json* outValue)
+{
+    /* The hash table is sized by the counting pass, so inserting never allocate and values are parsed in place */
+    const int count = Json_NextCount(state, JsonType::Object);
+    const int hashCount = Json_HashCount(count);
+
+    outValue->Type = JsonType::Object;
+    outValue->Object = MakeHashTable<Json>(hashCount);
+
+    HashTable<Json>* values = &outValue->Object;
+    if (count > 0)
+    {
+        const int capacity = (count + 1) & ~1;
+
+        values->Hashs = (I32*)Json_Alloc(state, hashCount * (int)sizeof(I32));
+        memset(values->Hashs, 0xFF, hashCount * sizeof(I32));
+
+        /* Key names follow the values, see JsonGetKey */
+        U8* buffer = (U8*)Json_Alloc(state, capacity * (int)(sizeof(I32) + sizeof(U64) + sizeof(Json) + sizeof(String)));
+        values->Nexts = (I32*)buffer;
+        values->Keys = (U64*)(buffer + capacity * sizeof(I32));
+        values->Values = (Json*)(buffer + capacity * (sizeof(I32) + sizeof(U64)));
+        values->Capacity = capacity;
+    }
+
+    if (Json_PeekToken(state) == '}')
+    {
+        Json_NextToken(state);
+        return;
+    }
+
+    for (int members = 0;; members++)
+    {
+        if (members >= count)
+        {
+            Json_Panic(state, JsonType::Object, JsonError::UnmatchToken, "Expected '}'");
+        }
+
+        if (Json_NextToken(state) != '"')
+        {
+            Json_Panic(state, JsonType::Object, JsonError::UnexpectedToken, "Expected <string> for <member-key> of <object>");
+        }
+
+        U64 hash;
+        const String name = Json_ParseKey(state, &hash);
+
+        if (Json_NextToken(state) != ':')
+        {
+            Json_Panic(state, JsonType::Object, JsonError::UnmatchToken, "Expected ':'");
+        }
+
+        /* Duplicated keys keep the last value */
+        Json* value;
+        const int index = HashTableGetValueOrNewSlot(values, hash, &value);
+        ((String*)(values->Values + values->Capacity))[index] = name;
+        Json_ParseValue(state, Json_NextToken(state), value);
+
+        const int c = Json_NextToken(state);
+        if (c == '}')
+        {
+            break;
+        }
+        else if (c != ',')
+        {
+            Json_Panic(state, JsonType::Object, JsonError::UnmatchToken, "Expected ',' or '}'");
+        }
+    }
+}
+
+/* Parallel parsing of large top-level arrays */
+
+constexpr int JSON_PARALLEL_MIN_SIZE    = 1024 * 1024;  /* Smaller documents parse faster than the jobs start */
+constexpr int JSON_PARALLEL_MIN_CHUNK   = 256 * 1024;
+
+/// JsonChunk
+/// Consecutive items of the top-level array, parsed by one job into its own state
+struct JsonChunk
+{
+    int                 FirstItem;
+    int                 ItemCount;
+    bool                Last;
+
+    int                 IndexCursor;    /* First structural of the chunk */
+    int                 CountsCursor;   /* First container of the chunk */
+    int                 KeysCount;
+    I64                 ArenaSize;
+
+    JsonState*          State;
+    Json*               Items;
+    std::atomic<I32>*   Pending;
+};
+
+/* @funcdef: Json_SplitArray */
+/* Split the top-level array at item boundaries into chunks of about the same size.
+ * Return false when the document is too small to be worth it, or is not a single array.
+ */
+static bool Json_SplitArray(JsonState* state, Array<JsonChunk>* outChunks)
+{
+    const int workerCount = GetJobWorkerCount();
+    if (workerCount == 0 || state->Length < JSON_PARALLEL_MIN_SIZE || state->CountsCount == 0 || state->Counts[0] < 2)
+    {
+        return false;
+    }
+
+    /* Trailing values are an error the serial parser reports */
+    const int indexCount = state->IndexCount;
+    if ((U8)state->Buffer[state->Index[indexCount - 1]] != ']')
+    {
+        return false;
+    }
+
+    /* A few chunks per thread, so the threads that finish first take more */
+    int chunkSize = state->Length / ((workerCount + 1) * 4);
+    if (chunkSize < JSON_PARALLEL_MIN_CHUNK)
+    {
+        chunkSize = JSON_PARALLEL_MIN_CHUNK;
+    }
+
+    JsonChunk chunk = {};
+    chunk.IndexCursor = 1;
+    chunk.CountsCursor = 1;
+
+    int chunkStart = state->Index[1];
+    int containers = 1;
+    int depth = 1;
+    int item = 0;
+
+    for (int i = 1; i < indexCount; i++)
+    {
+        const int offset = (int)state->Index[i];
+        const int c = (U8)state->Buffer[offset];
+        switch (c)
+        {
+        case '[':
+        case '{':
+            chunk.ArenaSize += Json_ArenaSizeOf(c == '[' ? JsonType::Array : JsonType::Object, state->Counts[containers++]);
+            depth++;
+            break;
+
+        case ']':
+        case '}':
+            /* The root must only close at the last structural */
+            if (--depth == 0 && i != indexCount - 1)
+            {
+                FreeArray(outChunks);
+                return false;
+            }
+            break;
+
+        case '"':
+            chunk.ArenaSize += state->InSitu ? 0 : JSON_ARENA_ALIGNMENT;
+            break;
+
+        case ':':
+            chunk.KeysCount++;
+            break;
+
+        case ',':
+            if (depth == 1)
+            {
+                item++;
+
+                if (offset - chunkStart >= chunkSize && i + 1 < indexCount - 1)
+                {
+                    chunk.ItemCount = item - chunk.FirstItem;
+                    chunk.ArenaSize += state->InSitu ? 0 : offset - chunkStart;
+                    ArrayPush(outChunks, chunk);
+
+                    chunk = {};
+                    chunk.FirstItem = item;
+                    chunk.IndexCursor = i + 1;
+                    chunk.CountsCursor = containers;
+                    chunkStart = (int)state->Index[i + 1];
+                }
+            }
+            break;
+        }
+    }
+
+    if (depth != 0 || outChunks->Count == 0)
+    {
+        FreeArray(outChunks);
+        return false;
+    }
+
+    chunk.ItemCount = state->Counts[0] - chunk.FirstItem;
+    chunk.ArenaSize += state->InSitu ? 0 : state->Length - chunkStart;
+    chunk.Last = true;
+    ArrayPush(outChunks, chunk);
+
+    return true;
+}
+
+/* @funcdef: Json_ParseChunk */
+/* Job: parse the items of a chunk, errors are kept in the chunk state */
+static void Json_ParseChunk(void* data)
+{
+    JsonChunk* chunk = (JsonChunk*)data;
+    JsonState* state = chunk->State;
+
+    if (setjmp(state->ErrorJump) == 0)
+    {
+        for (int i = 0, n = chunk->ItemCount; i < n; i++)
+        {
+            Json_ParseValue(state, Json_NextToken(state), &chunk->Items[i]);
+
+            /* Items are followed by ',' except the last one of the array */
+            const int expected = (chunk->Last && i == n - 1) ? ']' : ',';
+            if (Json_NextToken(state) != expected)
+            {
+                Json_Panic(state, JsonType::Array, JsonError::UnmatchToken, "Expected ',' or ']'");
+            }
+        }
+    }
+
+    chunk->Pending->fetch_sub(1, std::memory_order_release);
+}
+
+/* @funcdef: Json_ParseChunks */
+/* Parse the chunks on the job system then stitch the items in the root array.
+ * The heap is not thread-safe: the chunk states, arenas and key tables are all allocated here beforehand.
+ */
+static bool Json_ParseChunks(JsonState* state, Array<JsonChunk> chunks)
+{
+    const int itemCount = state->Counts[0];
+    Json* items = (Json*)Json_Alloc(state, itemCount * (int)sizeof(Json));
+
+    for (int i = 0; i < chunks.Count; i++)
+    {
+        JsonChunk* chunk = &chunks.Items[i];
+
+        JsonState* chunkState = JsonState_Make(state->Buffer, state->Length);
+        if (!chunkState)
+        {
+            Json_Panic(state, JsonType::Null, JsonError::OutOfMemory, "Out of memory");
+        }
+
+        /* Owned by the document from now on, freed with it even on errors */
+        chunkState->Next = state->Next;
+        state->Next = chunkState;
+
+        chunkState->IsChunk = true;
+        chunkState->InSitu = state->InSitu;
+
+        chunkState->Index = state->Index;
+        chunkState->IndexCount = state->IndexCount;
+        chunkState->IndexCursor = chunk->IndexCursor;
+
+        chunkState->Counts = state->Counts;
+        chunkState->CountsCount = state->CountsCount;
+        chunkState->CountsCursor = chunk->CountsCursor;
+
+        /* One more key than counted: a malformed member is interned before its ':' is checked */
+        chunkState->KeysCount = chunk->KeysCount;
+        chunkState->Keys = MakeHashTable<String>(Json_HashCount(chunk->KeysCount / 4));
+        chunkState->Keys.Hashs = (I32*)MemoryAlloc(chunkState->Keys.HashCount * (int)sizeof(I32));
+        chunkState->ErrorMessage = (char*)MemoryAlloc(JSON_ERROR_MESSAGE_SIZE);
+
+        const I64 arenaSize = chunk->ArenaSize > JSON_ARENA_ALIGNMENT ? chunk->ArenaSize : JSON_ARENA_ALIGNMENT;
+        if (!chunkState->Keys.Hashs || !chunkState->ErrorMessage
+            || !HashTableEnsure(&chunkState->Keys, chunk->KeysCount + 1)
+            || arenaSize > 0x7FFFFFFF - (I64)sizeof(JsonArena) || !JsonArena_Push(chunkState, (int)arenaSize))
+        {
+            Json_Panic(state, JsonType::Null, JsonError::OutOfMemory, "Out of memory");
+        }
+
+        memset(chunkState->Keys.Hashs, -1, chunkState->Keys.HashCount * sizeof(I32));
+        chunkState->ErrorMessage[0] = '\0';
+
+        chunk->State = chunkState;
+        chunk->Items = items + chunk->FirstItem;
+    }
+
+    std::atomic<I32> pending(chunks.Count);
+
+    Job* jobs = (Job*)MemoryAlloc(chunks.Count * (int)sizeof(Job));
+    if (!jobs)
+    {
+        Json_Panic(state, JsonType::Null, JsonError::OutOfMemory, "Out of memory");
+    }
+
+    for (int i = 0; i < chunks.Count; i++)
+    {
+        chunks.Items[i].Pending = &pending;
+        jobs[i] = { &chunks.Items[i], Json_ParseChunk, "Json_ParseChunk" };
+    }
+
+    StartJobs(jobs, chunks.Count);
+    WaitForJobs(&pending);
+    MemoryFree(jobs);
+
+    /* Report the first error in document order, like the serial parser */
+    for (int i = 0; i < chunks.Count; i++)
+    {
+        JsonState* chunkState = chunks.Items[i].State;
+        JsonState_FreeScratch(chunkState);
+
+        if (chunkState->ErrorCode != JsonError::None && state->ErrorCode == JsonError::None)
+        {
+            char* message = state->ErrorMessage;
+            state->ErrorMessage = chunkState->ErrorMessage;
+            state->ErrorCode = chunkState->ErrorCode;
+            chunkState->ErrorMessage = message;
+        }
+    }
+
+    if (state->ErrorCode != JsonError::None)
+    {
+        return false;
+    }
+
+    state->Root.Type = JsonType::Array;
+    state->Root.Array.Items = items;
+    state->Root.Array.Count = itemCount;
+    state->Root.Array.Capacity = itemCount;
+    return true;
+}
+
+/* Internal parsing function
+ */
+static Json* Json_ParseTopLevel(JsonState* state)
+{
+    if (!state)
+    {
+        return NULL;
+    }
+
+    /* JSON text is UTF-8, checked up front at memory speed so strings can be used as is */
+    const int invalidIndex = Utf8InvalidIndex(StringView(state->Buffer, state->Length));
+    if (invalidIndex > -1)
+    {
+        state->Cursor = invalidIndex;
+        Json_SetError(state, JsonType::Null, JsonError::Format, "Invalid UTF-8 sequence");
+        return NULL;
+    }
+
+    state->Index = (U32*)MemoryAlloc(sizeof(U32) * (state->Length + 1));
+    state->IndexCount = Json_BuildIndex(state->Buffer, state->Length, state->Index);
+    state->IndexCursor = 0;
+
+    const int c = Json_NextToken(state);
+    if (c != '{' && c != '[')
+    {
+        Json_SetError(state, JsonType::Null, JsonError::Format, "JSON must be starting with '{' or '[', first character is '%c'", c);
+        return NULL;
+    }
+
+    /* One block for the whole tree, large arrays are split and each chunk get its own */
+    Array<JsonChunk> chunks = {};
+    const I64 countedSize = Json_CountValues(state);
+    const bool parallel = c == '[' && Json_SplitArray(state, &chunks);
+    const I64 arenaSize = parallel ? Json_ArenaSizeOf(JsonType::Array, state->Counts[0]) : countedSize;
+    if (arenaSize > 0x7FFFFFFF - (I64)sizeof(JsonArena) || !JsonArena_Push(state, (int)arenaSize))
+    {
+        FreeArray(&chunks);
+        Json_SetError(state, JsonType::Null, JsonError::OutOfMemory, "Out of memory");
+        return NULL;
+    }
+
+    if (parallel)
+    {
+        volatile bool succeeded = false;
+        if (setjmp(state->ErrorJump) == 0)
+        {
+            succeeded = Json_ParseChunks(state, chunks);
+        }
+
+        FreeArray(&chunks);
+
+        if (!succeeded)
+        {
+            return NULL;
+        }
+
+        JsonState_FreeScratch(state);
+        return &state->Root;
+    }
+
+    if (setjmp(state->ErrorJump) == 0)
+    {
+        Json_ParseValue(state, c, &state->Root);
+
+        if (Json_NextToken(state) != 0)
+        {
+            Json_Panic(state, JsonType::Null, JsonError::Format, "JSON is not well-formed. JSON is start with <%s>.", c == '{' ? "object" : "array");
+        }
+
+        JsonState_FreeScratch(state);
+
+        return &state->Root;
+    }
+    else
+    {
+        return NULL;
+    }
+}
+
+Json* LoadJson(const char* filePath)
+{
+    Buffer content = LoadFileData(StringView(filePath, (int)strlen(filePath)));
+    if (!content.Data)
+    {
+        return nullptr;
+    }
+
+    JsonState* state = JsonState_Make((const char*)content.Data, content.Size);
+    if (!state)
+    {
+        MemoryFree(content.Data);
+        return nullptr;
+    }
+
+    /* The document own the file content, no string need to be copied */
+    state->InSitu = true;
+    state->Content = (char*)content.Data;
+
+    Json* value = Json_ParseTopLevel(state);
+
+    if (!value)
+    {
+        JsonState_Free(state);
+    }
+
+    return value;
+}
+
+Json* ParseJson(const char* json)
+{
+    return ParseJson(json, (int)strlen(json));
+}
+
+Json* ParseJson(const char* jsonContent, int jsonLength)
+{
+    JsonState* state = JsonState_Make(jsonContent, jsonLength);
+    Json* value = Json_ParseTopLevel(state);
+
+    if (!value)
+    {
+        JsonState_Free(state);
+    }
+
+    return value;
+}
+
+Json* ParseJsonInSitu(char* json)
+{
+    return ParseJsonInSitu(json, (int)strlen(json));
+}
+
+Json* ParseJsonInSitu(char* jsonContent, int jsonLength)
+{
+    JsonState* state = JsonState_Make(jsonContent, jsonLength);
+    if (state)
+    {
+        state->InSitu = true;
+    }
+
+    Json* value = Json_ParseTopLevel(state);
+
+    if (!value)
+    {
+        JsonState_Free(state);
+    }
+
+    return value;
+}
+
+void FreeJson(Json* rootValue)
+{
+    if (rootValue)
+    {
+        JsonState* state = JSON_SUPEROF(rootValue, JsonState, Root);
+        JsonState_Free(state);
+    }
+}
+
+JsonError JsonGetError(const Json* rootValue)
+{
+    if (rootValue)
+    {
+        JsonState* state = JSON_SUPEROF(rootValue, JsonState, Root);
+        return state->ErrorCode;
+    }
+
+    return JsonError::None;
+}
+
+const char* JsonGetErrorString(const Json* rootValue)
+{
+    if (rootValue)
+    {
+        JsonState* state = JSON_SUPEROF(rootValue, JsonState, Root);
+        return state->ErrorMessage;
+    }
+
+    return "";
+}
+
+bool JsonEquals(Json a, Json b)
+{
+    int i, n;
+
+    if (a.Type != b.Type)
+    {
+        return false;
+    }
+
+    switch (a.Type)
+    {
+    case JsonType::Null:
+        return true;
+
+    case JsonType::Number:
+        return a.Number == b.Number;
+
+    case JsonType::Integer:
+        return a.Integer == b.Integer;
+
+    case JsonType::Boolean:
+        return a.Boolean == b.Boolean;
+
+    case JsonType::Array:
+        if ((n = a.Array.Count) == b.Array.Count)
+        {
+            for (i = 0; i < n; i++)
+            {
+                if (!JsonEquals(a.Array.Items[i], b.Array.Items[i]))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+
+    case JsonType::Object:
+        if ((n = a.Object.Count) == b.Object.Count)
+        {
+            for (i = 0; i < n; i++)
+            {
+                if (a.Object.Keys[i] != b.Object.Keys[i])
+                {
+                    return false;
+                }
+
+                if (!JsonEquals(a.Object.Values[i], b.Object.Values[i]))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+
+    case JsonType::String:
+        return a.String == b.String;
+    }
+
+    return false;
+}
+
+Json JsonFind(const Json obj, const char* name)
+{
+    return JsonFind(obj, CalcHash64(name, (int)strlen(name)));
+}
+
+Json JsonFind(const Json obj, Symbol name)
+{
+    return JsonFind(obj, name.Hash);
+}
+
+Json JsonFind(const Json obj, U64 hash)
+{
+    if (obj.Type == JsonType::Object)
+    {
+        int index = HashTableIndexOf(obj.Object, hash);
+        if (index > -1)
+        {
+            return obj.Object.Values[index];
+        }
+    }
+
+    return {};
+}
+
+String JsonGetKey(const Json obj, int index)
+{
+    if (obj.Type == JsonType::Object && index > -1 && index < obj.Object.Count)
+    {
+        /* Names are stored after the values by Json_ParseObject */
+        const String* names = (const String*)(obj.Object.Values + obj.Object.Capacity);
+        return names[index];
+    }
+
+    return RefString("", 0, false);
+}
+
+/* Pull reader */
+
+enum struct JsonExpect
+{
+    Document,       /* A new top-level document or the end of the input */
+    ValueOrEnd,     /* After '[' */
+    KeyOrEnd,       /* After '{' */
+    Colon,
+    CommaOrEnd,
+};
+
+/// JsonReaderState
+/// Chunk window over the input, the public reader is its first member.
+/// The window is the Buffer/Length of an embedded JsonState, so the scalar parsers and errors are shared with ParseJson.
+struct JsonReaderState
+{
+    JsonReader          Reader;
+    JsonState           State;          /* Buffer is Chunk, Cursor is the next unread byte */
+
+    JsonReadFunc        Read;
+    void*               UserData;
+
+    File                File;
+    bool                OwnsFile;       /* Opened by OpenJsonReader, closed by FreeJsonReader */
+
+    char*               Chunk;
+    int                 ChunkSize;
+    bool                EndOfInput;
+    bool                Skipping;       /* JsonReaderSkip: strings are not decoded */
+
+    JsonExpect          Expect;
+    int                 Depth;
+    U64                 Objects[JSON_READER_MAX_DEPTH / 64];  /* One bit per depth, set for objects */
+};
+
+/* @funcdef: JsonReader_ReadFile */
+static int JsonReader_ReadFile(void* userData, void* buffer, int length)
+{
+    JsonReaderState* reader = (JsonReaderState*)userData;
+    return FileRead(reader->File, buffer, length);
+}
+
+/* @funcdef: JsonReader_Make */
+static JsonReader* JsonReader_Make(JsonReadFunc read, void* userData, int chunkSize)
+{
+    chunkSize = chunkSize > 0 ? chunkSize : JSON_READER_CHUNK_SIZE;
+
+    JsonReaderState* reader = (JsonReaderState*)MemoryAlloc(sizeof(JsonReaderState));
+    char* chunk = (char*)MemoryAlloc(chunkSize);
+    if (!reader || !chunk)
+    {
+        MemoryFree(reader);
+        MemoryFree(chunk);
+        return nullptr;
+    }
+
+    memset(reader, 0, sizeof(JsonReaderState));
+
+    reader->Read = read;
+    reader->UserData = userData;
+
+    reader->Chunk = chunk;
+    reader->ChunkSize = chunkSize;
+    reader->Expect = JsonExpect::Document;
+
+    reader->State.Buffer = chunk;
+    reader->State.InSitu = true;
+    reader->State.StreamOffset = 0;
+
+    return &reader->Reader;
+}
+
+/* @funcdef: JsonReader_Fill */
+/* Discard the bytes before the cursor and read more input after the window, return false at the end of the input */
+static bool JsonReader_Fill(JsonReaderState* reader)
+{
+    JsonState* state = &reader->State;
+    if (reader->EndOfInput)
+    {
+        return false;
+    }
+
+    if (state->Cursor > 0)
+    {
+        const int remain = state->Length - state->Cursor;
+        memmove(reader->Chunk, reader->Chunk + state->Cursor, remain);
+
+        state->StreamOffset += state->Cursor;
+        state->Length = remain;
+        state->Cursor = 0;
+    }
+
+    /* A single token fill the whole chunk */
+    if (state->Length == reader->ChunkSize)
+    {
+        char* chunk = reader->ChunkSize <= 0x3FFFFFFF ? (char*)MemoryRealloc(reader->Chunk, reader->ChunkSize * 2) : nullptr;
+        if (!chunk)
+        {
+            Json_Panic(state, JsonType::Null, JsonError::OutOfMemory, "Out of memory");
+        }
+
+        reader->Chunk = chunk;
+        reader->ChunkSize *= 2;
+        state->Buffer = chunk;
+    }
+
+    const int read = reader->Read(reader->UserData, reader->Chunk + state->Length, reader->ChunkSize - state->Length);
+    if (read < 0)
+    {
+        Json_Panic(state, JsonType::Null, JsonError::InternalError, "Failed to read the input");
+    }
+
+    if (read == 0)
+    {
+        reader->EndOfInput = true;
+        return false;
+    }
+
+    state->Length += read;
+    return true;
+}
+
+/* @funcdef: JsonReader_SkipSpaces */
+/* Return the next non-whitespace character, or -1 at the end of the input */
+static int JsonReader_SkipSpaces(JsonReaderState* reader)
+{
+    JsonState* state = &reader->State;
+    for (;;)
+    {
+        while (state->Cursor < state->Length)
+        {
+            const int c = (U8)state->Buffer[state->Cursor];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+            {
+                return c;
+            }
+
+            state->Cursor++;
+        }
+
+        if (!JsonReader_Fill(reader))
+        {
+            return -1;
+        }
+    }
+}
+
+/* @funcdef: JsonReader_ReadString */
+/* Read the string at the cursor into reader->Reader.String, decoded in the chunk and null-terminated */
+static void JsonReader_ReadString(JsonReaderState* reader, JsonType type)
+{
+    JsonState* state = &reader->State;
+
+    bool hasEscapes;
+    const char* quote;
+    for (;;)
+    {
+        const char* end = state->Buffer + state->Length;
+        quote = Json_FindStringEnd(state->Buffer + state->Cursor + 1, end, &hasEscapes);
+        if (quote < end)
+        {
+            break;
+        }
+
+        /* The cursor stay on the opening quote, so the string is kept by the refill */
+        if (!JsonReader_Fill(reader))
+        {
+            state->Cursor = state->Length;
+            Json_Panic(state, type, JsonError::UnmatchToken, "Expected '\"'");
+        }
+    }
+
+    if (*quote != '"')
+    {
+        state->Cursor = (int)(quote - state->Buffer);
+        Json_Panic(state, type, JsonError::UnexpectedToken, "Unexpected newline characters '%c'", *quote);
+    }
+
+    char* string = reader->Chunk + state->Cursor + 1;
+    int   length = (int)(quote - string);
+    if (hasEscapes && !reader->Skipping)
+    {
+        length = Json_UnescapeString(state, string, length, string);
+        if (length < 0)
+        {
+            Json_Panic(state, type, JsonError::UnknownToken, "Invalid escape sequence");
+        }
+    }
+
+    string[length] = '\0';
+    state->Cursor = (int)(quote - state->Buffer) + 1;
+
+    reader->Reader.String = RefString(string, length);
+}
+
+/* @funcdef: JsonReader_ReadScalar */
+/* Read the number, boolean or null at the cursor */
+static JsonToken JsonReader_ReadScalar(JsonReaderState* reader, int c)
+{
+    JsonState* state = &reader->State;
+
+    /* Make sure the whole token is in the window, the scalar parsers stop at its end */
+    int end = state->Cursor;
+    for (;;)
+    {
+        while (end < state->Length && !Json_IsOperatorOrSpace(state->Buffer[end]))
+        {
+            end++;
+        }
+
+        if (end < state->Length)
+        {
+            break;
+        }
+
+        const int start = state->Cursor;
+        if (!JsonReader_Fill(reader))
+        {
+            break;
+        }
+        end -= start - state->Cursor;
+    }
+
+    Json value;
+    Json_ParseValue(state, c, &value);
+    state->Cursor = end;
+
+    switch (value.Type)
+    {
+    case JsonType::Number:
+        reader->Reader.Number = value.Number;
+        return JsonToken::Number;
+
+    case JsonType::Integer:
+        reader->Reader.Integer = value.Integer;
+        return JsonToken::Integer;
+
+    case JsonType::Boolean:
+        reader->Reader.Boolean = value.Boolean;
+        return JsonToken::Boolean;
+
+    default:
+        return JsonToken::Null;
+    }
+}
+
+/* @funcdef: JsonReader_EndContainer */
+static JsonToken JsonReader_EndContainer(JsonReaderState* reader, int c)
+{
+    JsonState* state = &reader->State;
+
+    const bool isObject = (reader->Objects[(reader->Depth - 1) >> 6] >> ((reader->Depth - 1) & 63)) & 1;
+    if (isObject != (c == '}'))
+    {
+        Json_Panic(state, isObject ? JsonType::Object : JsonType::Array, JsonError::UnmatchToken, "Expected '%c', but got '%c'", isObject ? '}' : ']', c);
+    }
+
+    state->Cursor++;
+
+    reader->Depth--;
+    reader->Reader.Depth = reader->Depth;
+    reader->Expect = reader->Depth > 0 ? JsonExpect::CommaOrEnd : JsonExpect::Document;
+
+    return isObject ? JsonToken::EndObject : JsonToken::EndArray;
+}
+
+/* @funcdef: JsonReader_BeginContainer */
+static JsonToken JsonReader_BeginContainer(JsonReaderState* reader, int c)
+{
+    JsonState* state = &reader->State;
+
+    const bool isObject = c == '{';
+    if (reader->Depth >= JSON_READER_MAX_DEPTH)
+    {
+        Json_Panic(state, isObject ? JsonType::Object : JsonType::Array, JsonError::UnsupportedToken, "JSON is nested deeper than %d", JSON_READER_MAX_DEPTH);
+    }
+
+    const U64 bit = 1ull << (reader->Depth & 63);
+    U64* objects = &reader->Objects[reader->Depth >> 6];
+    *objects = isObject ? (*objects | bit) : (*objects & ~bit);
+
+    state->Cursor++;
+
+    reader->Reader.Depth = reader->Depth++;
+    reader->Expect = isObject ? JsonExpect::KeyOrEnd : JsonExpect::ValueOrEnd;
+
+    return isObject ? JsonToken::BeginObject : JsonToken::BeginArray;
+}
+
+/* @funcdef: JsonReader_ReadKey */
+static JsonToken JsonReader_ReadKey(JsonReaderState* reader, int c)
+{
+    JsonState* state = &reader->State;
+    if (c != '"')
+    {
+        Json_Panic(state, JsonType::Object, JsonError::UnexpectedToken, c < 0 ? "Unexpected end of JSON" : "Expected a key, but got '%c'", c);
+    }
+
+    JsonReader_ReadString(reader, JsonType::Object);
+
+    /* The colon is consumed by the next call, a refill now would move the key */
+    reader->Reader.Depth = reader->Depth;
+    reader->Expect = JsonExpect::Colon;
+    return JsonToken::Key;
+}
+
+/* @funcdef: JsonReader_Next */
+static JsonToken JsonReader_Next(JsonReaderState* reader)
+{
+    JsonState* state = &reader->State;
+
+    int c = JsonReader_SkipSpaces(reader);
+    switch (reader->Expect)
+    {
+    case JsonExpect::Document:
+        if (c < 0)
+        {
+            return JsonToken::End;
+        }
+
+        if (c != '{' && c != '[')
+        {
+            Json_Panic(state, JsonType::Null, JsonError::Format, "JSON must be starting with '{' or '[', first character is '%c'", c);
+        }
+        break;
+
+    case JsonExpect::Colon:
+        if (c != ':')
+        {
+            Json_Panic(state, JsonType::Object, JsonError::UnexpectedToken, c < 0 ? "Unexpected end of JSON" : "Expected ':', but got '%c'", c);
+        }
+
+        state->Cursor++;
+        c = JsonReader_SkipSpaces(reader);
+        break;
+
+    case JsonExpect::CommaOrEnd:
+        if (c == '}' || c == ']')
+        {
+            return JsonReader_EndContainer(reader, c);
+        }
+
+        if (c != ',')
+        {
+            Json_Panic(state, JsonType::Null, JsonError::UnexpectedToken, c < 0 ? "Unexpected end of JSON" : "Expected ',', but got '%c'", c);
+        }
+
+        state->Cursor++;
+        c = JsonReader_SkipSpaces(reader);
+
+        if ((reader->Objects[(reader->Depth - 1) >> 6] >> ((reader->Depth - 1) & 63)) & 1)
+        {
+            return JsonReader_ReadKey(reader, c);
+        }
+        break;
+
+    case JsonExpect::KeyOrEnd:
+        if (c == '}')
+        {
+            return JsonReader_EndContainer(reader, c);
+        }
+        return JsonReader_ReadKey(reader, c);
+
+    case JsonExpect::ValueOrEnd:
+        if (c == ']')
+        {
+            return JsonReader_EndContainer(reader, c);
+        }
+        break;
+    }
+
+    switch (c)
+    {
+    case '{':
+    case '[':
+        return JsonReader_BeginContainer(reader, c);
+
+    case -1:
+        Json_Panic(state, JsonType::Null, JsonError::Format, "Unexpected end of JSON");
+        break;
+
+    default:
+        break;
+    }
+
+    JsonToken token;
+    if (c == '"')
+    {
+        JsonReader_ReadString(reader, JsonType::String);
+        token = JsonToken::String;
+    }
+    else
+    {
+        token = JsonReader_ReadScalar(reader, c);
+    }
+
+    reader->Reader.Depth = reader->Depth;
+    reader->Expect = JsonExpect::CommaOrEnd;
+    return token;
+}
+
+JsonReader* OpenJsonReader(const char* filePath, int chunkSize)
+{
+    File file = OpenFile(StringView(filePath, (int)strlen(filePath)), FileMode::Read);
+    if (!file)
+    {
+        return nullptr;
+    }
+
+    JsonReader* reader = MakeJsonReader(file, chunkSize);
+    if (!reader)
+    {
+        CloseFile(file);
+        return nullptr;
+    }
+
+    JsonReaderState* state = JSON_SUPEROF(reader, JsonReaderState, Reader);
+    state->OwnsFile = true;
+    return reader;
+}
+
+JsonReader* MakeJsonReader(File file, int chunkSize)
+{
+    JsonReader* reader = JsonReader_Make(JsonReader_ReadFile, nullptr, chunkSize);
+    if (reader)
+    {
+        JsonReaderState* state = JSON_SUPEROF(reader, JsonReaderState, Reader);
+        state->UserData = state;
+        state->File = file;
+    }
+
+    return reader;
+}
+
+JsonReader* MakeJsonReader(JsonReadFunc read, void* userData, int chunkSize)
+{
+    return JsonReader_Make(read, userData, chunkSize);
+}
+
+void FreeJsonReader(JsonReader* reader)
+{
+    if (reader)
+    {
+        JsonReaderState* state = JSON_SUPEROF(reader, JsonReaderState, Reader);
+        if (state->OwnsFile)
+        {
+            CloseFile(state->File);
+        }
+
+        MemoryFree(state->Chunk);
+        MemoryFree(state->State.ErrorMessage);
+        MemoryFree(state);
+    }
+}
+
+JsonToken JsonReaderNext(JsonReader* reader)
+{
+    JsonReaderState* state = JSON_SUPEROF(reader, JsonReaderState, Reader);
+    if (reader->Token == JsonToken::Error)
+    {
+        return JsonToken::Error;
+    }
+
+    if (setjmp(state->State.ErrorJump) == 0)
+    {
+        reader->Token = JsonReader_Next(state);
+    }
+    else
+    {
+        reader->Token = JsonToken::Error;
+    }
+
+    return reader->Token;
+}
+
+bool JsonReaderSkip(JsonReader* reader)
+{
+    JsonReaderState* state = JSON_SUPEROF(reader, JsonReaderState, Reader);
 
-            case 'u':
-                c1 = 0;
-                for (i = 0; i < 4; i++)
-                {
-                    if (isxdigit((c0 = Json_NextChar(state))))
-                    {
-                        c1 = c1 * 10 + (isdigit(c0) ? c0 - '0' : c0 < 'a' ? c0 - 'A' : c0 - 'a');
-                    }
-                    else
-                    {
-                        Json_Panic(state, JsonType::String, JsonError::UnknownToken, "Expected hexa character in unicode character");
-                    }
-                }
+    /* Skipping a key skip its value */
+    if (reader->Token == JsonToken::Key)
+    {
+        JsonReaderNext(reader);
+    }
 
-                if (c1 <= 0x7F)
-                {
-                    buffer[length++] = c1;
-                }
-                else if (c1 <= 0x7FF)
-                {
-                    char c2 = (char)(0xC0 | (c1 >> 6));            /* 110xxxxx */
-                    char c3 = (char)(0x80 | (c1 & 0x3F));          /* 10xxxxxx */
-                    buffer[length++] = c2;
-                    buffer[length++] = c3;
-                }
-                else if (c1 <= 0xFFFF)
-                {
-                    char c2 = (char)(0xE0 | (c1 >> 12));           /* 1110xxxx */
-                    char c3 = (char)(0x80 | ((c1 >> 6) & 0x3F));   /* 10xxxxxx */
-                    char c4 = (char)(0x80 | (c1 & 0x3F));          /* 10xxxxxx */
-                    buffer[length++] = c2;
-                    buffer[length++] = c3;
-                    buffer[length++] = c4;
-                }
-                else if (c1 <= 0x10FFFF)
-                {
-                    char c2 = 0xF0 | (c1 >> 18);           /* 11110xxx */
-                    char c3 = 0x80 | ((c1 >> 12) & 0x3F);  /* 10xxxxxx */
-                    char c4 = 0x80 | ((c1 >> 6) & 0x3F);   /* 10xxxxxx */
-                    char c5 = 0x80 | (c1 & 0x3F);          /* 10xxxxxx */
-                    buffer[length++] = c2;
-                    buffer[length++] = c3;
-                    buffer[length++] = c4;
-                    buffer[length++] = c5;
-                }
-                break;
+    if (reader->Token == JsonToken::BeginObject || reader->Token == JsonToken::BeginArray)
+    {
+        const int depth = reader->Depth;
 
-            default:
-                Json_Panic(state, JsonType::String, JsonError::UnknownToken, "Unknown escape character");
-                break;
-            }
-        }
-        else
+        /* Skipped strings are only scanned, their escape sequences are not decoded */
+        state->Skipping = true;
+        for (;;)
         {
-            switch (c0)
+            const JsonToken token = JsonReaderNext(reader);
+            if (token == JsonToken::Error || (reader->Depth == depth && (token == JsonToken::EndObject || token == JsonToken::EndArray)))
             {
-            case '\r':
-            case '\n':
-                Json_Panic(state, JsonType::String, JsonError::UnexpectedToken, "Unexpected newline characters '%c'", c0);
-                break;
-
-            default:
-                buffer[length++] = (char)c0;
                 break;
             }
         }
-
-        Json_NextChar(state);
+        state->Skipping = false;
     }
 
-    Json_MatchChar(state, JsonType::String, '"');
-    if (length > 0)
+    return reader->Token != JsonToken::Error;
+}
+
+JsonError JsonReaderGetError(const JsonReader* reader)
+{
+    if (reader)
     {
-        buffer[length] = '\0';
-        if (outLength) *outLength = length;
+        JsonReaderState* state = JSON_SUPEROF(reader, JsonReaderState, Reader);
+        return state->State.ErrorCode;
+    }
 
-        char* string = (char*)MemoryAlloc(length + 1);
-        memcpy(string, buffer, length + 1);
+    return JsonError::None;
+}
 
-        return string;
-    }
-    else
+const char* JsonReaderGetErrorString(const JsonReader* reader)
+{
+    if (reader)
     {
-        buffer[length] = '\0';
-        if (outLength) *outLength = 0;
-        return "";
+        JsonReaderState* state = JSON_SUPEROF(reader, JsonReaderState, Reader);
+        return state->State.ErrorMessage ? state->State.ErrorMessage : "";
     }
+
+    return "";
 }
 
-/* @funcdef: Json_ParseString */
-static void Json_ParseString(JsonState* state, Json* outValue)
+/* Writer */
+
+/// JsonWriterState
+/// Output buffer and layout state, the public writer is its first member.
+struct JsonWriterState
+{
+    JsonWriter          Writer;
+
+    File                File;           /* 0 when writing into the buffer only */
+    int                 Capacity;
+    bool                Failed;
+
+    int                 Indent;
+    int                 Depth;
+    bool                First;          /* Nothing written yet in the current container */
+    bool                AfterKey;       /* The next value follow a key, no separator */
+};
+
+/* @funcdef: JsonWriter_Make */
+static JsonWriter* JsonWriter_Make(File file, int indent)
 {
-    if (Json_SkipSpace(state) > 0)
+    JsonWriterState* state = (JsonWriterState*)MemoryAlloc((int)sizeof(JsonWriterState));
+    if (!state)
     {
-        int length;
-        char* string = Json_ParseStringNoToken(state, &length);
+        return nullptr;
+    }
 
-        outValue->Type = JsonType::String;
-        outValue->String = RefString(string, length, length > 0);
+    memset(state, 0, sizeof(*state));
+    state->Writer.Buffer = (char*)MemoryAlloc(JSON_WRITER_CHUNK_SIZE);
+    if (!state->Writer.Buffer)
+    {
+        MemoryFree(state);
+        return nullptr;
     }
+
+    state->File = file;
+    state->Capacity = JSON_WRITER_CHUNK_SIZE;
+    state->Indent = indent > 0 ? indent : 0;
+    state->First = true;
+    return &state->Writer;
 }
 
-/* @funcdef: Json_ParseObject */
-static void Json_ParseObject(JsonState* state, Json* outValue)
+/* @funcdef: JsonWriter_Reserve */
+/* Make room for size more bytes: file writers flush first, the buffer only grows for a larger write */
+static bool JsonWriter_Reserve(JsonWriterState* state, int size)
 {
-    if (Json_SkipSpace(state) > 0)
+    JsonWriter* writer = &state->Writer;
+    if (writer->Length + size <= state->Capacity)
     {
-        Json_MatchChar(state, JsonType::Object, '{');
+        return true;
+    }
 
-        HashTable<Json> values = MakeHashTable<Json>(64);
-        while (Json_SkipSpace(state) > 0 && Json_PeekChar(state) != '}')
+    if (state->File)
+    {
+        JsonWriterFlush(writer);
+        if (size <= state->Capacity)
         {
-            if (values.Count > 0)
-            {
-                Json_MatchChar(state, JsonType::Object, ',');
-            }
+            return true;
+        }
+    }
 
-            if (Json_SkipSpace(state) != '"')
-            {
-                Json_Panic(state, JsonType::Object, JsonError::UnexpectedToken, "Expected <string> for <member-key> of <object>");
-            }
+    int capacity = state->Capacity;
+    while (capacity < writer->Length + size)
+    {
+        capacity *= 2;
+    }
+
+    char* buffer = (char*)MemoryRealloc(writer->Buffer, capacity);
+    if (!buffer)
+    {
+        state->Failed = true;
+        return false;
+    }
 
-            int   nameLength;
-            char* name = Json_ParseStringNoToken(state, &nameLength);
+    writer->Buffer = buffer;
+    state->Capacity = capacity;
+    return true;
+}
 
-            Json_SkipSpace(state);
-            Json_MatchChar(state, JsonType::Object, ':');
+/* @funcdef: JsonWriter_Put */
+static inline void JsonWriter_Put(JsonWriterState* state, const char* text, int length)
+{
+    if (state->Writer.Length + length <= state->Capacity || JsonWriter_Reserve(state, length))
+    {
+        memcpy(state->Writer.Buffer + state->Writer.Length, text, length);
+        state->Writer.Length += length;
+    }
+}
 
-            Json value;
-            Json_ParseSingle(state, &value);
+/* @funcdef: JsonWriter_NewLine */
+static void JsonWriter_NewLine(JsonWriterState* state)
+{
+    const int length = 1 + state->Indent * state->Depth;
+    if (JsonWriter_Reserve(state, length))
+    {
+        char* text = state->Writer.Buffer + state->Writer.Length;
+        text[0] = '\n';
+        memset(text + 1, ' ', length - 1);
+        state->Writer.Length += length;
+    }
+}
 
-            HashTableSetValue(&values, CalcHash64(name, nameLength), value);
+/* @funcdef: JsonWriter_BeginValue */
+/* Separator before a value or a key: ',' between members, and a new line in pretty output */
+static void JsonWriter_BeginValue(JsonWriterState* state)
+{
+    if (state->AfterKey)
+    {
+        state->AfterKey = false;
+        return;
+    }
 
-            MemoryFree(name);
+    if (state->Depth == 0)
+    {
+        if (!state->First)
+        {
+            JsonWriter_Put(state, "\n", 1);
+        }
+    }
+    else
+    {
+        if (!state->First)
+        {
+            JsonWriter_Put(state, ",", 1);
         }
 
-        Json_SkipSpace(state);
-        Json_MatchChar(state, JsonType::Object, '}');
-
-        outValue->Type = JsonType::Object;
-        outValue->Object = values;
+        if (state->Indent > 0)
+        {
+            JsonWriter_NewLine(state);
+        }
     }
+
+    state->First = false;
 }
 
-/* Internal parsing function
- */
-static Json* Json_ParseTopLevel(JsonState* state)
+/* @funcdef: JsonWriter_BeginContainer */
+static void JsonWriter_BeginContainer(JsonWriterState* state, char c)
 {
-    if (!state)
+    JsonWriter_BeginValue(state);
+    JsonWriter_Put(state, &c, 1);
+
+    state->Depth++;
+    state->First = true;
+}
+
+/* @funcdef: JsonWriter_EndContainer */
+static void JsonWriter_EndContainer(JsonWriterState* state, char c)
+{
+    DebugAssert(state->Depth > 0 && !state->AfterKey, "JsonWriter: unbalanced end of container");
+
+    state->Depth--;
+    if (!state->First && state->Indent > 0)
     {
-        return NULL;
+        JsonWriter_NewLine(state);
     }
 
-    if (Json_SkipSpace(state) == '{')
+    JsonWriter_Put(state, &c, 1);
+    state->First = false;
+}
+
+/* @funcdef: JsonWriter_PutString */
+/* Quote and escape a string, runs without characters to escape are copied at once */
+/* Invalid UTF-8 sequences are written as U+FFFD, so the parser accepts the output */
+static void JsonWriter_PutString(JsonWriterState* state, const char* string, int length)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    JsonWriter_Put(state, "\"", 1);
+
+    const char* ptr = string;
+    const char* end = string + length;
+    while (ptr < end)
     {
-        if (setjmp(state->ErrorJump) == 0)
+        const char* run = ptr;
+        ptr = Json_SkipPlainChars(ptr, end);
+        while (ptr > run)
         {
-            Json_ParseObject(state, &state->Root);
+            /* Runs end on ASCII characters, so a valid sequence never spans two runs */
+            const int invalidIndex = Utf8InvalidIndex(StringView(run, (int)(ptr - run)));
+            if (invalidIndex < 0)
+            {
+                JsonWriter_Put(state, run, (int)(ptr - run));
+                break;
+            }
 
-            Json_SkipSpace(state);
-            if (!Json_IsEOF(state))
+            if (invalidIndex > 0)
             {
-                Json_Panic(state, JsonType::Null, JsonError::Format, "JSON is not well-formed. JSON is start with <object>.");
+                JsonWriter_Put(state, run, invalidIndex);
             }
 
-            return &state->Root;
+            int  invalidLength;
+            char replacement[UTF8_MAX_BYTES];
+            Utf8Decode(run + invalidIndex, (int)(ptr - run) - invalidIndex, &invalidLength);
+            JsonWriter_Put(state, replacement, Utf8Encode(UTF8_REPLACEMENT_CHAR, replacement));
+            run += invalidIndex + invalidLength;
         }
-        else
+
+        if (ptr == end)
         {
-            return NULL;
+            break;
         }
-    }
-    else if (Json_SkipSpace(state) == '[')
-    {
-        if (setjmp(state->ErrorJump) == 0)
-        {
-            Json_ParseArray(state, &state->Root);
 
-            Json_SkipSpace(state);
-            if (!Json_IsEOF(state))
-            {
-                Json_Panic(state, JsonType::Null, JsonError::Format, "JSON is not well-formed. JSON is start with <array>.");
-            }
+        char escape[6] = { '\\', 0 };
+        int  escapeLength = 2;
 
-            return &state->Root;
-        }
-        else
+        const U8 c = (U8)*ptr++;
+        switch (c)
         {
-            return NULL;
+        case '"':  escape[1] = '"';  break;
+        case '\\': escape[1] = '\\'; break;
+        case '\b': escape[1] = 'b';  break;
+        case '\f': escape[1] = 'f';  break;
+        case '\n': escape[1] = 'n';  break;
+        case '\r': escape[1] = 'r';  break;
+        case '\t': escape[1] = 't';  break;
+
+        default:
+            escape[1] = 'u';
+            escape[2] = '0';
+            escape[3] = '0';
+            escape[4] = hex[c >> 4];
+            escape[5] = hex[c & 15];
+            escapeLength = 6;
+            break;
         }
+
+        JsonWriter_Put(state, escape, escapeLength);
     }
-    else
-    {
-        Json_SetError(state, JsonType::Null, JsonError::Format, "JSON must be starting with '{' or '[', first character is '%c'", Json_PeekChar(state));
-        return NULL;
-    }
+
+    JsonWriter_Put(state, "\"", 1);
 }
 
-Json* LoadJson(const char* filePath)
+JsonWriter* MakeJsonWriter(int indent)
 {
-    return nullptr;
+    return JsonWriter_Make(0, indent);
 }
 
-Json* ParseJson(const char* json)
+JsonWriter* MakeJsonWriter(File file, int indent)
 {
-    return ParseJson(json, (int)strlen(json));
+    if (!file)
+    {
+        return nullptr;
+    }
+
+    return JsonWriter_Make(file, indent);
 }
 
-Json* ParseJson(const char* jsonContent, int jsonLength)
+void FreeJsonWriter(JsonWriter* writer)
 {
-    JsonState* state = JsonState_Make(jsonContent, jsonLength);
-    Json* value = Json_ParseTopLevel(state);
-
-    if (!value)
+    if (writer)
     {
-        JsonState_Free(state);
-    }
+        JsonWriterFlush(writer);
 
-    return value;
+        JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+        MemoryFree(writer->Buffer);
+        MemoryFree(state);
+    }
 }
 
-void FreeJson(Json* rootValue)
+bool JsonWriterFlush(JsonWriter* writer)
 {
-    if (rootValue)
+    if (!writer)
     {
-        JsonState* state = JSON_SUPEROF(rootValue, JsonState, Root);
-        JsonState_Free(state);
+        return false;
+    }
+
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    if (state->File && writer->Length > 0)
+    {
+        if (FileWrite(state->File, writer->Buffer, writer->Length) != writer->Length)
+        {
+            state->Failed = true;
+        }
+
+        writer->Length = 0;
     }
+
+    return !state->Failed;
 }
 
-JsonError JsonGetError(const Json* rootValue)
+void JsonWriteBeginObject(JsonWriter* writer)
 {
-    if (rootValue)
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    JsonWriter_BeginContainer(state, '{');
+}
+
+void JsonWriteEndObject(JsonWriter* writer)
+{
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    JsonWriter_EndContainer(state, '}');
+}
+
+void JsonWriteBeginArray(JsonWriter* writer)
+{
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    JsonWriter_BeginContainer(state, '[');
+}
+
+void JsonWriteEndArray(JsonWriter* writer)
+{
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    JsonWriter_EndContainer(state, ']');
+}
+
+void JsonWriteKey(JsonWriter* writer, StringView name)
+{
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    DebugAssert(state->Depth > 0 && !state->AfterKey, "JsonWriter: key outside of an object");
+
+    JsonWriter_BeginValue(state);
+    JsonWriter_PutString(state, name.Buffer, name.Length);
+    JsonWriter_Put(state, ": ", state->Indent > 0 ? 2 : 1);
+
+    state->AfterKey = true;
+}
+
+void JsonWriteString(JsonWriter* writer, StringView value)
+{
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    JsonWriter_BeginValue(state);
+    JsonWriter_PutString(state, value.Buffer, value.Length);
+}
+
+void JsonWriteNumber(JsonWriter* writer, double value)
+{
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    JsonWriter_BeginValue(state);
+
+    if (!isfinite(value))
     {
-        JsonState* state = JSON_SUPEROF(rootValue, JsonState, Root);
-        return state->ErrorCode;
+        JsonWriter_Put(state, "null", 4);
+        return;
     }
 
-    return JsonError::None;
+    if (JsonWriter_Reserve(state, FORMAT_NUMBER_SIZE))
+    {
+        state->Writer.Length += FormatDouble(state->Writer.Buffer + state->Writer.Length, value);
+    }
 }
 
-const char* JsonGetErrorString(const Json* rootValue)
+void JsonWriteInteger(JsonWriter* writer, I64 value)
 {
-    if (rootValue)
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    JsonWriter_BeginValue(state);
+
+    if (JsonWriter_Reserve(state, FORMAT_NUMBER_SIZE))
     {
-        JsonState* state = JSON_SUPEROF(rootValue, JsonState, Root);
-        return state->ErrorMessage;
+        state->Writer.Length += FormatInteger(state->Writer.Buffer + state->Writer.Length, value);
     }
+}
 
-    return "";
+void JsonWriteBoolean(JsonWriter* writer, bool value)
+{
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    JsonWriter_BeginValue(state);
+    JsonWriter_Put(state, value ? "true" : "false", value ? 4 : 5);
 }
 
-bool JsonEquals(Json a, Json b)
+void JsonWriteNull(JsonWriter* writer)
 {
-    int i, n;
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    JsonWriter_BeginValue(state);
+    JsonWriter_Put(state, "null", 4);
+}
 
-    if (a.Type != b.Type)
+bool JsonWrite(JsonWriter* writer, const Json value)
+{
+    if (!writer)
     {
         return false;
     }
 
-    switch (a.Type)
+    switch (value.Type)
     {
     case JsonType::Null:
-        return true;
+        JsonWriteNull(writer);
+        break;
 
     case JsonType::Number:
-        return a.Number == b.Number;
+        JsonWriteNumber(writer, value.Number);
+        break;
+
+    case JsonType::Integer:
+        JsonWriteInteger(writer, value.Integer);
+        break;
 
     case JsonType::Boolean:
-        return a.Boolean == b.Boolean;
+        JsonWriteBoolean(writer, value.Boolean);
+        break;
+
+    case JsonType::String:
+        JsonWriteString(writer, value.String);
+        break;
 
     case JsonType::Array:
-        if ((n = a.Array.Count) == b.Array.Count)
+        JsonWriteBeginArray(writer);
+        for (int i = 0, n = value.Array.Count; i < n; i++)
         {
-            for (i = 0; i < n; i++)
-            {
-                if (!JsonEquals(a.Array.Items[i], b.Array.Items[i]))
-                {
-                    return false;
-                }
-            }
+            JsonWrite(writer, value.Array.Items[i]);
         }
-        return true;
+        JsonWriteEndArray(writer);
+        break;
 
     case JsonType::Object:
-        if ((n = a.Object.Count) == b.Object.Count)
+        JsonWriteBeginObject(writer);
+        for (int i = 0, n = value.Object.Count; i < n; i++)
         {
-            for (i = 0; i < n; i++)
-            {
-                if (a.Object.Keys[i] != b.Object.Keys[i])
-                {
-                    return false;
-                }
-
-                if (!JsonEquals(a.Object.Values[i], b.Object.Values[i]))
-                {
-                    return false;
-                }
-            }
+            const String name = JsonGetKey(value, i);
+            JsonWriteKey(writer, name);
+            JsonWrite(writer, value.Object.Values[i]);
         }
-        return true;
-
-    case JsonType::String:
-        return a.String == b.String;
+        JsonWriteEndObject(writer);
+        break;
     }
 
-    return false;
+    JsonWriterState* state = JSON_SUPEROF(writer, JsonWriterState, Writer);
+    return !state->Failed;
 }
 
-Json JsonFind(const Json obj, const char* name)
+bool SaveJson(const char* filePath, const Json value, int indent)
 {
-    return JsonFind(obj, CalcHash64(name, (int)strlen(name)));
-}
+    File file = OpenFile(StringView(filePath, (int)strlen(filePath)), (FileMode)(FileMode::Write | FileMode::Create | FileMode::Truncate));
+    if (!file)
+    {
+        return false;
+    }
 
-Json JsonFind(const Json obj, U64 hash)
-{
-    if (obj.Type == JsonType::Object)
+    JsonWriter* writer = MakeJsonWriter(file, indent);
+    if (!writer)
     {
-        int index = HashTableIndexOf(obj.Object, hash);
-        if (index > -1)
-        {
-            return obj.Object.Values[index];
-        }
+        CloseFile(file);
+        return false;
     }
 
-    return {};
+    JsonWrite(writer, value);
+    const bool result = JsonWriterFlush(writer);
+
+    FreeJsonWriter(writer);
+    CloseFile(file);
+    return result;
 }
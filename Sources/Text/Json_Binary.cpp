@@ -0,0 +1,651 @@
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include <Text/Json.h>
+#include <Text/String.h>
+
+#include <System/Memory.h>
+#include <System/FileSystem.h>
+
+#include <Container/HashTable.h>
+
+// Binary documents are read in place, every record is 8 bytes aligned and found by its offset
+// from the start of the document:
+//
+//  Header  'YJSB', version, document size, root value
+//  Value   U64, tag in the 3 low bits, an inline value or a record offset in the others
+//  Number  double          Integer  I64 (only those that do not fit inline)
+//  String  U32 length, chars, '\0'
+//  Array   U32 count, U32 packing, U64 values[count] (or I32/double items when packed)
+//  Object  U32 count, U32 reserved, U64 hashs[count], U64 values[count], U32 names[count] (offsets of strings)
+//
+// Members are sorted by the key hash (CalcHash64 of the name, as Json objects), strings are
+// stored once and arrays of only small integers or only numbers are packed (tile maps, meshes).
+// The format is little-endian like every platform we ship on.
+
+constexpr U32 JSON_BINARY_MAGIC         = 0x42534A59;   /* "YJSB" */
+constexpr U32 JSON_BINARY_VERSION       = 2;   /* 2: CalcHash64 changed */
+constexpr int JSON_BINARY_ALIGNMENT     = 8;
+constexpr int JSON_BINARY_MIN_CAPACITY  = 64 * 1024;
+
+enum struct JsonBinaryTag
+{
+    Null,
+    Boolean,
+    SmallInteger,   /* 61 bits integer stored in the value itself */
+    Number,
+    Integer,
+    String,
+    Array,
+    Object,
+};
+
+enum struct JsonBinaryPacking
+{
+    Values,
+    Int32,
+    Number,
+};
+
+struct JsonBinaryHeader
+{
+    U32         Magic;
+    U32         Version;
+    U64         Size;
+    U64         Root;
+};
+
+struct JsonBinaryRecord
+{
+    U32         Count;      /* Length of a string, items or members count of a container */
+    U32         Packing;    /* Items of an array, see JsonBinaryPacking */
+};
+
+/// JsonBinaryWriter
+/// Growable output of ConvertJsonToBinary
+struct JsonBinaryWriter
+{
+    U8*             Data;
+    int             Length;
+    int             Capacity;
+    bool            Failed;
+
+    HashTable<int>  Strings;    /* Offset of every string written, by hash */
+};
+
+struct JsonBinaryMember
+{
+    U64         Hash;
+    int         Index;
+};
+
+/* @funcdef: JsonBinary_Tag */
+static inline JsonBinaryTag JsonBinary_Tag(U64 bits)
+{
+    return (JsonBinaryTag)(bits & 7);
+}
+
+/* @funcdef: JsonBinary_Record */
+static inline const JsonBinaryRecord* JsonBinary_Record(const JsonBinary value)
+{
+    return (const JsonBinaryRecord*)(value.Document + (value.Bits >> 3));
+}
+
+/* @funcdef: JsonBinary_Value */
+static inline JsonBinary JsonBinary_Value(const JsonBinary parent, U64 bits)
+{
+    return { parent.Document, bits };
+}
+
+/* @funcdef: JsonBinary_Alloc */
+/* Append a zeroed record, return its offset or -1 when out of memory */
+static int JsonBinary_Alloc(JsonBinaryWriter* writer, I64 size)
+{
+    size = (size + JSON_BINARY_ALIGNMENT - 1) & ~(I64)(JSON_BINARY_ALIGNMENT - 1);
+    if (writer->Failed || writer->Length + size > 0x7FFFFFF8)
+    {
+        writer->Failed = true;
+        return -1;
+    }
+
+    if (writer->Length + size > writer->Capacity)
+    {
+        I64 capacity = writer->Capacity > 0 ? writer->Capacity : JSON_BINARY_MIN_CAPACITY;
+        while (capacity < writer->Length + size)
+        {
+            capacity *= 2;
+        }
+
+        capacity = capacity < 0x7FFFFFF8 ? capacity : 0x7FFFFFF8;
+
+        U8* data = (U8*)MemoryRealloc(writer->Data, (int)capacity);
+        if (!data)
+        {
+            writer->Failed = true;
+            return -1;
+        }
+
+        writer->Data = data;
+        writer->Capacity = (int)capacity;
+    }
+
+    const int offset = writer->Length;
+    memset(writer->Data + offset, 0, (size_t)size);
+    writer->Length += (int)size;
+    return offset;
+}
+
+/* @funcdef: JsonBinary_WriteString */
+/* Strings are stored once, keys and repeated values share their record */
+static int JsonBinary_WriteString(JsonBinaryWriter* writer, const char* string, int length)
+{
+    const U64 hash = CalcHash64(string, length);
+
+    int offset;
+    if (HashTableTryGetValue(writer->Strings, hash, &offset))
+    {
+        const JsonBinaryRecord* record = (const JsonBinaryRecord*)(writer->Data + offset);
+        if ((int)record->Count == length && memcmp(record + 1, string, length) == 0)
+        {
+            return offset;
+        }
+    }
+
+    offset = JsonBinary_Alloc(writer, sizeof(JsonBinaryRecord) + length + 1);
+    if (offset < 0)
+    {
+        return -1;
+    }
+
+    JsonBinaryRecord* record = (JsonBinaryRecord*)(writer->Data + offset);
+    record->Count = (U32)length;
+    memcpy(record + 1, string, length);
+
+    HashTableSetValue(&writer->Strings, hash, offset);
+    return offset;
+}
+
+/* @funcdef: JsonBinary_CompareMembers */
+static int JsonBinary_CompareMembers(const void* a, const void* b)
+{
+    const U64 hashA = ((const JsonBinaryMember*)a)->Hash;
+    const U64 hashB = ((const JsonBinaryMember*)b)->Hash;
+    return hashA < hashB ? -1 : hashA > hashB;
+}
+
+/* @funcdef: JsonBinary_Packing */
+/* Arrays of only integers that fit I32 or only numbers store their items without tags */
+static JsonBinaryPacking JsonBinary_Packing(const Json array)
+{
+    const int count = array.Array.Count;
+    if (count == 0)
+    {
+        return JsonBinaryPacking::Values;
+    }
+
+    const JsonType type = array.Array.Items[0].Type;
+    if (type != JsonType::Integer && type != JsonType::Number)
+    {
+        return JsonBinaryPacking::Values;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        const Json item = array.Array.Items[i];
+        if (item.Type != type || (type == JsonType::Integer && (item.Integer < -0x7FFFFFFFll - 1 || item.Integer > 0x7FFFFFFFll)))
+        {
+            return JsonBinaryPacking::Values;
+        }
+    }
+
+    return type == JsonType::Integer ? JsonBinaryPacking::Int32 : JsonBinaryPacking::Number;
+}
+
+/* @funcdef: JsonBinary_CountStrings */
+/* Keys and string values of a document, an upper bound of the strings written */
+static int JsonBinary_CountStrings(const Json value)
+{
+    int count = 0;
+    switch (value.Type)
+    {
+    case JsonType::String:
+        return 1;
+
+    case JsonType::Array:
+        for (int i = 0; i < value.Array.Count; i++)
+        {
+            count += JsonBinary_CountStrings(value.Array.Items[i]);
+        }
+        return count;
+
+    case JsonType::Object:
+        count = value.Object.Count;
+        for (int i = 0; i < value.Object.Count; i++)
+        {
+            count += JsonBinary_CountStrings(value.Object.Values[i]);
+        }
+        return count;
+
+    default:
+        return 0;
+    }
+}
+
+/* @funcdef: JsonBinary_Write */
+/* Write the records of a value, return its tagged value */
+static U64 JsonBinary_Write(JsonBinaryWriter* writer, const Json value)
+{
+    int offset = -1;
+
+    switch (value.Type)
+    {
+    case JsonType::Null:
+        return (U64)JsonBinaryTag::Null;
+
+    case JsonType::Boolean:
+        return ((U64)value.Boolean << 3) | (U64)JsonBinaryTag::Boolean;
+
+    case JsonType::Integer:
+        if (value.Integer >= -(1ll << 60) && value.Integer < (1ll << 60))
+        {
+            return ((U64)value.Integer << 3) | (U64)JsonBinaryTag::SmallInteger;
+        }
+
+        if ((offset = JsonBinary_Alloc(writer, sizeof(I64))) < 0)
+        {
+            return (U64)JsonBinaryTag::Null;
+        }
+
+        memcpy(writer->Data + offset, &value.Integer, sizeof(I64));
+        return ((U64)offset << 3) | (U64)JsonBinaryTag::Integer;
+
+    case JsonType::Number:
+        if ((offset = JsonBinary_Alloc(writer, sizeof(double))) < 0)
+        {
+            return (U64)JsonBinaryTag::Null;
+        }
+
+        memcpy(writer->Data + offset, &value.Number, sizeof(double));
+        return ((U64)offset << 3) | (U64)JsonBinaryTag::Number;
+
+    case JsonType::String:
+        if ((offset = JsonBinary_WriteString(writer, value.String.Buffer, value.String.Length)) < 0)
+        {
+            return (U64)JsonBinaryTag::Null;
+        }
+
+        return ((U64)offset << 3) | (U64)JsonBinaryTag::String;
+
+    case JsonType::Array:
+    {
+        const int count = value.Array.Count;
+        const JsonBinaryPacking packing = JsonBinary_Packing(value);
+        if (packing == JsonBinaryPacking::Int32)
+        {
+            if ((offset = JsonBinary_Alloc(writer, sizeof(JsonBinaryRecord) + (I64)count * sizeof(I32))) < 0)
+            {
+                return (U64)JsonBinaryTag::Null;
+            }
+
+            I32* items = (I32*)(writer->Data + offset + sizeof(JsonBinaryRecord));
+            for (int i = 0; i < count; i++)
+            {
+                items[i] = (I32)value.Array.Items[i].Integer;
+            }
+        }
+        else if (packing == JsonBinaryPacking::Number)
+        {
+            if ((offset = JsonBinary_Alloc(writer, sizeof(JsonBinaryRecord) + (I64)count * sizeof(double))) < 0)
+            {
+                return (U64)JsonBinaryTag::Null;
+            }
+
+            double* items = (double*)(writer->Data + offset + sizeof(JsonBinaryRecord));
+            for (int i = 0; i < count; i++)
+            {
+                items[i] = value.Array.Items[i].Number;
+            }
+        }
+
+        if (packing != JsonBinaryPacking::Values)
+        {
+            JsonBinaryRecord* record = (JsonBinaryRecord*)(writer->Data + offset);
+            record->Count = (U32)count;
+            record->Packing = (U32)packing;
+            return ((U64)offset << 3) | (U64)JsonBinaryTag::Array;
+        }
+
+        if ((offset = JsonBinary_Alloc(writer, sizeof(JsonBinaryRecord) + (I64)count * sizeof(U64))) < 0)
+        {
+            return (U64)JsonBinaryTag::Null;
+        }
+
+        ((JsonBinaryRecord*)(writer->Data + offset))->Count = (U32)count;
+
+        /* Items are written after the record, which may move the data: address it by offset */
+        for (int i = 0; i < count; i++)
+        {
+            const U64 item = JsonBinary_Write(writer, value.Array.Items[i]);
+            if (writer->Failed)
+            {
+                break;
+            }
+
+            ((U64*)(writer->Data + offset + sizeof(JsonBinaryRecord)))[i] = item;
+        }
+
+        return ((U64)offset << 3) | (U64)JsonBinaryTag::Array;
+    }
+
+    case JsonType::Object:
+    {
+        const int count = value.Object.Count;
+        if ((offset = JsonBinary_Alloc(writer, sizeof(JsonBinaryRecord) + (I64)count * (2 * sizeof(U64) + sizeof(U32)))) < 0)
+        {
+            return (U64)JsonBinaryTag::Null;
+        }
+
+        ((JsonBinaryRecord*)(writer->Data + offset))->Count = (U32)count;
+        if (count == 0)
+        {
+            return ((U64)offset << 3) | (U64)JsonBinaryTag::Object;
+        }
+
+        JsonBinaryMember* members = (JsonBinaryMember*)MemoryAlloc(count * (int)sizeof(JsonBinaryMember));
+        if (!members)
+        {
+            writer->Failed = true;
+            return (U64)JsonBinaryTag::Null;
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            members[i].Hash = value.Object.Keys[i];
+            members[i].Index = i;
+        }
+
+        qsort(members, count, sizeof(JsonBinaryMember), JsonBinary_CompareMembers);
+
+        for (int i = 0; i < count && !writer->Failed; i++)
+        {
+            const String name = JsonGetKey(value, members[i].Index);
+            const int nameOffset = JsonBinary_WriteString(writer, name.Buffer, name.Length);
+            const U64 member = JsonBinary_Write(writer, value.Object.Values[members[i].Index]);
+            if (writer->Failed)
+            {
+                break;
+            }
+
+            U64* hashs = (U64*)(writer->Data + offset + sizeof(JsonBinaryRecord));
+            hashs[i] = members[i].Hash;
+            hashs[count + i] = member;
+            ((U32*)(hashs + count * 2))[i] = (U32)nameOffset;
+        }
+
+        MemoryFree(members);
+        return ((U64)offset << 3) | (U64)JsonBinaryTag::Object;
+    }
+    }
+
+    return (U64)JsonBinaryTag::Null;
+}
+
+Buffer ConvertJsonToBinary(const Json value)
+{
+    JsonBinaryWriter writer = {};
+    // A bucket per string, up to 64K buckets
+    const int stringCount = JsonBinary_CountStrings(value);
+    writer.Strings = MakeHashTable<int>(stringCount < 16 ? 16 : stringCount < 64 * 1024 ? stringCount : 64 * 1024);
+
+    const int header = JsonBinary_Alloc(&writer, sizeof(JsonBinaryHeader));
+    const U64 root = JsonBinary_Write(&writer, value);
+
+    FreeHashTable(&writer.Strings);
+
+    if (writer.Failed || header < 0)
+    {
+        MemoryFree(writer.Data);
+        return { nullptr, 0 };
+    }
+
+    JsonBinaryHeader* result = (JsonBinaryHeader*)writer.Data;
+    result->Magic = JSON_BINARY_MAGIC;
+    result->Version = JSON_BINARY_VERSION;
+    result->Size = (U64)writer.Length;
+    result->Root = root;
+
+    return { writer.Data, writer.Length };
+}
+
+bool SaveJsonBinary(const char* filePath, const Json value)
+{
+    Buffer buffer = ConvertJsonToBinary(value);
+    if (!buffer.Data)
+    {
+        return false;
+    }
+
+    bool result = false;
+
+    File file = OpenFile(StringView(filePath, (int)strlen(filePath)), (FileMode)(FileMode::Write | FileMode::Create | FileMode::Truncate));
+    if (file)
+    {
+        result = FileWrite(file, buffer.Data, buffer.Size) == buffer.Size;
+        CloseFile(file);
+    }
+
+    MemoryFree(buffer.Data);
+    return result;
+}
+
+JsonBinary OpenJsonBinary(const void* data, I64 size)
+{
+    const JsonBinaryHeader* header = (const JsonBinaryHeader*)data;
+    if (!header || size < (I64)sizeof(JsonBinaryHeader)
+        || header->Magic != JSON_BINARY_MAGIC || header->Version != JSON_BINARY_VERSION || header->Size > (U64)size)
+    {
+        return { nullptr, 0 };
+    }
+
+    return { (const U8*)data, header->Root };
+}
+
+JsonBinary MapJsonBinary(const char* filePath)
+{
+    Buffer64 buffer = MapFileData(StringView(filePath, (int)strlen(filePath)));
+
+    JsonBinary root = OpenJsonBinary(buffer.Data, buffer.Size);
+    if (!root.Document)
+    {
+        UnmapFileData(buffer);
+    }
+
+    return root;
+}
+
+void UnmapJsonBinary(JsonBinary root)
+{
+    if (root.Document)
+    {
+        const JsonBinaryHeader* header = (const JsonBinaryHeader*)root.Document;
+        UnmapFileData({ (U8*)root.Document, (I64)header->Size });
+    }
+}
+
+JsonType JsonBinaryGetType(const JsonBinary value)
+{
+    switch (JsonBinary_Tag(value.Bits))
+    {
+    case JsonBinaryTag::Boolean:
+        return JsonType::Boolean;
+
+    case JsonBinaryTag::SmallInteger:
+    case JsonBinaryTag::Integer:
+        return JsonType::Integer;
+
+    case JsonBinaryTag::Number:
+        return JsonType::Number;
+
+    case JsonBinaryTag::String:
+        return JsonType::String;
+
+    case JsonBinaryTag::Array:
+        return JsonType::Array;
+
+    case JsonBinaryTag::Object:
+        return JsonType::Object;
+
+    default:
+        return JsonType::Null;
+    }
+}
+
+bool JsonBinaryGetBoolean(const JsonBinary value)
+{
+    return JsonBinary_Tag(value.Bits) == JsonBinaryTag::Boolean && (value.Bits >> 3) != 0;
+}
+
+I64 JsonBinaryGetInteger(const JsonBinary value)
+{
+    switch (JsonBinary_Tag(value.Bits))
+    {
+    case JsonBinaryTag::SmallInteger:
+        return (I64)value.Bits >> 3;
+
+    case JsonBinaryTag::Integer:
+    {
+        I64 result;
+        memcpy(&result, value.Document + (value.Bits >> 3), sizeof(I64));
+        return result;
+    }
+
+    case JsonBinaryTag::Number:
+        return (I64)JsonBinaryGetNumber(value);
+
+    default:
+        return 0;
+    }
+}
+
+double JsonBinaryGetNumber(const JsonBinary value)
+{
+    if (JsonBinary_Tag(value.Bits) == JsonBinaryTag::Number)
+    {
+        double result;
+        memcpy(&result, value.Document + (value.Bits >> 3), sizeof(double));
+        return result;
+    }
+
+    return (double)JsonBinaryGetInteger(value);
+}
+
+String JsonBinaryGetString(const JsonBinary value)
+{
+    if (value.Document && JsonBinary_Tag(value.Bits) == JsonBinaryTag::String)
+    {
+        const JsonBinaryRecord* record = JsonBinary_Record(value);
+        return RefString((const char*)(record + 1), (int)record->Count, false);
+    }
+
+    return RefString("", 0, false);
+}
+
+int JsonBinaryGetCount(const JsonBinary value)
+{
+    const JsonBinaryTag tag = JsonBinary_Tag(value.Bits);
+    if (value.Document && (tag == JsonBinaryTag::Array || tag == JsonBinaryTag::Object))
+    {
+        return (int)JsonBinary_Record(value)->Count;
+    }
+
+    return 0;
+}
+
+JsonBinary JsonBinaryGetItem(const JsonBinary array, int index)
+{
+    if (JsonBinary_Tag(array.Bits) == JsonBinaryTag::Array && index > -1 && index < JsonBinaryGetCount(array))
+    {
+        const JsonBinaryRecord* record = JsonBinary_Record(array);
+        switch ((JsonBinaryPacking)record->Packing)
+        {
+        case JsonBinaryPacking::Int32:
+            return JsonBinary_Value(array, ((U64)(I64)((const I32*)(record + 1))[index] << 3) | (U64)JsonBinaryTag::SmallInteger);
+
+        case JsonBinaryPacking::Number:
+        {
+            /* The packed item is a number record by itself */
+            const U64 offset = (U64)((const U8*)((const double*)(record + 1) + index) - array.Document);
+            return JsonBinary_Value(array, (offset << 3) | (U64)JsonBinaryTag::Number);
+        }
+
+        default:
+            return JsonBinary_Value(array, ((const U64*)(record + 1))[index]);
+        }
+    }
+
+    return { nullptr, 0 };
+}
+
+String JsonBinaryGetKey(const JsonBinary object, int index)
+{
+    if (JsonBinary_Tag(object.Bits) == JsonBinaryTag::Object && index > -1 && index < JsonBinaryGetCount(object))
+    {
+        const int count = JsonBinaryGetCount(object);
+        const U32* names = (const U32*)((const U64*)(JsonBinary_Record(object) + 1) + count * 2);
+        return JsonBinaryGetString(JsonBinary_Value(object, ((U64)names[index] << 3) | (U64)JsonBinaryTag::String));
+    }
+
+    return RefString("", 0, false);
+}
+
+JsonBinary JsonBinaryGetValue(const JsonBinary object, int index)
+{
+    if (JsonBinary_Tag(object.Bits) == JsonBinaryTag::Object && index > -1 && index < JsonBinaryGetCount(object))
+    {
+        const int count = JsonBinaryGetCount(object);
+        const U64* values = (const U64*)(JsonBinary_Record(object) + 1) + count;
+        return JsonBinary_Value(object, values[index]);
+    }
+
+    return { nullptr, 0 };
+}
+
+JsonBinary JsonFind(const JsonBinary object, const char* name)
+{
+    return JsonFind(object, CalcHash64(name, (int)strlen(name)));
+}
+
+JsonBinary JsonFind(const JsonBinary object, U64 hash)
+{
+    if (!object.Document || JsonBinary_Tag(object.Bits) != JsonBinaryTag::Object)
+    {
+        return { nullptr, 0 };
+    }
+
+    const int count = JsonBinaryGetCount(object);
+    const U64* hashs = (const U64*)(JsonBinary_Record(object) + 1);
+
+    /* Lower bound over the sorted hashs */
+    int lo = 0;
+    int hi = count;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        if (hashs[mid] < hash)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    if (lo < count && hashs[lo] == hash)
+    {
+        return JsonBinary_Value(object, hashs[count + lo]);
+    }
+
+    return { nullptr, 0 };
+}
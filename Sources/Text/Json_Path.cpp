@@ -0,0 +1,139 @@
+#include <string.h>
+
+#include <Text/Json.h>
+
+#include <Container/Array.h>
+#include <Container/HashTable.h>
+
+/// JsonQueryState
+/// Evaluation of a path, the hints are the positions the keys of each step were last found at
+struct JsonQueryState
+{
+    const JsonPath*     Path;
+    I32                 Hints[JSON_PATH_MAX_STEPS];
+
+    Array<Json>*        Values;     /* nullptr when only the first value is wanted */
+    Json                First;
+    int                 Count;
+};
+
+/* @funcdef: JsonQuery_FindMember */
+/* Records of an array usually share their layout, try the position of the previous match before hashing */
+static inline int JsonQuery_FindMember(const Json object, U64 hash, I32* hint)
+{
+    const int position = *hint;
+    if (position < object.Object.Count && object.Object.Keys[position] == hash)
+    {
+        return position;
+    }
+
+    const int index = HashTableIndexOf(object.Object, hash);
+    if (index > -1)
+    {
+        *hint = index;
+    }
+
+    return index;
+}
+
+/* @funcdef: JsonQuery_Match */
+/* Return true to stop the evaluation */
+static bool JsonQuery_Match(JsonQueryState* state, const Json value)
+{
+    if (state->Count++ == 0)
+    {
+        state->First = value;
+    }
+
+    if (!state->Values)
+    {
+        return true;
+    }
+
+    ArrayPush(state->Values, value);
+    return false;
+}
+
+/* @funcdef: JsonQuery_Step */
+static bool JsonQuery_Step(JsonQueryState* state, const Json value, int stepIndex)
+{
+    if (stepIndex == state->Path->Count)
+    {
+        return JsonQuery_Match(state, value);
+    }
+
+    const JsonPathStep& step = state->Path->Steps[stepIndex];
+
+    if (step.Wildcard)
+    {
+        if (value.Type == JsonType::Array)
+        {
+            for (int i = 0, n = value.Array.Count; i < n; i++)
+            {
+                if (JsonQuery_Step(state, value.Array.Items[i], stepIndex + 1))
+                {
+                    return true;
+                }
+            }
+        }
+        else if (value.Type == JsonType::Object)
+        {
+            for (int i = 0, n = value.Object.Count; i < n; i++)
+            {
+                if (JsonQuery_Step(state, value.Object.Values[i], stepIndex + 1))
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    if (value.Type == JsonType::Object)
+    {
+        const int index = JsonQuery_FindMember(value, step.Hash, &state->Hints[stepIndex]);
+        return index > -1 && JsonQuery_Step(state, value.Object.Values[index], stepIndex + 1);
+    }
+
+    if (value.Type == JsonType::Array)
+    {
+        return step.Index > -1 && step.Index < value.Array.Count && JsonQuery_Step(state, value.Array.Items[step.Index], stepIndex + 1);
+    }
+
+    return false;
+}
+
+JsonPath MakeJsonPath(const char* path)
+{
+    return MakeJsonPath(path, (I32)strlen(path));
+}
+
+Json JsonQuery(const Json value, const JsonPath& path)
+{
+    if (path.Count < 0)
+    {
+        return {};
+    }
+
+    JsonQueryState state = {};
+    state.Path = &path;
+
+    JsonQuery_Step(&state, value, 0);
+    return state.First;
+}
+
+int JsonQueryAll(const Json value, const JsonPath& path, Array<Json>* outValues)
+{
+    if (path.Count < 0 || !outValues)
+    {
+        return 0;
+    }
+
+    JsonQueryState state = {};
+    state.Path = &path;
+    state.Values = outValues;
+
+    JsonQuery_Step(&state, value, 0);
+    return state.Count;
+}
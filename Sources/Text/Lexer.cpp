@@ -0,0 +1,671 @@
+#include <string.h>
+
+#include <Text/Lexer.h>
+#include <Container/PerfectHashTable.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define LEXER_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define LEXER_SSE2 0
+#endif
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+// -----------------------------------
+// Char classes
+// -----------------------------------
+
+constexpr U8 LEXER_CHAR_SPACE       = 1 << 0;
+constexpr U8 LEXER_CHAR_IDENT_START = 1 << 1;
+constexpr U8 LEXER_CHAR_IDENT       = 1 << 2;   // Identifier start chars and digits
+constexpr U8 LEXER_CHAR_DIGIT       = 1 << 3;
+constexpr U8 LEXER_CHAR_PUNCT       = 1 << 4;
+
+/// LexerCharTable
+/// Classes of each byte, built at compile time
+struct LexerCharTable
+{
+    U8 Classes[256];
+
+    constexpr LexerCharTable()
+        : Classes()
+    {
+        for (I32 c = 0; c < 256; c++)
+        {
+            const bool space = c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+            const bool digit = c >= '0' && c <= '9';
+            const bool identStart = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c >= 0x80;
+
+            bool punct = false;
+            for (const char* p = "!%&()*+,-./:;<=>?[]^{|}~#"; *p; p++)
+            {
+                punct |= *p == c;
+            }
+
+            Classes[c] = (U8)((space ? LEXER_CHAR_SPACE : 0)
+                | (identStart ? LEXER_CHAR_IDENT_START | LEXER_CHAR_IDENT : 0)
+                | (digit ? LEXER_CHAR_DIGIT | LEXER_CHAR_IDENT : 0)
+                | (punct ? LEXER_CHAR_PUNCT : 0));
+        }
+    }
+};
+
+static constexpr LexerCharTable LEXER_CHARS = LexerCharTable();
+
+static inline bool Lexer_Is(U8 c, U8 classes)
+{
+    return (LEXER_CHARS.Classes[c] & classes) != 0;
+}
+
+// Multi-chars punctuators, longest first
+static constexpr const char* LEXER_PUNCTUATORS_3[] = { "<<=", ">>=", "...", "->*", "<=>" };
+static constexpr const char* LEXER_PUNCTUATORS_2[] = {
+    "->", "++", "--", "<<", ">>", "<=", ">=", "==", "!=", "&&", "||",
+    "+=", "-=", "*=", "/=", "%=", "&=", "^=", "|=", "::", "##", ".*",
+};
+
+static constexpr auto LEXER_PUNCTUATORS_3_TABLE = MakePerfectHashTable(LEXER_PUNCTUATORS_3);
+static constexpr auto LEXER_PUNCTUATORS_2_TABLE = MakePerfectHashTable(LEXER_PUNCTUATORS_2);
+static_assert(LEXER_PUNCTUATORS_3_TABLE.Valid && LEXER_PUNCTUATORS_2_TABLE.Valid, "Duplicated punctuators");
+
+// C and C++ keywords, shaders and scripts use a subset of them
+static constexpr const char* LEXER_KEYWORDS[] = {
+    "alignas", "alignof", "asm", "auto", "bool", "break", "case", "catch", "char", "char8_t", "char16_t",
+    "char32_t", "class", "concept", "const", "consteval", "constexpr", "constinit", "const_cast", "continue",
+    "co_await", "co_return", "co_yield", "decltype", "default", "delete", "do", "double", "dynamic_cast",
+    "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline",
+    "int", "long", "mutable", "namespace", "new", "noexcept", "nullptr", "operator", "private", "protected",
+    "public", "register", "reinterpret_cast", "requires", "restrict", "return", "short", "signed", "sizeof",
+    "static", "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local", "throw",
+    "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void",
+    "volatile", "wchar_t", "while", "_Alignas", "_Alignof", "_Atomic", "_Bool", "_Complex", "_Generic",
+    "_Imaginary", "_Noreturn", "_Static_assert", "_Thread_local",
+};
+
+static constexpr auto LEXER_KEYWORDS_TABLE = MakePerfectHashTable(LEXER_KEYWORDS);
+static_assert(LEXER_KEYWORDS_TABLE.Valid, "Duplicated keywords");
+
+// -----------------------------------
+// Scanning
+// -----------------------------------
+
+static inline I32 Lexer_LowestBit(U32 mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (I32)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// Index of the first of the chars in [start, end), end when there is none. Repeat a char to look for less.
+static I32 Lexer_FindChars(const U8* buffer, I32 start, I32 end, U8 c0, U8 c1, U8 c2, U8 c3)
+{
+    I32 i = start;
+
+#if LEXER_SSE2
+    const __m128i v0 = _mm_set1_epi8((char)c0);
+    const __m128i v1 = _mm_set1_epi8((char)c1);
+    const __m128i v2 = _mm_set1_epi8((char)c2);
+    const __m128i v3 = _mm_set1_epi8((char)c3);
+    for (; i + 16 <= end; i += 16)
+    {
+        const __m128i block = _mm_loadu_si128((const __m128i*)(buffer + i));
+        const __m128i found = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, v0), _mm_cmpeq_epi8(block, v1)),
+            _mm_or_si128(_mm_cmpeq_epi8(block, v2), _mm_cmpeq_epi8(block, v3)));
+
+        const U32 mask = (U32)_mm_movemask_epi8(found);
+        if (mask)
+        {
+            return i + Lexer_LowestBit(mask);
+        }
+    }
+#endif
+
+    for (; i < end; i++)
+    {
+        const U8 c = buffer[i];
+        if (c == c0 || c == c1 || c == c2 || c == c3)
+        {
+            return i;
+        }
+    }
+
+    return end;
+}
+
+static I32 Lexer_CountLines(const U8* buffer, I32 start, I32 end)
+{
+    I32 count = 0;
+    I32 i = start;
+
+#if LEXER_SSE2
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (i + 16 <= end)
+    {
+        // Per byte counters are summed before they overflow
+        __m128i counters = _mm_setzero_si128();
+        const I32 blockEnd = i + 255 * 16 < end ? i + 255 * 16 : end;
+        for (; i + 16 <= blockEnd; i += 16)
+        {
+            const __m128i block = _mm_loadu_si128((const __m128i*)(buffer + i));
+            counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(block, newline));
+        }
+
+        const __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+        count += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+    }
+#endif
+
+    for (; i < end; i++)
+    {
+        count += buffer[i] == '\n';
+    }
+
+    return count;
+}
+
+// Length of the line continuation (backslash newline) at i, 0 when there is none
+static inline I32 Lexer_Continuation(const U8* buffer, I32 length, I32 i)
+{
+    if (i + 1 < length && buffer[i + 1] == '\n')
+    {
+        return 2;
+    }
+
+    if (i + 2 < length && buffer[i + 1] == '\r' && buffer[i + 2] == '\n')
+    {
+        return 3;
+    }
+
+    return 0;
+}
+
+// Start at "//", return the index of the line break ending the comment (not consumed)
+static I32 Lexer_SkipLineComment(Lexer* lexer, I32 start)
+{
+    const U8* buffer = (const U8*)lexer->Buffer;
+
+    I32 i = start + 2;
+    for (;;)
+    {
+        i = Lexer_FindChars(buffer, i, lexer->Length, '\n', '\n', '\n', '\n');
+        if (i >= lexer->Length)
+        {
+            return lexer->Length;
+        }
+
+        I32 j = i - 1;
+        if (j > start && buffer[j] == '\r')
+        {
+            j--;
+        }
+
+        if (j <= start + 1 || buffer[j] != '\\')
+        {
+            return i;
+        }
+
+        lexer->Line++;
+        i++;
+    }
+}
+
+// Start at "/*", return the index after "*/", -1 when the comment is not terminated
+static I32 Lexer_SkipBlockComment(Lexer* lexer, I32 start)
+{
+    const U8* buffer = (const U8*)lexer->Buffer;
+
+    I32 i = start + 2;
+    for (;;)
+    {
+        i = Lexer_FindChars(buffer, i, lexer->Length, '*', '*', '*', '*');
+        if (i + 1 >= lexer->Length)
+        {
+            lexer->Line += Lexer_CountLines(buffer, start, lexer->Length);
+            return -1;
+        }
+
+        if (buffer[i + 1] == '/')
+        {
+            lexer->Line += Lexer_CountLines(buffer, start, i);
+            return i + 2;
+        }
+
+        i++;
+    }
+}
+
+// Start at the opening quote, set the index after the closing one.
+// Return false when the line ends first, end is then the index of the line break.
+static bool Lexer_SkipQuoted(Lexer* lexer, I32 start, I32* outEnd)
+{
+    const U8* buffer = (const U8*)lexer->Buffer;
+    const U8 quote = buffer[start];
+
+    I32 i = start + 1;
+    for (;;)
+    {
+        i = Lexer_FindChars(buffer, i, lexer->Length, quote, '\\', '\n', '\n');
+        if (i >= lexer->Length)
+        {
+            *outEnd = lexer->Length;
+            return false;
+        }
+
+        if (buffer[i] == quote)
+        {
+            *outEnd = i + 1;
+            return true;
+        }
+
+        if (buffer[i] == '\n')
+        {
+            *outEnd = i;
+            return false;
+        }
+
+        const I32 continuation = Lexer_Continuation(buffer, lexer->Length, i);
+        lexer->Line += continuation > 0;
+        i += continuation > 0 ? continuation : 2;
+    }
+}
+
+// Start at the quote of R"delimiter( ... )delimiter", set the index after the closing quote
+static bool Lexer_SkipRawString(Lexer* lexer, I32 start, I32* outEnd)
+{
+    const U8* buffer = (const U8*)lexer->Buffer;
+    constexpr I32 MAX_DELIMITER_LENGTH = 16;
+
+    I32 open = start + 1;
+    while (open < lexer->Length && open - start - 1 <= MAX_DELIMITER_LENGTH && buffer[open] != '(' && !Lexer_Is(buffer[open], LEXER_CHAR_SPACE))
+    {
+        open++;
+    }
+
+    if (open >= lexer->Length || buffer[open] != '(')
+    {
+        *outEnd = open;
+        return false;
+    }
+
+    const I32 delimiterLength = open - start - 1;
+    for (I32 i = open + 1;; i++)
+    {
+        i = Lexer_FindChars(buffer, i, lexer->Length, ')', ')', ')', ')');
+        if (i + delimiterLength + 1 >= lexer->Length)
+        {
+            lexer->Line += Lexer_CountLines(buffer, start, lexer->Length);
+            *outEnd = lexer->Length;
+            return false;
+        }
+
+        if (memcmp(buffer + i + 1, buffer + start + 1, delimiterLength) == 0 && buffer[i + delimiterLength + 1] == '"')
+        {
+            lexer->Line += Lexer_CountLines(buffer, start, i);
+            *outEnd = i + delimiterLength + 2;
+            return true;
+        }
+    }
+}
+
+// Kind of literal the identifier is a prefix of: 0 none, 1 string or char, 2 raw string
+static I32 Lexer_LiteralPrefix(const U8* identifier, I32 length, U8 quote)
+{
+    const bool raw = length > 0 && identifier[length - 1] == 'R';
+    const I32 prefixLength = raw ? length - 1 : length;
+
+    const bool encoding = prefixLength == 0
+        || (prefixLength == 1 && (identifier[0] == 'L' || identifier[0] == 'u' || identifier[0] == 'U'))
+        || (prefixLength == 2 && identifier[0] == 'u' && identifier[1] == '8');
+
+    if (!encoding || (prefixLength == 0 && !raw))
+    {
+        return 0;
+    }
+
+    if (raw)
+    {
+        return quote == '"' ? 2 : 0;
+    }
+
+    return 1;
+}
+
+// Start at the quote, return the token type and set the end of the literal
+static LexerTokenType Lexer_ScanLiteral(Lexer* lexer, I32 quote, I32 prefix, I32* outEnd)
+{
+    const char c = lexer->Buffer[quote];
+    const bool terminated = prefix == 2 ? Lexer_SkipRawString(lexer, quote, outEnd) : Lexer_SkipQuoted(lexer, quote, outEnd);
+    if (!terminated)
+    {
+        return LexerTokenType::Error;
+    }
+
+    return c == '"' ? LexerTokenType::String : LexerTokenType::Char;
+}
+
+// Start at '#', the directive runs to the end of line: continuations, comments and strings included
+static I32 Lexer_SkipDirective(Lexer* lexer, I32 start)
+{
+    const U8* buffer = (const U8*)lexer->Buffer;
+
+    I32 i = start + 1;
+    for (;;)
+    {
+        i = Lexer_FindChars(buffer, i, lexer->Length, '\n', '\\', '/', '"');
+        if (i >= lexer->Length)
+        {
+            return lexer->Length;
+        }
+
+        switch (buffer[i])
+        {
+        case '\n':
+            return i;
+
+        case '\\':
+        {
+            const I32 continuation = Lexer_Continuation(buffer, lexer->Length, i);
+            lexer->Line += continuation > 0;
+            i += continuation > 0 ? continuation : 1;
+        } break;
+
+        case '/':
+            if (i + 1 < lexer->Length && buffer[i + 1] == '/')
+            {
+                return Lexer_SkipLineComment(lexer, i);
+            }
+
+            if (i + 1 < lexer->Length && buffer[i + 1] == '*')
+            {
+                i = Lexer_SkipBlockComment(lexer, i);
+                if (i < 0)
+                {
+                    return lexer->Length;
+                }
+            }
+            else
+            {
+                i++;
+            }
+            break;
+
+        default:
+            Lexer_SkipQuoted(lexer, i, &i);
+            break;
+        }
+    }
+}
+
+// Span of the JSON object held by the block comment content, if any
+static bool Lexer_FindMetadata(const U8* buffer, I32 start, I32 end, I32* outStart, I32* outEnd)
+{
+    while (start < end && Lexer_Is(buffer[start], LEXER_CHAR_SPACE))
+    {
+        start++;
+    }
+
+    while (end > start && Lexer_Is(buffer[end - 1], LEXER_CHAR_SPACE))
+    {
+        end--;
+    }
+
+    if (end - start < 2 || buffer[start] != '{' || buffer[end - 1] != '}')
+    {
+        return false;
+    }
+
+    *outStart = start;
+    *outEnd = end;
+    return true;
+}
+
+// Start at "/*", make the Comment, Metadata or Error token
+static LexerTokenType Lexer_ScanBlockComment(Lexer* lexer, LexerToken* token)
+{
+    const U8* buffer = (const U8*)lexer->Buffer;
+    const I32 start = token->Start;
+
+    const I32 end = Lexer_SkipBlockComment(lexer, start);
+    if (end < 0)
+    {
+        token->Length = lexer->Length - start;
+        return LexerTokenType::Error;
+    }
+
+    I32 jsonStart, jsonEnd;
+    if (Lexer_FindMetadata(buffer, start + 2, end - 2, &jsonStart, &jsonEnd))
+    {
+        token->Line += Lexer_CountLines(buffer, start, jsonStart);
+        token->Start = jsonStart;
+        token->Length = jsonEnd - jsonStart;
+        lexer->Cursor = end;
+        return LexerTokenType::Metadata;
+    }
+
+    token->Length = end - start;
+    return LexerTokenType::Comment;
+}
+
+// -----------------------------------
+// Main functions
+// -----------------------------------
+
+Lexer MakeLexer(StringView source, U32 flags)
+{
+    Lexer lexer;
+    lexer.Buffer = source.Buffer;
+    lexer.Length = source.Length;
+    lexer.Cursor = 0;
+    lexer.Line = 1;
+    lexer.Flags = flags;
+    lexer.LineStart = true;
+    return lexer;
+}
+
+bool LexerNext(Lexer* lexer, LexerToken* outToken)
+{
+    DebugAssert(lexer != nullptr, "The input lexer is nullptr");
+
+    const U8* buffer = (const U8*)lexer->Buffer;
+    const I32 length = lexer->Length;
+
+    I32 i = lexer->Cursor;
+    for (;;)
+    {
+        while (i < length && Lexer_Is(buffer[i], LEXER_CHAR_SPACE))
+        {
+            if (buffer[i] == '\n')
+            {
+                lexer->Line++;
+                lexer->LineStart = true;
+            }
+            i++;
+        }
+
+        if (i >= length)
+        {
+            lexer->Cursor = length;
+            *outToken = { LexerTokenType::End, length, 0, lexer->Line };
+            return false;
+        }
+
+        LexerToken token = { LexerTokenType::Error, i, 1, lexer->Line };
+        const U8 c = buffer[i];
+
+        if (c == '/' && i + 1 < length && (buffer[i + 1] == '/' || buffer[i + 1] == '*'))
+        {
+            // Comments are spaces, a directive can still follow
+            if (buffer[i + 1] == '/')
+            {
+                token.Type = LexerTokenType::Comment;
+                token.Length = Lexer_SkipLineComment(lexer, i) - i;
+            }
+            else
+            {
+                token.Type = Lexer_ScanBlockComment(lexer, &token);
+            }
+
+            if (token.Type == LexerTokenType::Metadata)
+            {
+                *outToken = token;
+                return true;
+            }
+
+            i = token.Start + token.Length;
+            if (token.Type == LexerTokenType::Comment && (lexer->Flags & LEXER_KEEP_COMMENTS) == 0)
+            {
+                continue;
+            }
+        }
+        else if (c == '#' && lexer->LineStart)
+        {
+            token.Type = LexerTokenType::Preprocessor;
+            i = Lexer_SkipDirective(lexer, i);
+        }
+        else if (Lexer_Is(c, LEXER_CHAR_IDENT_START))
+        {
+            i++;
+            while (i < length && Lexer_Is(buffer[i], LEXER_CHAR_IDENT))
+            {
+                i++;
+            }
+
+            const I32 prefix = i < length && (buffer[i] == '"' || buffer[i] == '\'') ? Lexer_LiteralPrefix(buffer + token.Start, i - token.Start, buffer[i]) : 0;
+            token.Type = prefix > 0 ? Lexer_ScanLiteral(lexer, i, prefix, &i) : LexerTokenType::Identifier;
+        }
+        else if (Lexer_Is(c, LEXER_CHAR_DIGIT) || (c == '.' && i + 1 < length && Lexer_Is(buffer[i + 1], LEXER_CHAR_DIGIT)))
+        {
+            // Preprocessing number: digits, letters, dots, exponent signs and digit separators
+            token.Type = LexerTokenType::Number;
+            for (i++; i < length; i++)
+            {
+                const U8 n = buffer[i];
+                const U8 previous = buffer[i - 1] | 0x20;
+                const bool sign = (n == '+' || n == '-') && (previous == 'e' || previous == 'p');
+                const bool separator = n == '\'' && i + 1 < length && Lexer_Is(buffer[i + 1], LEXER_CHAR_IDENT);
+                if (!Lexer_Is(n, LEXER_CHAR_IDENT) && n != '.' && !sign && !separator)
+                {
+                    break;
+                }
+            }
+        }
+        else if (c == '"' || c == '\'')
+        {
+            token.Type = Lexer_ScanLiteral(lexer, i, 0, &i);
+        }
+        else if (Lexer_Is(c, LEXER_CHAR_PUNCT))
+        {
+            token.Type = LexerTokenType::Punctuator;
+
+            I32 punctuatorLength = 1;
+            if (i + 3 <= length && PerfectHashFind(LEXER_PUNCTUATORS_3_TABLE, StringView((const char*)buffer + i, 3)) >= 0)
+            {
+                punctuatorLength = 3;
+            }
+            else if (i + 2 <= length && PerfectHashFind(LEXER_PUNCTUATORS_2_TABLE, StringView((const char*)buffer + i, 2)) >= 0)
+            {
+                punctuatorLength = 2;
+            }
+
+            i += punctuatorLength;
+        }
+        else
+        {
+            i++;
+        }
+
+        if (token.Type != LexerTokenType::Comment)
+        {
+            lexer->LineStart = false;
+        }
+
+        token.Length = i - token.Start;
+        lexer->Cursor = i;
+        *outToken = token;
+        return true;
+    }
+}
+
+bool LexerNextMetadata(Lexer* lexer, LexerToken* outToken)
+{
+    DebugAssert(lexer != nullptr, "The input lexer is nullptr");
+
+    const U8* buffer = (const U8*)lexer->Buffer;
+    const I32 length = lexer->Length;
+
+    // Code is skipped to the next char that may start a comment or a literal, the lines are counted in bulk
+    I32 i = lexer->Cursor;
+    while (i < length)
+    {
+        const I32 next = Lexer_FindChars(buffer, i, length, '/', '"', '\'', '/');
+        lexer->Line += Lexer_CountLines(buffer, i, next);
+        i = next;
+        if (i >= length)
+        {
+            break;
+        }
+
+        const U8 c = buffer[i];
+        if (c == '/')
+        {
+            if (i + 1 < length && buffer[i + 1] == '*')
+            {
+                LexerToken token = { LexerTokenType::Error, i, 0, lexer->Line };
+                token.Type = Lexer_ScanBlockComment(lexer, &token);
+                if (token.Type == LexerTokenType::Metadata)
+                {
+                    *outToken = token;
+                    return true;
+                }
+
+                i = token.Start + token.Length;
+            }
+            else if (i + 1 < length && buffer[i + 1] == '/')
+            {
+                i = Lexer_SkipLineComment(lexer, i);
+            }
+            else
+            {
+                i++;
+            }
+            continue;
+        }
+
+        // The quote may end an identifier (a literal prefix) or a number (a digit separator)
+        I32 identifier = i;
+        while (identifier > 0 && Lexer_Is(buffer[identifier - 1], LEXER_CHAR_IDENT))
+        {
+            identifier--;
+        }
+
+        if (identifier < i && Lexer_Is(buffer[identifier], LEXER_CHAR_DIGIT))
+        {
+            i++;
+            continue;
+        }
+
+        Lexer_ScanLiteral(lexer, i, Lexer_LiteralPrefix(buffer + identifier, i - identifier, c), &i);
+    }
+
+    lexer->Cursor = length;
+    *outToken = { LexerTokenType::End, length, 0, lexer->Line };
+    return false;
+}
+
+StringView LexerTokenText(const Lexer* lexer, const LexerToken* token)
+{
+    return StringView(lexer->Buffer + token->Start, token->Length);
+}
+
+bool LexerIsKeyword(const Lexer* lexer, const LexerToken* token)
+{
+    return token->Type == LexerTokenType::Identifier && PerfectHashFind(LEXER_KEYWORDS_TABLE, LexerTokenText(lexer, token)) >= 0;
+}
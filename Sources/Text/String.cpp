@@ -10,6 +10,509 @@
 #include <System/Memory.h>
 #include <Container/HashTable.h>
 
+#include "./RyuTables.h"
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+// -----------------------------------
+// Search and comparison kernels
+// -----------------------------------
+
+// SSE2 is the x64 baseline, AVX2 kernels are built alongside and picked at runtime from cpuid
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define STRING_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define STRING_SSE2 0
+#endif
+
+#if STRING_SSE2 && (defined(_M_X64) || defined(__x86_64__))
+#   define STRING_AVX2 1
+#   include <immintrin.h>
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       define STRING_TARGET_AVX2
+#   else
+#       define STRING_TARGET_AVX2 __attribute__((target("avx2")))
+#   endif
+#else
+#   define STRING_AVX2 0
+#endif
+
+// Tails of the AVX2 kernels are inlined so they are VEX encoded too,
+// calling non-VEX SSE code with dirty ymm registers is very slow on some cpus
+#if defined(_MSC_VER)
+#   define STRING_INLINE __forceinline
+#else
+#   define STRING_INLINE inline __attribute__((always_inline))
+#endif
+
+/// StringKernels
+/// Implementations of the hot loops for one instruction set
+struct StringKernels
+{
+    I32 (*IndexOfChar)(const char* buffer, I32 length, char c);
+    I32 (*LastIndexOfChar)(const char* buffer, I32 length, char c);
+
+    // Substring is at least 2 chars long and not longer than buffer
+    I32 (*IndexOf)(const char* buffer, I32 length, const char* substring, I32 substringLength);
+    I32 (*LastIndexOf)(const char* buffer, I32 length, const char* substring, I32 substringLength);
+
+    // Index of the first different byte, length when both are equal
+    I32 (*Mismatch)(const char* a, const char* b, I32 length);
+};
+
+static STRING_INLINE I32 String_LowestBit(U32 mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (I32)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+static STRING_INLINE I32 String_HighestBit(U32 mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return (I32)index;
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
+
+// Scalar kernels, also used for the tails of the SIMD ones
+
+static STRING_INLINE I32 String_IndexOfCharScalar(const char* buffer, I32 length, char c)
+{
+    const char* found = (const char*)memchr(buffer, c, (size_t)length);
+    return found ? (I32)(found - buffer) : -1;
+}
+
+static STRING_INLINE I32 String_LastIndexOfCharScalar(const char* buffer, I32 length, char c)
+{
+    for (I32 i = length - 1; i > -1; i--)
+    {
+        if (buffer[i] == c)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static STRING_INLINE I32 String_IndexOfScalar(const char* buffer, I32 length, const char* substring, I32 substringLength)
+{
+    for (I32 i = 0, n = length - substringLength; i <= n; i++)
+    {
+        const I32 index = String_IndexOfCharScalar(buffer + i, n - i + 1, substring[0]);
+        if (index < 0)
+        {
+            break;
+        }
+
+        i += index;
+        if (memcmp(buffer + i + 1, substring + 1, (size_t)substringLength - 1) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+static STRING_INLINE I32 String_LastIndexOfScalar(const char* buffer, I32 length, const char* substring, I32 substringLength)
+{
+    for (I32 i = length - substringLength; i > -1; i--)
+    {
+        if (buffer[i] == substring[0] && memcmp(buffer + i + 1, substring + 1, (size_t)substringLength - 1) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// Index of the first different byte of two words, the lowest one as the supported targets are little-endian
+static STRING_INLINE I32 String_LowestByte(U64 difference)
+{
+    const U32 low = (U32)difference;
+    return low ? String_LowestBit(low) >> 3 : 4 + (String_LowestBit((U32)(difference >> 32)) >> 3);
+}
+
+// Strings shorter than 16 bytes are compared with two overlapping words
+static STRING_INLINE I32 String_MismatchShort(const char* a, const char* b, I32 length)
+{
+    if (length >= 8)
+    {
+        U64 wordA, wordB;
+        memcpy(&wordA, a, sizeof(wordA));
+        memcpy(&wordB, b, sizeof(wordB));
+        if (wordA != wordB)
+        {
+            return String_LowestByte(wordA ^ wordB);
+        }
+
+        memcpy(&wordA, a + length - 8, sizeof(wordA));
+        memcpy(&wordB, b + length - 8, sizeof(wordB));
+        return wordA != wordB ? length - 8 + String_LowestByte(wordA ^ wordB) : length;
+    }
+
+    if (length >= 4)
+    {
+        U32 wordA, wordB;
+        memcpy(&wordA, a, sizeof(wordA));
+        memcpy(&wordB, b, sizeof(wordB));
+        if (wordA != wordB)
+        {
+            return String_LowestBit(wordA ^ wordB) >> 3;
+        }
+
+        memcpy(&wordA, a + length - 4, sizeof(wordA));
+        memcpy(&wordB, b + length - 4, sizeof(wordB));
+        return wordA != wordB ? length - 4 + (String_LowestBit(wordA ^ wordB) >> 3) : length;
+    }
+
+    I32 i = 0;
+    while (i < length && a[i] == b[i])
+    {
+        i++;
+    }
+
+    return i;
+}
+
+static STRING_INLINE I32 String_MismatchScalar(const char* a, const char* b, I32 length)
+{
+    I32 i = 0;
+    for (; i + 8 <= length; i += 8)
+    {
+        U64 wordA, wordB;
+        memcpy(&wordA, a + i, sizeof(wordA));
+        memcpy(&wordB, b + i, sizeof(wordB));
+        if (wordA != wordB)
+        {
+            break;
+        }
+    }
+
+    return i + String_MismatchShort(a + i, b + i, length - i < 8 ? length - i : 8);
+}
+
+#if !STRING_SSE2
+static const StringKernels StringKernelsScalar = {
+    String_IndexOfCharScalar,
+    String_LastIndexOfCharScalar,
+    String_IndexOfScalar,
+    String_LastIndexOfScalar,
+    String_MismatchScalar,
+};
+#endif
+
+#if STRING_SSE2
+// 16 positions at a time. Substring search compare the first and the last char of the substring
+// at every position of the block, only the positions where both match are verified with memcmp.
+
+static STRING_INLINE I32 String_IndexOfCharSSE2(const char* buffer, I32 length, char c)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+
+    I32 i = 0;
+    for (; i + 16 <= length; i += 16)
+    {
+        const __m128i block = _mm_loadu_si128((const __m128i*)(buffer + i));
+        const U32 mask = (U32)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask)
+        {
+            return i + String_LowestBit(mask);
+        }
+    }
+
+    const I32 index = String_IndexOfCharScalar(buffer + i, length - i, c);
+    return index > -1 ? i + index : -1;
+}
+
+static STRING_INLINE I32 String_LastIndexOfCharSSE2(const char* buffer, I32 length, char c)
+{
+    const __m128i needle = _mm_set1_epi8(c);
+
+    I32 end = length;
+    for (; end >= 16; end -= 16)
+    {
+        const __m128i block = _mm_loadu_si128((const __m128i*)(buffer + end - 16));
+        const U32 mask = (U32)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask)
+        {
+            return end - 16 + String_HighestBit(mask);
+        }
+    }
+
+    return String_LastIndexOfCharScalar(buffer, end, c);
+}
+
+static STRING_INLINE I32 String_IndexOfSSE2(const char* buffer, I32 length, const char* substring, I32 substringLength)
+{
+    const __m128i first = _mm_set1_epi8(substring[0]);
+    const __m128i last = _mm_set1_epi8(substring[substringLength - 1]);
+
+    I32 i = 0;
+    for (; i + substringLength - 1 + 16 <= length; i += 16)
+    {
+        const __m128i blockFirst = _mm_loadu_si128((const __m128i*)(buffer + i));
+        const __m128i blockLast = _mm_loadu_si128((const __m128i*)(buffer + i + substringLength - 1));
+
+        U32 mask = (U32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last)));
+        while (mask)
+        {
+            const I32 position = i + String_LowestBit(mask);
+            if (memcmp(buffer + position + 1, substring + 1, (size_t)substringLength - 2) == 0)
+            {
+                return position;
+            }
+
+            mask &= mask - 1;
+        }
+    }
+
+    const I32 index = String_IndexOfScalar(buffer + i, length - i, substring, substringLength);
+    return index > -1 ? i + index : -1;
+}
+
+static STRING_INLINE I32 String_LastIndexOfSSE2(const char* buffer, I32 length, const char* substring, I32 substringLength)
+{
+    const __m128i first = _mm_set1_epi8(substring[0]);
+    const __m128i last = _mm_set1_epi8(substring[substringLength - 1]);
+
+    // Blocks of start positions, from the last possible one down
+    I32 end = length - substringLength + 1;
+    for (; end >= 16; end -= 16)
+    {
+        const I32 start = end - 16;
+        const __m128i blockFirst = _mm_loadu_si128((const __m128i*)(buffer + start));
+        const __m128i blockLast = _mm_loadu_si128((const __m128i*)(buffer + start + substringLength - 1));
+
+        U32 mask = (U32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last)));
+        while (mask)
+        {
+            const I32 bit = String_HighestBit(mask);
+            if (memcmp(buffer + start + bit + 1, substring + 1, (size_t)substringLength - 2) == 0)
+            {
+                return start + bit;
+            }
+
+            mask &= ~(1u << bit);
+        }
+    }
+
+    return String_LastIndexOfScalar(buffer, end + substringLength - 1, substring, substringLength);
+}
+
+static STRING_INLINE I32 String_MismatchSSE2(const char* a, const char* b, I32 length)
+{
+    if (length < 16)
+    {
+        return String_MismatchShort(a, b, length);
+    }
+
+    // The last block overlap the previous ones, bytes before i are known to be equal
+    I32 i = 0;
+    for (;; i += 16)
+    {
+        if (i + 16 > length)
+        {
+            i = length - 16;
+        }
+
+        const __m128i blockA = _mm_loadu_si128((const __m128i*)(a + i));
+        const __m128i blockB = _mm_loadu_si128((const __m128i*)(b + i));
+        const U32 mask = (U32)_mm_movemask_epi8(_mm_cmpeq_epi8(blockA, blockB)) ^ 0xFFFFu;
+        if (mask)
+        {
+            return i + String_LowestBit(mask);
+        }
+
+        if (i + 16 == length)
+        {
+            return length;
+        }
+    }
+}
+
+static const StringKernels StringKernelsSSE2 = {
+    String_IndexOfCharSSE2,
+    String_LastIndexOfCharSSE2,
+    String_IndexOfSSE2,
+    String_LastIndexOfSSE2,
+    String_MismatchSSE2,
+};
+#endif
+
+#if STRING_AVX2
+// Same algorithms as SSE2 on 32 positions at a time, tails are left to the SSE2 kernels
+
+STRING_TARGET_AVX2
+static I32 String_IndexOfCharAVX2(const char* buffer, I32 length, char c)
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+
+    I32 i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i block = _mm256_loadu_si256((const __m256i*)(buffer + i));
+        const U32 mask = (U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+        if (mask)
+        {
+            return i + String_LowestBit(mask);
+        }
+    }
+
+    const I32 index = String_IndexOfCharSSE2(buffer + i, length - i, c);
+    return index > -1 ? i + index : -1;
+}
+
+STRING_TARGET_AVX2
+static I32 String_LastIndexOfCharAVX2(const char* buffer, I32 length, char c)
+{
+    const __m256i needle = _mm256_set1_epi8(c);
+
+    I32 end = length;
+    for (; end >= 32; end -= 32)
+    {
+        const __m256i block = _mm256_loadu_si256((const __m256i*)(buffer + end - 32));
+        const U32 mask = (U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+        if (mask)
+        {
+            return end - 32 + String_HighestBit(mask);
+        }
+    }
+
+    return String_LastIndexOfCharSSE2(buffer, end, c);
+}
+
+STRING_TARGET_AVX2
+static I32 String_IndexOfAVX2(const char* buffer, I32 length, const char* substring, I32 substringLength)
+{
+    const __m256i first = _mm256_set1_epi8(substring[0]);
+    const __m256i last = _mm256_set1_epi8(substring[substringLength - 1]);
+
+    I32 i = 0;
+    for (; i + substringLength - 1 + 32 <= length; i += 32)
+    {
+        const __m256i blockFirst = _mm256_loadu_si256((const __m256i*)(buffer + i));
+        const __m256i blockLast = _mm256_loadu_si256((const __m256i*)(buffer + i + substringLength - 1));
+
+        U32 mask = (U32)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last)));
+        while (mask)
+        {
+            const I32 position = i + String_LowestBit(mask);
+            if (memcmp(buffer + position + 1, substring + 1, (size_t)substringLength - 2) == 0)
+            {
+                return position;
+            }
+
+            mask &= mask - 1;
+        }
+    }
+
+    const I32 index = String_IndexOfSSE2(buffer + i, length - i, substring, substringLength);
+    return index > -1 ? i + index : -1;
+}
+
+STRING_TARGET_AVX2
+static I32 String_LastIndexOfAVX2(const char* buffer, I32 length, const char* substring, I32 substringLength)
+{
+    const __m256i first = _mm256_set1_epi8(substring[0]);
+    const __m256i last = _mm256_set1_epi8(substring[substringLength - 1]);
+
+    I32 end = length - substringLength + 1;
+    for (; end >= 32; end -= 32)
+    {
+        const I32 start = end - 32;
+        const __m256i blockFirst = _mm256_loadu_si256((const __m256i*)(buffer + start));
+        const __m256i blockLast = _mm256_loadu_si256((const __m256i*)(buffer + start + substringLength - 1));
+
+        U32 mask = (U32)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last)));
+        while (mask)
+        {
+            const I32 bit = String_HighestBit(mask);
+            if (memcmp(buffer + start + bit + 1, substring + 1, (size_t)substringLength - 2) == 0)
+            {
+                return start + bit;
+            }
+
+            mask &= ~(1u << bit);
+        }
+    }
+
+    return String_LastIndexOfSSE2(buffer, end + substringLength - 1, substring, substringLength);
+}
+
+STRING_TARGET_AVX2
+static I32 String_MismatchAVX2(const char* a, const char* b, I32 length)
+{
+    I32 i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i blockA = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i blockB = _mm256_loadu_si256((const __m256i*)(b + i));
+        const U32 mask = ~(U32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(blockA, blockB));
+        if (mask)
+        {
+            return i + String_LowestBit(mask);
+        }
+    }
+
+    // Less than 16 bytes left: step back into the equal bytes for a full block
+    if (length - i < 16 && length >= 16)
+    {
+        i = length - 16;
+    }
+
+    return i + String_MismatchSSE2(a + i, b + i, length - i);
+}
+
+static const StringKernels StringKernelsAVX2 = {
+    String_IndexOfCharAVX2,
+    String_LastIndexOfCharAVX2,
+    String_IndexOfAVX2,
+    String_LastIndexOfAVX2,
+    String_MismatchAVX2,
+};
+#endif
+
+static const StringKernels* String_SelectKernels(void)
+{
+#if STRING_AVX2
+    if (CpuHasAVX2())
+    {
+        return &StringKernelsAVX2;
+    }
+#endif
+
+#if STRING_SSE2
+    return &StringKernelsSSE2;
+#else
+    return &StringKernelsScalar;
+#endif
+}
+
+// Selected once, on first use
+static inline const StringKernels* String_Kernels(void)
+{
+    static const StringKernels* kernels = String_SelectKernels();
+    return kernels;
+}
+
+// -----------------------------------
+// Main functions
+// -----------------------------------
+
 String MakeString(void* buffer, I32 bufferSize)
 {
     DebugAssert(buffer != nullptr, "Invalid buffer");
@@ -78,19 +581,51 @@ void FreeString(String* source)
     }
 }
 
+// Identifiers are short, they are compared inline without dispatching
+static inline I32 String_Mismatch(const char* a, const char* b, I32 length)
+{
+#if STRING_SSE2
+    if (length <= 32)
+    {
+        return String_MismatchSSE2(a, b, length);
+    }
+#else
+    if (length < 16)
+    {
+        return String_MismatchShort(a, b, length);
+    }
+#endif
+
+    return String_Kernels()->Mismatch(a, b, length);
+}
+
 I32 StringCompare(StringView str0, StringView str1)
 {
-    return strncmp(str0.Buffer, str1.Buffer, min(str0.Length, str1.Length));
+    const I32 length = min(str0.Length, str1.Length);
+    const I32 index = String_Mismatch(str0.Buffer, str1.Buffer, length);
+    if (index < length)
+    {
+        return (I32)(U8)str0.Buffer[index] - (I32)(U8)str1.Buffer[index];
+    }
+
+    // A prefix is ordered before the longer string
+    return str0.Length - str1.Length;
 }
 
 bool StringEquals(StringView str0, StringView str1)
 {
-    return str0.Length == str1.Length && memcmp(str0.Buffer, str1.Buffer, str0.Length) == 0;
+    // Length first: most unequal strings never touch their content
+    if (str0.Length != str1.Length)
+    {
+        return false;
+    }
+
+    return str0.Buffer == str1.Buffer || String_Mismatch(str0.Buffer, str1.Buffer, str0.Length) == str0.Length;
 }
 
 bool StringNotEquals(StringView str0, StringView str1)
 {
-    return str0.Length != str1.Length || memcmp(str0.Buffer, str1.Buffer, str0.Length) != 0;
+    return !StringEquals(str0, str1);
 }
 
 String StringFormat(I32 bufferSize, StringView format, ...)
@@ -130,54 +665,42 @@ String StringFormatArgv(void* buffer, I32 bufferSize, StringView format, ArgList
 
 I32 StringIndexOf(StringView target, int charCode)
 {
-    for (int i = 0; i < target.Length; i++)
-    {
-        if (target.Buffer[i] == charCode)
-        {
-            return i;
-        }
-    }
-
-    return -1;
+    return String_Kernels()->IndexOfChar(target.Buffer, target.Length, (char)charCode);
 }
 
 int StringIndexOf(StringView target, StringView substring)
 {
-    for (int i = 0, n = target.Length - substring.Length; i < n; i++)
+    if (substring.Length <= 1 || substring.Length > target.Length)
     {
-        if (strncmp(&target.Buffer[i], substring.Buffer, (size_t)substring.Length) == 0)
+        if (substring.Length == 1)
         {
-            return i;
+            return StringIndexOf(target, substring.Buffer[0]);
         }
+
+        return substring.Length == 0 ? 0 : -1;
     }
 
-    return -1;
+    return String_Kernels()->IndexOf(target.Buffer, target.Length, substring.Buffer, substring.Length);
 }
 
 int StringLastIndexOf(StringView target, int charCode)
 {
-    for (int i = target.Length - 1; i > -1; i--)
-    {
-        if (target.Buffer[i] == charCode)
-        {
-            return i;
-        }
-    }
-
-    return -1;
+    return String_Kernels()->LastIndexOfChar(target.Buffer, target.Length, (char)charCode);
 }
 
 int StringLastIndexOf(StringView target, StringView substring)
 {
-    for (int i = target.Length - substring.Length - 1; i > -1; i--)
+    if (substring.Length <= 1 || substring.Length > target.Length)
     {
-        if (strncmp(target.Buffer + i, substring.Buffer, (size_t)substring.Length) == 0)
+        if (substring.Length == 1)
         {
-            return i;
+            return StringLastIndexOf(target, substring.Buffer[0]);
         }
+
+        return substring.Length == 0 ? target.Length : -1;
     }
 
-    return -1;
+    return String_Kernels()->LastIndexOf(target.Buffer, target.Length, substring.Buffer, substring.Length);
 }
 
 String SubString(StringView source, int start, int end)
@@ -205,3 +728,439 @@ String SubString(StringView source, int start, int end)
         return { content, substringLength, substringLength + 1, true, false };
     }
 }
+
+// -----------------------------------
+// Number formatting
+// -----------------------------------
+
+static const char DigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static inline I32 DecimalLength(U64 value)
+{
+    I32 length = 1;
+    for (U64 limit = 10; length < 20 && value >= limit; limit *= 10)
+    {
+        length++;
+    }
+    return length;
+}
+
+// Write the digits of value backward from end, two at a time
+static inline void WriteDigits(char* end, U64 value)
+{
+    while (value >= 100)
+    {
+        const U32 pair = (U32)(value % 100) * 2;
+        value /= 100;
+
+        *--end = DigitPairs[pair + 1];
+        *--end = DigitPairs[pair];
+    }
+
+    if (value >= 10)
+    {
+        *--end = DigitPairs[value * 2 + 1];
+        *--end = DigitPairs[value * 2];
+    }
+    else
+    {
+        *--end = (char)('0' + value);
+    }
+}
+
+I32 FormatUnsigned(char* buffer, U64 value)
+{
+    const I32 length = DecimalLength(value);
+    WriteDigits(buffer + length, value);
+    return length;
+}
+
+I32 FormatInteger(char* buffer, I64 value)
+{
+    if (value < 0)
+    {
+        buffer[0] = '-';
+        return 1 + FormatUnsigned(buffer + 1, 0 - (U64)value);
+    }
+
+    return FormatUnsigned(buffer, (U64)value);
+}
+
+// Ryu: the shortest decimal in the rounding interval of a double, see RyuTables.h
+
+static inline I32 Ryu_Pow5Bits(I32 e)
+{
+    return ((e * 1217359) >> 19) + 1;
+}
+
+static inline I32 Ryu_Log10Pow2(I32 e)
+{
+    return (e * 78913) >> 18;
+}
+
+static inline I32 Ryu_Log10Pow5(I32 e)
+{
+    return (e * 732923) >> 20;
+}
+
+static inline bool Ryu_MultipleOfPowerOf5(U64 value, I32 p)
+{
+    I32 count = 0;
+    while (value % 5 == 0)
+    {
+        value /= 5;
+        count++;
+    }
+    return count >= p;
+}
+
+static inline bool Ryu_MultipleOfPowerOf2(U64 value, I32 p)
+{
+    return (value & ((1ull << p) - 1)) == 0;
+}
+
+// (m * mul) >> j, with mul a 128-bit number and 64 < j < 128
+static inline U64 Ryu_MulShift64(U64 m, const U64* mul, I32 j)
+{
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 b0 = (unsigned __int128)m * mul[0];
+    const unsigned __int128 b2 = (unsigned __int128)m * mul[1];
+    return (U64)(((b0 >> 64) + b2) >> (j - 64));
+#else
+    U64 high0, high1;
+#   if defined(_MSC_VER) && defined(_M_X64)
+    _umul128(m, mul[0], &high0);
+    const U64 low1 = _umul128(m, mul[1], &high1);
+#   else
+    const U64 mLow = (U32)m, mHigh = m >> 32;
+    U64 low1;
+    for (I32 i = 0; i < 2; i++)
+    {
+        const U64 bLow = (U32)mul[i], bHigh = mul[i] >> 32;
+        const U64 lowLow = mLow * bLow;
+        const U64 highLow = mHigh * bLow;
+        const U64 cross = (lowLow >> 32) + (U32)highLow + mLow * bHigh;
+        const U64 high = mHigh * bHigh + (highLow >> 32) + (cross >> 32);
+        if (i == 0)
+        {
+            high0 = high;
+        }
+        else
+        {
+            low1 = (cross << 32) | (U32)lowLow;
+            high1 = high;
+        }
+    }
+#   endif
+    const U64 sum = high0 + low1;
+    high1 += sum < high0;
+
+    const I32 shift = j - 64;
+    return shift == 0 ? sum : (high1 << (64 - shift)) | (sum >> shift);
+#endif
+}
+
+// Decimal mantissa and exponent of the shortest representation, rounded to nearest even when several are as short
+static void Ryu_ShortestDecimal(U64 ieeeMantissa, I32 ieeeExponent, U64* outMantissa, I32* outExponent)
+{
+    I32 e2;
+    U64 m2;
+    if (ieeeExponent == 0)
+    {
+        e2 = 1 - 1023 - 52 - 2;
+        m2 = ieeeMantissa;
+    }
+    else
+    {
+        e2 = ieeeExponent - 1023 - 52 - 2;
+        m2 = (1ull << 52) | ieeeMantissa;
+    }
+
+    const bool acceptBounds = (m2 & 1) == 0;
+
+    // Interval of the values rounding to this double: [mv - 1 - mmShift, mv + 2] / 4
+    const U64 mv = 4 * m2;
+    const U32 mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+
+    U64  vr, vp, vm;
+    I32  e10;
+    bool vmIsTrailingZeros = false;
+    bool vrIsTrailingZeros = false;
+    if (e2 >= 0)
+    {
+        const I32 q = Ryu_Log10Pow2(e2) - (e2 > 3);
+        const I32 k = RYU_POW5_INV_BITCOUNT + Ryu_Pow5Bits(q) - 1;
+        const I32 i = -e2 + q + k;
+        e10 = q;
+
+        vr = Ryu_MulShift64(4 * m2, RyuPow5InvSplit[q], i);
+        vp = Ryu_MulShift64(4 * m2 + 2, RyuPow5InvSplit[q], i);
+        vm = Ryu_MulShift64(4 * m2 - 1 - mmShift, RyuPow5InvSplit[q], i);
+
+        if (q <= 21)
+        {
+            // Only one of mp, mv and mm can be a multiple of 5
+            if (mv % 5 == 0)
+            {
+                vrIsTrailingZeros = Ryu_MultipleOfPowerOf5(mv, q);
+            }
+            else if (acceptBounds)
+            {
+                vmIsTrailingZeros = Ryu_MultipleOfPowerOf5(mv - 1 - mmShift, q);
+            }
+            else
+            {
+                vp -= Ryu_MultipleOfPowerOf5(mv + 2, q);
+            }
+        }
+    }
+    else
+    {
+        const I32 q = Ryu_Log10Pow5(-e2) - (-e2 > 1);
+        const I32 i = -e2 - q;
+        const I32 k = Ryu_Pow5Bits(i) - RYU_POW5_BITCOUNT;
+        const I32 j = q - k;
+        e10 = q + e2;
+
+        vr = Ryu_MulShift64(4 * m2, RyuPow5Split[i], j);
+        vp = Ryu_MulShift64(4 * m2 + 2, RyuPow5Split[i], j);
+        vm = Ryu_MulShift64(4 * m2 - 1 - mmShift, RyuPow5Split[i], j);
+
+        if (q <= 1)
+        {
+            // mv = 4 * m2 always has at least two trailing zero bits
+            vrIsTrailingZeros = true;
+            if (acceptBounds)
+            {
+                vmIsTrailingZeros = mmShift == 1;
+            }
+            else
+            {
+                vp--;
+            }
+        }
+        else if (q < 63)
+        {
+            vrIsTrailingZeros = Ryu_MultipleOfPowerOf2(mv, q);
+        }
+    }
+
+    // Remove digits while the interval still contain a shorter decimal
+    I32 removed = 0;
+    U64 output;
+    if (vmIsTrailingZeros || vrIsTrailingZeros)
+    {
+        // Rare (~0.7%): the exact bounds matter
+        U32 lastRemovedDigit = 0;
+        while (vp / 10 > vm / 10)
+        {
+            vmIsTrailingZeros &= vm % 10 == 0;
+            vrIsTrailingZeros &= lastRemovedDigit == 0;
+            lastRemovedDigit = (U32)(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+
+        if (vmIsTrailingZeros)
+        {
+            while (vm % 10 == 0)
+            {
+                vrIsTrailingZeros &= lastRemovedDigit == 0;
+                lastRemovedDigit = (U32)(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+
+        if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0)
+        {
+            // Exactly halfway: round to even
+            lastRemovedDigit = 4;
+        }
+
+        output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+    }
+    else
+    {
+        bool roundUp = false;
+        if (vp / 100 > vm / 100)
+        {
+            // Two digits at a time first
+            roundUp = vr % 100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+
+        while (vp / 10 > vm / 10)
+        {
+            roundUp = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+
+        output = vr + (vr == vm || roundUp);
+    }
+
+    *outMantissa = output;
+    *outExponent = e10 + removed;
+}
+
+I32 FormatDouble(char* buffer, double value)
+{
+    U64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    const bool negative = (bits >> 63) != 0;
+    const U64  ieeeMantissa = bits & ((1ull << 52) - 1);
+    const I32  ieeeExponent = (I32)((bits >> 52) & 0x7FF);
+
+    char* ptr = buffer;
+    if (ieeeExponent == 0x7FF)
+    {
+        if (ieeeMantissa != 0)
+        {
+            memcpy(ptr, "nan", 3);
+            return 3;
+        }
+
+        if (negative)
+        {
+            *ptr++ = '-';
+        }
+        memcpy(ptr, "inf", 3);
+        return (I32)(ptr - buffer) + 3;
+    }
+
+    if (negative)
+    {
+        *ptr++ = '-';
+    }
+
+    if (ieeeExponent == 0 && ieeeMantissa == 0)
+    {
+        memcpy(ptr, "0.0", 3);
+        return (I32)(ptr - buffer) + 3;
+    }
+
+    U64 mantissa;
+    I32 exponent;
+    Ryu_ShortestDecimal(ieeeMantissa, ieeeExponent, &mantissa, &exponent);
+
+    const I32 length = DecimalLength(mantissa);
+    const I32 scientificExponent = exponent + length - 1;
+
+    if (scientificExponent >= -5 && scientificExponent <= 16)
+    {
+        if (exponent >= 0)
+        {
+            // 1234e2 -> 123400.0
+            WriteDigits(ptr + length, mantissa);
+            ptr += length;
+
+            memset(ptr, '0', exponent);
+            ptr += exponent;
+
+            memcpy(ptr, ".0", 2);
+            ptr += 2;
+        }
+        else if (scientificExponent >= 0)
+        {
+            // 1234e-2 -> 12.34
+            const I32 integerLength = scientificExponent + 1;
+            WriteDigits(ptr + length + 1, mantissa);
+            memmove(ptr, ptr + 1, integerLength);
+            ptr[integerLength] = '.';
+            ptr += length + 1;
+        }
+        else
+        {
+            // 1234e-6 -> 0.001234
+            const I32 zeros = -scientificExponent - 1;
+            ptr[0] = '0';
+            ptr[1] = '.';
+            memset(ptr + 2, '0', zeros);
+            ptr += 2 + zeros;
+
+            WriteDigits(ptr + length, mantissa);
+            ptr += length;
+        }
+
+        return (I32)(ptr - buffer);
+    }
+
+    // 1234e30 -> 1.234e+33
+    WriteDigits(ptr + length + 1, mantissa);
+    ptr[0] = ptr[1];
+    if (length > 1)
+    {
+        ptr[1] = '.';
+        ptr += length + 1;
+    }
+    else
+    {
+        ptr += 1;
+    }
+
+    *ptr++ = 'e';
+    *ptr++ = scientificExponent < 0 ? '-' : '+';
+    ptr += FormatUnsigned(ptr, (U64)(scientificExponent < 0 ? -scientificExponent : scientificExponent));
+
+    return (I32)(ptr - buffer);
+}
+
+I32 FormatFixed(char* buffer, double value, I32 decimals)
+{
+    static const U64 powers[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+    decimals = decimals < 0 ? 0 : (decimals > 9 ? 9 : decimals);
+
+    U64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    const bool negative = (bits >> 63) != 0;
+
+    // The scaled value is rounded in a 53 bits integer, larger ones (and nan, inf) use the shortest form
+    const double scaled = (negative ? -value : value) * (double)powers[decimals];
+    if (!(scaled < 9007199254740992.0))
+    {
+        return FormatDouble(buffer, value);
+    }
+
+    const U64 rounded = (U64)(scaled + 0.5);
+
+    char* ptr = buffer;
+    if (negative)
+    {
+        *ptr++ = '-';
+    }
+
+    ptr += FormatUnsigned(ptr, rounded / powers[decimals]);
+    if (decimals > 0)
+    {
+        *ptr++ = '.';
+
+        // Leading zeros of the fraction are not written by WriteDigits
+        memset(ptr, '0', decimals);
+        WriteDigits(ptr + decimals, rounded % powers[decimals]);
+        ptr += decimals;
+    }
+
+    return (I32)(ptr - buffer);
+}
@@ -0,0 +1,178 @@
+#define _CRT_SECURE_NO_WARNINGS
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Text/String.h>
+#include <System/Memory.h>
+
+static inline char* StringBuilder_Buffer(StringBuilder* builder)
+{
+    return builder->Heap ? builder->Heap : builder->Inline;
+}
+
+void FreeStringBuilder(StringBuilder* builder)
+{
+    DebugAssert(builder != nullptr, "Attempting free string builder from nullptr.");
+
+    if (builder->Heap)
+    {
+        MemoryFree(builder->Heap);
+    }
+
+    builder->Heap = nullptr;
+    builder->Length = 0;
+    builder->Capacity = 0;
+    builder->Inline[0] = '\0';
+}
+
+void StringBuilderClear(StringBuilder* builder)
+{
+    builder->Length = 0;
+    StringBuilder_Buffer(builder)[0] = '\0';
+}
+
+bool StringBuilderReserve(StringBuilder* builder, I32 capacity)
+{
+    DebugAssert(builder != nullptr, "The input string builder is nullptr");
+
+    // One more char for the null terminator
+    const I32 current = builder->Heap ? builder->Capacity : STRING_BUILDER_INLINE_SIZE;
+    if (capacity + 1 <= current)
+    {
+        return true;
+    }
+
+    I32 newCapacity = current * 2;
+    while (newCapacity < capacity + 1)
+    {
+        newCapacity *= 2;
+    }
+
+    char* heap = (char*)MemoryRealloc(builder->Heap, newCapacity);
+    if (!heap)
+    {
+        return false;
+    }
+
+    if (!builder->Heap)
+    {
+        memcpy(heap, builder->Inline, builder->Length + 1);
+    }
+
+    builder->Heap = heap;
+    builder->Capacity = newCapacity;
+    return true;
+}
+
+void StringBuilderAppend(StringBuilder* builder, StringView text)
+{
+    if (StringBuilderReserve(builder, builder->Length + text.Length))
+    {
+        char* buffer = StringBuilder_Buffer(builder);
+        memcpy(buffer + builder->Length, text.Buffer, text.Length);
+        builder->Length += text.Length;
+        buffer[builder->Length] = '\0';
+    }
+}
+
+void StringBuilderAppendChar(StringBuilder* builder, char c)
+{
+    if (StringBuilderReserve(builder, builder->Length + 1))
+    {
+        char* buffer = StringBuilder_Buffer(builder);
+        buffer[builder->Length++] = c;
+        buffer[builder->Length] = '\0';
+    }
+}
+
+// Numbers are formatted in place, after making room for the longest one
+static inline char* StringBuilder_ReserveNumber(StringBuilder* builder)
+{
+    return StringBuilderReserve(builder, builder->Length + FORMAT_NUMBER_SIZE) ? StringBuilder_Buffer(builder) + builder->Length : nullptr;
+}
+
+static inline void StringBuilder_Commit(StringBuilder* builder, I32 length)
+{
+    builder->Length += length;
+    StringBuilder_Buffer(builder)[builder->Length] = '\0';
+}
+
+void StringBuilderAppendInteger(StringBuilder* builder, I64 value)
+{
+    if (char* end = StringBuilder_ReserveNumber(builder))
+    {
+        StringBuilder_Commit(builder, FormatInteger(end, value));
+    }
+}
+
+void StringBuilderAppendUnsigned(StringBuilder* builder, U64 value)
+{
+    if (char* end = StringBuilder_ReserveNumber(builder))
+    {
+        StringBuilder_Commit(builder, FormatUnsigned(end, value));
+    }
+}
+
+void StringBuilderAppendDouble(StringBuilder* builder, double value)
+{
+    if (char* end = StringBuilder_ReserveNumber(builder))
+    {
+        StringBuilder_Commit(builder, FormatDouble(end, value));
+    }
+}
+
+void StringBuilderAppendFixed(StringBuilder* builder, double value, I32 decimals)
+{
+    if (char* end = StringBuilder_ReserveNumber(builder))
+    {
+        StringBuilder_Commit(builder, FormatFixed(end, value, decimals));
+    }
+}
+
+void StringBuilderAppendFormat(StringBuilder* builder, const char* format, ...)
+{
+    ArgList argv;
+
+    // Try in the remaining space first, most formats fit
+    const I32 current = builder->Heap ? builder->Capacity : STRING_BUILDER_INLINE_SIZE;
+    ArgListBegin(argv, format);
+    const I32 length = vsnprintf(StringBuilder_Buffer(builder) + builder->Length, current - builder->Length, format, argv);
+    ArgListEnd(argv);
+
+    if (length < 0)
+    {
+        StringBuilder_Buffer(builder)[builder->Length] = '\0';
+        return;
+    }
+
+    if (builder->Length + length < current)
+    {
+        builder->Length += length;
+        return;
+    }
+
+    if (StringBuilderReserve(builder, builder->Length + length))
+    {
+        ArgListBegin(argv, format);
+        vsnprintf(StringBuilder_Buffer(builder) + builder->Length, length + 1, format, argv);
+        ArgListEnd(argv);
+
+        builder->Length += length;
+    }
+    else
+    {
+        StringBuilder_Buffer(builder)[builder->Length] = '\0';
+    }
+}
+
+String StringBuilderToString(const StringBuilder* builder)
+{
+    const char* buffer = builder->Heap ? builder->Heap : builder->Inline;
+    if (builder->Length == 0)
+    {
+        return { "", 0, 0, false, true };
+    }
+
+    return { buffer, builder->Length, 0, false, false };
+}
@@ -0,0 +1,267 @@
+#include <string.h>
+
+#include <Text/String.h>
+#include <System/Heap.h>
+#include <Concurrency/Sync.h>
+
+// Global pool of interned strings.
+// The pool is sharded by hash, each shard is an open addressing set of entries:
+//  - Lookups are lock-free: slots are published with release stores once the entry is written,
+//    so a reader either see a complete entry or an empty slot.
+//  - Insertions take the shard mutex, then search again before adding.
+//  - Growing publish a new table, the old one is kept alive for the readers still probing it.
+// Entries and tables are never freed, they are bump allocated in pages taken directly from the
+// system (PagedHeap) as the global heap is not thread-safe.
+
+constexpr I32 INTERN_SHARD_BITS         = 4;
+constexpr I32 INTERN_SHARD_COUNT        = 1 << INTERN_SHARD_BITS;
+constexpr I32 INTERN_PAGE_SIZE          = 64 * 1024;
+constexpr I32 INTERN_MIN_CAPACITY       = 256;
+
+/// InternEntry
+/// Header of an interned string, the null-terminated chars follow
+struct InternEntry
+{
+    U64                         Hash;
+    I32                         Length;
+};
+
+/// InternTable
+/// Open addressing set of entries, the slots follow
+struct InternTable
+{
+    I32                         Capacity;   // Power of two
+    InternTable*                Retired;    // Previous table, still probed by concurrent readers
+};
+
+struct alignas(CACHE_LINE_SIZE) InternShard
+{
+    std::atomic<InternTable*>   Table;
+
+    Mutex                       Lock;       // Protect everything below and the insertions in Table
+    I32                         Count;
+
+    U8*                         Page;
+    I32                         PageUsed;
+};
+
+static InternShard  InternShards[INTERN_SHARD_COUNT];
+static PagedHeap    InternPages;
+
+static inline std::atomic<InternEntry*>* Intern_Slots(InternTable* table)
+{
+    return (std::atomic<InternEntry*>*)(table + 1);
+}
+
+static inline const char* Intern_Chars(const InternEntry* entry)
+{
+    return (const char*)(entry + 1);
+}
+
+// Bump allocation in the shard pages, only called with the shard locked
+static void* Intern_Alloc(InternShard* shard, I32 size)
+{
+    size = (size + 7) & ~7;
+
+    // Large blocks have their own pages, the current page keep serving small ones
+    if (size > INTERN_PAGE_SIZE / 4)
+    {
+        return InternPages.Alloc(size);
+    }
+
+    if (!shard->Page || shard->PageUsed + size > INTERN_PAGE_SIZE)
+    {
+        shard->Page = (U8*)InternPages.Alloc(INTERN_PAGE_SIZE);
+        shard->PageUsed = 0;
+
+        if (!shard->Page)
+        {
+            return nullptr;
+        }
+    }
+
+    void* result = shard->Page + shard->PageUsed;
+    shard->PageUsed += size;
+    return result;
+}
+
+// Find the entry of the string, lock-free. outCollision is set when another string has the same hash.
+static InternEntry* Intern_Find(InternTable* table, U64 hash, StringView string, bool* outCollision = nullptr)
+{
+    if (!table)
+    {
+        return nullptr;
+    }
+
+    std::atomic<InternEntry*>* slots = Intern_Slots(table);
+    const U32 mask = (U32)table->Capacity - 1;
+    for (U32 i = (U32)hash & mask;; i = (i + 1) & mask)
+    {
+        InternEntry* entry = slots[i].load(std::memory_order_acquire);
+        if (!entry)
+        {
+            return nullptr;
+        }
+
+        if (entry->Hash == hash)
+        {
+            if (entry->Length == string.Length && memcmp(Intern_Chars(entry), string.Buffer, string.Length) == 0)
+            {
+                return entry;
+            }
+
+            if (outCollision)
+            {
+                *outCollision = true;
+            }
+        }
+    }
+}
+
+static void Intern_Insert(InternTable* table, InternEntry* entry)
+{
+    std::atomic<InternEntry*>* slots = Intern_Slots(table);
+    const U32 mask = (U32)table->Capacity - 1;
+
+    U32 i = (U32)entry->Hash & mask;
+    while (slots[i].load(std::memory_order_relaxed))
+    {
+        i = (i + 1) & mask;
+    }
+
+    slots[i].store(entry, std::memory_order_release);
+}
+
+// Double the capacity, only called with the shard locked
+static InternTable* Intern_Grow(InternShard* shard, InternTable* table)
+{
+    const I32 capacity = table ? table->Capacity * 2 : INTERN_MIN_CAPACITY;
+
+    InternTable* newTable = (InternTable*)Intern_Alloc(shard, (I32)sizeof(InternTable) + capacity * (I32)sizeof(std::atomic<InternEntry*>));
+    if (!newTable)
+    {
+        return nullptr;
+    }
+
+    newTable->Capacity = capacity;
+    newTable->Retired = table;
+
+    memset((void*)Intern_Slots(newTable), 0, capacity * sizeof(std::atomic<InternEntry*>));
+
+    if (table)
+    {
+        std::atomic<InternEntry*>* oldSlots = Intern_Slots(table);
+        for (I32 i = 0; i < table->Capacity; i++)
+        {
+            InternEntry* entry = oldSlots[i].load(std::memory_order_relaxed);
+            if (entry)
+            {
+                Intern_Insert(newTable, entry);
+            }
+        }
+    }
+
+    shard->Table.store(newTable, std::memory_order_release);
+    return newTable;
+}
+
+static InternEntry* Intern_GetEntry(StringView string, bool* outCollision)
+{
+    const U64 hash = CalcHash64(string.Buffer, string.Length);
+    InternShard* shard = &InternShards[hash >> (64 - INTERN_SHARD_BITS)];
+
+    InternEntry* entry = Intern_Find(shard->Table.load(std::memory_order_acquire), hash, string, outCollision);
+    if (entry)
+    {
+        return entry;
+    }
+
+    MutexLock(&shard->Lock);
+
+    // Another thread may have added it since the lookup
+    InternTable* table = shard->Table.load(std::memory_order_relaxed);
+    entry = Intern_Find(table, hash, string, outCollision);
+    if (!entry)
+    {
+        // Linear probing stay short below half full
+        if (!table || (shard->Count + 1) * 2 > table->Capacity)
+        {
+            table = Intern_Grow(shard, table);
+        }
+
+        entry = table ? (InternEntry*)Intern_Alloc(shard, (I32)sizeof(InternEntry) + string.Length + 1) : nullptr;
+        if (entry)
+        {
+            entry->Hash = hash;
+            entry->Length = string.Length;
+
+            char* chars = (char*)(entry + 1);
+            memcpy(chars, string.Buffer, string.Length);
+            chars[string.Length] = '\0';
+
+            Intern_Insert(table, entry);
+            shard->Count++;
+        }
+    }
+
+    MutexUnlock(&shard->Lock);
+
+    DebugAssert(entry != nullptr, "Out of memory");
+    return entry;
+}
+
+String InternString(StringView string)
+{
+    InternEntry* entry = Intern_GetEntry(string, nullptr);
+    if (!entry)
+    {
+        return String();
+    }
+
+    return { Intern_Chars(entry), entry->Length, 0, false, true };
+}
+
+Symbol InternSymbol(StringView name)
+{
+    bool collision = false;
+    InternEntry* entry = Intern_GetEntry(name, &collision);
+    DebugAssert(!collision, "Symbol '%.*s' has the same hash as another interned name", name.Length, name.Buffer);
+
+    if (!entry)
+    {
+        return MakeSymbol(name);
+    }
+
+    Symbol symbol;
+    symbol.Hash = entry->Hash;
+#ifndef NDEBUG
+    symbol.Name = { Intern_Chars(entry), entry->Length, 0, false, true };
+#endif
+    return symbol;
+}
+
+String GetSymbolName(Symbol symbol)
+{
+    InternShard* shard = &InternShards[symbol.Hash >> (64 - INTERN_SHARD_BITS)];
+    InternTable* table = shard->Table.load(std::memory_order_acquire);
+    if (!table)
+    {
+        return String();
+    }
+
+    std::atomic<InternEntry*>* slots = Intern_Slots(table);
+    const U32 mask = (U32)table->Capacity - 1;
+    for (U32 i = (U32)symbol.Hash & mask;; i = (i + 1) & mask)
+    {
+        InternEntry* entry = slots[i].load(std::memory_order_acquire);
+        if (!entry)
+        {
+            return String();
+        }
+
+        if (entry->Hash == symbol.Hash)
+        {
+            return { Intern_Chars(entry), entry->Length, 0, false, true };
+        }
+    }
+}
@@ -0,0 +1,548 @@
+#include <string.h>
+
+#include <Text/String.h>
+#include <Text/TextBuffer.h>
+#include <System/Memory.h>
+#include <Container/Array.h>
+
+// The piece tree is an implicit treap: pieces are ordered by position (the sums of the left
+// subtrees), priorities are random so the expected depth is O(log n) for any edit sequence.
+// Edits split the tree at the positions they touch and merge the parts back.
+
+// -----------------------------------
+// Line breaks
+// -----------------------------------
+
+// First index in the sorted breaks with a position >= value
+static I32 TextBuffer_LowerBound(const Array<I32>& breaks, I32 value)
+{
+    I32 low = 0;
+    I32 high = breaks.Count;
+    while (low < high)
+    {
+        const I32 middle = (low + high) >> 1;
+        if (breaks.Items[middle] < value)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+static void TextBuffer_IndexBreaks(Array<I32>* breaks, const char* text, I32 offset, I32 length)
+{
+    const char* end = text + length;
+    for (const char* p = text; p < end;)
+    {
+        const char* lineBreak = (const char*)memchr(p, '\n', end - p);
+        if (!lineBreak)
+        {
+            break;
+        }
+
+        ArrayPush(breaks, offset + (I32)(lineBreak - text));
+        p = lineBreak + 1;
+    }
+}
+
+static inline const char* TextBuffer_SourceChars(const TextBuffer* buffer, I32 source)
+{
+    return source == TEXT_SOURCE_ORIGINAL ? buffer->Original : buffer->Added.Items;
+}
+
+// -----------------------------------
+// Piece tree
+// -----------------------------------
+
+static inline I32 TextBuffer_TreeLength(const TextBuffer* buffer, I32 piece)
+{
+    return piece < 0 ? 0 : buffer->Pieces.Items[piece].TreeLength;
+}
+
+static inline I32 TextBuffer_TreeBreaks(const TextBuffer* buffer, I32 piece)
+{
+    return piece < 0 ? 0 : buffer->Pieces.Items[piece].TreeBreaks;
+}
+
+static void TextBuffer_Update(TextBuffer* buffer, I32 index)
+{
+    TextPiece* piece = &buffer->Pieces.Items[index];
+    piece->TreeLength = piece->Length + TextBuffer_TreeLength(buffer, piece->Left) + TextBuffer_TreeLength(buffer, piece->Right);
+    piece->TreeBreaks = piece->BreakCount + TextBuffer_TreeBreaks(buffer, piece->Left) + TextBuffer_TreeBreaks(buffer, piece->Right);
+}
+
+// Span of a source, with its line breaks found in the source index
+static void TextBuffer_SetSpan(TextBuffer* buffer, I32 index, I32 source, I32 start, I32 length)
+{
+    const Array<I32>& breaks = buffer->LineBreaks[source];
+    const I32 firstBreak = TextBuffer_LowerBound(breaks, start);
+
+    TextPiece* piece = &buffer->Pieces.Items[index];
+    piece->Source = source;
+    piece->Start = start;
+    piece->Length = length;
+    piece->FirstBreak = firstBreak;
+    piece->BreakCount = TextBuffer_LowerBound(breaks, start + length) - firstBreak;
+}
+
+static I32 TextBuffer_NewPiece(TextBuffer* buffer, I32 source, I32 start, I32 length)
+{
+    I32 index = buffer->FreePiece;
+    if (index > -1)
+    {
+        buffer->FreePiece = buffer->Pieces.Items[index].Left;
+    }
+    else
+    {
+        index = ArrayPush(&buffer->Pieces, TextPiece());
+        if (index < 0)
+        {
+            return -1;
+        }
+    }
+
+    // xorshift32, only the shape of the tree depends on it
+    U32 random = buffer->RandomState;
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    buffer->RandomState = random;
+
+    TextPiece* piece = &buffer->Pieces.Items[index];
+    piece->Left = -1;
+    piece->Right = -1;
+    piece->Priority = random;
+
+    TextBuffer_SetSpan(buffer, index, source, start, length);
+    TextBuffer_Update(buffer, index);
+    return index;
+}
+
+static void TextBuffer_FreePieces(TextBuffer* buffer, I32 index)
+{
+    if (index < 0)
+    {
+        return;
+    }
+
+    TextBuffer_FreePieces(buffer, buffer->Pieces.Items[index].Left);
+    TextBuffer_FreePieces(buffer, buffer->Pieces.Items[index].Right);
+
+    buffer->Pieces.Items[index].Left = buffer->FreePiece;
+    buffer->FreePiece = index;
+}
+
+// All the chars of left come before the chars of right
+static I32 TextBuffer_Merge(TextBuffer* buffer, I32 left, I32 right)
+{
+    if (left < 0)
+    {
+        return right;
+    }
+
+    if (right < 0)
+    {
+        return left;
+    }
+
+    if (buffer->Pieces.Items[left].Priority > buffer->Pieces.Items[right].Priority)
+    {
+        const I32 merged = TextBuffer_Merge(buffer, buffer->Pieces.Items[left].Right, right);
+        buffer->Pieces.Items[left].Right = merged;
+        TextBuffer_Update(buffer, left);
+        return left;
+    }
+    else
+    {
+        const I32 merged = TextBuffer_Merge(buffer, left, buffer->Pieces.Items[right].Left);
+        buffer->Pieces.Items[right].Left = merged;
+        TextBuffer_Update(buffer, right);
+        return right;
+    }
+}
+
+// Split the tree in the first position chars and the others, cutting the piece containing position in two
+static void TextBuffer_Split(TextBuffer* buffer, I32 index, I32 position, I32* outLeft, I32* outRight)
+{
+    if (index < 0)
+    {
+        *outLeft = -1;
+        *outRight = -1;
+        return;
+    }
+
+    const I32 leftLength = TextBuffer_TreeLength(buffer, buffer->Pieces.Items[index].Left);
+    const I32 pieceLength = buffer->Pieces.Items[index].Length;
+
+    if (position <= leftLength)
+    {
+        I32 right;
+        TextBuffer_Split(buffer, buffer->Pieces.Items[index].Left, position, outLeft, &right);
+        buffer->Pieces.Items[index].Left = right;
+        TextBuffer_Update(buffer, index);
+        *outRight = index;
+    }
+    else if (position >= leftLength + pieceLength)
+    {
+        I32 left;
+        TextBuffer_Split(buffer, buffer->Pieces.Items[index].Right, position - leftLength - pieceLength, &left, outRight);
+        buffer->Pieces.Items[index].Right = left;
+        TextBuffer_Update(buffer, index);
+        *outLeft = index;
+    }
+    else
+    {
+        const I32 offset = position - leftLength;
+        const TextPiece piece = buffer->Pieces.Items[index];
+
+        const I32 tail = TextBuffer_NewPiece(buffer, piece.Source, piece.Start + offset, piece.Length - offset);
+        DebugAssert(tail > -1, "Out of memory");
+        TextBuffer_SetSpan(buffer, index, piece.Source, piece.Start, offset);
+
+        const I32 right = TextBuffer_Merge(buffer, tail, piece.Right);
+        buffer->Pieces.Items[index].Right = -1;
+        TextBuffer_Update(buffer, index);
+
+        *outLeft = index;
+        *outRight = right;
+    }
+}
+
+// Piece containing the char at position (position < length), outOffset is the position in the piece
+static I32 TextBuffer_Find(const TextBuffer* buffer, I32 position, I32* outOffset)
+{
+    I32 index = buffer->Root;
+    while (index > -1)
+    {
+        const TextPiece& piece = buffer->Pieces.Items[index];
+        const I32 leftLength = TextBuffer_TreeLength(buffer, piece.Left);
+
+        if (position < leftLength)
+        {
+            index = piece.Left;
+        }
+        else if (position < leftLength + piece.Length)
+        {
+            *outOffset = position - leftLength;
+            return index;
+        }
+        else
+        {
+            position -= leftLength + piece.Length;
+            index = piece.Right;
+        }
+    }
+
+    return -1;
+}
+
+static inline I32 TextBuffer_Clamp(I32 value, I32 min, I32 max)
+{
+    return value < min ? min : (value > max ? max : value);
+}
+
+// -----------------------------------
+// Main functions
+// -----------------------------------
+
+TextBuffer MakeTextBuffer(StringView content)
+{
+    TextBuffer buffer = {};
+    buffer.Root = -1;
+    buffer.FreePiece = -1;
+    buffer.RandomState = 0x9e3779b9U;
+
+    if (content.Length > 0)
+    {
+        buffer.Original = (char*)MemoryAlloc(content.Length);
+        if (!buffer.Original)
+        {
+            return buffer;
+        }
+
+        memcpy(buffer.Original, content.Buffer, content.Length);
+        buffer.OriginalLength = content.Length;
+
+        TextBuffer_IndexBreaks(&buffer.LineBreaks[TEXT_SOURCE_ORIGINAL], buffer.Original, 0, content.Length);
+        buffer.Root = TextBuffer_NewPiece(&buffer, TEXT_SOURCE_ORIGINAL, 0, content.Length);
+    }
+
+    return buffer;
+}
+
+void FreeTextBuffer(TextBuffer* buffer)
+{
+    DebugAssert(buffer != nullptr, "Attempting free text buffer from nullptr.");
+
+    MemoryFree(buffer->Original);
+    FreeArray(&buffer->Pieces);
+    FreeArray(&buffer->Added);
+    FreeArray(&buffer->LineBreaks[TEXT_SOURCE_ORIGINAL]);
+    FreeArray(&buffer->LineBreaks[TEXT_SOURCE_ADDED]);
+
+    *buffer = {};
+    buffer->Root = -1;
+    buffer->FreePiece = -1;
+}
+
+I32 TextBufferLength(const TextBuffer* buffer)
+{
+    return TextBuffer_TreeLength(buffer, buffer->Root);
+}
+
+bool TextBufferInsert(TextBuffer* buffer, I32 position, StringView text)
+{
+    DebugAssert(buffer != nullptr, "The input text buffer is nullptr");
+
+    if (text.Length <= 0)
+    {
+        return true;
+    }
+
+    const I32 addedStart = buffer->Added.Count;
+    if (!ArrayEnsure(&buffer->Added, addedStart + text.Length))
+    {
+        return false;
+    }
+
+    memcpy(buffer->Added.Items + addedStart, text.Buffer, text.Length);
+    buffer->Added.Count += text.Length;
+    TextBuffer_IndexBreaks(&buffer->LineBreaks[TEXT_SOURCE_ADDED], text.Buffer, addedStart, text.Length);
+
+    position = TextBuffer_Clamp(position, 0, TextBufferLength(buffer));
+
+    I32 left, right;
+    TextBuffer_Split(buffer, buffer->Root, position, &left, &right);
+
+    // Typing appends to the added chars right after the previous insertion: grow its piece instead of adding one.
+    // The last piece of left is at the end of its right spine, the sums of the spine grow with it.
+    I32 last = left;
+    while (last > -1 && buffer->Pieces.Items[last].Right > -1)
+    {
+        last = buffer->Pieces.Items[last].Right;
+    }
+
+    if (last > -1 && buffer->Pieces.Items[last].Source == TEXT_SOURCE_ADDED
+        && buffer->Pieces.Items[last].Start + buffer->Pieces.Items[last].Length == addedStart)
+    {
+        const I32 oldBreaks = buffer->Pieces.Items[last].BreakCount;
+        TextBuffer_SetSpan(buffer, last, TEXT_SOURCE_ADDED, buffer->Pieces.Items[last].Start, buffer->Pieces.Items[last].Length + text.Length);
+
+        const I32 addedBreaks = buffer->Pieces.Items[last].BreakCount - oldBreaks;
+        for (I32 index = left; index > -1; index = buffer->Pieces.Items[index].Right)
+        {
+            buffer->Pieces.Items[index].TreeLength += text.Length;
+            buffer->Pieces.Items[index].TreeBreaks += addedBreaks;
+        }
+
+        buffer->Root = TextBuffer_Merge(buffer, left, right);
+        return true;
+    }
+
+    const I32 inserted = TextBuffer_NewPiece(buffer, TEXT_SOURCE_ADDED, addedStart, text.Length);
+    if (inserted < 0)
+    {
+        buffer->Root = TextBuffer_Merge(buffer, left, right);
+        return false;
+    }
+
+    buffer->Root = TextBuffer_Merge(buffer, TextBuffer_Merge(buffer, left, inserted), right);
+    return true;
+}
+
+void TextBufferDelete(TextBuffer* buffer, I32 position, I32 length)
+{
+    DebugAssert(buffer != nullptr, "The input text buffer is nullptr");
+
+    const I32 bufferLength = TextBufferLength(buffer);
+    position = TextBuffer_Clamp(position, 0, bufferLength);
+    length = TextBuffer_Clamp(length, 0, bufferLength - position);
+    if (length == 0)
+    {
+        return;
+    }
+
+    I32 left, middle, deleted, right;
+    TextBuffer_Split(buffer, buffer->Root, position, &left, &middle);
+    TextBuffer_Split(buffer, middle, length, &deleted, &right);
+
+    TextBuffer_FreePieces(buffer, deleted);
+    buffer->Root = TextBuffer_Merge(buffer, left, right);
+}
+
+char TextBufferCharAt(const TextBuffer* buffer, I32 position)
+{
+    I32 offset;
+    const I32 index = position >= 0 ? TextBuffer_Find(buffer, position, &offset) : -1;
+    if (index < 0)
+    {
+        return '\0';
+    }
+
+    const TextPiece& piece = buffer->Pieces.Items[index];
+    return TextBuffer_SourceChars(buffer, piece.Source)[piece.Start + offset];
+}
+
+I32 TextBufferCopy(const TextBuffer* buffer, I32 position, I32 length, char* output)
+{
+    I32 copied = 0;
+
+    TextBufferIterator iterator = MakeTextBufferIterator(buffer, position, position + length);
+    for (String chunk; TextBufferNext(&iterator, &chunk);)
+    {
+        memcpy(output + copied, chunk.Buffer, chunk.Length);
+        copied += chunk.Length;
+    }
+
+    return copied;
+}
+
+String TextBufferToString(const TextBuffer* buffer)
+{
+    const I32 length = TextBufferLength(buffer);
+
+    char* chars = (char*)MemoryAlloc(length + 1);
+    if (!chars)
+    {
+        return String();
+    }
+
+    TextBufferCopy(buffer, 0, length, chars);
+    chars[length] = '\0';
+
+    return { chars, length, length + 1, true, false };
+}
+
+// -----------------------------------
+// Lines
+// -----------------------------------
+
+I32 TextBufferLineCount(const TextBuffer* buffer)
+{
+    return TextBuffer_TreeBreaks(buffer, buffer->Root) + 1;
+}
+
+I32 TextBufferLineStart(const TextBuffer* buffer, I32 line)
+{
+    if (line <= 0)
+    {
+        return 0;
+    }
+
+    // Find the line-th break
+    I32 position = 0;
+    I32 index = buffer->Root;
+    while (index > -1)
+    {
+        const TextPiece& piece = buffer->Pieces.Items[index];
+        const I32 leftBreaks = TextBuffer_TreeBreaks(buffer, piece.Left);
+
+        if (line <= leftBreaks)
+        {
+            index = piece.Left;
+        }
+        else if (line <= leftBreaks + piece.BreakCount)
+        {
+            const I32 lineBreak = buffer->LineBreaks[piece.Source].Items[piece.FirstBreak + line - leftBreaks - 1];
+            return position + TextBuffer_TreeLength(buffer, piece.Left) + (lineBreak - piece.Start) + 1;
+        }
+        else
+        {
+            line -= leftBreaks + piece.BreakCount;
+            position += TextBuffer_TreeLength(buffer, piece.Left) + piece.Length;
+            index = piece.Right;
+        }
+    }
+
+    return TextBufferLength(buffer);
+}
+
+I32 TextBufferLineEnd(const TextBuffer* buffer, I32 line)
+{
+    if (line < 0)
+    {
+        return 0;
+    }
+
+    if (line + 1 >= TextBufferLineCount(buffer))
+    {
+        return TextBufferLength(buffer);
+    }
+
+    return TextBufferLineStart(buffer, line + 1) - 1;
+}
+
+I32 TextBufferLineOf(const TextBuffer* buffer, I32 position)
+{
+    position = TextBuffer_Clamp(position, 0, TextBufferLength(buffer));
+
+    // Count the breaks before position
+    I32 line = 0;
+    I32 index = buffer->Root;
+    while (index > -1)
+    {
+        const TextPiece& piece = buffer->Pieces.Items[index];
+        const I32 leftLength = TextBuffer_TreeLength(buffer, piece.Left);
+
+        if (position <= leftLength)
+        {
+            index = piece.Left;
+        }
+        else if (position <= leftLength + piece.Length)
+        {
+            const I32 sourcePosition = piece.Start + position - leftLength;
+            const I32 breaks = TextBuffer_LowerBound(buffer->LineBreaks[piece.Source], sourcePosition) - piece.FirstBreak;
+            return line + TextBuffer_TreeBreaks(buffer, piece.Left) + breaks;
+        }
+        else
+        {
+            line += TextBuffer_TreeBreaks(buffer, piece.Left) + piece.BreakCount;
+            position -= leftLength + piece.Length;
+            index = piece.Right;
+        }
+    }
+
+    return line;
+}
+
+// -----------------------------------
+// Iteration
+// -----------------------------------
+
+TextBufferIterator MakeTextBufferIterator(const TextBuffer* buffer, I32 start, I32 end)
+{
+    const I32 length = TextBufferLength(buffer);
+
+    TextBufferIterator iterator;
+    iterator.Buffer = buffer;
+    iterator.End = end < 0 ? length : TextBuffer_Clamp(end, 0, length);
+    iterator.Position = TextBuffer_Clamp(start, 0, iterator.End);
+    return iterator;
+}
+
+bool TextBufferNext(TextBufferIterator* iterator, String* outChunk)
+{
+    if (iterator->Position >= iterator->End)
+    {
+        return false;
+    }
+
+    I32 offset;
+    const I32 index = TextBuffer_Find(iterator->Buffer, iterator->Position, &offset);
+    if (index < 0)
+    {
+        return false;
+    }
+
+    const TextPiece& piece = iterator->Buffer->Pieces.Items[index];
+    const I32 remain = iterator->End - iterator->Position;
+    const I32 length = piece.Length - offset < remain ? piece.Length - offset : remain;
+
+    *outChunk = RefString(TextBuffer_SourceChars(iterator->Buffer, piece.Source) + piece.Start + offset, length);
+    iterator->Position += length;
+    return true;
+}
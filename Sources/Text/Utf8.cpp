@@ -0,0 +1,555 @@
+#include <string.h>
+
+#include <Text/Utf8.h>
+
+// SSE2 is the x64 baseline, the AVX2 validator is built alongside and picked at runtime from cpuid
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define UTF8_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define UTF8_SSE2 0
+#endif
+
+#if UTF8_SSE2 && (defined(_M_X64) || defined(__x86_64__))
+#   define UTF8_AVX2 1
+#   include <immintrin.h>
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       define UTF8_TARGET_AVX2
+#   else
+#       define UTF8_TARGET_AVX2 __attribute__((target("avx2")))
+#   endif
+#else
+#   define UTF8_AVX2 0
+#endif
+
+#if defined(_MSC_VER)
+#   define UTF8_INLINE __forceinline
+#else
+#   define UTF8_INLINE inline __attribute__((always_inline))
+#endif
+
+// -----------------------------------
+// Scalar sequences
+// -----------------------------------
+
+// Decode the sequence at the start of text, following the well-formed byte sequences table of the Unicode standard.
+// Return its length, 0 when it is invalid.
+static UTF8_INLINE I32 Utf8_DecodeSequence(const U8* text, I32 length, U32* outCodepoint)
+{
+    const U32 c0 = text[0];
+    if (c0 < 0x80)
+    {
+        *outCodepoint = c0;
+        return 1;
+    }
+
+    // Continuation bytes, and C0 C1 which can only start overlong forms
+    if (c0 < 0xC2)
+    {
+        return 0;
+    }
+
+    if (c0 < 0xE0)
+    {
+        if (length < 2 || (text[1] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+
+        *outCodepoint = ((c0 & 0x1F) << 6) | (text[1] & 0x3F);
+        return 2;
+    }
+
+    // The range of the second byte excludes overlong forms after E0 and F0, surrogates after ED and code points above U+10FFFF after F4
+    if (c0 < 0xF0)
+    {
+        const U32 low = c0 == 0xE0 ? 0xA0 : 0x80;
+        const U32 high = c0 == 0xED ? 0x9F : 0xBF;
+        if (length < 3 || text[1] < low || text[1] > high || (text[2] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+
+        *outCodepoint = ((c0 & 0x0F) << 12) | ((text[1] & 0x3F) << 6) | (text[2] & 0x3F);
+        return 3;
+    }
+
+    if (c0 < 0xF5)
+    {
+        const U32 low = c0 == 0xF0 ? 0x90 : 0x80;
+        const U32 high = c0 == 0xF4 ? 0x8F : 0xBF;
+        if (length < 4 || text[1] < low || text[1] > high || (text[2] & 0xC0) != 0x80 || (text[3] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+
+        *outCodepoint = ((c0 & 0x07) << 18) | ((text[1] & 0x3F) << 12) | ((text[2] & 0x3F) << 6) | (text[3] & 0x3F);
+        return 4;
+    }
+
+    return 0;
+}
+
+// Decoding never fails, invalid bytes are replaced one by one
+static UTF8_INLINE U32 Utf8_DecodeNext(const U8* text, I32 length, I32* outLength)
+{
+    U32 codepoint;
+    const I32 sequenceLength = Utf8_DecodeSequence(text, length, &codepoint);
+    *outLength = sequenceLength > 0 ? sequenceLength : 1;
+    return sequenceLength > 0 ? codepoint : UTF8_REPLACEMENT_CHAR;
+}
+
+static UTF8_INLINE bool Utf8_IsAscii16(const U8* text)
+{
+#if UTF8_SSE2
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)text)) == 0;
+#else
+    U64 words[2];
+    memcpy(words, text, sizeof(words));
+    return ((words[0] | words[1]) & 0x8080808080808080ULL) == 0;
+#endif
+}
+
+// Validate from start, which must be the start of a sequence, skipping ASCII 16 bytes at a time
+static I32 Utf8_InvalidIndexScalar(const U8* text, I32 length, I32 start)
+{
+    I32 i = start;
+    while (i < length)
+    {
+        if (i + 16 <= length && Utf8_IsAscii16(text + i))
+        {
+            i += 16;
+            continue;
+        }
+
+        U32 codepoint;
+        const I32 sequenceLength = Utf8_DecodeSequence(text + i, length - i, &codepoint);
+        if (sequenceLength == 0)
+        {
+            return i;
+        }
+
+        i += sequenceLength;
+    }
+
+    return -1;
+}
+
+// -----------------------------------
+// AVX2 validation
+// -----------------------------------
+
+#if UTF8_AVX2
+// Lookup validator from "Validating UTF-8 In Less Than One Instruction Per Byte" (Keiser, Lemire).
+// Every error of a 2-byte window shows in the high nibble of the first byte, its low nibble and the high nibble of the second:
+// each nibble is looked up in a 16 entries table (one vpshufb) for the errors it allows, an error is set in all three.
+// The remaining checks are on the 3rd and 4th bytes of sequences, which must be continuations and only them.
+
+constexpr U8 UTF8_TOO_SHORT         = 1 << 0;   // Lead byte not followed by a continuation
+constexpr U8 UTF8_TOO_LONG          = 1 << 1;   // ASCII followed by a continuation
+constexpr U8 UTF8_OVERLONG_3        = 1 << 2;   // E0 80..9F
+constexpr U8 UTF8_TOO_LARGE         = 1 << 3;   // F4 90..BF, F5..FF
+constexpr U8 UTF8_SURROGATE         = 1 << 4;   // ED A0..BF
+constexpr U8 UTF8_OVERLONG_2        = 1 << 5;   // C0 C1
+constexpr U8 UTF8_TOO_LARGE_1000    = 1 << 6;   // F5..FF 80..8F
+constexpr U8 UTF8_OVERLONG_4        = 1 << 6;   // F0 80..8F
+constexpr U8 UTF8_TWO_CONTS         = 1 << 7;   // Continuation after a continuation, valid for the 3rd and 4th bytes only
+constexpr U8 UTF8_CARRY             = UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS;
+
+alignas(16) static const U8 UTF8_BYTE1_HIGH[16] = {
+    // 0_______ ASCII
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    // 10______ continuation
+    UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+    // 1100____ 1101____ 1110____ 1111____ leads
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+    UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+};
+
+alignas(16) static const U8 UTF8_BYTE1_LOW[16] = {
+    UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,   // ____0000
+    UTF8_CARRY | UTF8_OVERLONG_2,                                       // ____0001
+    UTF8_CARRY,
+    UTF8_CARRY,
+    UTF8_CARRY | UTF8_TOO_LARGE,                                        // ____0100
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,                  // ____0101 and above
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE, // ____1101
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+};
+
+alignas(16) static const U8 UTF8_BYTE2_HIGH[16] = {
+    // 0_______ ASCII
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    // 1000____ 1001____ 101_____ continuations
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 | UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE | UTF8_TOO_LARGE,
+    // 11______ leads
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+};
+
+// A block must not end inside a sequence, unless the next block continues it
+alignas(32) static const U8 UTF8_MAX_ENDING[32] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+// Bytes of input shifted by n, the first ones taken from the end of previous
+#define UTF8_PREVIOUS(input, previous, n) _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - (n))
+
+UTF8_TARGET_AVX2
+static UTF8_INLINE __m256i Utf8_LookupNibbles(const U8* table, __m256i nibbles)
+{
+    return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)table)), nibbles);
+}
+
+UTF8_TARGET_AVX2
+static UTF8_INLINE __m256i Utf8_CheckBlock(__m256i input, __m256i previous)
+{
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+
+    const __m256i prev1 = UTF8_PREVIOUS(input, previous, 1);
+    const __m256i byte1High = Utf8_LookupNibbles(UTF8_BYTE1_HIGH, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibbleMask));
+    const __m256i byte1Low = Utf8_LookupNibbles(UTF8_BYTE1_LOW, _mm256_and_si256(prev1, nibbleMask));
+    const __m256i byte2High = Utf8_LookupNibbles(UTF8_BYTE2_HIGH, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibbleMask));
+    const __m256i special = _mm256_and_si256(_mm256_and_si256(byte1High, byte1Low), byte2High);
+
+    // Third bytes follow E0..FF by two, fourth bytes F0..FF by three: their high bit must match TWO_CONTS exactly
+    const __m256i prev2 = UTF8_PREVIOUS(input, previous, 2);
+    const __m256i prev3 = UTF8_PREVIOUS(input, previous, 3);
+    const __m256i isThird = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    const __m256i isFourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    const __m256i mustContinue = _mm256_and_si256(_mm256_or_si256(isThird, isFourth), _mm256_set1_epi8((char)0x80));
+
+    return _mm256_xor_si256(mustContinue, special);
+}
+
+// Return the offset of the block where the first error shows, the error itself can be up to 3 bytes before.
+// Return -1 when text is valid.
+UTF8_TARGET_AVX2
+static I32 Utf8_FindErrorBlockAVX2(const U8* text, I32 length)
+{
+    const __m256i maxEnding = _mm256_load_si256((const __m256i*)UTF8_MAX_ENDING);
+
+    __m256i previous = _mm256_setzero_si256();
+    __m256i incomplete = _mm256_setzero_si256();
+
+    I32 i = 0;
+    for (; i + 32 <= length; i += 32)
+    {
+        const __m256i input = _mm256_loadu_si256((const __m256i*)(text + i));
+        if (_mm256_movemask_epi8(input) == 0)
+        {
+            // Skipped by the checks, a sequence ending the previous block is then truncated
+            if (!_mm256_testz_si256(incomplete, incomplete))
+            {
+                return i;
+            }
+        }
+        else
+        {
+            const __m256i error = Utf8_CheckBlock(input, previous);
+            if (!_mm256_testz_si256(error, error))
+            {
+                return i;
+            }
+        }
+
+        incomplete = _mm256_subs_epu8(input, maxEnding);
+        previous = input;
+    }
+
+    // The tail is padded with zeros, a truncated sequence at the end is then too short
+    if (i < length)
+    {
+        alignas(32) U8 tail[32] = {};
+        memcpy(tail, text + i, length - i);
+
+        const __m256i error = Utf8_CheckBlock(_mm256_load_si256((const __m256i*)tail), previous);
+        return _mm256_testz_si256(error, error) ? -1 : i;
+    }
+
+    return _mm256_testz_si256(incomplete, incomplete) ? -1 : length;
+}
+
+#undef UTF8_PREVIOUS
+#endif
+
+// -----------------------------------
+// Validation
+// -----------------------------------
+
+bool Utf8IsValid(StringView text)
+{
+#if UTF8_AVX2
+    if (CpuHasAVX2())
+    {
+        return Utf8_FindErrorBlockAVX2((const U8*)text.Buffer, text.Length) < 0;
+    }
+#endif
+
+    return Utf8_InvalidIndexScalar((const U8*)text.Buffer, text.Length, 0) < 0;
+}
+
+I32 Utf8InvalidIndex(StringView text)
+{
+    const U8* buffer = (const U8*)text.Buffer;
+
+#if UTF8_AVX2
+    if (CpuHasAVX2())
+    {
+        const I32 block = Utf8_FindErrorBlockAVX2(buffer, text.Length);
+        if (block < 0)
+        {
+            return -1;
+        }
+
+        // Everything before the block is made of valid sequences, but the last one may continue in the block
+        I32 start = block;
+        while (start > 0 && start > block - 3 && (buffer[start - 1] & 0xC0) == 0x80)
+        {
+            start--;
+        }
+
+        if (start > 0 && start > block - 4 && buffer[start - 1] >= 0xC0)
+        {
+            start--;
+        }
+
+        return Utf8_InvalidIndexScalar(buffer, text.Length, start);
+    }
+#endif
+
+    return Utf8_InvalidIndexScalar(buffer, text.Length, 0);
+}
+
+I32 Utf8Length(StringView text)
+{
+    const U8* buffer = (const U8*)text.Buffer;
+
+    // Count the bytes which are not continuations (0x80..0xBF, -128..-65 as signed)
+    I32 count = 0;
+    I32 i = 0;
+
+#if UTF8_SSE2
+    const __m128i continuation = _mm_set1_epi8(-65);
+    while (i + 16 <= text.Length)
+    {
+        // Per byte counters are summed before they overflow
+        __m128i counters = _mm_setzero_si128();
+        const I32 end = i + 255 * 16 < text.Length ? i + 255 * 16 : text.Length;
+        for (; i + 16 <= end; i += 16)
+        {
+            const __m128i block = _mm_loadu_si128((const __m128i*)(buffer + i));
+            counters = _mm_sub_epi8(counters, _mm_cmpgt_epi8(block, continuation));
+        }
+
+        const __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+        count += _mm_cvtsi128_si32(sums) + _mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+    }
+#endif
+
+    for (; i < text.Length; i++)
+    {
+        count += (buffer[i] & 0xC0) != 0x80;
+    }
+
+    return count;
+}
+
+// -----------------------------------
+// Code points
+// -----------------------------------
+
+U32 Utf8Decode(const char* text, I32 length, I32* outLength)
+{
+    DebugAssert(outLength != nullptr, "The output length is nullptr");
+
+    if (length <= 0)
+    {
+        *outLength = 0;
+        return 0;
+    }
+
+    return Utf8_DecodeNext((const U8*)text, length, outLength);
+}
+
+I32 Utf8Encode(U32 codepoint, char* buffer)
+{
+    if (codepoint <= 0x7F)
+    {
+        buffer[0] = (char)codepoint;
+        return 1;
+    }
+
+    if (codepoint <= 0x7FF)
+    {
+        buffer[0] = (char)(0xC0 | (codepoint >> 6));            /* 110xxxxx */
+        buffer[1] = (char)(0x80 | (codepoint & 0x3F));          /* 10xxxxxx */
+        return 2;
+    }
+
+    if ((codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > UTF8_MAX_CODEPOINT)
+    {
+        codepoint = UTF8_REPLACEMENT_CHAR;
+    }
+
+    if (codepoint <= 0xFFFF)
+    {
+        buffer[0] = (char)(0xE0 | (codepoint >> 12));           /* 1110xxxx */
+        buffer[1] = (char)(0x80 | ((codepoint >> 6) & 0x3F));   /* 10xxxxxx */
+        buffer[2] = (char)(0x80 | (codepoint & 0x3F));          /* 10xxxxxx */
+        return 3;
+    }
+
+    buffer[0] = (char)(0xF0 | (codepoint >> 18));               /* 11110xxx */
+    buffer[1] = (char)(0x80 | ((codepoint >> 12) & 0x3F));      /* 10xxxxxx */
+    buffer[2] = (char)(0x80 | ((codepoint >> 6) & 0x3F));       /* 10xxxxxx */
+    buffer[3] = (char)(0x80 | (codepoint & 0x3F));              /* 10xxxxxx */
+    return 4;
+}
+
+I32 Utf8ToCodepoints(StringView text, U32* output, I32 capacity)
+{
+    const U8* buffer = (const U8*)text.Buffer;
+
+    I32 count = 0;
+    I32 i = 0;
+    while (i < text.Length && count < capacity)
+    {
+#if UTF8_SSE2
+        // ASCII runs are widened 16 chars at a time
+        if (buffer[i] < 0x80 && i + 16 <= text.Length && count + 16 <= capacity)
+        {
+            const __m128i block = _mm_loadu_si128((const __m128i*)(buffer + i));
+            if (_mm_movemask_epi8(block) == 0)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i low = _mm_unpacklo_epi8(block, zero);
+                const __m128i high = _mm_unpackhi_epi8(block, zero);
+                _mm_storeu_si128((__m128i*)(output + count + 0), _mm_unpacklo_epi16(low, zero));
+                _mm_storeu_si128((__m128i*)(output + count + 4), _mm_unpackhi_epi16(low, zero));
+                _mm_storeu_si128((__m128i*)(output + count + 8), _mm_unpacklo_epi16(high, zero));
+                _mm_storeu_si128((__m128i*)(output + count + 12), _mm_unpackhi_epi16(high, zero));
+
+                i += 16;
+                count += 16;
+                continue;
+            }
+        }
+#endif
+
+        I32 sequenceLength;
+        output[count++] = Utf8_DecodeNext(buffer + i, text.Length - i, &sequenceLength);
+        i += sequenceLength;
+    }
+
+    return count;
+}
+
+// -----------------------------------
+// UTF-16
+// -----------------------------------
+
+I32 Utf8ToUtf16(StringView text, U16* output, I32 capacity)
+{
+    const U8* buffer = (const U8*)text.Buffer;
+
+    I32 count = 0;
+    I32 i = 0;
+    while (i < text.Length && count < capacity)
+    {
+#if UTF8_SSE2
+        if (buffer[i] < 0x80 && i + 16 <= text.Length && count + 16 <= capacity)
+        {
+            const __m128i block = _mm_loadu_si128((const __m128i*)(buffer + i));
+            if (_mm_movemask_epi8(block) == 0)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                _mm_storeu_si128((__m128i*)(output + count + 0), _mm_unpacklo_epi8(block, zero));
+                _mm_storeu_si128((__m128i*)(output + count + 8), _mm_unpackhi_epi8(block, zero));
+
+                i += 16;
+                count += 16;
+                continue;
+            }
+        }
+#endif
+
+        I32 sequenceLength;
+        const U32 codepoint = Utf8_DecodeNext(buffer + i, text.Length - i, &sequenceLength);
+        if (codepoint <= 0xFFFF)
+        {
+            output[count++] = (U16)codepoint;
+        }
+        else if (count + 2 <= capacity)
+        {
+            output[count++] = (U16)(0xD800 + ((codepoint - 0x10000) >> 10));
+            output[count++] = (U16)(0xDC00 + ((codepoint - 0x10000) & 0x3FF));
+        }
+        else
+        {
+            break;
+        }
+
+        i += sequenceLength;
+    }
+
+    return count;
+}
+
+I32 Utf16ToUtf8(const U16* text, I32 length, char* output, I32 capacity)
+{
+    I32 count = 0;
+    I32 i = 0;
+    while (i < length)
+    {
+#if UTF8_SSE2
+        // ASCII runs are narrowed 8 units at a time
+        if (i + 8 <= length && count + 8 <= capacity)
+        {
+            const __m128i block = _mm_loadu_si128((const __m128i*)(text + i));
+            const __m128i nonAscii = _mm_and_si128(block, _mm_set1_epi16((short)0xFF80));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) == 0xFFFF)
+            {
+                _mm_storel_epi64((__m128i*)(output + count), _mm_packus_epi16(block, block));
+
+                i += 8;
+                count += 8;
+                continue;
+            }
+        }
+#endif
+
+        U32 codepoint = text[i++];
+        if (codepoint >= 0xD800 && codepoint <= 0xDBFF && i < length && text[i] >= 0xDC00 && text[i] <= 0xDFFF)
+        {
+            codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (text[i++] - 0xDC00);
+        }
+
+        char encoded[UTF8_MAX_BYTES];
+        const I32 encodedLength = Utf8Encode(codepoint, encoded);
+        if (count + encodedLength > capacity)
+        {
+            break;
+        }
+
+        memcpy(output + count, encoded, encodedLength);
+        count += encodedLength;
+    }
+
+    return count;
+}
@@ -1,16 +1,194 @@
 #include <Misc/Testing.h>
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include <System/Core.h>
 #include <Text/String.h>
+#include <System/Memory.h>
+
+// Deterministic keys for the quality tests
+static U64 HashTest_Next(U64* state)
+{
+    U64 z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static void HashTest_Fill(U8* buffer, I32 length, U64 seed)
+{
+    for (I32 i = 0; i < length; i++)
+    {
+        buffer[i] = (U8)HashTest_Next(&seed);
+    }
+}
+
+// Flipping any input bit must flip each output bit half of the time
+static bool HashTest_Avalanche(I32 length, I32 keyCount)
+{
+    U8 key[512];
+    I32 flips[64] = {};
+    I32 samples = 0;
+
+    for (I32 k = 0; k < keyCount; k++)
+    {
+        HashTest_Fill(key, length, k + 1);
+        const U64 hash = CalcHash64(key, length);
+
+        for (I32 bit = 0; bit < length * 8; bit++)
+        {
+            key[bit >> 3] ^= (U8)(1 << (bit & 7));
+            const U64 diff = hash ^ CalcHash64(key, length);
+            key[bit >> 3] ^= (U8)(1 << (bit & 7));
+
+            for (I32 i = 0; i < 64; i++)
+            {
+                flips[i] += (I32)((diff >> i) & 1);
+            }
+            samples++;
+        }
+    }
+
+    for (I32 i = 0; i < 64; i++)
+    {
+        const double ratio = flips[i] / (double)samples;
+        if (ratio < 0.45 || ratio > 0.55)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
 
 DEFINE_TEST_CASE("CalcHash32")
 {
-    
+    TestEqual(CalcHash32("Hello world", 11), CalcHash32("Hello world", 11));
+    Test(CalcHash32("Hello world", 11) != CalcHash32("Hello world", 11, 1));
+
+    const U64 hash = CalcHash64("Hello world", 11, 7);
+    TestEqual(CalcHash32("Hello world", 11, 7), (U32)(hash ^ (hash >> 32)));
 }
 
 DEFINE_TEST_CASE("CalcHash64")
 {
-    
+    // Unaligned inputs give the same hashes
+    U8 buffer[1100 + 8];
+    HashTest_Fill(buffer, sizeof(buffer), 42);
+    for (I32 length = 0; length < 1100; length += 7)
+    {
+        U8 copy[1100];
+        memcpy(copy, buffer + 3, length);
+        TestEqual(CalcHash64(buffer + 3, length), CalcHash64(copy, length));
+    }
+
+    // Zeros of every length and every seed are distinct
+    U8 zeros[600] = {};
+    U64 hashes[601 + 16];
+    for (I32 length = 0; length <= 600; length++)
+    {
+        hashes[length] = CalcHash64(zeros, length);
+    }
+    for (I32 seed = 1; seed <= 16; seed++)
+    {
+        hashes[600 + seed] = CalcHash64(zeros, 8, seed);
+    }
+
+    I32 duplicates = 0;
+    for (I32 i = 0; i < 601 + 16; i++)
+    {
+        for (I32 j = i + 1; j < 601 + 16; j++)
+        {
+            duplicates += hashes[i] == hashes[j];
+        }
+    }
+    TestEqual(duplicates, 0);
+}
+
+DEFINE_TEST_CASE("CalcHash64 avalanche")
+{
+    // Every path: short, words, 48 bytes loop, long striped
+    Test(HashTest_Avalanche(3, 400));
+    Test(HashTest_Avalanche(8, 200));
+    Test(HashTest_Avalanche(16, 100));
+    Test(HashTest_Avalanche(40, 50));
+    Test(HashTest_Avalanche(200, 10));
+    Test(HashTest_Avalanche(300, 10));
+    Test(HashTest_Avalanche(512, 6));
+}
+
+DEFINE_TEST_CASE("CalcHash64 sparse keys")
+{
+    // All the 32 bytes keys with at most 2 bits set, no collision expected
+    const I32 bits = 32 * 8;
+    const I32 count = 1 + bits + bits * (bits - 1) / 2;
+    U64* hashes = (U64*)MemoryAlloc(count * sizeof(U64));
+
+    U8 key[32] = {};
+    I32 index = 0;
+    hashes[index++] = CalcHash64(key, sizeof(key));
+    for (I32 i = 0; i < bits; i++)
+    {
+        key[i >> 3] ^= (U8)(1 << (i & 7));
+        hashes[index++] = CalcHash64(key, sizeof(key));
+        for (I32 j = i + 1; j < bits; j++)
+        {
+            key[j >> 3] ^= (U8)(1 << (j & 7));
+            hashes[index++] = CalcHash64(key, sizeof(key));
+            key[j >> 3] ^= (U8)(1 << (j & 7));
+        }
+        key[i >> 3] ^= (U8)(1 << (i & 7));
+    }
+    TestEqual(index, count);
+
+    qsort(hashes, count, sizeof(U64), [](const void* a, const void* b) {
+        const U64 x = *(const U64*)a;
+        const U64 y = *(const U64*)b;
+        return x < y ? -1 : x > y;
+    });
+
+    I32 collisions = 0;
+    for (I32 i = 1; i < count; i++)
+    {
+        collisions += hashes[i] == hashes[i - 1];
+    }
+    TestEqual(collisions, 0);
+
+    MemoryFree(hashes);
+}
+
+DEFINE_TEST_CASE("CalcHash64 buckets")
+{
+    // Hash tables take the hash modulo their bucket count, sequential names must spread evenly
+    constexpr I32 BUCKET_COUNT = 1024;
+    constexpr I32 KEY_COUNT = BUCKET_COUNT * 64;
+
+    // Both halves are checked, 32-bit hashes fold them
+    static I32 lowBuckets[BUCKET_COUNT];
+    static I32 highBuckets[BUCKET_COUNT];
+    memset(lowBuckets, 0, sizeof(lowBuckets));
+    memset(highBuckets, 0, sizeof(highBuckets));
+    for (I32 i = 0; i < KEY_COUNT; i++)
+    {
+        char name[32];
+        const I32 length = snprintf(name, sizeof(name), "entity_%d", i);
+        const U64 hash = CalcHash64(name, length);
+        lowBuckets[hash % BUCKET_COUNT]++;
+        highBuckets[(hash >> 32) % BUCKET_COUNT]++;
+    }
+
+    // Chi-square with 1023 degrees of freedom: about 1023 +/- 45 for an unbiased hash
+    double lowChiSquare = 0.0;
+    double highChiSquare = 0.0;
+    for (I32 i = 0; i < BUCKET_COUNT; i++)
+    {
+        lowChiSquare += (lowBuckets[i] - 64.0) * (lowBuckets[i] - 64.0) / 64.0;
+        highChiSquare += (highBuckets[i] - 64.0) * (highBuckets[i] - 64.0) / 64.0;
+    }
+    Test(lowChiSquare < 1200.0);
+    Test(highChiSquare < 1200.0);
 }
 
 DEFINE_TEST_CASE("ConstHash32")
@@ -21,4 +199,29 @@ DEFINE_TEST_CASE("ConstHash32")
 DEFINE_TEST_CASE("ConstHash64")
 {
     TestEqual(ConstHash64("Hello world"), CalcHash64("Hello world"));
+
+    // Evaluated by the compiler, on every path
+    constexpr U64 shortHash = ConstHash64("abc");
+    constexpr U64 mediumHash = ConstHash64("Symbols names are usually shorter than this one, but not always");
+    constexpr U64 longHash = ConstHash64(
+        "Long names go through the striped path: it starts above HASH_LONG_MIN bytes, reads the input in stripes of 64 bytes, "
+        "and ends with the last 64 bytes of the input overlapping the previous stripe. This text is long enough for it, "
+        "with a few more words to be sure.");
+    TestEqual(shortHash, CalcHash64("abc", 3));
+    TestEqual(mediumHash, CalcHash64(StringView("Symbols names are usually shorter than this one, but not always")));
+    TestEqual(longHash, CalcHash64(StringView(
+        "Long names go through the striped path: it starts above HASH_LONG_MIN bytes, reads the input in stripes of 64 bytes, "
+        "and ends with the last 64 bytes of the input overlapping the previous stripe. This text is long enough for it, "
+        "with a few more words to be sure.")));
+
+    // Runtime evaluation of the twin, every length and a few seeds (the SIMD paths must agree with it)
+    static char buffer[2200];
+    HashTest_Fill((U8*)buffer, sizeof(buffer), 7);
+    I32 mismatches = 0;
+    for (I32 length = 0; length <= (I32)sizeof(buffer); length++)
+    {
+        mismatches += ConstHash64(StringView(buffer, length)) != CalcHash64(buffer, length);
+        mismatches += ConstHash64(StringView(buffer, length), length * 31) != CalcHash64(buffer, length, length * 31);
+    }
+    TestEqual(mismatches, 0);
 }
@@ -0,0 +1,173 @@
+#include <Misc/Testing.h>
+
+#include <Concurrency/JobSystem.h>
+#include <Concurrency/JobProfiler.h>
+
+static const char* IncrementCounterName = "IncrementCounter";
+
+static void IncrementCounter(void* data)
+{
+    (*(I32*)data)++;
+}
+
+DEFINE_TEST_CASE("StartJob")
+{
+    I32 counter = 0;
+    StartJob(&counter, IncrementCounter, IncrementCounterName);
+    StartJob(&counter, IncrementCounter, IncrementCounterName);
+    UpdateJobs();
+
+    TestEqual(counter, 2);
+}
+
+#if JOB_PROFILER
+DEFINE_TEST_CASE("JobProfilerRecord")
+{
+    JobProfilerClear();
+    JobProfilerEnable(true);
+
+    I32 counter = 0;
+    StartJob(&counter, IncrementCounter, IncrementCounterName);
+    UpdateJobs();
+
+    JobProfilerEnable(false);
+
+    JobProfileEvent events[4];
+    I32 count = JobProfilerCollect(events, 4);
+    TestEqual(count, 1);
+    TestEqual(events[0].Worker, 0);
+    Test(events[0].End >= events[0].Start);
+    Test(events[0].Name == IncrementCounterName);
+
+    JobProfilerClear();
+    TestEqual(JobProfilerCollect(events, 4), 0);
+}
+#endif
+
+struct OrderRecorder
+{
+    I32 Count;
+    I32 Order[64];
+};
+
+struct OrderJobData
+{
+    OrderRecorder*  Recorder;
+    I32             Id;
+};
+
+static void RecordOrder(void* data)
+{
+    OrderJobData* jobData = (OrderJobData*)data;
+    OrderRecorder* recorder = jobData->Recorder;
+    recorder->Order[recorder->Count++] = jobData->Id;
+}
+
+DEFINE_TEST_CASE("StartJob with priorities")
+{
+    OrderRecorder recorder = {};
+    OrderJobData background = { &recorder, 2 };
+    OrderJobData normal     = { &recorder, 1 };
+    OrderJobData high       = { &recorder, 0 };
+
+    StartJob(&background, RecordOrder, "Background", JobPriority::Background);
+    StartJob(&normal, RecordOrder, "Normal", JobPriority::Normal);
+    StartJob(&high, RecordOrder, "High", JobPriority::High);
+    UpdateJobs();
+
+    TestEqual(recorder.Count, 3);
+    TestEqual(recorder.Order[0], 0);
+    TestEqual(recorder.Order[1], 1);
+    TestEqual(recorder.Order[2], 2);
+}
+
+DEFINE_TEST_CASE("StartJob background is not starved")
+{
+    OrderRecorder recorder = {};
+    OrderJobData background = { &recorder, 1 };
+    OrderJobData high       = { &recorder, 0 };
+
+    StartJob(&background, RecordOrder, "Background", JobPriority::Background);
+    for (I32 i = 0; i < 32; i++)
+    {
+        StartJob(&high, RecordOrder, "High", JobPriority::High);
+    }
+    UpdateJobs();
+
+    TestEqual(recorder.Count, 33);
+
+    I32 backgroundIndex = -1;
+    for (I32 i = 0; i < recorder.Count; i++)
+    {
+        if (recorder.Order[i] == 1)
+        {
+            backgroundIndex = i;
+        }
+    }
+    Test(backgroundIndex >= 0 && backgroundIndex < 32);
+}
+
+DEFINE_TEST_CASE("StartMainThreadJob")
+{
+    I32 counter = 0;
+    for (I32 i = 0; i < 4; i++)
+    {
+        StartMainThreadJob(&counter, IncrementCounter, IncrementCounterName);
+    }
+
+    // Zero budget run exactly one job
+    TestEqual(UpdateMainThreadJobs(0.0f), 1);
+    TestEqual(counter, 1);
+
+    TestEqual(UpdateMainThreadJobs(1.0f), 3);
+    TestEqual(counter, 4);
+    TestEqual(UpdateMainThreadJobs(1.0f), 0);
+}
+
+static void IncrementAtomicCounter(void* data)
+{
+    ((std::atomic<I32>*)data)->fetch_add(1);
+}
+
+DEFINE_TEST_CASE("InitJobSystem")
+{
+    Test(InitJobSystem(4));
+    TestEqual(GetJobWorkerCount(), 4);
+
+    std::atomic<I32> counter(0);
+    for (I32 i = 0; i < 300; i++)
+    {
+        StartJob(&counter, IncrementAtomicCounter, "IncrementAtomicCounter", (JobPriority)(i % (I32)JobPriority::Count));
+    }
+
+    ShutdownJobSystem();
+    TestEqual(counter.load(), 300);
+    TestEqual(GetJobWorkerCount(), 0);
+}
+
+DEFINE_TEST_CASE("StartJobs")
+{
+    std::atomic<I32> counter(0);
+
+    Job jobs[1000];
+    for (I32 i = 0; i < 1000; i++)
+    {
+        jobs[i] = Job{ &counter, IncrementAtomicCounter, "IncrementAtomicCounter" };
+    }
+
+    // Without workers
+    StartJobs(jobs, 1000);
+    WaitForJobs();
+    TestEqual(counter.load(), 1000);
+
+    // With workers, more batches than the injection queue can hold
+    Test(InitJobSystem(4));
+    for (I32 i = 0; i < 100; i++)
+    {
+        StartJobs(jobs, 1000);
+    }
+    WaitForJobs();
+    TestEqual(counter.load(), 101000);
+
+    ShutdownJobSystem();
+}
@@ -1,7 +1,15 @@
 #include <Misc/Testing.h>
 
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include <Text/Json.h>
 #include <Text/String.h>
+#include <System/Memory.h>
+#include <Container/Array.h>
+#include <Concurrency/JobSystem.h>
 
 DEFINE_TEST_CASE("Basics json")
 {
@@ -12,4 +20,622 @@ DEFINE_TEST_CASE("Basics json")
     );
 
     FreeJson(json);
-}
\ No newline at end of file
+}
+
+DEFINE_TEST_CASE("Json values")
+{
+    Json* json = ParseJson(
+        "{\n"
+        "    \"name\": \"player\",\n"
+        "    \"position\": [ 1.5, -2e3, 0, 123456789012, 0.125E+1 ],\n"
+        "    \"visible\": true,\n"
+        "    \"parent\": null,\n"
+        "    \"tags\": [],\n"
+        "    \"components\": { \"sprite\": { \"frame\": 3 }, \"empty\": {} }\n"
+        "}\n");
+    Test(json != nullptr && json->Type == JsonType::Object);
+
+    Json position = JsonFind(*json, "position");
+    TestEqual(position.Type, JsonType::Array);
+    TestEqual(position.Array.Count, 5);
+    TestEqual(position.Array.Items[0].Number, 1.5);
+    TestEqual(position.Array.Items[1].Number, -2000.0);
+    TestEqual(position.Array.Items[2].Type, JsonType::Integer);
+    TestEqual(position.Array.Items[2].Integer, (I64)0);
+    TestEqual(position.Array.Items[3].Integer, (I64)123456789012);
+    TestEqual(position.Array.Items[4].Number, 1.25);
+
+    Test(JsonFind(*json, "visible").Type == JsonType::Boolean && JsonFind(*json, "visible").Boolean);
+    TestEqual(JsonFind(*json, "parent").Type, JsonType::Null);
+    TestEqual(JsonFind(*json, "tags").Array.Count, 0);
+
+    Json sprite = JsonFind(JsonFind(*json, "components"), "sprite");
+    TestEqual(JsonFind(sprite, "frame").Integer, (I64)3);
+    TestEqual(JsonGetNumber(JsonFind(sprite, "frame")), 3.0);
+    TestEqual(JsonFind(JsonFind(*json, "components"), "empty").Type, JsonType::Object);
+
+    FreeJson(json);
+}
+
+DEFINE_TEST_CASE("Json numbers")
+{
+    // Parsed doubles must be the nearest double, exactly as strtod would round them
+    const char* numbers[] = {
+        "0.1", "-0.0", "3.141592653589793238462643383279", "2.2250738585072014e-308", "4.9e-324", "2e-324",
+        "1.7976931348623157e308", "1e400", "9007199254740993.0", "123456789012345678901234567890", "7.2057594037927933e16",
+        "1.00000000000000011102230246251565404236316680908203125", "1.00000000000000011102230246251565404236316680908203126",
+        "0.000000000000000000000000000001234", "9223372036854775808", "12345678.87654321e-5",
+    };
+
+    char document[128];
+    for (const char* number : numbers)
+    {
+        snprintf(document, sizeof(document), "[%s]", number);
+
+        Json* json = ParseJson(document);
+        Test(json != nullptr && json->Array.Items[0].Type == JsonType::Number);
+
+        const double expected = strtod(number, nullptr);
+        Test(memcmp(&json->Array.Items[0].Number, &expected, sizeof(double)) == 0);
+
+        FreeJson(json);
+    }
+
+    // Random doubles printed with every precision must round-trip
+    U64 seed = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 20000; i++)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+
+        double value;
+        U64 bits = seed & 0x7FEFFFFFFFFFFFFFull;
+        memcpy(&value, &bits, sizeof(value));
+
+        snprintf(document, sizeof(document), "[%.*g]", 1 + i % 17, value);
+
+        Json* json = ParseJson(document);
+        const double expected = strtod(document + 1, nullptr);
+        const double parsed = JsonGetNumber(json->Array.Items[0]);
+        Test(memcmp(&parsed, &expected, sizeof(double)) == 0);
+
+        FreeJson(json);
+    }
+
+    // Integers are exact up to the I64 limits
+    Json* json = ParseJson("[9223372036854775807, -9223372036854775808, 9007199254740993, -12, 1.0, 1e2]");
+    TestEqual(json->Array.Items[0].Integer, (I64)0x7FFFFFFFFFFFFFFFll);
+    TestEqual(json->Array.Items[1].Integer, (I64)(-0x7FFFFFFFFFFFFFFFll - 1));
+    TestEqual(json->Array.Items[2].Integer, (I64)9007199254740993ll);
+    TestEqual(json->Array.Items[3].Integer, (I64)-12);
+    TestEqual(json->Array.Items[4].Type, JsonType::Number);
+    TestEqual(json->Array.Items[5].Type, JsonType::Number);
+    FreeJson(json);
+
+    // Negative zero keeps its sign through parsing and writing
+    json = ParseJson("[-0]");
+    TestEqual(json->Array.Items[0].Type, JsonType::Number);
+    Test(signbit(json->Array.Items[0].Number));
+
+    JsonWriter* writer = MakeJsonWriter();
+    Test(JsonWrite(writer, *json));
+
+    Json* written = ParseJson(writer->Buffer, writer->Length);
+    Test(written != nullptr && written->Array.Items[0].Type == JsonType::Number && signbit(written->Array.Items[0].Number));
+
+    FreeJson(written);
+    FreeJsonWriter(writer);
+    FreeJson(json);
+}
+
+DEFINE_TEST_CASE("Json string escapes")
+{
+    // Backslash runs cross the 64 bytes blocks of the structural index
+    Json* json = ParseJson(
+        "[\"0123456789012345678901234567890123456789012345678901234567890\\\\\","
+        "\"tab\\there \\\"quoted\\\" \\u00e9\\/\", \"\\\\\\\\\\\\\\\"\"]");
+    Test(json != nullptr && json->Array.Count == 3);
+    TestEqual(json->Array.Items[0].String.Length, 62);
+    Test(StringCompare(json->Array.Items[1].String, "tab\there \"quoted\" \xC3\xA9/") == 0);
+    Test(StringCompare(json->Array.Items[2].String, "\\\\\\\"") == 0);
+    FreeJson(json);
+
+    // Surrogate pairs are one code point, unpaired surrogates are replaced
+    json = ParseJson("[\"\\ud83d\\ude00\", \"\\ud83d!\", \"\\ude00\\ud83d\"]");
+    Test(json != nullptr && json->Array.Count == 3);
+    Test(StringCompare(json->Array.Items[0].String, "\xF0\x9F\x98\x80") == 0);
+    Test(StringCompare(json->Array.Items[1].String, "\xEF\xBF\xBD!") == 0);
+    Test(StringCompare(json->Array.Items[2].String, "\xEF\xBF\xBD\xEF\xBF\xBD") == 0);
+    FreeJson(json);
+
+    // Strings are not limited by an internal buffer
+    static char text[10004];
+    text[0] = '[';
+    text[1] = '"';
+    for (I32 i = 0; i < 10000; i++)
+    {
+        text[i + 2] = (char)('a' + i % 26);
+    }
+    text[10002] = '"';
+    text[10003] = ']';
+
+    json = ParseJson(text, (I32)sizeof(text));
+    Test(json != nullptr && json->Array.Items[0].String.Length == 10000);
+    FreeJson(json);
+}
+
+DEFINE_TEST_CASE("Json malformed documents")
+{
+    const char* documents[] = {
+        "",
+        "1",
+        "[1, 2,]",
+        "[1 2]",
+        "[01]",
+        "[1.]",
+        "[1e]",
+        "[+1]",
+        "[tru]",
+        "[truex]",
+        "[\"unterminated]",
+        "[\"new\nline\"]",
+        "[\"\\x\"]",
+        "{\"key\" 1}",
+        "{\"key\": 1 \"other\": 2}",
+        "{key: 1}",
+        "{\"key\": 1}}",
+        "[[1, 2]",
+        "[\"caf\xC3\"]",
+        "[\"\xED\xA0\x80\"]",
+    };
+
+    for (const char* document : documents)
+    {
+        Json* json = ParseJson(document);
+        Test(json == nullptr);
+        FreeJson(json);
+    }
+}
+
+DEFINE_TEST_CASE("Json in situ")
+{
+    char source[] = "{ \"name\": \"hero\", \"quote\": \"say \\\"hi\\\"\\n\", \"empty\": \"\", \"keys\\u0021\": [ \"a\\\\b\" ] }";
+    const char* sourceEnd = source + sizeof(source);
+
+    Json* json = ParseJsonInSitu(source);
+    Test(json != nullptr);
+
+    // Strings are decoded in place and point into the source buffer
+    String name = JsonFind(*json, "name").String;
+    Test(name.Buffer >= source && name.Buffer < sourceEnd && !name.IsOwned);
+    Test(StringCompare(name, "hero") == 0);
+
+    String quote = JsonFind(*json, "quote").String;
+    Test(quote.Buffer >= source && quote.Buffer < sourceEnd);
+    Test(StringCompare(quote, "say \"hi\"\n") == 0);
+
+    TestEqual(JsonFind(*json, "empty").String.Length, 0);
+    Test(StringCompare(JsonFind(*json, "keys!").Array.Items[0].String, "a\\b") == 0);
+
+    FreeJson(json);
+}
+
+// Feed the reader a few bytes at a time, so every token cross chunk boundaries
+struct JsonTestStream
+{
+    const char* Buffer;
+    int         Length;
+    int         Cursor;
+    int         Step;
+};
+
+static int JsonTestStreamRead(void* userData, void* buffer, int length)
+{
+    JsonTestStream* stream = (JsonTestStream*)userData;
+
+    int count = stream->Length - stream->Cursor;
+    count = count < length ? count : length;
+    count = count < stream->Step ? count : stream->Step;
+
+    memcpy(buffer, stream->Buffer + stream->Cursor, count);
+    stream->Cursor += count;
+    return count;
+}
+
+DEFINE_TEST_CASE("Json reader")
+{
+    const char* document = "{ \"id\": 42, \"name\": \"long enough to grow the chunk \\\"twice\\\"\", \"tags\": [true, null, -1.5e3], \"empty\": {} }";
+
+    for (int step = 1; step <= 7; step++)
+    {
+        JsonTestStream stream = { document, (int)strlen(document), 0, step };
+        JsonReader* reader = MakeJsonReader(JsonTestStreamRead, &stream, 8);
+
+        Test(JsonReaderNext(reader) == JsonToken::BeginObject && reader->Depth == 0);
+
+        Test(JsonReaderNext(reader) == JsonToken::Key && StringCompare(reader->String, "id") == 0);
+        Test(JsonReaderNext(reader) == JsonToken::Integer && reader->Integer == 42 && reader->Depth == 1);
+
+        Test(JsonReaderNext(reader) == JsonToken::Key && StringCompare(reader->String, "name") == 0);
+        Test(JsonReaderNext(reader) == JsonToken::String && StringCompare(reader->String, "long enough to grow the chunk \"twice\"") == 0);
+        Test(reader->String.Buffer[reader->String.Length] == '\0');
+
+        Test(JsonReaderNext(reader) == JsonToken::Key && StringCompare(reader->String, "tags") == 0);
+        Test(JsonReaderNext(reader) == JsonToken::BeginArray && reader->Depth == 1);
+        Test(JsonReaderNext(reader) == JsonToken::Boolean && reader->Boolean && reader->Depth == 2);
+        Test(JsonReaderNext(reader) == JsonToken::Null);
+        Test(JsonReaderNext(reader) == JsonToken::Number && reader->Number == -1500.0);
+        Test(JsonReaderNext(reader) == JsonToken::EndArray && reader->Depth == 1);
+
+        Test(JsonReaderNext(reader) == JsonToken::Key && StringCompare(reader->String, "empty") == 0);
+        Test(JsonReaderNext(reader) == JsonToken::BeginObject);
+        Test(JsonReaderNext(reader) == JsonToken::EndObject);
+
+        Test(JsonReaderNext(reader) == JsonToken::EndObject && reader->Depth == 0);
+        Test(JsonReaderNext(reader) == JsonToken::End);
+        Test(JsonReaderNext(reader) == JsonToken::End);
+        TestEqual(JsonReaderGetError(reader), JsonError::None);
+
+        FreeJsonReader(reader);
+    }
+}
+
+DEFINE_TEST_CASE("Json reader skip records")
+{
+    // JSON Lines log, only "frame" is read from each record
+    const char* document =
+        "{\"frame\":1,\"input\":{\"keys\":[1,2,3],\"text\":\"a\\\\b\"},\"pos\":[0.5,1]}\n"
+        "{\"pos\":[2,3],\"input\":{},\"frame\":2}\n"
+        "{\"frame\":3}\n";
+
+    JsonTestStream stream = { document, (int)strlen(document), 0, 5 };
+    JsonReader* reader = MakeJsonReader(JsonTestStreamRead, &stream, 16);
+
+    I64    frames = 0;
+    int    records = 0;
+    while (JsonReaderNext(reader) == JsonToken::BeginObject)
+    {
+        records++;
+        while (JsonReaderNext(reader) == JsonToken::Key)
+        {
+            if (StringCompare(reader->String, "frame") == 0)
+            {
+                Test(JsonReaderNext(reader) == JsonToken::Integer);
+                frames += reader->Integer;
+            }
+            else
+            {
+                Test(JsonReaderSkip(reader));
+            }
+        }
+        Test(reader->Token == JsonToken::EndObject);
+    }
+
+    Test(reader->Token == JsonToken::End);
+    TestEqual(records, 3);
+    TestEqual(frames, (I64)6);
+
+    FreeJsonReader(reader);
+}
+
+DEFINE_TEST_CASE("Json reader malformed documents")
+{
+    const char* documents[] = {
+        "",
+        "42",
+        "{ \"a\": }",
+        "{ \"a\" 1 }",
+        "[1, 2",
+        "[1 2]",
+        "{ \"a\": [1, 2} }",
+        "[\"unterminated]",
+        "[tru]",
+        "[01]",
+        "{}x",
+    };
+
+    for (const char* document : documents)
+    {
+        JsonTestStream stream = { document, (int)strlen(document), 0, 3 };
+        JsonReader* reader = MakeJsonReader(JsonTestStreamRead, &stream, 4);
+
+        JsonToken token;
+        do
+        {
+            token = JsonReaderNext(reader);
+        } while (token != JsonToken::End && token != JsonToken::Error);
+
+        // An empty input is an empty stream
+        Test(token == (document[0] ? JsonToken::Error : JsonToken::End));
+        Test(JsonReaderNext(reader) == token);
+        Test(token == JsonToken::End || JsonReaderGetError(reader) != JsonError::None);
+
+        FreeJsonReader(reader);
+    }
+}
+
+DEFINE_TEST_CASE("Json writer")
+{
+    JsonWriter* writer = MakeJsonWriter();
+    JsonWriteBeginObject(writer);
+    JsonWriteKey(writer, "name");
+    JsonWriteString(writer, "tab\there \"quoted\" \\ \x01");
+    JsonWriteKey(writer, "position");
+    JsonWriteBeginArray(writer);
+    JsonWriteNumber(writer, 0.1);
+    JsonWriteNumber(writer, -2e30);
+    JsonWriteInteger(writer, -9007199254740993ll);
+    JsonWriteNumber(writer, HUGE_VAL);
+    JsonWriteEndArray(writer);
+    JsonWriteKey(writer, "tags");
+    JsonWriteBeginArray(writer);
+    JsonWriteEndArray(writer);
+    JsonWriteKey(writer, "visible");
+    JsonWriteBoolean(writer, true);
+    JsonWriteKey(writer, "parent");
+    JsonWriteNull(writer);
+    JsonWriteEndObject(writer);
+
+    const char* expected =
+        "{\"name\":\"tab\\there \\\"quoted\\\" \\\\ \\u0001\","
+        "\"position\":[0.1,-2e+30,-9007199254740993,null],\"tags\":[],\"visible\":true,\"parent\":null}";
+    Test(writer->Length == (int)strlen(expected) && memcmp(writer->Buffer, expected, writer->Length) == 0);
+    FreeJsonWriter(writer);
+
+    writer = MakeJsonWriter(2);
+    JsonWriteBeginObject(writer);
+    JsonWriteKey(writer, "frame");
+    JsonWriteBeginArray(writer);
+    JsonWriteInteger(writer, 1);
+    JsonWriteInteger(writer, 2);
+    JsonWriteEndArray(writer);
+    JsonWriteKey(writer, "empty");
+    JsonWriteBeginObject(writer);
+    JsonWriteEndObject(writer);
+    JsonWriteEndObject(writer);
+
+    expected = "{\n  \"frame\": [\n    1,\n    2\n  ],\n  \"empty\": {}\n}";
+    Test(writer->Length == (int)strlen(expected) && memcmp(writer->Buffer, expected, writer->Length) == 0);
+    FreeJsonWriter(writer);
+
+    // Invalid UTF-8 is replaced so the text parses again: stray continuation, truncated sequence, overlong form
+    writer = MakeJsonWriter();
+    JsonWriteBeginArray(writer);
+    JsonWriteString(writer, "a\x80" "b\xC3\"\xC3\xA9\xC0\xAF");
+    JsonWriteEndArray(writer);
+
+    expected = "[\"a\xEF\xBF\xBD" "b\xEF\xBF\xBD\\\"\xC3\xA9\xEF\xBF\xBD\xEF\xBF\xBD\"]";
+    Test(writer->Length == (int)strlen(expected) && memcmp(writer->Buffer, expected, writer->Length) == 0);
+
+    Json* written = ParseJson(writer->Buffer, writer->Length);
+    Test(written != nullptr);
+    FreeJson(written);
+    FreeJsonWriter(writer);
+}
+
+DEFINE_TEST_CASE("Json writer round trip")
+{
+    const char* document =
+        "{\n"
+        "    \"name\": \"player \\\"one\\\"\\n\\u00e9\",\n"
+        "    \"position\": [ 1.5, -2e3, 0, 123456789012, 0.1, 5e-324, 1.7976931348623157e308 ],\n"
+        "    \"visible\": true,\n"
+        "    \"parent\": null,\n"
+        "    \"tags\": [],\n"
+        "    \"components\": { \"sprite\": { \"frame\": 3, \"pivot\": [0.5, 0.25] }, \"empty\": {} }\n"
+        "}\n";
+
+    Json* json = ParseJson(document);
+    Test(json != nullptr);
+
+    Test(StringCompare(JsonGetKey(*json, 0), "name") == 0);
+    Test(StringCompare(JsonGetKey(*json, 5), "components") == 0);
+    TestEqual(JsonGetKey(*json, 6).Length, 0);
+
+    for (int indent = 0; indent <= 4; indent += 4)
+    {
+        JsonWriter* writer = MakeJsonWriter(indent);
+        Test(JsonWrite(writer, *json));
+
+        Json* written = ParseJson(writer->Buffer, writer->Length);
+        Test(written != nullptr && JsonEquals(*json, *written));
+
+        // Writing is deterministic: the same document give the same text
+        JsonWriter* rewriter = MakeJsonWriter(indent);
+        JsonWrite(rewriter, *written);
+        Test(rewriter->Length == writer->Length && memcmp(rewriter->Buffer, writer->Buffer, writer->Length) == 0);
+
+        FreeJsonWriter(rewriter);
+        FreeJson(written);
+        FreeJsonWriter(writer);
+    }
+
+    FreeJson(json);
+}
+
+DEFINE_TEST_CASE("Json binary")
+{
+    Json* json = ParseJson(
+        "{\n"
+        "    \"name\": \"player\",\n"
+        "    \"position\": [ 1.5, -2e3, 0, 1152921504606846976, -12 ],\n"
+        "    \"visible\": true,\n"
+        "    \"parent\": null,\n"
+        "    \"tags\": [],\n"
+        "    \"components\": { \"sprite\": { \"name\": \"player\", \"frame\": 3 }, \"empty\": {} },\n"
+        "    \"tiles\": [ 1, -2, 2147483647 ], \"pivot\": [ 0.5, 0.25 ]\n"
+        "}\n");
+    Test(json != nullptr);
+
+    Buffer buffer = ConvertJsonToBinary(*json);
+    Test(buffer.Data != nullptr && buffer.Size > 0);
+
+    JsonBinary root = OpenJsonBinary(buffer.Data, buffer.Size);
+    Test(root.Document != nullptr);
+    TestEqual(JsonBinaryGetType(root), JsonType::Object);
+    TestEqual(JsonBinaryGetCount(root), 8);
+
+    Test(StringCompare(JsonBinaryGetString(JsonFind(root, "name")), "player") == 0);
+    Test(JsonBinaryGetBoolean(JsonFind(root, "visible")));
+    TestEqual(JsonBinaryGetType(JsonFind(root, "parent")), JsonType::Null);
+    TestEqual(JsonBinaryGetType(JsonFind(root, "missing")), JsonType::Null);
+    TestEqual(JsonBinaryGetCount(JsonFind(root, "tags")), 0);
+
+    JsonBinary position = JsonFind(root, "position");
+    TestEqual(JsonBinaryGetCount(position), 5);
+    TestEqual(JsonBinaryGetNumber(JsonBinaryGetItem(position, 0)), 1.5);
+    TestEqual(JsonBinaryGetNumber(JsonBinaryGetItem(position, 1)), -2000.0);
+    TestEqual(JsonBinaryGetType(JsonBinaryGetItem(position, 2)), JsonType::Integer);
+    TestEqual(JsonBinaryGetInteger(JsonBinaryGetItem(position, 3)), (I64)1152921504606846976ll);
+    TestEqual(JsonBinaryGetInteger(JsonBinaryGetItem(position, 4)), (I64)-12);
+    TestEqual(JsonBinaryGetType(JsonBinaryGetItem(position, 5)), JsonType::Null);
+
+    // Arrays of only integers or only numbers are packed
+    JsonBinary tiles = JsonFind(root, "tiles");
+    TestEqual(JsonBinaryGetInteger(JsonBinaryGetItem(tiles, 1)), (I64)-2);
+    TestEqual(JsonBinaryGetInteger(JsonBinaryGetItem(tiles, 2)), (I64)2147483647);
+    TestEqual(JsonBinaryGetType(JsonBinaryGetItem(JsonFind(root, "pivot"), 1)), JsonType::Number);
+    TestEqual(JsonBinaryGetNumber(JsonBinaryGetItem(JsonFind(root, "pivot"), 1)), 0.25);
+
+    // Strings are stored once
+    JsonBinary sprite = JsonFind(JsonFind(root, "components"), "sprite");
+    TestEqual(JsonBinaryGetInteger(JsonFind(sprite, "frame")), (I64)3);
+    Test(JsonBinaryGetString(JsonFind(sprite, "name")).Buffer == JsonBinaryGetString(JsonFind(root, "name")).Buffer);
+
+    // Members are sorted by hash, every key is found back by its name
+    for (int i = 0; i < JsonBinaryGetCount(root); i++)
+    {
+        const String key = JsonBinaryGetKey(root, i);
+        TestEqual(JsonFind(root, key.Buffer).Bits, JsonBinaryGetValue(root, i).Bits);
+    }
+
+    // Text is not a binary document
+    Test(OpenJsonBinary("{\"name\":\"player\"}", 17).Document == nullptr);
+    Test(OpenJsonBinary(buffer.Data, buffer.Size - 1).Document == nullptr);
+
+    MemoryFree(buffer.Data);
+    FreeJson(json);
+}
+
+DEFINE_TEST_CASE("Json interned keys")
+{
+    char document[] =
+        "[{ \"name\": \"a\", \"frame\": 1 },"
+        " { \"frame\": 2, \"name\": \"b\" },"
+        " { \"na\\u006de\": \"c\", \"frame\": 3, \"name\": \"d\" }]";
+
+    for (int inSitu = 0; inSitu < 2; inSitu++)
+    {
+        Json* json = inSitu ? ParseJsonInSitu(document) : ParseJson(document);
+        Test(json != nullptr && json->Array.Count == 3);
+
+        // Members keep the document order, equal names share one string
+        Json* records = json->Array.Items;
+        Test(StringCompare(JsonGetKey(records[0], 0), "name") == 0);
+        Test(StringCompare(JsonGetKey(records[1], 0), "frame") == 0);
+        Test(JsonGetKey(records[0], 0).Buffer == JsonGetKey(records[1], 1).Buffer);
+        Test(JsonGetKey(records[0], 1).Buffer == JsonGetKey(records[1], 0).Buffer);
+        Test(JsonGetKey(records[0], 0).Buffer == JsonGetKey(records[2], 0).Buffer);
+
+        // A duplicated key keep its first position and its last value
+        TestEqual(records[2].Object.Count, 2);
+        Test(StringCompare(JsonFind(records[2], ConstSymbol("name")).String, "d") == 0);
+        TestEqual(JsonFind(records[2], ConstSymbol("frame")).Integer, (I64)3);
+
+        FreeJson(json);
+    }
+}
+
+DEFINE_TEST_CASE("Json path")
+{
+    constexpr JsonPath positions = ConstJsonPath("/levels/1/entities/*/position");
+    static_assert(positions.Count == 5 && positions.Steps[1].Index == 1 && positions.Steps[3].Wildcard, "Path is compiled at compile time");
+
+    // Runtime and compile time paths hash keys as the parser
+    const JsonPath runtime = MakeJsonPath("/levels/1/entities/*/position");
+    TestEqual(runtime.Steps[0].Hash, positions.Steps[0].Hash);
+    TestEqual(runtime.Steps[4].Hash, CalcHash64("position", 8));
+
+    TestEqual(MakeJsonPath("").Count, 0);
+    TestEqual(MakeJsonPath("levels").Count, -1);
+    TestEqual(MakeJsonPath("/a~2b").Count, -1);
+    TestEqual(MakeJsonPath("/01").Steps[0].Index, -1);
+    TestEqual(MakeJsonPath("/a~1b~0c").Steps[0].Hash, CalcHash64("a/b~c", 5));
+
+    Json* json = ParseJson(
+        "{ \"levels\": ["
+        "    { \"entities\": [] },"
+        "    { \"entities\": ["
+        "        { \"name\": \"a\", \"position\": [1, 2] },"
+        "        { \"name\": \"b\", \"position\": [3, 4] },"
+        "        { \"position\": [5, 6], \"name\": \"c\" },"
+        "        { \"name\": \"d\" }"
+        "    ] }"
+        "], \"a/b~c\": true, \"7\": 7 }");
+    Test(json != nullptr);
+
+    Array<Json> values = {};
+    TestEqual(JsonQueryAll(*json, positions, &values), 3);
+    TestEqual(values.Items[0].Array.Items[0].Integer, (I64)1);
+    TestEqual(values.Items[2].Array.Items[1].Integer, (I64)6);
+
+    TestEqual(JsonQuery(*json, ConstJsonPath("/levels/1/entities/*/position/1")).Integer, (I64)2);
+    TestEqual(JsonQuery(*json, ConstJsonPath("/levels/1/entities/3/name")).String.Buffer[0], 'd');
+    Test(JsonQuery(*json, ConstJsonPath("/a~1b~0c")).Boolean);
+    TestEqual(JsonQuery(*json, ConstJsonPath("/7")).Integer, (I64)7);
+    TestEqual(JsonQuery(*json, ConstJsonPath("/levels/2")).Type, JsonType::Null);
+    TestEqual(JsonQuery(*json, ConstJsonPath("")).Type, JsonType::Object);
+
+    FreeArray(&values);
+    FreeJson(json);
+}
+
+DEFINE_TEST_CASE("Json parallel parsing")
+{
+    // Large enough to be split: records with nested containers, escapes and repeated keys
+    Array<char> document = {};
+    ArrayPush(&document, '[');
+    for (int i = 0; i < 20000; i++)
+    {
+        char record[256];
+        const int length = snprintf(record, sizeof(record),
+            "%s{\"id\":%d,\"name\":\"entity \\\"%d\\\"\",\"position\":[%d.5,-%de-3],\"tags\":[\"a\",\"b\"],\"parent\":%s,\"extra\":{}}",
+            i > 0 ? ",\n" : "", i, i, i, i, (i & 1) ? "null" : "true");
+
+        for (int j = 0; j < length; j++)
+        {
+            ArrayPush(&document, record[j]);
+        }
+    }
+    ArrayPush(&document, ']');
+
+    Json* serial = ParseJson(document.Items, document.Count);
+    Test(serial != nullptr && serial->Type == JsonType::Array);
+    TestEqual(serial->Array.Count, 20000);
+
+    Test(InitJobSystem(4));
+
+    Json* parallel = ParseJson(document.Items, document.Count);
+    Test(parallel != nullptr && JsonEquals(*serial, *parallel));
+    Test(StringCompare(JsonFind(parallel->Array.Items[12345], "name").String, "entity \"12345\"") == 0);
+
+    // In situ strings are decoded in place by the jobs
+    char* mutableDocument = (char*)MemoryAlloc(document.Count);
+    memcpy(mutableDocument, document.Items, document.Count);
+    Json* inSitu = ParseJsonInSitu(mutableDocument, document.Count);
+    Test(inSitu != nullptr && JsonEquals(*serial, *inSitu));
+
+    // An error in the middle of a chunk fails the whole document
+    const int broken = document.Count * 2 / 3;
+    const char saved = document.Items[broken];
+    document.Items[broken] = '#';
+    Test(ParseJson(document.Items, document.Count) == nullptr);
+    document.Items[broken] = saved;
+
+    ShutdownJobSystem();
+
+    FreeJson(inSitu);
+    MemoryFree(mutableDocument);
+    FreeJson(parallel);
+    FreeJson(serial);
+    FreeArray(&document);
+}
@@ -0,0 +1,170 @@
+#include <Misc/Testing.h>
+
+#include <string.h>
+
+#include <Text/Json.h>
+#include <Text/Lexer.h>
+#include <Text/String.h>
+
+static bool LexerExpect(Lexer* lexer, LexerTokenType type, StringView text, I32 line)
+{
+    LexerToken token;
+    LexerNext(lexer, &token);
+    return token.Type == type && StringEquals(LexerTokenText(lexer, &token), text) && token.Line == line;
+}
+
+DEFINE_TEST_CASE("Lexer tokens")
+{
+    const char source[] =
+        "#include <stdio.h> // comment\n"
+        "int main(int argc, char** argv)\n"
+        "{\n"
+        "    /* block\n"
+        "       comment */ x <<= 0x1F'00ull + .5e-3f;\n"
+        "    puts(u8\"caf\\\"\xC3\xA9\" R\"x(raw \" /* )x\" L'\\'');\n"
+        "    #define TWO \\\n"
+        "        2\n"
+        "    a->b::c != d ... @\n"
+        "}";
+
+    Lexer lexer = MakeLexer(StringView(source, sizeof(source) - 1));
+    Test(LexerExpect(&lexer, LexerTokenType::Preprocessor, "#include <stdio.h> // comment", 1));
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "int", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "main", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "(", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "int", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "argc", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, ",", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "char", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "*", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "*", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "argv", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, ")", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "{", 3));
+
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "x", 5));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "<<=", 5));
+    Test(LexerExpect(&lexer, LexerTokenType::Number, "0x1F'00ull", 5));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "+", 5));
+    Test(LexerExpect(&lexer, LexerTokenType::Number, ".5e-3f", 5));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, ";", 5));
+
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "puts", 6));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "(", 6));
+    Test(LexerExpect(&lexer, LexerTokenType::String, "u8\"caf\\\"\xC3\xA9\"", 6));
+    Test(LexerExpect(&lexer, LexerTokenType::String, "R\"x(raw \" /* )x\"", 6));
+    Test(LexerExpect(&lexer, LexerTokenType::Char, "L'\\''", 6));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, ")", 6));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, ";", 6));
+
+    // Directives can be indented, and continue on the next lines
+    Test(LexerExpect(&lexer, LexerTokenType::Preprocessor, "#define TWO \\\n        2", 7));
+
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "a", 9));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "->", 9));
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "b", 9));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "::", 9));
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "c", 9));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "!=", 9));
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "d", 9));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "...", 9));
+    Test(LexerExpect(&lexer, LexerTokenType::Error, "@", 9));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "}", 10));
+
+    LexerToken token;
+    Test(!LexerNext(&lexer, &token));
+    TestEqual(token.Type, LexerTokenType::End);
+    TestEqual(token.Line, 10);
+
+    // Keywords are identifiers, told apart with LexerIsKeyword
+    lexer = MakeLexer("static_assert constexpr int integer _Bool \"int\"");
+    bool keywords[6] = {};
+    for (I32 i = 0; i < 6 && LexerNext(&lexer, &token); i++)
+    {
+        keywords[i] = LexerIsKeyword(&lexer, &token);
+    }
+    Test(keywords[0] && keywords[1] && keywords[2] && !keywords[3] && keywords[4] && !keywords[5]);
+}
+
+DEFINE_TEST_CASE("Lexer comments and errors")
+{
+    const char source[] = "a // line \\\n continued\n/* block */ \"unterminated\n'x' /* open";
+
+    Lexer lexer = MakeLexer(StringView(source, sizeof(source) - 1), LEXER_KEEP_COMMENTS);
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "a", 1));
+    Test(LexerExpect(&lexer, LexerTokenType::Comment, "// line \\\n continued", 1));
+    Test(LexerExpect(&lexer, LexerTokenType::Comment, "/* block */", 3));
+    Test(LexerExpect(&lexer, LexerTokenType::Error, "\"unterminated", 3));
+    Test(LexerExpect(&lexer, LexerTokenType::Char, "'x'", 4));
+    Test(LexerExpect(&lexer, LexerTokenType::Error, "/* open", 4));
+
+    LexerToken token;
+    Test(!LexerNext(&lexer, &token));
+
+    // Comments are spaces, a directive may follow them
+    lexer = MakeLexer("/* c */ # pragma once\nx # y");
+    Test(LexerExpect(&lexer, LexerTokenType::Preprocessor, "# pragma once", 1));
+    Test(LexerExpect(&lexer, LexerTokenType::Identifier, "x", 2));
+    Test(LexerExpect(&lexer, LexerTokenType::Punctuator, "#", 2));
+}
+
+DEFINE_TEST_CASE("Lexer metadata")
+{
+    const char source[] =
+        "// THIS METADATA ARE GENERATE BY EDITOR, PLEASE DO NOT REMOVE ITS\n"
+        "/* \n"
+        "{\n"
+        "    \"name\": \"main player\",\n"
+        "    \"states\": [ \"idle\", \"move\", \"jump\", \"attack\" ],\n"
+        "    \"entry\": \"idle\"\n"
+        "} \n"
+        "*/\n"
+        "// END OF METADATA\n"
+        "const char* fake = \"/* { \\\"not\\\": 1 } */\";\n"
+        "const char* raw = R\"(/* { \"raw\": 1 } */)\";\n"
+        "const char quote = '\"'; int n = 1'000; /* plain comment */\n"
+        "/*{ \"second\": true }*/";
+
+    const StringView view(source, sizeof(source) - 1);
+
+    // Both the full lexer and the fast scan find the two blocks only
+    LexerToken tokens[2][4];
+    I32 counts[2] = {};
+
+    Lexer lexer = MakeLexer(view);
+    for (LexerToken token; LexerNext(&lexer, &token);)
+    {
+        if (token.Type == LexerTokenType::Metadata && counts[0] < 4)
+        {
+            tokens[0][counts[0]++] = token;
+        }
+    }
+
+    lexer = MakeLexer(view);
+    for (LexerToken token; LexerNextMetadata(&lexer, &token);)
+    {
+        if (counts[1] < 4)
+        {
+            tokens[1][counts[1]++] = token;
+        }
+    }
+
+    TestEqual(counts[0], 2);
+    TestEqual(counts[1], 2);
+    for (I32 i = 0; i < 2; i++)
+    {
+        TestEqual(tokens[0][i].Start, tokens[1][i].Start);
+        TestEqual(tokens[0][i].Length, tokens[1][i].Length);
+        TestEqual(tokens[0][i].Line, tokens[1][i].Line);
+    }
+
+    TestEqual(tokens[0][0].Line, 3);
+    TestEqual(tokens[0][1].Line, 13);
+    Test(StringEquals(LexerTokenText(&lexer, &tokens[0][1]), "{ \"second\": true }"));
+
+    // The JSON is parsed from the source
+    Json* json = ParseJson(source + tokens[0][0].Start, tokens[0][0].Length);
+    Test(json != nullptr && json->Type == JsonType::Object);
+    Test(StringEquals(JsonFind(*json, "entry").String, "idle"));
+    FreeJson(json);
+}
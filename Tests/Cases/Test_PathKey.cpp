@@ -0,0 +1,59 @@
+#include <Misc/Testing.h>
+
+#include <string.h>
+
+#include <System/FileSystem.h>
+
+static bool PathNormalizesTo(const char* path, const char* expected, U32 flags = 0)
+{
+    char output[256];
+    const I32 length = NormalizePath(StringView(path, (I32)strlen(path)), output, sizeof(output), flags);
+    return length == (I32)strlen(expected) && memcmp(output, expected, length) == 0;
+}
+
+DEFINE_TEST_CASE("Path normalization")
+{
+    Test(PathNormalizesTo("Art/Player.png", "Art/Player.png"));
+    Test(PathNormalizesTo("Art\\\\Player.png", "Art/Player.png"));
+    Test(PathNormalizesTo("./Art/./Player.png/", "Art/Player.png"));
+    Test(PathNormalizesTo("Assets/../Art/Sprites/../Player.png", "Art/Player.png"));
+    Test(PathNormalizesTo("Art/Player.png", "art/player.png", PATH_FOLD_CASE));
+
+    // Relative paths keep their leading "..", absolute paths cannot go above the root
+    Test(PathNormalizesTo("../../Games/Assets/..", "../../Games"));
+    Test(PathNormalizesTo("a/../../b", "../b"));
+    Test(PathNormalizesTo("/../a//b/", "/a/b"));
+    Test(PathNormalizesTo("C:\\..\\Games\\..\\Assets", "c:/assets", PATH_FOLD_CASE));
+    Test(PathNormalizesTo("/", "/"));
+    Test(PathNormalizesTo("a/..", ""));
+    Test(PathNormalizesTo("", ""));
+
+    // Segments longer than a SIMD block, with dots and non-ASCII bytes which are not folded
+    Test(PathNormalizesTo("Assets/Very Long Directory Name\xC3\x89/.hidden/..Not.A.Parent/File.PNG",
+                          "assets/very long directory name\xC3\x89/.hidden/..not.a.parent/file.png", PATH_FOLD_CASE));
+
+    char small[4];
+    TestEqual(NormalizePath("Art/Player.png", small, sizeof(small)), -1);
+}
+
+DEFINE_TEST_CASE("Path keys")
+{
+    const PathKey key = MakePathKey("Assets/Art/Player.png");
+    Test(key.Hash == MakePathKey("assets\\art\\PLAYER.png").Hash);
+    Test(key.Hash == MakePathKey("./Assets/Audios/../Art//Player.png").Hash);
+    Test(key.Hash != MakePathKey("Assets/Art/Player.jpg").Hash);
+    Test(key.Hash != MakePathKey("Assets/Art/Player.png", 0).Hash);
+    TestEqual(key.Length, 21);
+    TestEqual(key.Hash, CalcHash64("assets/art/player.png", 21));
+
+    // Paths longer than the stack buffer
+    char path[3000];
+    char upper[3000];
+    for (I32 i = 0; i < 3000; i++)
+    {
+        path[i] = i % 10 == 9 ? '/' : (char)('a' + i % 7);
+        upper[i] = path[i] == '/' ? '\\' : (char)(path[i] - 'a' + 'A');
+    }
+    TestEqual(MakePathKey(StringView(path, 3000)).Hash, MakePathKey(StringView(upper, 3000)).Hash);
+    TestEqual(MakePathKey(StringView(path, 3000)).Length, 2999);
+}
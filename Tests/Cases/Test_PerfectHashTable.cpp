@@ -0,0 +1,82 @@
+#include <Misc/Testing.h>
+
+#include <string.h>
+
+#include <Container/PerfectHashTable.h>
+
+constexpr const char* PERFECT_HASH_KEYWORDS[] = {
+    "auto", "break", "case", "char", "const", "continue", "default", "do", "double", "else", "enum",
+    "extern", "float", "for", "goto", "if", "inline", "int", "long", "register", "restrict", "return",
+    "short", "signed", "sizeof", "static", "struct", "switch", "typedef", "union", "unsigned", "void",
+    "volatile", "while", "_Bool", "_Complex", "_Imaginary", "", "a", "b", "ab", "ba",
+};
+constexpr I32 PERFECT_HASH_KEYWORD_COUNT = (I32)(sizeof(PERFECT_HASH_KEYWORDS) / sizeof(PERFECT_HASH_KEYWORDS[0]));
+
+constexpr auto PERFECT_HASH_KEYWORD_TABLE = MakePerfectHashTable(PERFECT_HASH_KEYWORDS);
+static_assert(PERFECT_HASH_KEYWORD_TABLE.Valid, "Keywords are not unique");
+static_assert(ConstPerfectHashFind(PERFECT_HASH_KEYWORD_TABLE, "while") == 33, "Compile-time lookup");
+static_assert(ConstPerfectHashFind(PERFECT_HASH_KEYWORD_TABLE, "whilst") == -1, "Compile-time lookup");
+
+constexpr const char* PERFECT_HASH_DUPLICATES[] = { "png", "wav", "png" };
+static_assert(!MakePerfectHashTable(PERFECT_HASH_DUPLICATES).Valid, "Equal keys cannot be placed");
+
+constexpr const char* PERFECT_HASH_EXTENSIONS[] = { "png", "wav", "json", "ttf" };
+constexpr auto PERFECT_HASH_EXTENSION_TABLE = MakePerfectHashTable(PERFECT_HASH_EXTENSIONS);
+
+static const char* AssetKind(StringView extension)
+{
+    switch (PerfectHashFind(PERFECT_HASH_EXTENSION_TABLE, extension))
+    {
+    case ConstPerfectHashFind(PERFECT_HASH_EXTENSION_TABLE, "png"):
+        return "texture";
+
+    case ConstPerfectHashFind(PERFECT_HASH_EXTENSION_TABLE, "wav"):
+        return "sound";
+
+    case ConstPerfectHashFind(PERFECT_HASH_EXTENSION_TABLE, "json"):
+        return "data";
+
+    case ConstPerfectHashFind(PERFECT_HASH_EXTENSION_TABLE, "ttf"):
+        return "font";
+
+    default:
+        return "unknown";
+    }
+}
+
+DEFINE_TEST_CASE("Perfect hash table lookup")
+{
+    // Every key is found at its index, in one slot
+    bool allFound = true;
+    for (I32 i = 0; i < PERFECT_HASH_KEYWORD_COUNT; i++)
+    {
+        const char* key = PERFECT_HASH_KEYWORDS[i];
+        allFound &= PerfectHashFind(PERFECT_HASH_KEYWORD_TABLE, StringView(key, (I32)strlen(key))) == i;
+    }
+    Test(allFound);
+
+    // Prefixes, extensions and near misses of the keys are not
+    const char* missing[] = { "whil", "whiles", "While", "i", "iff", "abc", "c", "_Boo", "static_assert" };
+    bool noneFound = true;
+    for (const char* key : missing)
+    {
+        noneFound &= PerfectHashFind(PERFECT_HASH_KEYWORD_TABLE, StringView(key, (I32)strlen(key))) == -1;
+    }
+    Test(noneFound);
+
+    I32 entryCount = 0;
+    for (const PerfectHashEntry& entry : PERFECT_HASH_KEYWORD_TABLE.Entries)
+    {
+        entryCount += entry.Length >= 0;
+    }
+    TestEqual(entryCount, PERFECT_HASH_KEYWORD_COUNT);
+}
+
+DEFINE_TEST_CASE("Perfect hash table switch")
+{
+    Test(strcmp(AssetKind("png"), "texture") == 0);
+    Test(strcmp(AssetKind("json"), "data") == 0);
+    Test(strcmp(AssetKind("ttf"), "font") == 0);
+    Test(strcmp(AssetKind("jpg"), "unknown") == 0);
+    Test(strcmp(AssetKind(""), "unknown") == 0);
+}
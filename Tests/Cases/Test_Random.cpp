@@ -0,0 +1,122 @@
+#include <Misc/Testing.h>
+
+#include <string.h>
+
+#include <System/Random.h>
+
+DEFINE_TEST_CASE("Random sequence")
+{
+    // Reference outputs of xoshiro256** from the state { 1, 2, 3, 4 }
+    Random random = { { 1, 2, 3, 4 } };
+    TestEqual(RandomNextU64(&random), 11520ULL);
+    TestEqual(RandomNextU64(&random), 0ULL);
+    TestEqual(RandomNextU64(&random), 1509978240ULL);
+    TestEqual(RandomNextU64(&random), 1215971899390074240ULL);
+
+    // Same seed, same sequence
+    Random a = MakeRandom(42);
+    Random b = MakeRandom(42);
+    Random c = MakeRandom(43);
+    bool same = true;
+    bool different = true;
+    for (I32 i = 0; i < 1000; i++)
+    {
+        const U64 x = RandomNextU64(&a);
+        same &= x == RandomNextU64(&b);
+        different &= x != RandomNextU64(&c);
+    }
+    Test(same);
+    Test(different);
+
+    // A jumped copy starts a new stream
+    Random jumped = a;
+    RandomJump(&jumped);
+    Test(memcmp(jumped.State, a.State, sizeof(a.State)) != 0);
+    Test(RandomNextU64(&jumped) != RandomNextU64(&a));
+
+    // The thread generator is not reseeded on each call
+    TestEqual(GetThreadRandom(), GetThreadRandom());
+    Test(RandomNextU64() != RandomNextU64());
+}
+
+DEFINE_TEST_CASE("Random ranges")
+{
+    Random random = MakeRandom(0);
+
+    bool inRange = true;
+    I32 hits[10] = {};
+    for (I32 i = 0; i < 10000; i++)
+    {
+        const float f = RandomNextF32(&random);
+        inRange &= f >= 0.0f && f < 1.0f;
+
+        const float g = RandomRangeF32(&random, -2.0f, 2.0f);
+        inRange &= g >= -2.0f && g < 2.0f;
+
+        const I32 n = RandomRangeI32(&random, -5, 5);
+        inRange &= n >= -5 && n < 5;
+        hits[n + 5]++;
+    }
+    Test(inRange);
+
+    bool allHit = true;
+    for (I32 count : hits)
+    {
+        allHit &= count > 800 && count < 1200;
+    }
+    Test(allHit);
+
+    // Full range does not overflow
+    TestEqual(RandomRangeI32(&random, 7, 8), 7);
+    const I32 wide = RandomRangeI32(&random, -0x7FFFFFFF - 1, 0x7FFFFFFF);
+    Test(wide < 0x7FFFFFFF);
+}
+
+DEFINE_TEST_CASE("Random fill")
+{
+    constexpr I32 COUNT = 8 * 64 + 5;
+    float floats[COUNT + 1];
+    floats[COUNT] = -1.0f;
+
+    Random random = MakeRandom(1234);
+    Random reference = random;
+    RandomFillF32(&random, floats, COUNT);
+    TestEqual(floats[COUNT], -1.0f);
+
+    // Interleaved streams seeded from the generator, 2 floats per number, whatever the instruction set
+    Random lanes[4];
+    for (Random& lane : lanes)
+    {
+        lane = MakeRandom(RandomNextU64(&reference));
+    }
+    Test(memcmp(random.State, reference.State, sizeof(random.State)) == 0);
+
+    bool matching = true;
+    bool inRange = true;
+    for (I32 i = 0; i < COUNT; i += 2)
+    {
+        const U64 x = RandomNextU64(&lanes[(i / 2) % 4]);
+        const U32 high = (U32)(x >> 41) | 0x3F800000U;
+        const U32 low = ((U32)(x >> 9) & 0x7FFFFFU) | 0x3F800000U;
+
+        float expected[2];
+        memcpy(&expected[0], &high, sizeof(float));
+        memcpy(&expected[1], &low, sizeof(float));
+
+        for (I32 j = i; j < i + 2 && j < COUNT; j++)
+        {
+            matching &= floats[j] == expected[j - i] - 1.0f;
+            inRange &= floats[j] >= 0.0f && floats[j] < 1.0f;
+        }
+    }
+    Test(matching);
+    Test(inRange);
+
+    // Mean of uniform floats
+    double sum = 0.0;
+    for (I32 i = 0; i < COUNT; i++)
+    {
+        sum += floats[i];
+    }
+    Test(sum / COUNT > 0.45 && sum / COUNT < 0.55);
+}
@@ -1,7 +1,11 @@
 #include <Misc/Testing.h>
 
+#include <stdio.h>
+#include <string.h>
+
 #include <Text/String.h>
 #include <System/Memory.h>
+#include <Concurrency/JobSystem.h>
 
 DEFINE_TEST_CASE("Construct const string")
 {
@@ -50,3 +54,277 @@ DEFINE_TEST_CASE("Test two strings are not equal with operator")
 {
     Test(ConstString("Hello World") != ConstString("Hello Kitty"));
 }
+
+DEFINE_TEST_CASE("String compare")
+{
+    Test(StringCompare("abc", "abc") == 0);
+    Test(StringCompare("abc", "abd") < 0);
+    Test(StringCompare("abd", "abc") > 0);
+
+    // A prefix is ordered before the longer string
+    Test(StringCompare("abc", "abcd") < 0);
+    Test(StringCompare("abcd", "abc") > 0);
+
+    // Bytes are compared unsigned, like strcmp
+    Test(StringCompare("\xC3\xA9", "z") > 0);
+
+    // Long strings go through the wide kernels, the difference is found in every lane and in the tail
+    char a[100], b[100];
+    memset(a, 'x', sizeof(a));
+    for (I32 i = 0; i < (I32)sizeof(a); i++)
+    {
+        memcpy(b, a, sizeof(b));
+        b[i] = 'y';
+        Test(StringCompare(StringView(a, sizeof(a)), StringView(b, sizeof(b))) < 0);
+        Test(!StringEquals(StringView(a, sizeof(a)), StringView(b, sizeof(b))));
+        Test(StringEquals(StringView(a, i), StringView(b, i)));
+    }
+}
+
+// Reference implementations, every offset and length cross the 16 and 32 bytes blocks of the kernels
+static I32 NaiveIndexOf(const char* target, I32 length, const char* substring, I32 substringLength)
+{
+    for (I32 i = 0; i + substringLength <= length; i++)
+    {
+        if (memcmp(target + i, substring, substringLength) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static I32 NaiveLastIndexOf(const char* target, I32 length, const char* substring, I32 substringLength)
+{
+    for (I32 i = length - substringLength; i > -1; i--)
+    {
+        if (memcmp(target + i, substring, substringLength) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+DEFINE_TEST_CASE("String search")
+{
+    Test(StringIndexOf("Hello World", 'o') == 4);
+    Test(StringLastIndexOf("Hello World", 'o') == 7);
+    Test(StringIndexOf("Hello World", 'z') == -1);
+    Test(StringIndexOf("Hello World", "World") == 6);
+    Test(StringLastIndexOf("Hello World", "l") == 9);
+    Test(StringIndexOf("Hello World", "") == 0);
+    Test(StringLastIndexOf("Hello World", "") == 11);
+    Test(StringIndexOf("Hi", "Hello") == -1);
+
+    // Matches at the very end of the target
+    Test(StringIndexOf("abcd", "cd") == 2);
+    Test(StringLastIndexOf("abcd", "ab") == 0);
+
+    // Small alphabet: many candidates pass the first/last char filter
+    char target[200];
+    U32 seed = 12345;
+    for (I32 i = 0; i < (I32)sizeof(target); i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        target[i] = 'a' + (char)((seed >> 16) % 3);
+    }
+
+    for (I32 length = 0; length <= (I32)sizeof(target); length += 7)
+    {
+        const StringView view(target, length);
+        for (I32 substringLength = 1; substringLength <= 6; substringLength++)
+        {
+            for (I32 offset = 0; offset + substringLength <= (I32)sizeof(target); offset += 13)
+            {
+                const char* substring = target + offset;
+                TestEqual(StringIndexOf(view, StringView(substring, substringLength)), NaiveIndexOf(target, length, substring, substringLength));
+                TestEqual(StringLastIndexOf(view, StringView(substring, substringLength)), NaiveLastIndexOf(target, length, substring, substringLength));
+            }
+        }
+
+        for (char c = 'a'; c <= 'd'; c++)
+        {
+            TestEqual(StringIndexOf(view, c), NaiveIndexOf(target, length, &c, 1));
+            TestEqual(StringLastIndexOf(view, c), NaiveLastIndexOf(target, length, &c, 1));
+        }
+    }
+}
+
+DEFINE_TEST_CASE("Format integers")
+{
+    char buffer[FORMAT_NUMBER_SIZE];
+
+    Test(StringCompare(StringView(buffer, FormatInteger(buffer, 0)), "0") == 0);
+    Test(StringCompare(StringView(buffer, FormatInteger(buffer, -42)), "-42") == 0);
+    Test(StringCompare(StringView(buffer, FormatInteger(buffer, -0x7FFFFFFFFFFFFFFFll - 1)), "-9223372036854775808") == 0);
+    Test(StringCompare(StringView(buffer, FormatUnsigned(buffer, 0xFFFFFFFFFFFFFFFFull)), "18446744073709551615") == 0);
+}
+
+DEFINE_TEST_CASE("Format doubles")
+{
+    char buffer[FORMAT_NUMBER_SIZE];
+
+    // Shortest digits that parse back to the same double
+    Test(StringCompare(StringView(buffer, FormatDouble(buffer, 0.1)), "0.1") == 0);
+    Test(StringCompare(StringView(buffer, FormatDouble(buffer, 0.1 + 0.2)), "0.30000000000000004") == 0);
+    Test(StringCompare(StringView(buffer, FormatDouble(buffer, 1.0)), "1.0") == 0);
+    Test(StringCompare(StringView(buffer, FormatDouble(buffer, -0.0)), "-0.0") == 0);
+    Test(StringCompare(StringView(buffer, FormatDouble(buffer, 123456.75)), "123456.75") == 0);
+    Test(StringCompare(StringView(buffer, FormatDouble(buffer, 1e22)), "1e+22") == 0);
+    Test(StringCompare(StringView(buffer, FormatDouble(buffer, 1e-7)), "1e-7") == 0);
+    Test(StringCompare(StringView(buffer, FormatDouble(buffer, 5e-324)), "5e-324") == 0);
+    Test(StringCompare(StringView(buffer, FormatDouble(buffer, 1.7976931348623157e308)), "1.7976931348623157e+308") == 0);
+}
+
+DEFINE_TEST_CASE("Format fixed")
+{
+    char buffer[FORMAT_NUMBER_SIZE];
+
+    Test(StringCompare(StringView(buffer, FormatFixed(buffer, 59.94, 2)), "59.94") == 0);
+    Test(StringCompare(StringView(buffer, FormatFixed(buffer, 0.05, 3)), "0.050") == 0);
+    Test(StringCompare(StringView(buffer, FormatFixed(buffer, 2.5, 0)), "3") == 0);
+    Test(StringCompare(StringView(buffer, FormatFixed(buffer, -0.001, 2)), "-0.00") == 0);
+    Test(StringCompare(StringView(buffer, FormatFixed(buffer, 1e300, 2)), "1e+300") == 0);
+
+    // Same digits as printf away from halfway cases
+    U32 random = 1;
+    for (I32 i = 0; i < 10000; i++)
+    {
+        random = random * 1664525U + 1013904223U;
+        const double value = (I32)random / 1000.0 + 0.0001234;
+        const I32 decimals = i % 7;
+
+        char expected[64];
+        snprintf(expected, sizeof(expected), "%.*f", decimals, value);
+        Test(StringCompare(StringView(buffer, FormatFixed(buffer, value, decimals)), StringView(expected, (I32)strlen(expected))) == 0);
+    }
+}
+
+DEFINE_TEST_CASE("String builder")
+{
+    StringBuilder builder = {};
+    TestEqual(StringBuilderToString(&builder).Length, 0);
+
+    StringBuilderAppend(&builder, "FPS: ");
+    StringBuilderAppendFixed(&builder, 59.941, 2);
+    StringBuilderAppendChar(&builder, ' ');
+    StringBuilderAppendInteger(&builder, -42);
+    StringBuilderAppendChar(&builder, ' ');
+    StringBuilderAppendDouble(&builder, 0.1);
+    StringBuilderAppendFormat(&builder, " %s=%x", "mask", 255);
+    Test(StringEquals(StringBuilderToString(&builder), "FPS: 59.94 -42 0.1 mask=ff"));
+    Test(builder.Heap == nullptr);
+
+    // Past the inline buffer, the text moves to the heap and stays null-terminated
+    StringBuilderClear(&builder);
+    for (I32 i = 0; i < 1000; i++)
+    {
+        StringBuilderAppendUnsigned(&builder, (U64)i);
+        StringBuilderAppendChar(&builder, ',');
+    }
+    Test(builder.Heap != nullptr);
+    TestEqual(builder.Length, 3890);
+    TestEqual(builder.Heap[builder.Length], '\0');
+    Test(StringBuilderToString(&builder).Buffer[builder.Length - 4] == '9');
+
+    // Long formats are retried after growing
+    char longText[600];
+    memset(longText, 'a', sizeof(longText) - 1);
+    longText[sizeof(longText) - 1] = '\0';
+    StringBuilderClear(&builder);
+    StringBuilderAppendFormat(&builder, "[%s]", longText);
+    TestEqual(builder.Length, 601);
+    TestEqual(builder.Heap[600], ']');
+    FreeStringBuilder(&builder);
+
+    // Reserving alone moves the text with its terminator
+    StringBuilderAppend(&builder, "inline");
+    Test(StringBuilderReserve(&builder, 4096));
+    Test(builder.Heap != nullptr);
+    Test(strcmp(builder.Heap, "inline") == 0);
+
+    FreeStringBuilder(&builder);
+}
+
+DEFINE_TEST_CASE("String interning")
+{
+    char buffer[] = "enemy_spawn_point";
+
+    String interned = InternString("enemy_spawn_point");
+    Test(interned.IsConst && StringEquals(interned, "enemy_spawn_point"));
+    TestEqual(interned.Buffer[interned.Length], '\0');
+
+    // Same content from another buffer gives the same storage
+    Test(InternString(StringView(buffer, sizeof(buffer) - 1)).Buffer == interned.Buffer);
+    Test(InternString("enemy_spawn").Buffer != interned.Buffer);
+    Test(InternString("").Length == 0);
+
+    // Interned symbols hash like compile-time symbols, and keep their name in release builds
+    Symbol symbol = InternSymbol("player_position");
+    TestEqual(symbol.Hash, ConstSymbol("player_position").Hash);
+    Test(StringEquals(GetSymbolName(symbol), "player_position"));
+    TestEqual(GetSymbolName(ConstSymbol("never_interned")).Length, 0);
+
+    // Enough names to grow the tables of every shard
+    for (I32 i = 0; i < 10000; i++)
+    {
+        char name[32];
+        const I32 length = snprintf(name, sizeof(name), "entity_%d", i);
+        String first = InternString(StringView(name, length));
+        Test(StringEquals(first, StringView(name, length)));
+
+        if (i % 100 == 0)
+        {
+            Test(InternString(StringView(name, length)).Buffer == first.Buffer);
+        }
+    }
+
+    Test(InternString("enemy_spawn_point").Buffer == interned.Buffer);
+}
+
+struct InternJobData
+{
+    I32                 First;
+    const char*         Results[2000];
+    std::atomic<I32>*   Pending;
+};
+
+static void InternNames(void* data)
+{
+    InternJobData* job = (InternJobData*)data;
+    for (I32 i = 0; i < 2000; i++)
+    {
+        char name[32];
+        const I32 length = snprintf(name, sizeof(name), "shared_%d", (job->First + i) % 2000);
+        job->Results[(job->First + i) % 2000] = InternString(StringView(name, length)).Buffer;
+    }
+
+    job->Pending->fetch_sub(1, std::memory_order_release);
+}
+
+DEFINE_TEST_CASE("String interning from jobs")
+{
+    Test(InitJobSystem(4));
+
+    // Every job interns the same names in a different order, all of them must get the same buffers
+    static InternJobData jobs[8];
+    std::atomic<I32> pending(8);
+    for (I32 i = 0; i < 8; i++)
+    {
+        jobs[i].First = i * 250;
+        jobs[i].Pending = &pending;
+        StartJob(&jobs[i], InternNames, "InternNames");
+    }
+    WaitForJobs(&pending);
+
+    for (I32 i = 0; i < 2000; i++)
+    {
+        for (I32 j = 1; j < 8; j++)
+        {
+            Test(jobs[j].Results[i] == jobs[0].Results[i]);
+        }
+    }
+
+    ShutdownJobSystem();
+}
@@ -0,0 +1,205 @@
+#include <Misc/Testing.h>
+
+#include <thread>
+#include <Concurrency/Sync.h>
+
+constexpr I32 SYNC_TEST_THREADS     = 4;
+constexpr I32 SYNC_TEST_ITERATIONS  = 10000;
+
+template <typename Lock, void (*Acquire)(Lock*), void (*Release)(Lock*)>
+static I32 CountWithLock(void)
+{
+    static Lock lock;
+    static I32  counter;
+
+    counter = 0;
+
+    std::thread threads[SYNC_TEST_THREADS];
+    for (I32 i = 0; i < SYNC_TEST_THREADS; i++)
+    {
+        threads[i] = std::thread([]{
+            for (I32 j = 0; j < SYNC_TEST_ITERATIONS; j++)
+            {
+                Acquire(&lock);
+                counter++;
+                Release(&lock);
+            }
+        });
+    }
+
+    for (I32 i = 0; i < SYNC_TEST_THREADS; i++)
+    {
+        threads[i].join();
+    }
+
+    return counter;
+}
+
+DEFINE_TEST_CASE("SpinLock")
+{
+    SpinLock lock = {};
+    Test(SpinLockTryAcquire(&lock));
+    Test(!SpinLockTryAcquire(&lock));
+    SpinLockRelease(&lock);
+
+    TestEqual((CountWithLock<SpinLock, SpinLockAcquire, SpinLockRelease>()), SYNC_TEST_THREADS * SYNC_TEST_ITERATIONS);
+}
+
+DEFINE_TEST_CASE("TicketLock")
+{
+    TicketLock lock = {};
+    Test(TicketLockTryAcquire(&lock));
+    Test(!TicketLockTryAcquire(&lock));
+    TicketLockRelease(&lock);
+    Test(TicketLockTryAcquire(&lock));
+    TicketLockRelease(&lock);
+
+    TestEqual((CountWithLock<TicketLock, TicketLockAcquire, TicketLockRelease>()), SYNC_TEST_THREADS * SYNC_TEST_ITERATIONS);
+}
+
+DEFINE_TEST_CASE("Mutex")
+{
+    Mutex mutex = {};
+    Test(MutexTryLock(&mutex));
+    Test(!MutexTryLock(&mutex));
+    MutexUnlock(&mutex);
+
+    TestEqual((CountWithLock<Mutex, MutexLock, MutexUnlock>()), SYNC_TEST_THREADS * SYNC_TEST_ITERATIONS);
+}
+
+DEFINE_TEST_CASE("RWLock")
+{
+    TestEqual((CountWithLock<RWLock, RWLockWriteLock, RWLockWriteUnlock>()), SYNC_TEST_THREADS * SYNC_TEST_ITERATIONS);
+
+    RWLock lock = {};
+    RWLockReadLock(&lock);
+    RWLockReadLock(&lock);
+    TestEqual(lock.State.load(), 2u);
+    RWLockReadUnlock(&lock);
+    RWLockReadUnlock(&lock);
+
+    RWLockWriteLock(&lock);
+    TestEqual(lock.State.load(), RWLOCK_WRITER);
+    RWLockWriteUnlock(&lock);
+    TestEqual(lock.State.load(), 0u);
+}
+
+DEFINE_TEST_CASE("RWLock readers with write bursts")
+{
+    static RWLock lock;
+    static I32 first;
+    static I32 second;
+    static std::atomic<I32> torn;
+    static std::atomic<bool> writing;
+
+    first = 0;
+    second = 0;
+    torn = 0;
+    writing = true;
+
+    // Readers sleep while writers come and go, every release must wake them
+    std::thread readers[SYNC_TEST_THREADS];
+    for (I32 i = 0; i < SYNC_TEST_THREADS; i++)
+    {
+        readers[i] = std::thread([]{
+            while (writing.load())
+            {
+                RWLockReadLock(&lock);
+                torn += first != second;
+                RWLockReadUnlock(&lock);
+            }
+        });
+    }
+
+    std::thread writer([]{
+        for (I32 i = 0; i < SYNC_TEST_ITERATIONS / 10; i++)
+        {
+            for (I32 j = 0; j < 4; j++)
+            {
+                RWLockWriteLock(&lock);
+                first++;
+                second++;
+                RWLockWriteUnlock(&lock);
+            }
+            ThreadYield();
+        }
+        writing = false;
+    });
+
+    writer.join();
+    for (I32 i = 0; i < SYNC_TEST_THREADS; i++)
+    {
+        readers[i].join();
+    }
+
+    TestEqual(torn.load(), 0);
+    TestEqual(first, SYNC_TEST_ITERATIONS / 10 * 4);
+}
+
+DEFINE_TEST_CASE("Event")
+{
+    static Event event;
+    static std::atomic<I32> released;
+
+    EventReset(&event);
+    released = 0;
+
+    std::thread waiters[SYNC_TEST_THREADS];
+    for (I32 i = 0; i < SYNC_TEST_THREADS; i++)
+    {
+        waiters[i] = std::thread([]{
+            EventWait(&event);
+            released++;
+        });
+    }
+
+    Test(!EventIsSignaled(&event));
+    EventSignal(&event);
+
+    for (I32 i = 0; i < SYNC_TEST_THREADS; i++)
+    {
+        waiters[i].join();
+    }
+
+    TestEqual(released.load(), SYNC_TEST_THREADS);
+    Test(EventIsSignaled(&event));
+}
+
+DEFINE_TEST_CASE("Semaphore")
+{
+    static Semaphore semaphore;
+    static std::atomic<I32> consumed;
+
+    Test(!SemaphoreTryWait(&semaphore));
+    SemaphoreSignal(&semaphore, 2);
+    Test(SemaphoreTryWait(&semaphore));
+    Test(SemaphoreTryWait(&semaphore));
+    Test(!SemaphoreTryWait(&semaphore));
+
+    consumed = 0;
+
+    std::thread consumers[SYNC_TEST_THREADS];
+    for (I32 i = 0; i < SYNC_TEST_THREADS; i++)
+    {
+        consumers[i] = std::thread([]{
+            for (I32 j = 0; j < 100; j++)
+            {
+                SemaphoreWait(&semaphore);
+                consumed++;
+            }
+        });
+    }
+
+    for (I32 i = 0; i < SYNC_TEST_THREADS * 100; i++)
+    {
+        SemaphoreSignal(&semaphore);
+    }
+
+    for (I32 i = 0; i < SYNC_TEST_THREADS; i++)
+    {
+        consumers[i].join();
+    }
+
+    TestEqual(consumed.load(), SYNC_TEST_THREADS * 100);
+    Test(!SemaphoreTryWait(&semaphore));
+}
@@ -0,0 +1,200 @@
+#include <Misc/Testing.h>
+
+#include <string.h>
+
+#include <Text/String.h>
+#include <Text/TextBuffer.h>
+#include <System/Memory.h>
+
+// Flat copy of the text, edited with memmove, to check the buffer against
+struct TextBufferModel
+{
+    char    Chars[16 * 1024];
+    I32     Length;
+};
+
+static void TextBufferModelInsert(TextBufferModel* model, I32 position, const char* text, I32 length)
+{
+    memmove(model->Chars + position + length, model->Chars + position, model->Length - position);
+    memcpy(model->Chars + position, text, length);
+    model->Length += length;
+}
+
+static void TextBufferModelDelete(TextBufferModel* model, I32 position, I32 length)
+{
+    memmove(model->Chars + position, model->Chars + position + length, model->Length - position - length);
+    model->Length -= length;
+}
+
+static bool TextBufferMatchModel(const TextBuffer* buffer, const TextBufferModel* model)
+{
+    if (TextBufferLength(buffer) != model->Length)
+    {
+        return false;
+    }
+
+    String text = TextBufferToString(buffer);
+    const bool sameText = memcmp(text.Buffer, model->Chars, model->Length) == 0;
+    FreeString(&text);
+    if (!sameText)
+    {
+        return false;
+    }
+
+    // Lines found by scanning the flat text
+    I32 line = 0;
+    I32 lineStart = 0;
+    for (I32 i = 0; i <= model->Length; i++)
+    {
+        if (TextBufferLineOf(buffer, i) != line)
+        {
+            return false;
+        }
+
+        if (i == model->Length || model->Chars[i] == '\n')
+        {
+            if (TextBufferLineStart(buffer, line) != lineStart || TextBufferLineEnd(buffer, line) != i)
+            {
+                return false;
+            }
+
+            line++;
+            lineStart = i + 1;
+        }
+    }
+
+    return TextBufferLineCount(buffer) == line;
+}
+
+DEFINE_TEST_CASE("TextBuffer edits")
+{
+    TextBuffer buffer = MakeTextBuffer("first line\nsecond line\nthird");
+    TestEqual(TextBufferLength(&buffer), 28);
+    TestEqual(TextBufferLineCount(&buffer), 3);
+    TestEqual(TextBufferLineStart(&buffer, 1), 11);
+    TestEqual(TextBufferLineEnd(&buffer, 1), 22);
+    TestEqual(TextBufferLineOf(&buffer, 10), 0);
+    TestEqual(TextBufferLineOf(&buffer, 11), 1);
+    TestEqual(TextBufferCharAt(&buffer, 6), 'l');
+
+    Test(TextBufferInsert(&buffer, 11, "inserted\n"));
+    TextBufferDelete(&buffer, 0, 6);
+
+    String text = TextBufferToString(&buffer);
+    Test(StringEquals(text, "line\ninserted\nsecond line\nthird"));
+    FreeString(&text);
+
+    TestEqual(TextBufferLineCount(&buffer), 4);
+    TestEqual(TextBufferLineStart(&buffer, 2), 14);
+    TestEqual(TextBufferLineStart(&buffer, 10), TextBufferLength(&buffer));
+
+    // Out of range edits are clamped
+    Test(TextBufferInsert(&buffer, 1000, "!"));
+    TextBufferDelete(&buffer, -5, 10);
+    text = TextBufferToString(&buffer);
+    Test(StringEquals(text, "ted\nsecond line\nthird!"));
+    FreeString(&text);
+
+    FreeTextBuffer(&buffer);
+}
+
+DEFINE_TEST_CASE("TextBuffer iterator")
+{
+    TextBuffer buffer = MakeTextBuffer("0123456789");
+    TextBufferInsert(&buffer, 5, "abc");
+    TextBufferInsert(&buffer, 0, "xyz");
+
+    // Chunks are contiguous spans, the line is read without flattening
+    char line[32];
+    I32 length = 0;
+    I32 chunks = 0;
+    TextBufferIterator iterator = MakeTextBufferIterator(&buffer, 2, 12);
+    for (String chunk; TextBufferNext(&iterator, &chunk);)
+    {
+        memcpy(line + length, chunk.Buffer, chunk.Length);
+        length += chunk.Length;
+        chunks++;
+    }
+
+    TestEqual(length, 10);
+    TestEqual(chunks, 4);
+    Test(memcmp(line, "z01234abc5", 10) == 0);
+
+    TestEqual(TextBufferCopy(&buffer, 10, 100, line), 6);
+    Test(memcmp(line, "c56789", 6) == 0);
+
+    FreeTextBuffer(&buffer);
+}
+
+DEFINE_TEST_CASE("TextBuffer typing")
+{
+    TextBuffer buffer = MakeTextBuffer("int main()\n{\n}\n");
+
+    // Consecutive chars extend the same piece
+    const char typed[] = "    return 0;\n";
+    for (I32 i = 0; i < (I32)sizeof(typed) - 1; i++)
+    {
+        TextBufferInsert(&buffer, 13 + i, StringView(typed + i, 1));
+    }
+
+    String text = TextBufferToString(&buffer);
+    Test(StringEquals(text, "int main()\n{\n    return 0;\n}\n"));
+    FreeString(&text);
+    TestEqual(buffer.Pieces.Count, 3);
+    TestEqual(TextBufferLineCount(&buffer), 5);
+
+    FreeTextBuffer(&buffer);
+}
+
+DEFINE_TEST_CASE("TextBuffer random edits")
+{
+    static TextBufferModel model;
+    model.Length = 0;
+
+    const char* words[] = { "a", "line\n", "\n", "some words ", "x\ny\nz", "", "\n\n\n" };
+
+    TextBuffer buffer = MakeTextBuffer();
+    U32 random = 12345;
+    bool matched = true;
+    for (I32 i = 0; i < 3000 && matched; i++)
+    {
+        random = random * 1664525U + 1013904223U;
+        const I32 position = model.Length > 0 ? (I32)((random >> 8) % (U32)(model.Length + 1)) : 0;
+
+        if ((random >> 4) % 3 != 0 || model.Length < 64)
+        {
+            const char* word = words[(random >> 20) % 7];
+            const I32 length = (I32)strlen(word);
+            if (model.Length + length < (I32)sizeof(model.Chars))
+            {
+                TextBufferModelInsert(&model, position, word, length);
+                TextBufferInsert(&buffer, position, StringView(word, length));
+            }
+        }
+        else
+        {
+            const I32 length = (I32)((random >> 16) % 24);
+            const I32 deleted = length < model.Length - position ? length : model.Length - position;
+            TextBufferModelDelete(&model, position, deleted);
+            TextBufferDelete(&buffer, position, length);
+        }
+
+        if (i % 100 == 0)
+        {
+            matched = TextBufferMatchModel(&buffer, &model);
+        }
+    }
+
+    Test(matched);
+    Test(TextBufferMatchModel(&buffer, &model));
+
+    // Pieces of deleted text are reused
+    TextBufferDelete(&buffer, 0, TextBufferLength(&buffer));
+    TestEqual(TextBufferLength(&buffer), 0);
+    TestEqual(TextBufferLineCount(&buffer), 1);
+    const I32 pieceCount = buffer.Pieces.Count;
+    TextBufferInsert(&buffer, 0, "reused");
+    TestEqual(buffer.Pieces.Count, pieceCount);
+
+    FreeTextBuffer(&buffer);
+}
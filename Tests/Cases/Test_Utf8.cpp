@@ -0,0 +1,195 @@
+#include <Misc/Testing.h>
+
+#include <string.h>
+
+#include <Text/Utf8.h>
+#include <Text/String.h>
+
+// Index of the error found in sequence padded with ASCII, so it can land at every position of the validator blocks
+static I32 Utf8InvalidIndexAt(const char* sequence, I32 offset)
+{
+    char text[96];
+    memset(text, 'a', sizeof(text));
+    const I32 length = (I32)strlen(sequence);
+    memcpy(text + offset, sequence, length);
+
+    const StringView view(text, offset + length + (offset & 7));
+    const I32 index = Utf8InvalidIndex(view);
+    return Utf8IsValid(view) == (index < 0) ? index : -2;
+}
+
+DEFINE_TEST_CASE("UTF-8 validation")
+{
+    Test(Utf8IsValid(""));
+    Test(Utf8IsValid("plain ASCII text"));
+    Test(Utf8IsValid("caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80"));      // é € 😀
+    Test(Utf8IsValid("\xED\x9F\xBF\xEE\x80\x80"));                      // U+D7FF U+E000 around the surrogates
+    Test(Utf8IsValid("\xF4\x8F\xBF\xBF"));                              // U+10FFFF
+    Test(Utf8IsValid(StringView("\0", 1)));
+
+    // Each kind of error, at every offset of two validator blocks
+    const char* invalids[] = {
+        "\x80",                 // Lone continuation
+        "\xC3",                 // Truncated
+        "\xC3\x28",             // Lead followed by ASCII
+        "\xE2\x82",
+        "\xF0\x9F\x98",
+        "\xC0\xAF",             // Overlong forms
+        "\xE0\x80\xAF",
+        "\xF0\x80\x80\xAF",
+        "\xED\xA0\x80",         // Surrogate
+        "\xF4\x90\x80\x80",     // Above U+10FFFF
+        "\xF8\x88\x80\x80\x80",
+        "\xFF",
+        "\xC3\xA9\xA9",         // Continuation after a complete sequence
+    };
+
+    bool allFound = true;
+    for (I32 i = 0; i < (I32)(sizeof(invalids) / sizeof(invalids[0])); i++)
+    {
+        for (I32 offset = 0; offset < 80; offset++)
+        {
+            const I32 expected = invalids[i][strlen(invalids[i]) - 1] == '\xA9' ? offset + 2 : offset;
+            allFound &= Utf8InvalidIndexAt(invalids[i], offset) == expected;
+        }
+    }
+    Test(allFound);
+
+    TestEqual(Utf8InvalidIndexAt("\xE2\x28\xA1", 31), 31);
+    TestEqual(Utf8InvalidIndex("valid \xC3\xA9 then \xC3"), 14);
+}
+
+DEFINE_TEST_CASE("UTF-8 validation of random text")
+{
+    // Valid text of mixed lengths, then single byte corruptions: the result must match the scalar decoder
+    const char* pieces[] = { "a", "text ", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\xD0\x96", "\n" };
+
+    static char text[4096];
+    I32 length = 0;
+    U32 random = 777;
+    while (length < (I32)sizeof(text) - 8)
+    {
+        random = random * 1664525U + 1013904223U;
+        const char* piece = pieces[(random >> 16) % 7];
+        const I32 pieceLength = (I32)strlen(piece);
+        memcpy(text + length, piece, pieceLength);
+        length += pieceLength;
+    }
+
+    Test(Utf8IsValid(StringView(text, length)));
+
+    bool allMatched = true;
+    for (I32 i = 0; i < 2000; i++)
+    {
+        random = random * 1664525U + 1013904223U;
+        const I32 position = (I32)((random >> 8) % (U32)length);
+        const char saved = text[position];
+        text[position] = (char)(random >> 24);
+
+        // Reference: decode sequence by sequence
+        I32 expected = -1;
+        for (I32 j = 0; j < length;)
+        {
+            I32 sequenceLength;
+            const U32 codepoint = Utf8Decode(text + j, length - j, &sequenceLength);
+            if (codepoint == UTF8_REPLACEMENT_CHAR && memcmp(text + j, "\xEF\xBF\xBD", 3) != 0)
+            {
+                expected = j;
+                break;
+            }
+            j += sequenceLength;
+        }
+
+        allMatched &= Utf8InvalidIndex(StringView(text, length)) == expected;
+        allMatched &= Utf8IsValid(StringView(text, length)) == (expected < 0);
+        text[position] = saved;
+    }
+    Test(allMatched);
+}
+
+DEFINE_TEST_CASE("UTF-8 decode and encode")
+{
+    I32 length;
+    TestEqual(Utf8Decode("A", 1, &length), 'A');
+    TestEqual(length, 1);
+    TestEqual(Utf8Decode("\xC3\xA9", 2, &length), 0xE9u);
+    TestEqual(length, 2);
+    TestEqual(Utf8Decode("\xE2\x82\xAC", 3, &length), 0x20ACu);
+    TestEqual(length, 3);
+    TestEqual(Utf8Decode("\xF0\x9F\x98\x80", 4, &length), 0x1F600u);
+    TestEqual(length, 4);
+    TestEqual(Utf8Decode("\xF0\x9F\x98", 3, &length), UTF8_REPLACEMENT_CHAR);
+    TestEqual(length, 1);
+
+    char buffer[UTF8_MAX_BYTES];
+    const U32 codepoints[] = { 0, 0x7F, 0x80, 0x7FF, 0x800, 0xFFFF, 0x10000, 0x10FFFF };
+    bool roundTrips = true;
+    for (U32 codepoint : codepoints)
+    {
+        const I32 encodedLength = Utf8Encode(codepoint, buffer);
+        roundTrips &= Utf8Decode(buffer, encodedLength, &length) == codepoint && length == encodedLength;
+    }
+    Test(roundTrips);
+
+    TestEqual(Utf8Encode(0xD800, buffer), 3);
+    Test(memcmp(buffer, "\xEF\xBF\xBD", 3) == 0);
+    TestEqual(Utf8Encode(0x110000, buffer), 3);
+
+    // ASCII runs take the wide path, the rest is decoded one by one
+    const char* text = "0123456789abcdef0123456789\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xFF!";
+    const StringView view(text, (I32)strlen(text));
+    U32 decoded[64];
+    const I32 count = Utf8ToCodepoints(view, decoded, 64);
+    TestEqual(count, 31);
+    TestEqual(count, Utf8Length(view));
+    TestEqual(decoded[15], 'f');
+    TestEqual(decoded[26], 0xE9u);
+    TestEqual(decoded[27], 0x20ACu);
+    TestEqual(decoded[28], 0x1F600u);
+    TestEqual(decoded[29], UTF8_REPLACEMENT_CHAR);
+    TestEqual(decoded[30], '!');
+
+    TestEqual(Utf8ToCodepoints(view, decoded, 20), 20);
+    TestEqual(decoded[19], '3');
+}
+
+DEFINE_TEST_CASE("UTF-8 length")
+{
+    TestEqual(Utf8Length(""), 0);
+    TestEqual(Utf8Length("caf\xC3\xA9"), 4);
+
+    // Long enough for the per byte counters to be summed several times
+    static char text[3 * 5000];
+    for (I32 i = 0; i < 5000; i++)
+    {
+        memcpy(text + i * 3, "\xE2\x82\xAC", 3);
+    }
+    TestEqual(Utf8Length(StringView(text, (I32)sizeof(text))), 5000);
+}
+
+DEFINE_TEST_CASE("UTF-16 conversion")
+{
+    const char* text = "Hello, world! caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80";
+    const I32 textLength = (I32)strlen(text);
+
+    U16 wide[64];
+    const I32 wideLength = Utf8ToUtf16(StringView(text, textLength), wide, 64);
+    TestEqual(wideLength, 23);
+    TestEqual(wide[17], 0xE9);
+    TestEqual(wide[19], 0x20AC);
+    TestEqual(wide[21], 0xD83D);
+    TestEqual(wide[22], 0xDE00);
+
+    char narrow[64];
+    TestEqual(Utf16ToUtf8(wide, wideLength, narrow, 64), textLength);
+    Test(memcmp(narrow, text, textLength) == 0);
+
+    // Truncated at a code point boundary, a surrogate pair is never split
+    TestEqual(Utf8ToUtf16(StringView(text, textLength), wide, 22), 21);
+    TestEqual(Utf16ToUtf8(wide, 21, narrow, 21), 20);
+
+    // Unpaired surrogates
+    const U16 unpaired[] = { 'a', 0xD83D, 'b', 0xDE00 };
+    TestEqual(Utf16ToUtf8(unpaired, 4, narrow, 64), 8);
+    Test(memcmp(narrow, "a\xEF\xBF\xBD" "b\xEF\xBF\xBD", 8) == 0);
+}
@@ -96,6 +96,7 @@ do
 
         "Sources",
         "Sources/Misc",
+        "Sources/Concurrency",
         "Sources/Text",
         "Sources/Imgui",
         "Sources/System",
@@ -146,6 +147,26 @@ do
     filter {}
 end
 
+project "Yolo.Benchmark"
+do
+    kind "ConsoleApp"
+
+    links {
+        "Yolo"
+    }
+
+    includedirs {
+        path.join(ROOT_DIR, "Include"),
+    }
+
+    files {
+        path.join(ROOT_DIR, "Benchmarks/*.cpp"),
+        path.join(ROOT_DIR, "Benchmarks/**/*.cpp"),   
+    }
+
+    filter {}
+end
+
 project "Spaneon"
 do
     kind "ConsoleApp"